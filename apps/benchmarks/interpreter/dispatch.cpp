@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+
+#include <components/interpreter/context.hpp>
+#include <components/interpreter/installopcodes.hpp>
+#include <components/interpreter/interpreter.hpp>
+#include <components/interpreter/opcodes.hpp>
+#include <components/interpreter/runtime.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace Interpreter;
+
+    // Roughly the number of extension opcodes the engine installs into segments 3 and 5
+    constexpr int segment3OpcodeCount = 100;
+    constexpr int segment5OpcodeCount = 800;
+    constexpr int firstExtensionCode3 = 0x20000;
+    constexpr int firstExtensionCode5 = 0x2000000;
+
+    int sCounter = 0;
+
+    class OpCount : public Opcode0
+    {
+        public:
+
+            void execute (Runtime& runtime) override
+            {
+                ++sCounter;
+            }
+    };
+
+    class OpCountArg : public Opcode1
+    {
+        public:
+
+            void execute (Runtime& runtime, unsigned int arg0) override
+            {
+                sCounter += arg0;
+            }
+    };
+
+    class EmptyContext : public Context
+    {
+        public:
+
+            int getLocalShort (int index) const override { return 0; }
+            int getLocalLong (int index) const override { return 0; }
+            float getLocalFloat (int index) const override { return 0; }
+            void setLocalShort (int index, int value) override {}
+            void setLocalLong (int index, int value) override {}
+            void setLocalFloat (int index, float value) override {}
+            void messageBox (const std::string& message, const std::vector<std::string>& buttons) override {}
+            void report (const std::string& message) override {}
+            int getGlobalShort (const std::string& name) const override { return 0; }
+            int getGlobalLong (const std::string& name) const override { return 0; }
+            float getGlobalFloat (const std::string& name) const override { return 0; }
+            void setGlobalShort (const std::string& name, int value) override {}
+            void setGlobalLong (const std::string& name, int value) override {}
+            void setGlobalFloat (const std::string& name, float value) override {}
+            std::vector<std::string> getGlobals () const override { return {}; }
+            char getGlobalType (const std::string& name) const override { return ' '; }
+            std::string getActionBinding (const std::string& action) const override { return {}; }
+            std::string getActorName() const override { return {}; }
+            std::string getNPCRace() const override { return {}; }
+            std::string getNPCClass() const override { return {}; }
+            std::string getNPCFaction() const override { return {}; }
+            std::string getNPCRank() const override { return {}; }
+            std::string getPCName() const override { return {}; }
+            std::string getPCRace() const override { return {}; }
+            std::string getPCClass() const override { return {}; }
+            std::string getPCRank() const override { return {}; }
+            std::string getPCNextRank() const override { return {}; }
+            int getPCBounty() const override { return 0; }
+            std::string getCurrentCellName() const override { return {}; }
+            int getMemberShort (const std::string& id, const std::string& name, bool global) const override { return 0; }
+            int getMemberLong (const std::string& id, const std::string& name, bool global) const override { return 0; }
+            float getMemberFloat (const std::string& id, const std::string& name, bool global) const override { return 0; }
+            void setMemberShort (const std::string& id, const std::string& name, int value, bool global) override {}
+            void setMemberLong (const std::string& id, const std::string& name, int value, bool global) override {}
+            void setMemberFloat (const std::string& id, const std::string& name, float value, bool global) override {}
+            unsigned short getContextType() const override { return SCRIPT_LOCAL; }
+            std::string getCurrentScriptName() const override { return {}; }
+            void trackContextType (unsigned short interpreterType) override {}
+            void trackCurrentScriptName (const std::string& name) override {}
+    };
+
+    Type_Code segment0 (int opcode, unsigned int arg0)
+    {
+        return (opcode << 24) | (arg0 & 0xffffff);
+    }
+
+    Type_Code segment3 (int opcode, unsigned int arg0)
+    {
+        return (0x30 << 26) | (opcode << 8) | (arg0 & 0xff);
+    }
+
+    Type_Code segment5 (int opcode)
+    {
+        return (0x32 << 26) | opcode;
+    }
+
+    void installBenchmarkOpcodes (Interpreter::Interpreter& interpreter)
+    {
+        installOpcodes (interpreter);
+
+        for (int i = 0; i < segment3OpcodeCount; ++i)
+            interpreter.installSegment3 (firstExtensionCode3 + i, new OpCountArg);
+
+        for (int i = 0; i < segment5OpcodeCount; ++i)
+            interpreter.installSegment5 (firstExtensionCode5 + i, new OpCount);
+    }
+
+    // Script-like code mixing the stack opcodes with calls to randomly picked extension opcodes
+    std::vector<Type_Code> generateCode (std::size_t instructions)
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<int> kind (0, 3);
+        std::uniform_int_distribution<int> extension3 (0, segment3OpcodeCount - 1);
+        std::uniform_int_distribution<int> extension5 (0, segment5OpcodeCount - 1);
+
+        std::vector<Type_Code> code {0, 0, 0, 0};
+
+        while (code.size() - 4 < instructions)
+        {
+            switch (kind (random))
+            {
+                case 0:
+
+                    code.push_back (segment0 (0, 1)); // push integer
+                    code.push_back (segment5 (3)); // integer to float
+                    code.push_back (segment5 (6)); // float to integer
+                    code.push_back (segment5 (7)); // negate integer
+                    code.push_back (segment5 (24)); // pop and skip the next instruction if zero
+                    code.push_back (segment3 (firstExtensionCode3 + extension3 (random), 1));
+                    code.push_back (segment5 (firstExtensionCode5 + extension5 (random)));
+                    code.push_back (segment0 (0, 0));
+                    code.push_back (segment5 (24));
+                    code.push_back (segment5 (firstExtensionCode5 + extension5 (random)));
+                    code.push_back (segment3 (firstExtensionCode3 + extension3 (random), 0));
+                    break;
+
+                default:
+
+                    code.push_back (segment5 (firstExtensionCode5 + extension5 (random)));
+                    code.push_back (segment3 (firstExtensionCode3 + extension3 (random), 2));
+                    break;
+            }
+        }
+
+        code[0] = static_cast<Type_Code> (code.size() - 4);
+
+        return code;
+    }
+
+    void runByteCode (benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        installBenchmarkOpcodes (interpreter);
+        EmptyContext context;
+        const std::vector<Type_Code> code = generateCode (state.range(0));
+
+        for (auto _ : state)
+        {
+            interpreter.run (code.data(), static_cast<int> (code.size()), context);
+            benchmark::DoNotOptimize (sCounter);
+        }
+
+        state.SetItemsProcessed (state.iterations() * code[0]);
+    }
+
+    void runDecodedCode (benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        installBenchmarkOpcodes (interpreter);
+        EmptyContext context;
+        const std::vector<Type_Code> code = generateCode (state.range(0));
+        DecodedCode decodedCode;
+        interpreter.decode (code.data(), static_cast<int> (code.size()), decodedCode);
+
+        for (auto _ : state)
+        {
+            interpreter.run (decodedCode, context);
+            benchmark::DoNotOptimize (sCounter);
+        }
+
+        state.SetItemsProcessed (state.iterations() * code[0]);
+    }
+
+    void decodeCode (benchmark::State& state)
+    {
+        Interpreter::Interpreter interpreter;
+        installBenchmarkOpcodes (interpreter);
+        const std::vector<Type_Code> code = generateCode (state.range(0));
+        DecodedCode decodedCode;
+
+        for (auto _ : state)
+        {
+            interpreter.decode (code.data(), static_cast<int> (code.size()), decodedCode);
+            benchmark::DoNotOptimize (decodedCode);
+        }
+
+        state.SetItemsProcessed (state.iterations() * code[0]);
+    }
+} // namespace
+
+BENCHMARK(runByteCode)->Arg(64)->Arg(1024);
+BENCHMARK(runDecodedCode)->Arg(64)->Arg(1024);
+BENCHMARK(decodeCode)->Arg(64)->Arg(1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/loadstat.hpp>
+#include <components/misc/stringops.hpp>
+
+#include <components/esmstore/store.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef ESM::Static RecordType;
+
+    // Ids the way scripts and dialogue tend to spell them, in mixed case
+    std::vector<std::string> generateIds (std::size_t count)
+    {
+        std::vector<std::string> ids;
+        ids.reserve (count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            ids.push_back ("Furn_De_Ex_Bench_" + std::to_string (i));
+
+        return ids;
+    }
+
+    std::vector<std::size_t> generateLookups (std::size_t count)
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution (0, count - 1);
+        std::vector<std::size_t> lookups (1024);
+
+        for (std::size_t& lookup : lookups)
+            lookup = distribution (random);
+
+        return lookups;
+    }
+
+    void fillStore (MWWorld::Store<RecordType>& store, const std::vector<std::string>& ids)
+    {
+        for (const std::string& id : ids)
+        {
+            RecordType record;
+            record.blank();
+            record.mId = id;
+            store.insertStatic (record);
+        }
+    }
+
+    // How Store<T>::search found records before it had an index
+    void searchLowerCasedMap (benchmark::State& state)
+    {
+        const std::vector<std::string> ids = generateIds (state.range(0));
+        const std::vector<std::size_t> lookups = generateLookups (ids.size());
+        std::map<std::string, RecordType> map;
+
+        for (const std::string& id : ids)
+        {
+            RecordType record;
+            record.blank();
+            record.mId = id;
+            map.emplace (Misc::StringUtils::lowerCase (id), record);
+        }
+
+        std::size_t i = 0;
+
+        for (auto _ : state)
+        {
+            auto it = map.find (Misc::StringUtils::lowerCase (ids[lookups[i++ % lookups.size()]]));
+            benchmark::DoNotOptimize (it);
+        }
+
+        state.SetItemsProcessed (state.iterations());
+    }
+
+    void searchId (benchmark::State& state)
+    {
+        const std::vector<std::string> ids = generateIds (state.range(0));
+        const std::vector<std::size_t> lookups = generateLookups (ids.size());
+        MWWorld::Store<RecordType> store;
+        fillStore (store, ids);
+
+        std::size_t i = 0;
+
+        for (auto _ : state)
+        {
+            const RecordType *record = store.search (ids[lookups[i++ % lookups.size()]]);
+            benchmark::DoNotOptimize (record);
+        }
+
+        state.SetItemsProcessed (state.iterations());
+    }
+
+    void searchRecordKey (benchmark::State& state)
+    {
+        const std::vector<std::string> ids = generateIds (state.range(0));
+        const std::vector<std::size_t> lookups = generateLookups (ids.size());
+        MWWorld::Store<RecordType> store;
+        fillStore (store, ids);
+
+        std::vector<MWWorld::RecordKey> keys;
+        for (const std::string& id : ids)
+            keys.emplace_back (id);
+
+        std::size_t i = 0;
+
+        for (auto _ : state)
+        {
+            const RecordType *record = store.search (keys[lookups[i++ % lookups.size()]]);
+            benchmark::DoNotOptimize (record);
+        }
+
+        state.SetItemsProcessed (state.iterations());
+    }
+
+    void searchMissingId (benchmark::State& state)
+    {
+        const std::vector<std::string> ids = generateIds (state.range(0));
+        MWWorld::Store<RecordType> store;
+        fillStore (store, ids);
+
+        const std::string missing = "Furn_De_Ex_Bench_Missing";
+
+        for (auto _ : state)
+        {
+            const RecordType *record = store.search (missing);
+            benchmark::DoNotOptimize (record);
+        }
+
+        state.SetItemsProcessed (state.iterations());
+    }
+} // namespace
+
+BENCHMARK(searchLowerCasedMap)->Arg(256)->Arg(16384);
+BENCHMARK(searchId)->Arg(256)->Arg(16384);
+BENCHMARK(searchRecordKey)->Arg(256)->Arg(16384);
+BENCHMARK(searchMissingId)->Arg(256)->Arg(16384);
+
+BENCHMARK_MAIN();
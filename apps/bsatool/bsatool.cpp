@@ -2,6 +2,16 @@
 #include <iomanip>
 #include <vector>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <chrono>
+/*
+    End of tes3mp addition
+*/
+
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -41,6 +51,9 @@ bool parseOptions (int argc, char** argv, Arguments &info)
             "      Add a file to the input archive.\n\n"
             "  bsatool create [-c] archivefile\n"
             "      Create an archive.\n\n"
+            "  bsatool bench archivefile\n"
+            "      Measure how fast the files in the input archive can be read, with and without\n"
+            "      mapping the archive into memory.\n\n"
             "Allowed options");
 
     desc.add_options()
@@ -100,7 +113,8 @@ bool parseOptions (int argc, char** argv, Arguments &info)
     }
 
     info.mode = variables["mode"].as<std::string>();
-    if (!(info.mode == "list" || info.mode == "extract" || info.mode == "extractall" || info.mode == "add" || info.mode == "create"))
+    if (!(info.mode == "list" || info.mode == "extract" || info.mode == "extractall" || info.mode == "add" || info.mode == "create"
+        || info.mode == "bench"))
     {
         std::cout << std::endl << "ERROR: invalid mode \"" << info.mode << "\"\n\n"
             << desc << std::endl;
@@ -155,6 +169,7 @@ int list(std::unique_ptr<Bsa::BSAFile>& bsa, Arguments& info);
 int extract(std::unique_ptr<Bsa::BSAFile>& bsa, Arguments& info);
 int extractAll(std::unique_ptr<Bsa::BSAFile>& bsa, Arguments& info);
 int add(std::unique_ptr<Bsa::BSAFile>& bsa, Arguments& info);
+int bench(Arguments& info);
 
 int main(int argc, char** argv)
 {
@@ -180,6 +195,9 @@ int main(int argc, char** argv)
             return 0;
         }
 
+        if (info.mode == "bench")
+            return bench(info);
+
         bsa->open(info.filename);
 
         if (info.mode == "list")
@@ -316,3 +334,61 @@ int add(std::unique_ptr<Bsa::BSAFile>& bsa, Arguments& info)
 
     return 0;
 }
+
+/*
+    Start of tes3mp addition
+
+    Measure how fast the files in an archive can be read, with and without mapping it into memory
+*/
+int bench(Arguments& info)
+{
+    const int passes = 3;
+
+    for (bool memoryMapped : {false, true})
+    {
+        std::unique_ptr<Bsa::BSAFile> bsa;
+
+        if (Bsa::CompressedBSAFile::detectVersion(info.filename) == Bsa::BSAVER_COMPRESSED)
+            bsa = std::make_unique<Bsa::CompressedBSAFile>(Bsa::CompressedBSAFile());
+        else
+            bsa = std::make_unique<Bsa::BSAFile>(Bsa::BSAFile());
+
+        bsa->setMemoryMapped(memoryMapped);
+        bsa->open(info.filename);
+
+        std::vector<char> buffer(64 * 1024);
+        size_t files = 0;
+        size_t bytes = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            for (const auto &file : bsa->getList())
+            {
+                Files::IStreamPtr data = bsa->getFile(&file);
+
+                // Read the whole file, counting what comes out of the stream rather than the size
+                // in the archive, which is the compressed size for compressed files
+                while (data->read(buffer.data(), buffer.size()) || data->gcount() > 0)
+                    bytes += static_cast<size_t>(data->gcount());
+
+                ++files;
+            }
+        }
+
+        const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+        const double seconds = std::max(time.count(), 1e-9);
+
+        std::cout << (memoryMapped ? (bsa->isMemoryMapped() ? "Mapped: " : "Mapped (unavailable): ") : "Streamed: ")
+                  << files << " files, " << std::fixed << std::setprecision(1)
+                  << bytes / (1024.0 * 1024.0) << " MiB in " << std::setprecision(3) << seconds << " s, "
+                  << std::setprecision(1) << bytes / (1024.0 * 1024.0) / seconds << " MiB/s, "
+                  << files / seconds << " files/s" << std::endl;
+    }
+
+    return 0;
+}
+/*
+    End of tes3mp addition
+*/
@@ -12,6 +12,10 @@
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 #include <components/esm/records.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+
+#include <components/esmstore/esmstore.hpp>
+#include <components/esmstore/esmstorecache.hpp>
 
 #include "record.hpp"
 
@@ -60,6 +64,7 @@ struct Arguments
     std::string encoding;
     std::string filename;
     std::string outname;
+    std::vector<std::string> filenames;
 
     std::vector<std::string> types;
     std::string name;
@@ -71,7 +76,7 @@ struct Arguments
 
 bool parseOptions (int argc, char** argv, Arguments &info)
 {
-    bpo::options_description desc("Inspect and extract from Morrowind ES files (ESM, ESP, ESS)\nSyntax: esmtool [options] mode infile [outfile]\nAllowed modes:\n  dump\t Dumps all readable data from the input file.\n  clone\t Clones the input file to the output file.\n  comp\t Compares the given files.\n\nAllowed options");
+    bpo::options_description desc("Inspect and extract from Morrowind ES files (ESM, ESP, ESS)\nSyntax: esmtool [options] mode infile [outfile]\nAllowed modes:\n  dump\t Dumps all readable data from the input file.\n  clone\t Clones the input file to the output file.\n  comp\t Compares the given files.\n  cache\t Writes the store cache for the given content files, in load order, to the last file given.\n\nAllowed options");
 
     desc.add_options()
         ("help,h", "print help message.")
@@ -109,7 +114,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
         ;
 
     bpo::positional_options_description p;
-    p.add("mode", 1).add("input-file", 2);
+    p.add("mode", 1).add("input-file", -1);
 
     // there might be a better way to do this
     bpo::options_description all;
@@ -154,7 +159,7 @@ bool parseOptions (int argc, char** argv, Arguments &info)
         info.name = variables["name"].as<std::string>();
 
     info.mode = variables["mode"].as<std::string>();
-    if (!(info.mode == "dump" || info.mode == "clone" || info.mode == "comp"))
+    if (!(info.mode == "dump" || info.mode == "clone" || info.mode == "comp" || info.mode == "cache"))
     {
         std::cout << std::endl << "ERROR: invalid mode \"" << info.mode << "\"" << std::endl << std::endl
                   << desc << finalText << std::endl;
@@ -176,9 +181,19 @@ bool parseOptions (int argc, char** argv, Arguments &info)
       return false;
       }*/
 
-    info.filename = variables["input-file"].as< std::vector<std::string> >()[0];
-    if (variables["input-file"].as< std::vector<std::string> >().size() > 1)
-        info.outname = variables["input-file"].as< std::vector<std::string> >()[1];
+    info.filenames = variables["input-file"].as< std::vector<std::string> >();
+
+    // Only the cache mode takes a whole list of files
+    if (info.mode != "cache" && info.filenames.size() > 2)
+    {
+        std::cout << "\nERROR: too many ES files specified\n\n";
+        std::cout << desc << finalText << std::endl;
+        return false;
+    }
+
+    info.filename = info.filenames[0];
+    if (info.filenames.size() > 1)
+        info.outname = info.filenames[1];
 
     info.raw_given = variables.count ("raw") != 0;
     info.quiet_given = variables.count ("quiet") != 0;
@@ -203,6 +218,7 @@ void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, Arguments& info);
 int load(Arguments& info);
 int clone(Arguments& info);
 int comp(Arguments& info);
+int cache(Arguments& info);
 
 int main(int argc, char**argv)
 {
@@ -218,6 +234,8 @@ int main(int argc, char**argv)
             return clone(info);
         else if (info.mode == "comp")
             return comp(info);
+        else if (info.mode == "cache")
+            return cache(info);
         else
         {
             std::cout << "Invalid or no mode specified, dying horribly. Have a nice day." << std::endl;
@@ -570,3 +588,50 @@ int comp(Arguments& info)
 
     return 0;
 }
+
+int cache(Arguments& info)
+{
+    if (info.filenames.size() < 2)
+    {
+        std::cout << "You need to specify the content files and the cache file" << std::endl;
+        return 1;
+    }
+
+    const std::vector<std::string> contentFiles(info.filenames.begin(), info.filenames.end() - 1);
+    const std::string& cacheFile = info.filenames.back();
+
+    ToUTF8::Utf8Encoder encoder (ToUTF8::calculateEncoding(info.encoding));
+    Loading::Listener listener;
+
+    // Load the content files the way the engine does, so the cache matches what it would write itself
+    MWWorld::ESMStore store;
+    std::vector<ESM::ESMReader> readers(contentFiles.size());
+
+    for (size_t i = 0; i < contentFiles.size(); ++i)
+    {
+        std::cout << "Loading file: " << contentFiles[i] << std::endl;
+
+        ESM::ESMReader& esm = readers[i];
+        esm.setEncoder(&encoder);
+        esm.setIndex(static_cast<int>(i));
+        esm.setGlobalReaderList(&readers);
+        esm.open(contentFiles[i]);
+
+        store.load(esm, &listener);
+    }
+
+    store.setUp(true);
+
+    std::cout << "Writing store cache: " << cacheFile << std::endl;
+
+    MWWorld::ESMStoreCache storeCache(cacheFile, contentFiles, &encoder);
+    if (!storeCache.write(store))
+    {
+        std::cout << "Failed to write " << cacheFile << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done!" << std::endl;
+
+    return 0;
+}
@@ -4,6 +4,17 @@
 #include <fstream>
 #include <cstdlib>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <chrono>
+#include <iomanip>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/nif/niffile.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/vfs/manager.hpp>
@@ -80,17 +91,102 @@ void readVFS(VFS::Archive* anArchive,std::string archivePath = "")
     }
 }
 
-bool parseOptions (int argc, char** argv, std::vector<std::string>& files)
+/*
+    Start of tes3mp addition
+
+    Measure how fast nif files are parsed
+*/
+/// Parse all the nif files in the given BSA files and directories a few times, both through streams
+/// and from buffers, and print how long that took
+int bench(const std::vector<std::string>& paths)
+{
+    const int passes = 3;
+
+    VFS::Manager manager(true);
+
+    for (const std::string& path : paths)
+    {
+        if (isBSA(path))
+            manager.addArchive(new VFS::BsaArchive(path));
+        else if (bfs::is_directory(bfs::path(path)))
+            manager.addArchive(new VFS::FileSystemArchive(path));
+        else
+            std::cerr << "ERROR:  \"" << path << "\" is not a bsa file or directory!" << std::endl;
+    }
+
+    manager.buildIndex();
+
+    std::vector<std::string> names;
+    for (const auto& file : manager.getIndex())
+    {
+        if (isNIF(file.first))
+            names.push_back(file.first);
+    }
+
+    for (bool buffered : {false, true})
+    {
+        Nif::NIFFile::setParseFromBuffer(buffered);
+
+        size_t files = 0;
+        size_t failed = 0;
+        size_t records = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            for (const std::string& name : names)
+            {
+                try
+                {
+                    Nif::NIFFile nif(manager.getNormalized(name), name);
+                    records += nif.numRecords();
+                    ++files;
+                }
+                catch (std::exception&)
+                {
+                    ++failed;
+                }
+            }
+        }
+
+        const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+        const double seconds = std::max(time.count(), 1e-9);
+
+        std::cout << (buffered ? "Buffered: " : "Streamed: ") << files << " files (" << failed << " failed), "
+                  << records << " records in " << std::fixed << std::setprecision(3) << seconds << " s, "
+                  << std::setprecision(1) << files / seconds << " files/s, " << records / seconds << " records/s"
+                  << std::endl;
+    }
+
+    return 0;
+}
+/*
+    End of tes3mp addition
+*/
+
+/*
+    Start of tes3mp change (minor)
+
+    Add a mode that measures how fast nif files are parsed
+*/
+bool parseOptions (int argc, char** argv, std::vector<std::string>& files, bool& benchmark)
 {
     bpo::options_description desc("Ensure that OpenMW can use the provided NIF and BSA files\n\n"
         "Usages:\n"
         "  niftool <nif files, BSA files, or directories>\n"
-        "      Scan the file or directories for nif errors.\n\n"
+        "      Scan the file or directories for nif errors.\n"
+        "  niftool --bench <BSA files or directories>\n"
+        "      Measure how fast the nif files in the BSA files or directories are parsed.\n\n"
         "Allowed options");
     desc.add_options()
         ("help,h", "print help message.")
+        ("bench", "measure parsing speed instead of checking for errors.")
         ("input-file", bpo::value< std::vector<std::string> >(), "input file")
         ;
+/*
+    End of tes3mp change (minor)
+*/
 
     //Default option if none provided
     bpo::positional_options_description p;
@@ -108,6 +204,15 @@ bool parseOptions (int argc, char** argv, std::vector<std::string>& files)
             std::cout << desc << std::endl;
             return false;
         }
+        /*
+            Start of tes3mp addition
+
+            Add a mode that measures how fast nif files are parsed
+        */
+        benchmark = variables.count("bench") != 0;
+        /*
+            End of tes3mp addition
+        */
         if (variables.count("input-file"))
         {
             files = variables["input-file"].as< std::vector<std::string> >();
@@ -129,10 +234,30 @@ bool parseOptions (int argc, char** argv, std::vector<std::string>& files)
 int main(int argc, char **argv)
 {
     std::vector<std::string> files;
-    if(!parseOptions (argc, argv, files))
+    /*
+        Start of tes3mp change (minor)
+
+        Add a mode that measures how fast nif files are parsed
+    */
+    bool benchmark = false;
+    if(!parseOptions (argc, argv, files, benchmark))
         return 1;
+    /*
+        End of tes3mp change (minor)
+    */
 
     Nif::NIFFile::setLoadUnsupportedFiles(true);
+
+    /*
+        Start of tes3mp addition
+
+        Add a mode that measures how fast nif files are parsed
+    */
+    if (benchmark)
+        return bench(files);
+    /*
+        End of tes3mp addition
+    */
 //     std::cout << "Reading Files" << std::endl;
     for(std::vector<std::string>::const_iterator it=files.begin(); it!=files.end(); ++it)
     {
@@ -3,10 +3,13 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 
 #include <iostream>
+#include "CellController.hpp"
+#include "ObjectRegistry.hpp"
 #include "Player.hpp"
 #include "Script/Script.hpp"
 
-Cell::Cell(ESM::Cell cell) : cell(cell)
+Cell::Cell(ESM::Cell cell) : cell(cell), authorityGuid(RakNet::UNASSIGNED_RAKNET_GUID), authorityOverride(false),
+    objectRegistry(nullptr)
 {
     cellActorList.count = 0;
 }
@@ -45,6 +48,9 @@ void Cell::addPlayer(Player *player)
     Script::Call<Script::CallbackIdentity("OnCellLoad")>(player->getId(), getDescription().c_str());
 
     players.push_back(player);
+
+    if (objectRegistry != nullptr && CellController::get()->getObjectSnapshots())
+        objectRegistry->sendSnapshot(player->guid);
 }
 
 void Cell::removePlayer(Player *player, bool cleanPlayer)
@@ -69,6 +75,12 @@ void Cell::removePlayer(Player *player, bool cleanPlayer)
             Script::Call<Script::CallbackIdentity("OnCellUnload")>(player->getId(), getDescription().c_str());
 
             players.erase(it);
+
+            if (CellController::get()->getAutomaticAuthority() && player->guid == authorityGuid)
+            {
+                authorityGuid = RakNet::UNASSIGNED_RAKNET_GUID;
+                authorityOverride = false;
+            }
             return;
         }
     }
@@ -168,14 +180,42 @@ RakNet::RakNetGUID *Cell::getAuthority()
 
 void Cell::setAuthority(const RakNet::RakNetGUID& guid)
 {
+    if (authorityGuid != guid)
+        authorityAssignmentTime = std::chrono::steady_clock::now();
+
     authorityGuid = guid;
 }
 
+bool Cell::hasAuthority() const
+{
+    return authorityGuid != RakNet::UNASSIGNED_RAKNET_GUID;
+}
+
+bool Cell::hasAuthorityOverride() const
+{
+    return authorityOverride;
+}
+
+void Cell::setAuthorityOverride(bool state)
+{
+    authorityOverride = state;
+}
+
+std::chrono::steady_clock::time_point Cell::getAuthorityAssignmentTime() const
+{
+    return authorityAssignmentTime;
+}
+
 mwmp::BaseActorList *Cell::getActorList()
 {
     return &cellActorList;
 }
 
+ObjectRegistry *Cell::getObjectRegistry()
+{
+    return objectRegistry;
+}
+
 Cell::TPlayers Cell::getPlayers() const
 {
     return players;
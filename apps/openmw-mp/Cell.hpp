@@ -1,6 +1,7 @@
 #ifndef OPENMW_SERVERCELL_HPP
 #define OPENMW_SERVERCELL_HPP
 
+#include <chrono>
 #include <deque>
 #include <string>
 #include <components/esm/records.hpp>
@@ -11,6 +12,7 @@
 
 class Player;
 class Cell;
+class ObjectRegistry;
 
 class Cell
 {
@@ -33,7 +35,13 @@ public:
 
     RakNet::RakNetGUID *getAuthority();
     void setAuthority(const RakNet::RakNetGUID& guid);
+    bool hasAuthority() const;
+
+    bool hasAuthorityOverride() const;
+    void setAuthorityOverride(bool state);
+    std::chrono::steady_clock::time_point getAuthorityAssignmentTime() const;
     mwmp::BaseActorList *getActorList();
+    ObjectRegistry *getObjectRegistry();
 
     TPlayers getPlayers() const;
     void sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *baseActorList) const;
@@ -47,7 +55,12 @@ private:
     ESM::Cell cell;
 
     RakNet::RakNetGUID authorityGuid;
+    // Whether a script has asked to keep the current authority, in which case the CellController's
+    // automatic assignment leaves it alone for as long as that player stays in the cell
+    bool authorityOverride;
+    std::chrono::steady_clock::time_point authorityAssignmentTime;
     mwmp::BaseActorList cellActorList;
+    ObjectRegistry *objectRegistry;
 };
 
 
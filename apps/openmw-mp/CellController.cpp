@@ -1,11 +1,16 @@
 #include "CellController.hpp"
 
 #include <iostream>
+#include <components/openmw-mp/NetworkMessages.hpp>
 #include "Cell.hpp"
+#include "Networking.hpp"
+#include "ObjectRegistry.hpp"
 #include "Player.hpp"
 #include "Script/Script.hpp"
 
-CellController::CellController()
+CellController::CellController() : automaticAuthority(false), authorityRebalanceInterval(2000),
+    authorityMinimumHoldTime(10000), authorityHysteresis(0.25f), authorityFrameTimeWeight(4),
+    authorityActorWeight(2), objectSnapshots(false)
 {
 
 }
@@ -101,6 +106,9 @@ Cell *CellController::addCell(ESM::Cell cellData)
         LOG_APPEND(TimedLog::LOG_INFO, "- Adding %s to CellController", cellData.getDescription().c_str());
 
         cell = new Cell(cellData);
+        std::unique_ptr<ObjectRegistry> &objectRegistry = objectRegistries[cellData.getDescription()];
+        objectRegistry.reset(new ObjectRegistry(cellData));
+        cell->objectRegistry = objectRegistry.get();
         cells.push_back(cell);
     }
     else
@@ -124,6 +132,7 @@ void CellController::removeCell(Cell *cell)
             Script::Call<Script::CallbackIdentity("OnCellDeletion")>(cell->getDescription().c_str());
             LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from CellController", cell->getDescription().c_str());
 
+            objectRegistries.erase(cell->getDescription());
             delete *it;
             it = cells.erase(it);
         }
@@ -189,3 +198,151 @@ void CellController::update(Player *player)
         removeCell(cell);
     }
 }
+
+ObjectRegistry *CellController::getObjectRegistry(const ESM::Cell &cell)
+{
+    auto it = objectRegistries.find(cell.getDescription());
+
+    if (it == objectRegistries.end())
+        return nullptr;
+
+    return it->second.get();
+}
+
+void CellController::recordObjectList(unsigned char packetID, const mwmp::BaseObjectList &objectList)
+{
+    if (!ObjectRegistry::tracksPacket(packetID))
+        return;
+
+    ObjectRegistry *objectRegistry = getObjectRegistry(objectList.cell);
+
+    if (objectRegistry != nullptr)
+        objectRegistry->applyObjectList(packetID, objectList);
+}
+
+void CellController::setObjectSnapshots(bool state)
+{
+    objectSnapshots = state;
+}
+
+bool CellController::getObjectSnapshots() const
+{
+    return objectSnapshots;
+}
+
+void CellController::setAutomaticAuthority(bool state)
+{
+    automaticAuthority = state;
+}
+
+bool CellController::getAutomaticAuthority() const
+{
+    return automaticAuthority;
+}
+
+void CellController::setAuthorityTuning(int rebalanceInterval, int minimumHoldTime, float hysteresis,
+                                        float frameTimeWeight, float actorWeight)
+{
+    authorityRebalanceInterval = std::chrono::milliseconds(std::max(rebalanceInterval, 100));
+    authorityMinimumHoldTime = std::chrono::milliseconds(std::max(minimumHoldTime, 0));
+    authorityHysteresis = std::min(std::max(hysteresis, 0.f), 1.f);
+    authorityFrameTimeWeight = std::max(frameTimeWeight, 0.f);
+    authorityActorWeight = std::max(actorWeight, 0.f);
+}
+
+void CellController::updateAuthority()
+{
+    if (!automaticAuthority)
+        return;
+
+    auto now = std::chrono::steady_clock::now();
+
+    if (now - lastAuthorityUpdate < authorityRebalanceInterval)
+        return;
+
+    lastAuthorityUpdate = now;
+
+    for (auto &&cell : cells)
+    {
+        if (cell->players.empty() || cell->hasAuthorityOverride())
+            continue;
+
+        Player *currentAuthority = nullptr;
+        Player *bestCandidate = nullptr;
+        float bestCost = 0;
+
+        for (auto &&player : cell->players)
+        {
+            // Ignore players who have not finished logging in
+            if (player == nullptr || player->getLoadState() != Player::POSTLOADED)
+                continue;
+
+            if (cell->hasAuthority() && player->guid == *cell->getAuthority())
+                currentAuthority = player;
+
+            float cost = getAuthorityCost(player, cell);
+
+            if (bestCandidate == nullptr || cost < bestCost)
+            {
+                bestCandidate = player;
+                bestCost = cost;
+            }
+        }
+
+        if (bestCandidate == nullptr || bestCandidate == currentAuthority)
+            continue;
+
+        if (currentAuthority != nullptr)
+        {
+            if (now - cell->getAuthorityAssignmentTime() < authorityMinimumHoldTime)
+                continue;
+
+            if (bestCost >= getAuthorityCost(currentAuthority, cell) * (1 - authorityHysteresis))
+                continue;
+        }
+
+        assignAuthority(cell, bestCandidate);
+    }
+}
+
+float CellController::getAuthorityCost(Player *player, const Cell *excludedCell) const
+{
+    int ping = std::max(mwmp::Networking::get().getAvgPing(player->guid), 0);
+
+    return ping + authorityFrameTimeWeight * player->averageFrameTime * 1000 +
+        authorityActorWeight * getAuthoritativeActorCount(player, excludedCell);
+}
+
+unsigned int CellController::getAuthoritativeActorCount(Player *player, const Cell *excludedCell) const
+{
+    unsigned int actorCount = 0;
+
+    for (auto &&cell : *player->getCells())
+    {
+        if (cell != excludedCell && cell->hasAuthority() && *cell->getAuthority() == player->guid)
+            actorCount += cell->cellActorList.baseActors.size();
+    }
+
+    return actorCount;
+}
+
+void CellController::assignAuthority(Cell *cell, Player *player)
+{
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Assigning actor authority in %s to %s", cell->getDescription().c_str(),
+                       player->npc.mName.c_str());
+
+    cell->setAuthority(player->guid);
+
+    mwmp::BaseActorList actorList;
+    actorList.guid = player->guid;
+    actorList.cell = cell->cell;
+
+    mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_AUTHORITY);
+    actorPacket->setActorList(&actorList);
+
+    // Always send the packet to everyone on the server, to reduce bugs caused by late-arriving packets
+    actorPacket->Send(false);
+    actorPacket->Send(true);
+
+    Script::Call<Script::CallbackIdentity("OnActorAuthorityChange")>(player->getId(), cell->getDescription().c_str());
+}
@@ -1,8 +1,11 @@
 #ifndef OPENMW_SERVERCELLCONTROLLER_HPP
 #define OPENMW_SERVERCELLCONTROLLER_HPP
 
+#include <chrono>
 #include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <components/esm/records.hpp>
 #include <components/openmw-mp/Base/BaseObject.hpp>
 #include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
@@ -10,6 +13,7 @@
 
 class Player;
 class Cell;
+class ObjectRegistry;
 
 
 class CellController
@@ -38,9 +42,47 @@ public:
 
     void update(Player *player);
 
+    // Get the object registry of a loaded cell, or nullptr if the cell isn't loaded; registries are
+    // freed along with their cells, after OnCellDeletion gives scripts a last chance to read them
+    ObjectRegistry *getObjectRegistry(const ESM::Cell &cell);
+    // Record an object list that was accepted and sent on to players in its cell's registry
+    void recordObjectList(unsigned char packetID, const mwmp::BaseObjectList &objectList);
+    // Whether players loading a cell get sent the objects in its registry
+    void setObjectSnapshots(bool state);
+    bool getObjectSnapshots() const;
+
+    /**
+     * Automatic actor authority assignment
+     *
+     * Every rebalance interval, each cell whose authority has not been set by a script gets the
+     * player with the lowest authority cost, which combines their average ping, the average frame
+     * time reported by their client and the number of actors they are already simulating in
+     * other cells. An existing authority is only replaced after it has been held for the minimum
+     * hold time and when another player's cost is lower by more than the hysteresis fraction.
+     */
+    void setAutomaticAuthority(bool state);
+    bool getAutomaticAuthority() const;
+    void setAuthorityTuning(int rebalanceInterval, int minimumHoldTime, float hysteresis, float frameTimeWeight,
+                            float actorWeight);
+    void updateAuthority();
+
 private:
+    float getAuthorityCost(Player *player, const Cell *excludedCell) const;
+    unsigned int getAuthoritativeActorCount(Player *player, const Cell *excludedCell) const;
+    void assignAuthority(Cell *cell, Player *player);
+
     static CellController *sThis;
     TContainer cells;
+    std::unordered_map<std::string, std::unique_ptr<ObjectRegistry>> objectRegistries;
+    bool objectSnapshots;
+
+    bool automaticAuthority;
+    std::chrono::milliseconds authorityRebalanceInterval;
+    std::chrono::milliseconds authorityMinimumHoldTime;
+    float authorityHysteresis;
+    float authorityFrameTimeWeight;
+    float authorityActorWeight;
+    std::chrono::steady_clock::time_point lastAuthorityUpdate;
 };
 
 #endif //OPENMW_SERVERCELLCONTROLLER_HPP
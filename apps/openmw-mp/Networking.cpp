@@ -57,6 +57,14 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     objectPacketController->SetStream(0, &bsOut);
     worldstatePacketController->SetStream(0, &bsOut);
 
+    // Route entity updates through the per-connection bandwidth budget
+    outgoingScheduler = new OutgoingScheduler(peer);
+    playerPacketController->SetScheduler(outgoingScheduler);
+    actorPacketController->SetScheduler(outgoingScheduler);
+    objectPacketController->SetScheduler(outgoingScheduler);
+
+    packetDecoder = new PacketDecoder(peer, actorPacketController, objectPacketController, worldstatePacketController);
+
     running = true;
     exitCode = 0;
 
@@ -78,7 +86,9 @@ Networking::~Networking()
     delete playerPacketController;
     delete actorPacketController;
     delete objectPacketController;
+    delete packetDecoder;
     delete worldstatePacketController;
+    delete outgoingScheduler;
 }
 
 void Networking::setServerPassword(std::string password) noexcept
@@ -195,38 +205,38 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
 
 }
 
-void Networking::processActorPacket(RakNet::Packet *packet)
+void Networking::processActorPacket(RakNet::Packet *packet, BaseActorList *decodedActorList)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!ActorProcessor::Process(*packet, baseActorList))
+    if (!ActorProcessor::Process(*packet, baseActorList, decodedActorList))
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
 
 }
 
-void Networking::processObjectPacket(RakNet::Packet *packet)
+void Networking::processObjectPacket(RakNet::Packet *packet, BaseObjectList *decodedObjectList)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!ObjectProcessor::Process(*packet, baseObjectList))
+    if (!ObjectProcessor::Process(*packet, baseObjectList, decodedObjectList))
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
 
 }
 
-void Networking::processWorldstatePacket(RakNet::Packet *packet)
+void Networking::processWorldstatePacket(RakNet::Packet *packet, BaseWorldstate *decodedWorldstate)
 {
     Player *player = Players::getPlayer(packet->guid);
 
     if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
         return;
 
-    if (!WorldstateProcessor::Process(*packet, baseWorldstate))
+    if (!WorldstateProcessor::Process(*packet, baseWorldstate, decodedWorldstate))
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled WorldstatePacket with identifier %i has arrived", packet->data[0]);
 
 }
@@ -304,8 +314,10 @@ bool Networking::preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn)
     return false;
 }
 
-void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn)
+void Networking::update(PacketDecoder::DecodedPacket &decoded, RakNet::BitStream &bsIn)
 {
+    RakNet::Packet *packet = decoded.packet;
+
     if (systemPacketController->ContainsPacket(packet->data[0]))
     {
         systemPacketController->SetStream(&bsIn, nullptr);
@@ -319,17 +331,17 @@ void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn)
     else if (actorPacketController->ContainsPacket(packet->data[0]))
     {
         actorPacketController->SetStream(&bsIn, 0);
-        processActorPacket(packet);
+        processActorPacket(packet, decoded.actorList.get());
     }
     else if (objectPacketController->ContainsPacket(packet->data[0]))
     {
         objectPacketController->SetStream(&bsIn, 0);
-        processObjectPacket(packet);
+        processObjectPacket(packet, decoded.objectList.get());
     }
     else if (worldstatePacketController->ContainsPacket(packet->data[0]))
     {
         worldstatePacketController->SetStream(&bsIn, 0);
-        processWorldstatePacket(packet);
+        processWorldstatePacket(packet, decoded.worldstate.get());
     }
     else
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packet->data[0]);
@@ -391,6 +403,7 @@ void Networking::disconnectPlayer(RakNet::RakNetGUID guid)
     playerPacketController->GetPacket(ID_USER_DISCONNECTED)->setPlayer(player);
     playerPacketController->GetPacket(ID_USER_DISCONNECTED)->Send(true);
     Players::deletePlayer(guid);
+    outgoingScheduler->removeConnection(guid);
 }
 
 PlayerPacketController *Networking::getPlayerPacketController() const
@@ -398,6 +411,16 @@ PlayerPacketController *Networking::getPlayerPacketController() const
     return playerPacketController;
 }
 
+OutgoingScheduler *Networking::getOutgoingScheduler() const
+{
+    return outgoingScheduler;
+}
+
+PacketDecoder *Networking::getPacketDecoder() const
+{
+    return packetDecoder;
+}
+
 ActorPacketController *Networking::getActorPacketController() const
 {
     return actorPacketController;
@@ -530,10 +553,26 @@ int Networking::mainLoop()
     while (running and !killLoop)
     {
         mwmp_input::handler();
-        for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
+
+        // Queue everything that has arrived first, so the workers can decode packets while
+        // the ones that arrived before them are being processed here
+        for (packet = peer->Receive(); packet; packet = peer->Receive())
+        {
+            bool canDecode = Players::doesPlayerExist(packet->guid) && Players::getPlayer(packet->guid)->isHandshaked();
+            packetDecoder->push(packet, canDecode);
+        }
+
+        PacketDecoder::DecodedPacket decoded;
+
+        while (packetDecoder->pop(decoded))
         {
+            packet = decoded.packet;
+
             if (getMasterClient()->Process(packet))
+            {
+                peer->DeallocatePacket(packet);
                 continue;
+            }
 
             switch (packet->data[0])
             {
@@ -576,13 +615,17 @@ int Networking::mainLoop()
 
 
                     if (Players::doesPlayerExist(packet->guid))
-                        update(packet, bsIn);
+                        update(decoded, bsIn);
                     else
                         preInit(packet, bsIn);
                     break;
                 }
             }
+
+            peer->DeallocatePacket(packet);
         }
+        outgoingScheduler->update();
+        CellController::get()->updateAuthority();
         TimerAPI::Tick();
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
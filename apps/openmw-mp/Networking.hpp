@@ -8,6 +8,8 @@
 #include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
 #include "Player.hpp"
+#include "OutgoingScheduler.hpp"
+#include "PacketDecoder.hpp"
 
 class MasterClient;
 namespace  mwmp
@@ -28,10 +30,10 @@ namespace  mwmp
 
         void processSystemPacket(RakNet::Packet *packet);
         void processPlayerPacket(RakNet::Packet *packet);
-        void processActorPacket(RakNet::Packet *packet);
-        void processObjectPacket(RakNet::Packet *packet);
-        void processWorldstatePacket(RakNet::Packet *packet);
-        void update(RakNet::Packet *packet, RakNet::BitStream &bsIn);
+        void processActorPacket(RakNet::Packet *packet, BaseActorList *decodedActorList);
+        void processObjectPacket(RakNet::Packet *packet, BaseObjectList *decodedObjectList);
+        void processWorldstatePacket(RakNet::Packet *packet, BaseWorldstate *decodedWorldstate);
+        void update(PacketDecoder::DecodedPacket &decoded, RakNet::BitStream &bsIn);
 
         unsigned short numberOfConnections() const;
         unsigned int maxConnections() const;
@@ -48,6 +50,9 @@ namespace  mwmp
         ObjectPacketController *getObjectPacketController() const;
         WorldstatePacketController *getWorldstatePacketController() const;
 
+        OutgoingScheduler *getOutgoingScheduler() const;
+        PacketDecoder *getPacketDecoder() const;
+
         BaseActorList *getReceivedActorList();
         BaseObjectList *getReceivedObjectList();
         BaseWorldstate *getReceivedWorldstate();
@@ -94,6 +99,9 @@ namespace  mwmp
         ObjectPacketController *objectPacketController;
         WorldstatePacketController *worldstatePacketController;
 
+        OutgoingScheduler *outgoingScheduler;
+        PacketDecoder *packetDecoder;
+
         bool running;
         int exitCode;
         PacketPreInit::PluginContainer samples;
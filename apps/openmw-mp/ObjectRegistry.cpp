@@ -0,0 +1,310 @@
+#include "ObjectRegistry.hpp"
+
+#include <algorithm>
+
+#include <components/misc/stringops.hpp>
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+#include "Networking.hpp"
+
+using namespace mwmp;
+
+// The most objects a client accepts in a single object packet
+static const size_t maxObjectsPerPacket = 3000;
+
+ObjectRegistry::ObjectRegistry(const ESM::Cell &cell)
+{
+    objectList.cell = cell;
+    objectList.baseObjectCount = 0;
+    objectList.packetOrigin = mwmp::PACKET_ORIGIN::SERVER_SCRIPT;
+    objectList.action = BaseObjectList::SET;
+    objectList.containerSubAction = BaseObjectList::NONE;
+    objectList.isValid = true;
+}
+
+bool ObjectRegistry::tracksPacket(unsigned char packetID)
+{
+    switch (packetID)
+    {
+    case ID_OBJECT_PLACE:
+    case ID_OBJECT_SPAWN:
+    case ID_OBJECT_DELETE:
+    case ID_OBJECT_LOCK:
+    case ID_OBJECT_SCALE:
+    case ID_OBJECT_STATE:
+    case ID_DOOR_STATE:
+    case ID_OBJECT_TRAP:
+    case ID_OBJECT_MOVE:
+    case ID_OBJECT_ROTATE:
+    case ID_CONTAINER:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void ObjectRegistry::applyObjectList(unsigned char packetID, const BaseObjectList &newObjectList)
+{
+    if (!tracksPacket(packetID))
+        return;
+
+    // Requests don't change anything, and only replies to them carry the contents of containers
+    if (packetID == ID_CONTAINER && newObjectList.action == BaseObjectList::REQUEST)
+        return;
+
+    for (const auto &baseObject : newObjectList.baseObjects)
+    {
+        if (baseObject.isPlayer)
+            continue;
+
+        if (packetID == ID_OBJECT_DELETE)
+        {
+            int index = getIndex(baseObject.refNum, baseObject.mpNum);
+
+            // Objects that only ever existed during play can simply be forgotten
+            if (index != -1 && (objectChanges[index] & (CHANGE_PLACED | CHANGE_SPAWNED)) != 0)
+            {
+                removeObject(baseObject.refNum, baseObject.mpNum);
+                continue;
+            }
+        }
+        // Summons go away on their own, so there is nothing to recreate for them later
+        else if (packetID == ID_OBJECT_SPAWN && baseObject.isSummon)
+            continue;
+
+        unsigned int index = getOrAddIndex(baseObject);
+        BaseObject &registryObject = objectList.baseObjects[index];
+        unsigned int &changes = objectChanges[index];
+
+        switch (packetID)
+        {
+        case ID_OBJECT_PLACE:
+        case ID_OBJECT_SPAWN:
+        {
+            registryObject = baseObject;
+            changes |= packetID == ID_OBJECT_PLACE ? CHANGE_PLACED : CHANGE_SPAWNED;
+            break;
+        }
+        case ID_OBJECT_DELETE:
+            changes = CHANGE_DELETED;
+            break;
+        case ID_OBJECT_LOCK:
+            registryObject.lockLevel = baseObject.lockLevel;
+            changes |= CHANGE_LOCK;
+            break;
+        case ID_OBJECT_SCALE:
+            registryObject.scale = baseObject.scale;
+            changes |= CHANGE_SCALE;
+            break;
+        case ID_OBJECT_STATE:
+            registryObject.objectState = baseObject.objectState;
+            changes |= CHANGE_STATE;
+            break;
+        case ID_DOOR_STATE:
+            registryObject.doorState = baseObject.doorState;
+            changes |= CHANGE_DOOR_STATE;
+            break;
+        case ID_OBJECT_TRAP:
+            // Whether a trap was disarmed or went off, it's gone afterwards
+            registryObject.isDisarmed = true;
+            changes |= CHANGE_TRAP;
+            break;
+        case ID_OBJECT_MOVE:
+            for (int i = 0; i < 3; ++i)
+                registryObject.position.pos[i] = baseObject.position.pos[i];
+            changes |= CHANGE_POSITION;
+            break;
+        case ID_OBJECT_ROTATE:
+            for (int i = 0; i < 3; ++i)
+                registryObject.position.rot[i] = baseObject.position.rot[i];
+            changes |= CHANGE_ROTATION;
+            break;
+        case ID_CONTAINER:
+            applyContainer(registryObject, baseObject, newObjectList.action);
+            changes |= CHANGE_CONTAINER;
+            break;
+        }
+    }
+}
+
+int ObjectRegistry::getIndex(unsigned int refNum, unsigned int mpNum) const
+{
+    auto it = indexes.find(getKey(refNum, mpNum));
+
+    if (it == indexes.end())
+        return -1;
+
+    return static_cast<int>(it->second);
+}
+
+unsigned int ObjectRegistry::getChanges(unsigned int index) const
+{
+    if (index >= objectChanges.size())
+        return 0;
+
+    return objectChanges[index];
+}
+
+bool ObjectRegistry::removeObject(unsigned int refNum, unsigned int mpNum)
+{
+    auto it = indexes.find(getKey(refNum, mpNum));
+
+    if (it == indexes.end())
+        return false;
+
+    unsigned int index = it->second;
+    unsigned int lastIndex = static_cast<unsigned int>(objectList.baseObjects.size() - 1);
+    indexes.erase(it);
+
+    // Keep the list contiguous by moving the last object into the gap
+    if (index != lastIndex)
+    {
+        objectList.baseObjects[index] = std::move(objectList.baseObjects[lastIndex]);
+        objectChanges[index] = objectChanges[lastIndex];
+
+        const BaseObject &movedObject = objectList.baseObjects[index];
+        indexes[getKey(movedObject.refNum, movedObject.mpNum)] = index;
+    }
+
+    objectList.baseObjects.pop_back();
+    objectChanges.pop_back();
+    objectList.baseObjectCount = static_cast<unsigned int>(objectList.baseObjects.size());
+    return true;
+}
+
+void ObjectRegistry::clear()
+{
+    objectList.baseObjects.clear();
+    objectList.baseObjectCount = 0;
+    objectChanges.clear();
+    indexes.clear();
+}
+
+BaseObjectList *ObjectRegistry::getObjectList()
+{
+    return &objectList;
+}
+
+void ObjectRegistry::sendSnapshot(const RakNet::RakNetGUID &guid) const
+{
+    if (objectList.baseObjects.empty())
+        return;
+
+    // Objects have to exist before anything else can be done to them, and objects that were
+    // placed or spawned during play already carry their position and rotation
+    sendObjects(guid, ID_OBJECT_PLACE, CHANGE_PLACED, 0);
+    sendObjects(guid, ID_OBJECT_SPAWN, CHANGE_SPAWNED, 0);
+    sendObjects(guid, ID_OBJECT_DELETE, CHANGE_DELETED, 0);
+    sendObjects(guid, ID_OBJECT_STATE, CHANGE_STATE, CHANGE_DELETED);
+    sendObjects(guid, ID_OBJECT_LOCK, CHANGE_LOCK, CHANGE_DELETED);
+    sendObjects(guid, ID_OBJECT_SCALE, CHANGE_SCALE, CHANGE_DELETED);
+    sendObjects(guid, ID_DOOR_STATE, CHANGE_DOOR_STATE, CHANGE_DELETED);
+    sendObjects(guid, ID_OBJECT_TRAP, CHANGE_TRAP, CHANGE_DELETED);
+    sendObjects(guid, ID_OBJECT_MOVE, CHANGE_POSITION, CHANGE_DELETED | CHANGE_PLACED | CHANGE_SPAWNED);
+    sendObjects(guid, ID_OBJECT_ROTATE, CHANGE_ROTATION, CHANGE_DELETED | CHANGE_PLACED | CHANGE_SPAWNED);
+    sendObjects(guid, ID_CONTAINER, CHANGE_CONTAINER, CHANGE_DELETED);
+}
+
+unsigned int ObjectRegistry::getOrAddIndex(const BaseObject &baseObject)
+{
+    uint64_t key = getKey(baseObject.refNum, baseObject.mpNum);
+    auto it = indexes.find(key);
+
+    if (it != indexes.end())
+        return it->second;
+
+    BaseObject registryObject = {};
+    registryObject.refId = baseObject.refId;
+    registryObject.refNum = baseObject.refNum;
+    registryObject.mpNum = baseObject.mpNum;
+    registryObject.count = 1;
+    registryObject.charge = -1;
+    registryObject.enchantmentCharge = -1;
+    registryObject.goldValue = 1;
+    registryObject.objectState = true;
+    registryObject.scale = 1;
+
+    unsigned int index = static_cast<unsigned int>(objectList.baseObjects.size());
+    objectList.baseObjects.push_back(std::move(registryObject));
+    objectList.baseObjectCount = index + 1;
+    objectChanges.push_back(0);
+    indexes[key] = index;
+    return index;
+}
+
+void ObjectRegistry::applyContainer(BaseObject &registryObject, const BaseObject &baseObject, unsigned char action)
+{
+    if (action == BaseObjectList::SET)
+        registryObject.containerItems.clear();
+
+    for (const auto &containerItem : baseObject.containerItems)
+    {
+        auto it = std::find_if(registryObject.containerItems.begin(), registryObject.containerItems.end(),
+            [&containerItem](const ContainerItem &item) {
+                return Misc::StringUtils::ciEqual(item.refId, containerItem.refId) &&
+                    item.charge == containerItem.charge &&
+                    item.enchantmentCharge == containerItem.enchantmentCharge &&
+                    Misc::StringUtils::ciEqual(item.soul, containerItem.soul);
+            });
+
+        if (action == BaseObjectList::SET || action == BaseObjectList::ADD)
+        {
+            if (it != registryObject.containerItems.end())
+                it->count += containerItem.count;
+            else
+            {
+                registryObject.containerItems.push_back(containerItem);
+                registryObject.containerItems.back().actionCount = 0;
+            }
+        }
+        else if (action == BaseObjectList::REMOVE && it != registryObject.containerItems.end())
+        {
+            it->count -= containerItem.actionCount;
+
+            if (it->count <= 0)
+                registryObject.containerItems.erase(it);
+        }
+    }
+
+    registryObject.containerItemCount = static_cast<unsigned int>(registryObject.containerItems.size());
+}
+
+void ObjectRegistry::sendObjects(const RakNet::RakNetGUID &guid, unsigned char packetID, unsigned int requiredChanges,
+                                 unsigned int excludedChanges) const
+{
+    ObjectPacket *packet = Networking::get().getObjectPacketController()->GetPacket(packetID);
+
+    BaseObjectList sentObjectList;
+    sentObjectList.guid = guid;
+    sentObjectList.cell = objectList.cell;
+    sentObjectList.packetOrigin = mwmp::PACKET_ORIGIN::SERVER_SCRIPT;
+    sentObjectList.action = BaseObjectList::SET;
+    sentObjectList.containerSubAction = BaseObjectList::NONE;
+    sentObjectList.isValid = true;
+
+    for (unsigned int i = 0; i < objectList.baseObjects.size(); ++i)
+    {
+        if ((objectChanges[i] & requiredChanges) == 0 || (objectChanges[i] & excludedChanges) != 0)
+            continue;
+
+        sentObjectList.baseObjects.push_back(objectList.baseObjects[i]);
+
+        if (sentObjectList.baseObjects.size() == maxObjectsPerPacket)
+        {
+            packet->setObjectList(&sentObjectList);
+            packet->Send(false);
+            sentObjectList.baseObjects.clear();
+        }
+    }
+
+    if (!sentObjectList.baseObjects.empty())
+    {
+        packet->setObjectList(&sentObjectList);
+        packet->Send(false);
+    }
+}
+
+uint64_t ObjectRegistry::getKey(unsigned int refNum, unsigned int mpNum)
+{
+    return (static_cast<uint64_t>(refNum) << 32) | mpNum;
+}
@@ -0,0 +1,72 @@
+#ifndef OPENMW_OBJECTREGISTRY_HPP
+#define OPENMW_OBJECTREGISTRY_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+/*
+    Keeps the latest known state of the objects in one cell, as sent on to players, so it can be
+    looked up and iterated from scripts and sent to players loading the cell without going
+    through scripts
+
+    Objects are stored contiguously in a BaseObjectList, letting scripts read all of them through
+    the same functions they use for received object lists, and are found by their refNum and
+    mpNum through an index into that list
+*/
+class ObjectRegistry
+{
+public:
+    enum CHANGE
+    {
+        CHANGE_PLACED = 1 << 0,
+        CHANGE_SPAWNED = 1 << 1,
+        CHANGE_DELETED = 1 << 2,
+        CHANGE_LOCK = 1 << 3,
+        CHANGE_SCALE = 1 << 4,
+        CHANGE_STATE = 1 << 5,
+        CHANGE_DOOR_STATE = 1 << 6,
+        CHANGE_TRAP = 1 << 7,
+        CHANGE_POSITION = 1 << 8,
+        CHANGE_ROTATION = 1 << 9,
+        CHANGE_CONTAINER = 1 << 10
+    };
+
+    ObjectRegistry(const ESM::Cell &cell);
+
+    // Whether packets with this ID change anything the registry keeps track of
+    static bool tracksPacket(unsigned char packetID);
+
+    // Record the changes from an object packet about this cell
+    void applyObjectList(unsigned char packetID, const mwmp::BaseObjectList &objectList);
+
+    // Get the index of an object in the object list, or -1 if it isn't in the registry
+    int getIndex(unsigned int refNum, unsigned int mpNum) const;
+    // Get a bitmask of the CHANGE flags recorded for the object at an index
+    unsigned int getChanges(unsigned int index) const;
+
+    bool removeObject(unsigned int refNum, unsigned int mpNum);
+    void clear();
+
+    mwmp::BaseObjectList *getObjectList();
+
+    // Send everything in the registry to a player as the object packets that recreate it
+    void sendSnapshot(const RakNet::RakNetGUID &guid) const;
+
+private:
+    static uint64_t getKey(unsigned int refNum, unsigned int mpNum);
+
+    unsigned int getOrAddIndex(const mwmp::BaseObject &baseObject);
+    static void applyContainer(mwmp::BaseObject &registryObject, const mwmp::BaseObject &baseObject,
+                               unsigned char action);
+    void sendObjects(const RakNet::RakNetGUID &guid, unsigned char packetID, unsigned int requiredChanges,
+                     unsigned int excludedChanges) const;
+
+    mwmp::BaseObjectList objectList;
+    std::vector<unsigned int> objectChanges;
+    std::unordered_map<uint64_t, unsigned int> indexes;
+};
+
+#endif //OPENMW_OBJECTREGISTRY_HPP
@@ -0,0 +1,348 @@
+#include "OutgoingScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include <RakPeerInterface.h>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
+#include <components/openmw-mp/Packets/Player/PlayerPacket.hpp>
+
+#include "Cell.hpp"
+#include "CellController.hpp"
+#include "Player.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    // How long the budget can be left unused before it stops accumulating
+    const double maxBurstSeconds = 0.1;
+    const std::chrono::milliseconds updateInterval(10);
+    // Relative priority of updates about something that isn't in the recipient's current worldspace
+    const float otherWorldspacePriority = 0.1f;
+
+    void combineKey(uint64_t &key, uint64_t value)
+    {
+        key = (key ^ value) * 1099511628211ULL;
+    }
+}
+
+OutgoingScheduler::OutgoingScheduler(RakNet::RakPeerInterface *peer) : peer(peer), budget(0), distanceScale(2048),
+    lastUpdate(std::chrono::steady_clock::now())
+{
+
+}
+
+void OutgoingScheduler::setBudget(unsigned int bytesPerSecond)
+{
+    budget = bytesPerSecond;
+
+    // Send out everything that was being held back by the old budget
+    if (budget == 0)
+    {
+        for (auto &&connection : connections)
+        {
+            for (auto &&pendingUpdate : connection.second.pendingUpdates)
+                sendUpdate(connection.first, connection.second, pendingUpdate.second);
+        }
+
+        connections.clear();
+    }
+}
+
+unsigned int OutgoingScheduler::getBudget() const
+{
+    return budget;
+}
+
+void OutgoingScheduler::setDistanceScale(float scale)
+{
+    distanceScale = std::max(scale, 1.f);
+}
+
+uint32_t OutgoingScheduler::Send(BasePacket *packet, RakNet::BitStream *bitStream, PacketPriority priority,
+                                 PacketReliability reliability, char orderChannel, RakNet::AddressOrGUID destination,
+                                 bool broadcast)
+{
+    if (budget == 0)
+        return peer->Send(bitStream, priority, reliability, orderChannel, destination, broadcast);
+
+    uint64_t key;
+    StateUpdate update;
+
+    if (isStateUpdate(packet, key, update))
+    {
+        update.data.assign(bitStream->GetData(), bitStream->GetData() + bitStream->GetNumberOfBytesUsed());
+        update.priority = priority;
+        update.reliability = reliability;
+        update.orderChannel = orderChannel;
+        update.accumulatedPriority = 0;
+
+        if (broadcast)
+        {
+            for (auto &&player : *Players::getPlayers())
+            {
+                if (player.first != destination.rakNetGuid)
+                    queueUpdate(player.first, key, update);
+            }
+        }
+        else
+            queueUpdate(destination.rakNetGuid, key, update);
+
+        return 0;
+    }
+
+    double size = bitStream->GetNumberOfBytesUsed();
+    RakNet::RakNetGUID subjectGuid = packet->getGUID();
+
+    if (broadcast)
+    {
+        for (auto &&connection : connections)
+        {
+            if (connection.first == destination.rakNetGuid)
+                continue;
+
+            flushSubject(connection.first, connection.second, subjectGuid);
+            connection.second.availableBytes -= size;
+        }
+    }
+    else
+    {
+        auto it = connections.find(destination.rakNetGuid);
+
+        if (it != connections.end())
+        {
+            flushSubject(it->first, it->second, subjectGuid);
+            it->second.availableBytes -= size;
+        }
+    }
+
+    return peer->Send(bitStream, priority, reliability, orderChannel, destination, broadcast);
+}
+
+void OutgoingScheduler::update()
+{
+    if (budget == 0)
+        return;
+
+    auto now = std::chrono::steady_clock::now();
+
+    if (now - lastUpdate < updateInterval)
+        return;
+
+    lastUpdate = now;
+
+    double maxAvailableBytes = budget * maxBurstSeconds;
+
+    for (auto &&connection : connections)
+    {
+        Connection &state = connection.second;
+
+        // Only refill for the time since the connection's last refill, or since it started being tracked
+        double dt = std::chrono::duration<double>(now - state.lastRefill).count();
+        state.lastRefill = now;
+
+        state.availableBytes = std::min(state.availableBytes + budget * dt, maxAvailableBytes);
+
+        if (state.pendingUpdates.empty())
+            continue;
+
+        Player *recipient = Players::getPlayer(connection.first);
+
+        std::vector<std::pair<float, uint64_t> > order;
+        order.reserve(state.pendingUpdates.size());
+
+        for (auto &&pendingUpdate : state.pendingUpdates)
+        {
+            StateUpdate &update = pendingUpdate.second;
+
+            if (recipient != nullptr)
+                update.accumulatedPriority += getBasePriority(recipient, update) * dt;
+            else
+                update.accumulatedPriority += dt;
+
+            order.emplace_back(update.accumulatedPriority, pendingUpdate.first);
+        }
+
+        std::sort(order.begin(), order.end(), std::greater<std::pair<float, uint64_t> >());
+
+        for (auto &&entry : order)
+        {
+            if (state.availableBytes <= 0)
+                break;
+
+            auto it = state.pendingUpdates.find(entry.second);
+            sendUpdate(connection.first, state, it->second);
+            state.pendingUpdates.erase(it);
+        }
+    }
+}
+
+void OutgoingScheduler::removeConnection(RakNet::RakNetGUID guid)
+{
+    connections.erase(guid);
+}
+
+bool OutgoingScheduler::isStateUpdate(BasePacket *packet, uint64_t &key, StateUpdate &update) const
+{
+    unsigned char packetID = packet->GetPacketID();
+    key = 14695981039346656037ULL;
+    combineKey(key, packetID);
+
+    switch (packetID)
+    {
+        case ID_PLAYER_POSITION:
+        case ID_PLAYER_ANIM_FLAGS:
+        {
+            BasePlayer *player = static_cast<PlayerPacket*>(packet)->getPlayer();
+
+            combineKey(key, player->guid.g);
+
+            update.subjectGuid = player->guid;
+            update.hasPosition = true;
+            update.cell = player->cell;
+            update.position = player->position;
+            return true;
+        }
+        case ID_ACTOR_POSITION:
+        case ID_ACTOR_ANIM_FLAGS:
+        case ID_ACTOR_STATS_DYNAMIC:
+        case ID_ACTOR_FRAME:
+        {
+            BaseActorList *actorList = static_cast<ActorPacket*>(packet)->getActorList();
+
+            if (actorList->baseActors.empty())
+                return false;
+
+            // Frames only carry the latest state when they have nothing besides the facets above
+            const uint16_t stateFacets = BaseActor::FACET_POSITION | BaseActor::FACET_ANIM_FLAGS |
+                BaseActor::FACET_STATS_DYNAMIC;
+
+            if (packetID == ID_ACTOR_FRAME)
+            {
+                for (auto &&actor : actorList->baseActors)
+                {
+                    if (actor.frameFacets & ~stateFacets)
+                        return false;
+                }
+            }
+
+            // Only an update about exactly the same actors can replace an earlier one
+            combineKey(key, actorList->guid.g);
+            combineKey(key, std::hash<std::string>()(actorList->cell.mName));
+            combineKey(key, (uint32_t) actorList->cell.mData.mX);
+            combineKey(key, (uint32_t) actorList->cell.mData.mY);
+
+            // A frame can only replace one that has the same facets for each of its actors
+            for (auto &&actor : actorList->baseActors)
+            {
+                combineKey(key, actor.refNum);
+                combineKey(key, actor.mpNum);
+
+                if (packetID == ID_ACTOR_FRAME)
+                    combineKey(key, actor.frameFacets);
+            }
+
+            const BaseActor &firstActor = actorList->baseActors.front();
+
+            update.subjectGuid = actorList->guid;
+            update.cell = actorList->cell;
+            update.hasPosition = packetID == ID_ACTOR_POSITION ||
+                (packetID == ID_ACTOR_FRAME && (firstActor.frameFacets & BaseActor::FACET_POSITION));
+
+            if (update.hasPosition)
+                update.position = firstActor.position;
+            else
+            {
+                Cell *serverCell = CellController::get()->getCell(&actorList->cell);
+                BaseActor *cellActor = serverCell != nullptr ? serverCell->getActor(firstActor.refNum, firstActor.mpNum) : nullptr;
+
+                if (cellActor != nullptr && cellActor->hasPositionData)
+                {
+                    update.hasPosition = true;
+                    update.position = cellActor->position;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void OutgoingScheduler::queueUpdate(RakNet::RakNetGUID recipient, uint64_t key, const StateUpdate &update)
+{
+    auto it = connections.find(recipient);
+
+    if (it == connections.end())
+        it = connections.insert(std::make_pair(recipient, Connection{budget * maxBurstSeconds, std::chrono::steady_clock::now(), {}})).first;
+
+    Connection &connection = it->second;
+
+    // Don't add any latency while the connection is within its budget
+    if (connection.pendingUpdates.empty() && connection.availableBytes > 0)
+    {
+        sendUpdate(recipient, connection, update);
+        return;
+    }
+
+    auto pendingIt = connection.pendingUpdates.find(key);
+
+    if (pendingIt != connection.pendingUpdates.end())
+    {
+        // Replace the superseded update but keep the priority it has accumulated while waiting
+        float accumulatedPriority = pendingIt->second.accumulatedPriority;
+        pendingIt->second = update;
+        pendingIt->second.accumulatedPriority = accumulatedPriority;
+    }
+    else
+        connection.pendingUpdates.insert(std::make_pair(key, update));
+}
+
+void OutgoingScheduler::flushSubject(RakNet::RakNetGUID recipient, Connection &connection, RakNet::RakNetGUID subjectGuid)
+{
+    for (auto it = connection.pendingUpdates.begin(); it != connection.pendingUpdates.end();)
+    {
+        if (it->second.subjectGuid == subjectGuid)
+        {
+            sendUpdate(recipient, connection, it->second);
+            it = connection.pendingUpdates.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+void OutgoingScheduler::sendUpdate(RakNet::RakNetGUID recipient, Connection &connection, const StateUpdate &update)
+{
+    peer->Send((const char *) update.data.data(), (int) update.data.size(), update.priority, update.reliability,
+               update.orderChannel, recipient, false);
+
+    connection.availableBytes -= update.data.size();
+}
+
+float OutgoingScheduler::getBasePriority(Player *recipient, const StateUpdate &update) const
+{
+    if (!update.hasPosition)
+        return 1;
+
+    bool isSameWorldspace;
+
+    if (recipient->cell.isExterior())
+        isSameWorldspace = update.cell.isExterior();
+    else
+        isSameWorldspace = !update.cell.isExterior() && update.cell.mName == recipient->cell.mName;
+
+    if (!isSameWorldspace)
+        return otherWorldspacePriority;
+
+    float dx = update.position.pos[0] - recipient->position.pos[0];
+    float dy = update.position.pos[1] - recipient->position.pos[1];
+    float dz = update.position.pos[2] - recipient->position.pos[2];
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    return 1 / (1 + distance / distanceScale);
+}
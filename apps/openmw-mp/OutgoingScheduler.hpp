@@ -0,0 +1,85 @@
+#ifndef OPENMW_OUTGOINGSCHEDULER_HPP
+#define OPENMW_OUTGOINGSCHEDULER_HPP
+
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include <components/esm/defs.hpp>
+#include <components/esm/loadcell.hpp>
+#include <components/openmw-mp/Packets/PacketScheduler.hpp>
+
+class Player;
+
+namespace mwmp
+{
+    /*
+        Sits between the packet controllers and the RakPeer, giving every connection a budget of
+        bytes per second
+
+        Packets that only carry the latest state of a player or of a set of actors (positions,
+        animation flags and dynamic stats of actors) are queued per connection, where a newer one
+        replaces an older unsent one about the same thing. Queued updates accumulate priority over
+        time, faster the closer their subject is to the recipient, and are sent in order of
+        accumulated priority for as long as the connection's budget allows
+
+        All other packets are sent right away, after any queued updates about the same subject
+        that would otherwise arrive out of order, and count against the budget without being
+        held back by it
+    */
+    class OutgoingScheduler : public PacketScheduler
+    {
+    public:
+        OutgoingScheduler(RakNet::RakPeerInterface *peer);
+
+        void setBudget(unsigned int bytesPerSecond);
+        unsigned int getBudget() const;
+        void setDistanceScale(float scale);
+
+        uint32_t Send(BasePacket *packet, RakNet::BitStream *bitStream, PacketPriority priority,
+                      PacketReliability reliability, char orderChannel, RakNet::AddressOrGUID destination,
+                      bool broadcast) override;
+
+        void update();
+        void removeConnection(RakNet::RakNetGUID guid);
+
+    private:
+        struct StateUpdate
+        {
+            RakNet::RakNetGUID subjectGuid;
+            std::vector<unsigned char> data;
+            PacketPriority priority;
+            PacketReliability reliability;
+            char orderChannel;
+
+            bool hasPosition;
+            ESM::Cell cell;
+            ESM::Position position;
+
+            float accumulatedPriority;
+        };
+
+        struct Connection
+        {
+            double availableBytes;
+            std::chrono::steady_clock::time_point lastRefill;
+            std::unordered_map<uint64_t, StateUpdate> pendingUpdates;
+        };
+
+        bool isStateUpdate(BasePacket *packet, uint64_t &key, StateUpdate &update) const;
+        void queueUpdate(RakNet::RakNetGUID recipient, uint64_t key, const StateUpdate &update);
+        void flushSubject(RakNet::RakNetGUID recipient, Connection &connection, RakNet::RakNetGUID subjectGuid);
+        void sendUpdate(RakNet::RakNetGUID recipient, Connection &connection, const StateUpdate &update);
+        float getBasePriority(Player *recipient, const StateUpdate &update) const;
+
+        RakNet::RakPeerInterface *peer;
+        unsigned int budget;
+        float distanceScale;
+
+        std::map<RakNet::RakNetGUID, Connection> connections;
+        std::chrono::steady_clock::time_point lastUpdate;
+    };
+}
+
+#endif //OPENMW_OUTGOINGSCHEDULER_HPP
@@ -0,0 +1,179 @@
+#include "PacketDecoder.hpp"
+
+#include <RakPeerInterface.h>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+
+#include "processors/ActorProcessor.hpp"
+#include "processors/ObjectProcessor.hpp"
+#include "processors/WorldstateProcessor.hpp"
+
+using namespace mwmp;
+
+PacketDecoder::PacketDecoder(RakNet::RakPeerInterface *peer, ActorPacketController *actorPacketController,
+                             ObjectPacketController *objectPacketController,
+                             WorldstatePacketController *worldstatePacketController) :
+    peer(peer), actorPacketController(actorPacketController), objectPacketController(objectPacketController),
+    worldstatePacketController(worldstatePacketController), isStopping(false)
+{
+
+}
+
+PacketDecoder::~PacketDecoder()
+{
+    stopWorkers();
+}
+
+void PacketDecoder::setWorkerCount(unsigned int count)
+{
+    // The current workers finish whatever they have been given before stopping
+    stopWorkers();
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        // Packets keep track of the stream and list they are reading, so every worker needs
+        // instances of its own
+        std::unique_ptr<Worker> worker(new Worker);
+        worker->actorPacketController.reset(new ActorPacketController(peer));
+        worker->objectPacketController.reset(new ObjectPacketController(peer));
+        worker->worldstatePacketController.reset(new WorldstatePacketController(peer));
+        worker->thread = std::thread(&PacketDecoder::runWorker, this, worker.get());
+        workers.push_back(std::move(worker));
+    }
+}
+
+unsigned int PacketDecoder::getWorkerCount() const
+{
+    return static_cast<unsigned int>(workers.size());
+}
+
+void PacketDecoder::push(RakNet::Packet *packet, bool canDecode)
+{
+    std::unique_ptr<Job> job(new Job);
+    job->decoded.packet = packet;
+    job->isDecoding = false;
+
+    if (canDecode && !workers.empty())
+    {
+        unsigned char packetID = packet->data[0];
+
+        if (actorPacketController->ContainsPacket(packetID) && ActorProcessor::IsDecodable(packetID))
+            job->decoded.actorList.reset(new BaseActorList);
+        else if (objectPacketController->ContainsPacket(packetID) && ObjectProcessor::IsDecodable(packetID))
+            job->decoded.objectList.reset(new BaseObjectList);
+        else if (worldstatePacketController->ContainsPacket(packetID) && WorldstateProcessor::IsDecodable(packetID))
+            job->decoded.worldstate.reset(new BaseWorldstate);
+    }
+
+    bool hasList = job->decoded.actorList || job->decoded.objectList || job->decoded.worldstate;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (hasList)
+    {
+        job->isDecoding = true;
+        pendingJobs.push_back(job.get());
+        jobAdded.notify_one();
+    }
+
+    jobs.push_back(std::move(job));
+}
+
+bool PacketDecoder::pop(DecodedPacket &decoded)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (jobs.empty())
+        return false;
+
+    Job *job = jobs.front().get();
+    jobDecoded.wait(lock, [job] { return !job->isDecoding; });
+
+    decoded = std::move(job->decoded);
+    jobs.pop_front();
+    return true;
+}
+
+void PacketDecoder::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    jobAdded.notify_all();
+
+    for (auto &worker : workers)
+        worker->thread.join();
+
+    workers.clear();
+    isStopping = false;
+}
+
+void PacketDecoder::runWorker(Worker *worker)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        jobAdded.wait(lock, [this] { return isStopping || !pendingJobs.empty(); });
+
+        if (pendingJobs.empty())
+            return;
+
+        Job *job = pendingJobs.front();
+        pendingJobs.pop_front();
+
+        lock.unlock();
+        decode(*worker, job->decoded);
+        lock.lock();
+
+        job->isDecoding = false;
+        jobDecoded.notify_all();
+    }
+}
+
+void PacketDecoder::decode(Worker &worker, DecodedPacket &decoded)
+{
+    RakNet::Packet *packet = decoded.packet;
+
+    RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+    if (decoded.actorList)
+    {
+        BaseActorList &actorList = *decoded.actorList;
+        actorList.cell.blank();
+        actorList.guid = packet->guid;
+        actorList.isValid = true;
+
+        ActorPacket *actorPacket = worker.actorPacketController->GetPacket(packet->data[0]);
+        actorPacket->SetReadStream(&bsIn);
+        actorPacket->setActorList(&actorList);
+        actorPacket->Read();
+    }
+    else if (decoded.objectList)
+    {
+        BaseObjectList &objectList = *decoded.objectList;
+        objectList.cell.blank();
+        objectList.guid = packet->guid;
+        objectList.isValid = true;
+
+        ObjectPacket *objectPacket = worker.objectPacketController->GetPacket(packet->data[0]);
+        objectPacket->SetReadStream(&bsIn);
+        objectPacket->setObjectList(&objectList);
+        objectPacket->Read();
+    }
+    else if (decoded.worldstate)
+    {
+        BaseWorldstate &worldstate = *decoded.worldstate;
+        worldstate.guid = packet->guid;
+        worldstate.isValid = true;
+
+        WorldstatePacket *worldstatePacket = worker.worldstatePacketController->GetPacket(packet->data[0]);
+        worldstatePacket->SetReadStream(&bsIn);
+        worldstatePacket->setWorldstate(&worldstate);
+        worldstatePacket->Read();
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef OPENMW_PACKETDECODER_HPP
+#define OPENMW_PACKETDECODER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+#include <components/openmw-mp/Base/BaseWorldstate.hpp>
+
+namespace RakNet
+{
+    struct Packet;
+    class RakPeerInterface;
+}
+
+namespace mwmp
+{
+    class ActorPacketController;
+    class ObjectPacketController;
+    class WorldstatePacketController;
+
+    /*
+        Reads actor, object and worldstate packets into lists of their own on a pool of worker
+        threads, so the main thread only has to validate them, run script callbacks and forward
+        them once it gets to them
+
+        Every received packet goes through the decoder, whether it can be decoded ahead or not,
+        and packets are handed back in the order they were received
+    */
+    class PacketDecoder
+    {
+    public:
+        struct DecodedPacket
+        {
+            RakNet::Packet *packet;
+
+            // At most one of these is set, and only for packets that were decoded ahead
+            std::unique_ptr<BaseActorList> actorList;
+            std::unique_ptr<BaseObjectList> objectList;
+            std::unique_ptr<BaseWorldstate> worldstate;
+        };
+
+        PacketDecoder(RakNet::RakPeerInterface *peer, ActorPacketController *actorPacketController,
+                      ObjectPacketController *objectPacketController,
+                      WorldstatePacketController *worldstatePacketController);
+        ~PacketDecoder();
+
+        // Replace the worker threads with the given number of them, with 0 leaving all decoding
+        // to the main thread
+        void setWorkerCount(unsigned int count);
+        unsigned int getWorkerCount() const;
+
+        // Queue a received packet, decoding it on a worker if canDecode is true and the packet
+        // belongs to a processor that reads its packets
+        void push(RakNet::Packet *packet, bool canDecode);
+
+        // Take the oldest queued packet, waiting for a worker to finish decoding it if need be,
+        // or return false if there are none left
+        bool pop(DecodedPacket &decoded);
+
+    private:
+        struct Job
+        {
+            DecodedPacket decoded;
+            bool isDecoding;
+        };
+
+        struct Worker
+        {
+            std::unique_ptr<ActorPacketController> actorPacketController;
+            std::unique_ptr<ObjectPacketController> objectPacketController;
+            std::unique_ptr<WorldstatePacketController> worldstatePacketController;
+            std::thread thread;
+        };
+
+        void stopWorkers();
+        void runWorker(Worker *worker);
+        static void decode(Worker &worker, DecodedPacket &decoded);
+
+        RakNet::RakPeerInterface *peer;
+        ActorPacketController *actorPacketController;
+        ObjectPacketController *objectPacketController;
+        WorldstatePacketController *worldstatePacketController;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        // Only the main thread adds and removes jobs, while workers take them from pendingJobs
+        // and mark them as done under the mutex
+        std::deque<std::unique_ptr<Job>> jobs;
+        std::deque<Job*> pendingJobs;
+        std::mutex mutex;
+        std::condition_variable jobAdded;
+        std::condition_variable jobDecoded;
+        bool isStopping;
+    };
+}
+
+#endif //OPENMW_PACKETDECODER_HPP
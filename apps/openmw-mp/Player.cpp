@@ -1,6 +1,13 @@
 #include "Player.hpp"
 #include "Networking.hpp"
 
+#include <algorithm>
+
+#include <components/misc/stringops.hpp>
+#include <components/openmw-mp/Base/InventorySync.hpp>
+
+using namespace mwmp::InventorySync;
+
 TPlayers Players::players;
 TSlots Players::slots;
 
@@ -68,6 +75,15 @@ Player::Player(RakNet::RakNetGUID guid) : BasePlayer(guid)
 {
     handshakeCounter = 0;
     loadState = NOTLOADED;
+
+    isInventorySynced = false;
+    isSpellbookSynced = false;
+    inventoryRevision = 0;
+    lastInventorySetRevision = 0;
+    lastInventoryDeltaRevision = 0;
+    spellbookRevision = 0;
+    lastSpellbookSetRevision = 0;
+    lastSpellbookDeltaRevision = 0;
 }
 
 Player::~Player()
@@ -175,3 +191,235 @@ bool Players::doesPlayerExist(RakNet::RakNetGUID guid)
 {
     return players.find(guid) != players.end();
 }
+
+void Player::sendInventoryChangesToSelf(mwmp::PlayerPacket *myPacket)
+{
+    std::vector<mwmp::Item> scriptItems;
+    bool isDelta = inventoryChanges.action == mwmp::InventoryChanges::SET && isInventorySynced;
+
+    if (isDelta)
+    {
+        requestedInventory.clear();
+
+        for (auto &&item : inventoryChanges.items)
+            addToInventory(requestedInventory, item, item.count);
+
+        std::vector<mwmp::Item> delta = getInventoryDelta(syncedInventory, requestedInventory);
+        inventoryChanges.baseChecksum = getInventoryChecksum(syncedInventory);
+        syncedInventory = requestedInventory;
+
+        scriptItems.swap(inventoryChanges.items);
+        inventoryChanges.items.swap(delta);
+        inventoryChanges.action = mwmp::InventoryChanges::DELTA;
+    }
+    else
+        applyToSyncedInventory(inventoryChanges);
+
+    inventoryChanges.revision = ++inventoryRevision;
+
+    if (inventoryChanges.action == mwmp::InventoryChanges::SET)
+        lastInventorySetRevision = inventoryRevision;
+    else if (isDelta)
+        lastInventoryDeltaRevision = inventoryRevision;
+
+    myPacket->setPlayer(this);
+    useRefIdTable = true;
+    myPacket->Send(false);
+    useRefIdTable = false;
+
+    // Leave the changes the way the script set them, for anyone else they get sent to
+    if (isDelta)
+    {
+        inventoryChanges.items.swap(scriptItems);
+        inventoryChanges.action = mwmp::InventoryChanges::SET;
+    }
+}
+
+void Player::sendSpellbookChangesToSelf(mwmp::PlayerPacket *myPacket)
+{
+    std::vector<ESM::Spell> scriptSpells;
+    bool isDelta = spellbookChanges.action == mwmp::SpellbookChanges::SET && isSpellbookSynced;
+
+    if (isDelta)
+    {
+        std::vector<std::string> targetSpellbook;
+        std::vector<ESM::Spell> addedSpells;
+
+        for (auto &&spell : spellbookChanges.spells)
+        {
+            std::string spellId = Misc::StringUtils::lowerCase(spell.mId);
+
+            if (std::find(targetSpellbook.begin(), targetSpellbook.end(), spellId) != targetSpellbook.end())
+                continue;
+
+            if (std::find(syncedSpellbook.begin(), syncedSpellbook.end(), spellId) == syncedSpellbook.end())
+                addedSpells.push_back(spell);
+
+            targetSpellbook.push_back(spellId);
+        }
+
+        spellbookChanges.removedSpells.clear();
+
+        for (auto &&spellId : syncedSpellbook)
+        {
+            if (std::find(targetSpellbook.begin(), targetSpellbook.end(), spellId) == targetSpellbook.end())
+            {
+                ESM::Spell spell;
+                spell.mId = spellId;
+                spellbookChanges.removedSpells.push_back(spell);
+            }
+        }
+
+        spellbookChanges.baseChecksum = getSpellbookChecksum(syncedSpellbook);
+        syncedSpellbook = std::move(targetSpellbook);
+        requestedSpellbook = spellbookChanges.spells;
+
+        scriptSpells.swap(spellbookChanges.spells);
+        spellbookChanges.spells.swap(addedSpells);
+        spellbookChanges.action = mwmp::SpellbookChanges::DELTA;
+    }
+    else
+        applyToSyncedSpellbook(spellbookChanges);
+
+    spellbookChanges.revision = ++spellbookRevision;
+
+    if (spellbookChanges.action == mwmp::SpellbookChanges::SET)
+        lastSpellbookSetRevision = spellbookRevision;
+    else if (isDelta)
+        lastSpellbookDeltaRevision = spellbookRevision;
+
+    myPacket->setPlayer(this);
+    useRefIdTable = true;
+    myPacket->Send(false);
+    useRefIdTable = false;
+
+    if (isDelta)
+    {
+        spellbookChanges.spells.swap(scriptSpells);
+        spellbookChanges.removedSpells.clear();
+        spellbookChanges.action = mwmp::SpellbookChanges::SET;
+    }
+}
+
+void Player::resolveInventoryChanges()
+{
+    if (inventoryChanges.action == mwmp::InventoryChanges::SET)
+    {
+        // The client's whole inventory is only useful if there are no changes from us it hasn't applied yet
+        if (inventoryChanges.revision == inventoryRevision)
+            applyToSyncedInventory(inventoryChanges);
+        else
+            clearSyncedInventory();
+    }
+    // Additions and removals made before the client received our last SET were overwritten by it,
+    // while any other changes can be applied in whichever order
+    else if (inventoryChanges.revision >= lastInventorySetRevision)
+        applyToSyncedInventory(inventoryChanges);
+}
+
+void Player::resolveSpellbookChanges()
+{
+    if (spellbookChanges.action == mwmp::SpellbookChanges::SET)
+    {
+        if (spellbookChanges.revision == spellbookRevision)
+            applyToSyncedSpellbook(spellbookChanges);
+        else
+            clearSyncedSpellbook();
+    }
+    else if (spellbookChanges.revision >= lastSpellbookSetRevision)
+        applyToSyncedSpellbook(spellbookChanges);
+}
+
+void Player::handleInventoryRequest(mwmp::PlayerPacket *myPacket)
+{
+    // Anything we have sent since the DELTA replaces what it asked for, so the request is out of date
+    if (inventoryChanges.revision != inventoryRevision || inventoryRevision != lastInventoryDeltaRevision)
+        return;
+
+    inventoryChanges.items = requestedInventory;
+    inventoryChanges.action = mwmp::InventoryChanges::SET;
+    sendInventoryChangesToSelf(myPacket);
+}
+
+void Player::handleSpellbookRequest(mwmp::PlayerPacket *myPacket)
+{
+    if (spellbookChanges.revision != spellbookRevision || spellbookRevision != lastSpellbookDeltaRevision)
+        return;
+
+    spellbookChanges.spells = requestedSpellbook;
+    spellbookChanges.action = mwmp::SpellbookChanges::SET;
+    sendSpellbookChangesToSelf(myPacket);
+}
+
+void Player::applyToSyncedInventory(const mwmp::InventoryChanges &changes)
+{
+    if (changes.action == mwmp::InventoryChanges::SET)
+    {
+        syncedInventory.clear();
+
+        for (auto &&item : changes.items)
+            addToInventory(syncedInventory, item, item.count);
+
+        isInventorySynced = true;
+        return;
+    }
+
+    if (!isInventorySynced)
+        return;
+
+    for (auto &&item : changes.items)
+    {
+        bool isKnown = true;
+
+        if (changes.action == mwmp::InventoryChanges::ADD)
+            addToInventory(syncedInventory, item, item.count);
+        else if (changes.action == mwmp::InventoryChanges::REMOVE)
+            isKnown = removeFromInventory(syncedInventory, item, item.count);
+
+        if (!isKnown)
+        {
+            clearSyncedInventory();
+            return;
+        }
+    }
+}
+
+void Player::applyToSyncedSpellbook(const mwmp::SpellbookChanges &changes)
+{
+    if (changes.action == mwmp::SpellbookChanges::SET)
+    {
+        syncedSpellbook.clear();
+        isSpellbookSynced = true;
+    }
+    else if (!isSpellbookSynced)
+        return;
+
+    auto addSpell = [this](const ESM::Spell &spell) {
+        std::string spellId = Misc::StringUtils::lowerCase(spell.mId);
+
+        if (std::find(syncedSpellbook.begin(), syncedSpellbook.end(), spellId) == syncedSpellbook.end())
+            syncedSpellbook.push_back(spellId);
+    };
+
+    auto removeSpell = [this](const ESM::Spell &spell) {
+        std::string spellId = Misc::StringUtils::lowerCase(spell.mId);
+        syncedSpellbook.erase(std::remove(syncedSpellbook.begin(), syncedSpellbook.end(), spellId), syncedSpellbook.end());
+    };
+
+    if (changes.action == mwmp::SpellbookChanges::REMOVE)
+        std::for_each(changes.spells.begin(), changes.spells.end(), removeSpell);
+    else
+        std::for_each(changes.spells.begin(), changes.spells.end(), addSpell);
+}
+
+void Player::clearSyncedInventory()
+{
+    syncedInventory.clear();
+    isInventorySynced = false;
+}
+
+void Player::clearSyncedSpellbook()
+{
+    syncedSpellbook.clear();
+    isSpellbookSynced = false;
+}
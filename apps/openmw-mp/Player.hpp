@@ -69,11 +69,49 @@ public:
 
     void forEachLoaded(std::function<void(Player *pl, Player *other)> func);
 
+    // Send inventoryChanges or spellbookChanges to the player themselves, replacing a SET with
+    // a DELTA against what the player is known to have whenever possible
+    void sendInventoryChangesToSelf(mwmp::PlayerPacket *myPacket);
+    void sendSpellbookChangesToSelf(mwmp::PlayerPacket *myPacket);
+
+    // Apply inventoryChanges or spellbookChanges received from the player to what they are known to have
+    void resolveInventoryChanges();
+    void resolveSpellbookChanges();
+
+    // Send the player all of what the last DELTA was meant to leave them with, if they have
+    // asked for it because the DELTA didn't apply to what they had
+    void handleInventoryRequest(mwmp::PlayerPacket *myPacket);
+    void handleSpellbookRequest(mwmp::PlayerPacket *myPacket);
+
 private:
+    void applyToSyncedInventory(const mwmp::InventoryChanges &changes);
+    void applyToSyncedSpellbook(const mwmp::SpellbookChanges &changes);
+    void clearSyncedInventory();
+    void clearSyncedSpellbook();
+
     CellController::TContainer cells;
     int loadState;
     int handshakeCounter;
 
+    // The inventory and spellbook the player has as of the last packets exchanged with them,
+    // only known once a SET has been exchanged and until the two ends can no longer be sure
+    // to have applied the same changes
+    std::vector<mwmp::Item> syncedInventory;
+    std::vector<std::string> syncedSpellbook;
+    bool isInventorySynced;
+    bool isSpellbookSynced;
+
+    // What the last DELTA sent to the player was meant to leave them with
+    std::vector<mwmp::Item> requestedInventory;
+    std::vector<ESM::Spell> requestedSpellbook;
+
+    unsigned int inventoryRevision;
+    unsigned int lastInventorySetRevision;
+    unsigned int lastInventoryDeltaRevision;
+    unsigned int spellbookRevision;
+    unsigned int lastSpellbookSetRevision;
+    unsigned int lastSpellbookDeltaRevision;
+
 };
 
 #endif //OPENMW_PLAYER_HPP
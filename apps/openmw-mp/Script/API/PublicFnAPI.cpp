@@ -28,6 +28,19 @@ boost::any Public::Call(const std::string &name, const std::vector<boost::any> &
     return it->second->ScriptFunction::Call(args);
 }
 
+#if defined(ENABLE_LUA)
+int Public::CallFromLua(const std::string &name, lua_State *caller, int firstArg, int argCount)
+{
+    auto it = publics.find(name);
+    if (it == publics.end())
+        throw std::runtime_error("Public with name \"" + name + "\" does not exist");
+
+    if (argCount != (int) it->second->def.length())
+        throw std::invalid_argument("Script call: Number of arguments does not match definition");
+
+    return it->second->ScriptFunction::CallFromLua(caller, firstArg);
+}
+#endif
 
 const std::string &Public::GetDefinition(const std::string &name)
 {
@@ -23,6 +23,10 @@ public:
     { new Public(std::forward<Args>(args)...); }
 
     static boost::any Call(const std::string &name, const std::vector<boost::any> &args);
+#if defined(ENABLE_LUA)
+    // Call a Lua public with its arguments taken straight from the calling Lua state's stack
+    static int CallFromLua(const std::string &name, lua_State *caller, int firstArg, int argCount);
+#endif
 
     static const std::string& GetDefinition(const std::string& name);
 
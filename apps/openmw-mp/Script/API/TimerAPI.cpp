@@ -32,6 +32,14 @@ void Timer::Tick()
     if (time - startTime >= targetMsec)
     {
         isEnded = true;
+
+#if defined(ENABLE_LUA)
+        const char *name = script_type == SCRIPT_LUA ? fLua.name.c_str() : "native timer";
+#else
+        const char *name = "native timer";
+#endif
+        ScriptProfiler::Scope profilerScope(name, ScriptProfiler::SCOPE_TIMER);
+
         Call(args);
     }
 }
@@ -269,6 +269,9 @@ void ActorFunctions::SetActorPosition(double x, double y, double z) noexcept
     tempActor.position.pos[0] = x;
     tempActor.position.pos[1] = y;
     tempActor.position.pos[2] = z;
+
+    // Have clients display the position right away instead of interpolating towards it
+    tempActor.hasPositionTimestamp = false;
 }
 
 void ActorFunctions::SetActorRotation(double x, double y, double z) noexcept
@@ -405,6 +408,42 @@ void ActorFunctions::AddActor() noexcept
     tempActor = emptyActor;
 }
 
+bool ActorFunctions::GetAutomaticAuthorityState() noexcept
+{
+    return CellController::get()->getAutomaticAuthority();
+}
+
+void ActorFunctions::SetAutomaticAuthorityState(bool state) noexcept
+{
+    if (CellController::get()->getAutomaticAuthority() == state)
+        return;
+
+    CellController::get()->setAutomaticAuthority(state);
+
+    // Frame time reports are only needed by automatic assignment, so tell players who have
+    // already loaded in to start or stop sending them
+    mwmp::PlayerPacket *packet = mwmp::Networking::get().getPlayerPacketController()->GetPacket(ID_GAME_SETTINGS);
+
+    for (auto &&player : *Players::getPlayers())
+    {
+        if (player.second->getLoadState() != Player::POSTLOADED)
+            continue;
+
+        player.second->frameTimeReportsRequested = state;
+        packet->setPlayer(player.second);
+        packet->Send(false);
+    }
+}
+
+void ActorFunctions::SetActorAuthorityOverride(const char *cellDescription, bool state) noexcept
+{
+    ESM::Cell esmCell = Utils::getCellFromDescription(cellDescription);
+    Cell *serverCell = CellController::get()->getCell(&esmCell);
+
+    if (serverCell != nullptr)
+        serverCell->setAuthorityOverride(state);
+}
+
 void ActorFunctions::SendActorList() noexcept
 {
     mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_LIST);
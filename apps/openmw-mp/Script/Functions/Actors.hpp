@@ -89,6 +89,10 @@
     \
     {"AddActor",                               ActorFunctions::AddActor},\
     \
+    {"GetAutomaticAuthorityState",             ActorFunctions::GetAutomaticAuthorityState},\
+    {"SetAutomaticAuthorityState",             ActorFunctions::SetAutomaticAuthorityState},\
+    {"SetActorAuthorityOverride",              ActorFunctions::SetActorAuthorityOverride},\
+    \
     {"SendActorList",                          ActorFunctions::SendActorList},\
     {"SendActorAuthority",                     ActorFunctions::SendActorAuthority},\
     {"SendActorPosition",                      ActorFunctions::SendActorPosition},\
@@ -703,6 +707,40 @@ public:
     */
     static void AddActor() noexcept;
 
+    /**
+    * \brief Check whether the server is automatically choosing the actor authority of cells.
+    *
+    * \return The automatic authority state.
+    */
+    static bool GetAutomaticAuthorityState() noexcept;
+
+    /**
+    * \brief Set whether the server should automatically choose the actor authority of cells
+    *        based on each player's ping, frame time and existing authority load.
+    *
+    * When enabled, the OnActorAuthorityChange event is triggered every time the server
+    * assigns authority over a cell to a player.
+    *
+    * Players who have already loaded in are sent their game settings again, so they start
+    * or stop reporting their frame time.
+    *
+    * \param state The new automatic authority state.
+    * \return void
+    */
+    static void SetAutomaticAuthorityState(bool state) noexcept;
+
+    /**
+    * \brief Set whether automatic authority assignment should leave the current actor authority
+    *        of a cell alone.
+    *
+    * The override is cleared automatically when the player holding authority unloads the cell.
+    *
+    * \param cellDescription The description of the cell.
+    * \param state Whether the current authority is kept.
+    * \return void
+    */
+    static void SetActorAuthorityOverride(const char *cellDescription, bool state) noexcept;
+
     /**
     * \brief Send an ActorList packet.
     *
@@ -716,7 +754,9 @@ public:
     * \brief Send an ActorAuthority packet.
     *
     * The player for whom the current actor list was initialized is recorded in the server memory
-    * as the new actor authority for the actor list's cell.
+    * as the new actor authority for the actor list's cell. Automatic authority assignment can
+    * move it to another player after the minimum hold time, unless SetActorAuthorityOverride
+    * is used to keep it.
     *
     * The packet is sent to that player as well as all other players who have the cell loaded.
     *
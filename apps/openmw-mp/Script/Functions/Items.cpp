@@ -251,12 +251,14 @@ void ItemFunctions::SendInventoryChanges(unsigned short pid, bool sendToOtherPla
     GET_PLAYER(pid, player, );
 
     mwmp::PlayerPacket *packet = mwmp::Networking::get().getPlayerPacketController()->GetPacket(ID_PLAYER_INVENTORY);
-    packet->setPlayer(player);
 
     if (!skipAttachedPlayer)
-        packet->Send(false);
+        player->sendInventoryChangesToSelf(packet);
     if (sendToOtherPlayers)
+    {
+        packet->setPlayer(player);
         packet->Send(true);
+    }
 }
 
 void ItemFunctions::SendItemUse(unsigned short pid) noexcept
@@ -1,7 +1,9 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/Base/BaseObject.hpp>
 
+#include <apps/openmw-mp/CellController.hpp>
 #include <apps/openmw-mp/Networking.hpp>
+#include <apps/openmw-mp/ObjectRegistry.hpp>
 #include <apps/openmw-mp/Player.hpp>
 #include <apps/openmw-mp/Utils.hpp>
 #include <apps/openmw-mp/Script/ScriptFunctions.hpp>
@@ -12,6 +14,8 @@ using namespace mwmp;
 
 BaseObjectList *readObjectList;
 BaseObjectList writeObjectList;
+ObjectRegistry *readObjectRegistry = nullptr;
+BaseObjectList emptyObjectList;
 
 BaseObject tempObject;
 const BaseObject emptyObject = {};
@@ -22,6 +26,7 @@ const ContainerItem emptyContainerItem = {};
 void ObjectFunctions::ReadReceivedObjectList() noexcept
 {
     readObjectList = mwmp::Networking::getPtr()->getReceivedObjectList();
+    readObjectRegistry = nullptr;
 }
 
 void ObjectFunctions::ClearObjectList() noexcept
@@ -44,6 +49,66 @@ void ObjectFunctions::CopyReceivedObjectListToStore() noexcept
     writeObjectList = *readObjectList;
 }
 
+void ObjectFunctions::ReadCellObjectList(const char* cellDescription) noexcept
+{
+    readObjectRegistry = CellController::get()->getObjectRegistry(Utils::getCellFromDescription(cellDescription));
+
+    if (readObjectRegistry != nullptr)
+        readObjectList = readObjectRegistry->getObjectList();
+    else
+    {
+        emptyObjectList.baseObjects.clear();
+        emptyObjectList.baseObjectCount = 0;
+        readObjectList = &emptyObjectList;
+    }
+}
+
+int ObjectFunctions::GetCellObjectIndex(unsigned int refNum, unsigned int mpNum) noexcept
+{
+    if (readObjectRegistry == nullptr)
+        return -1;
+
+    return readObjectRegistry->getIndex(refNum, mpNum);
+}
+
+unsigned int ObjectFunctions::GetCellObjectChanges(unsigned int index) noexcept
+{
+    if (readObjectRegistry == nullptr)
+        return 0;
+
+    return readObjectRegistry->getChanges(index);
+}
+
+bool ObjectFunctions::RemoveCellObject(const char* cellDescription, unsigned int refNum, unsigned int mpNum) noexcept
+{
+    ObjectRegistry *objectRegistry = CellController::get()->getObjectRegistry(Utils::getCellFromDescription(cellDescription));
+    return objectRegistry != nullptr && objectRegistry->removeObject(refNum, mpNum);
+}
+
+void ObjectFunctions::ClearCellObjects(const char* cellDescription) noexcept
+{
+    ObjectRegistry *objectRegistry = CellController::get()->getObjectRegistry(Utils::getCellFromDescription(cellDescription));
+
+    if (objectRegistry != nullptr)
+        objectRegistry->clear();
+}
+
+void ObjectFunctions::SendCellObjects(unsigned short pid, const char* cellDescription) noexcept
+{
+    Player *player;
+    GET_PLAYER(pid, player, );
+
+    ObjectRegistry *objectRegistry = CellController::get()->getObjectRegistry(Utils::getCellFromDescription(cellDescription));
+
+    if (objectRegistry != nullptr)
+        objectRegistry->sendSnapshot(player->guid);
+}
+
+void ObjectFunctions::SetCellObjectSnapshotState(bool state) noexcept
+{
+    CellController::get()->setObjectSnapshots(state);
+}
+
 unsigned int ObjectFunctions::GetObjectListSize() noexcept
 {
     return readObjectList->baseObjectCount;
@@ -732,6 +797,9 @@ void ObjectFunctions::SendObjectPlace(bool sendToOtherPlayers, bool skipAttached
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_PLACE, writeObjectList);
 }
 
 void ObjectFunctions::SendObjectSpawn(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -743,6 +811,9 @@ void ObjectFunctions::SendObjectSpawn(bool sendToOtherPlayers, bool skipAttached
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_SPAWN, writeObjectList);
 }
 
 void ObjectFunctions::SendObjectDelete(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -754,6 +825,9 @@ void ObjectFunctions::SendObjectDelete(bool sendToOtherPlayers, bool skipAttache
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_DELETE, writeObjectList);
 }
 
 void ObjectFunctions::SendObjectLock(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -765,6 +839,9 @@ void ObjectFunctions::SendObjectLock(bool sendToOtherPlayers, bool skipAttachedP
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_LOCK, writeObjectList);
 }
 
 void ObjectFunctions::SendObjectDialogueChoice(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -809,6 +886,9 @@ void ObjectFunctions::SendObjectTrap(bool sendToOtherPlayers, bool skipAttachedP
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_TRAP, writeObjectList);
 }
 
 void ObjectFunctions::SendObjectScale(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -820,6 +900,9 @@ void ObjectFunctions::SendObjectScale(bool sendToOtherPlayers, bool skipAttached
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_SCALE, writeObjectList);
 }
 
 void ObjectFunctions::SendObjectSound(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -842,6 +925,9 @@ void ObjectFunctions::SendObjectState(bool sendToOtherPlayers, bool skipAttached
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_OBJECT_STATE, writeObjectList);
 }
 
 void ObjectFunctions::SendDoorState(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -853,6 +939,9 @@ void ObjectFunctions::SendDoorState(bool sendToOtherPlayers, bool skipAttachedPl
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_DOOR_STATE, writeObjectList);
 }
 
 void ObjectFunctions::SendDoorDestination(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -875,6 +964,9 @@ void ObjectFunctions::SendContainer(bool sendToOtherPlayers, bool skipAttachedPl
         packet->Send(false);
     if (sendToOtherPlayers)
         packet->Send(true);
+
+    if (sendToOtherPlayers || !skipAttachedPlayer)
+        CellController::get()->recordObjectList(ID_CONTAINER, writeObjectList);
 }
 
 void ObjectFunctions::SendVideoPlay(bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -9,6 +9,14 @@
     \
     {"CopyReceivedObjectListToStore",         ObjectFunctions::CopyReceivedObjectListToStore},\
     \
+    {"ReadCellObjectList",                    ObjectFunctions::ReadCellObjectList},\
+    {"GetCellObjectIndex",                    ObjectFunctions::GetCellObjectIndex},\
+    {"GetCellObjectChanges",                  ObjectFunctions::GetCellObjectChanges},\
+    {"RemoveCellObject",                      ObjectFunctions::RemoveCellObject},\
+    {"ClearCellObjects",                      ObjectFunctions::ClearCellObjects},\
+    {"SendCellObjects",                       ObjectFunctions::SendCellObjects},\
+    {"SetCellObjectSnapshotState",            ObjectFunctions::SetCellObjectSnapshotState},\
+    \
     {"GetObjectListSize",                     ObjectFunctions::GetObjectListSize},\
     {"GetObjectListOrigin",                   ObjectFunctions::GetObjectListOrigin},\
     {"GetObjectListClientScript",             ObjectFunctions::GetObjectListClientScript},\
@@ -219,6 +227,77 @@ public:
     */
     static void CopyReceivedObjectListToStore() noexcept;
 
+    /**
+    * \brief Use the object registry of a cell as the object list being read.
+    *
+    * The server keeps track of objects placed, spawned and deleted in every loaded cell, and of
+    * the lock levels, scales, states, door states, traps, positions, rotations and container
+    * contents of objects, as sent on to players after being accepted. A cell's registry is
+    * freed when the cell is unloaded, right after OnCellDeletion, and an unloaded cell has an
+    * empty object list. After this, the usual object list getters return the registry's
+    * objects, and CopyReceivedObjectListToStore() copies them.
+    *
+    * \param cellDescription The description of the cell.
+    * \return void
+    */
+    static void ReadCellObjectList(const char* cellDescription) noexcept;
+
+    /**
+    * \brief Get the index of an object in the cell object list being read.
+    *
+    * \param refNum The refNum of the object.
+    * \param mpNum The mpNum of the object.
+    * \return The index of the object, or -1 if it isn't in the cell's registry.
+    */
+    static int GetCellObjectIndex(unsigned int refNum, unsigned int mpNum) noexcept;
+
+    /**
+    * \brief Get what has been recorded about the object at a certain index in the cell
+    *        object list being read.
+    *
+    * \param index The index of the object.
+    * \return A bitmask of the recorded changes (1 for placed, 2 for spawned, 4 for deleted,
+    * 8 for lock level, 16 for scale, 32 for state, 64 for door state, 128 for trap, 256 for
+    * position, 512 for rotation, 1024 for container), or 0 if no cell object list is being read.
+    */
+    static unsigned int GetCellObjectChanges(unsigned int index) noexcept;
+
+    /**
+    * \brief Remove an object from the object registry of a cell.
+    *
+    * \param cellDescription The description of the cell.
+    * \param refNum The refNum of the object.
+    * \param mpNum The mpNum of the object.
+    * \return Whether the object was in the registry.
+    */
+    static bool RemoveCellObject(const char* cellDescription, unsigned int refNum, unsigned int mpNum) noexcept;
+
+    /**
+    * \brief Remove every object from the object registry of a cell.
+    *
+    * \param cellDescription The description of the cell.
+    * \return void
+    */
+    static void ClearCellObjects(const char* cellDescription) noexcept;
+
+    /**
+    * \brief Send the contents of the object registry of a cell to a player.
+    *
+    * \param pid The player ID to send them to.
+    * \param cellDescription The description of the cell.
+    * \return void
+    */
+    static void SendCellObjects(unsigned short pid, const char* cellDescription) noexcept;
+
+    /**
+    * \brief Set whether players loading a cell are automatically sent the contents of its
+    *        object registry, right after OnCellLoad.
+    *
+    * \param state The snapshot state.
+    * \return void
+    */
+    static void SetCellObjectSnapshotState(bool state) noexcept;
+
     /**
     * \brief Get the number of indexes in the read object list.
     *
@@ -23,6 +23,65 @@ void ServerFunctions::LogAppend(unsigned short level, const char *message) noexc
     LOG_APPEND(level, "[Script]: %s", message);
 }
 
+unsigned int ServerFunctions::GetDroppedLogMessageCount() noexcept
+{
+    return (unsigned int) TimedLog::GetDroppedCount();
+}
+
+double ServerFunctions::GetScriptMemoryUsage() noexcept
+{
+    return Script::GetMemoryUsage() / 1024.0;
+}
+
+double ServerFunctions::GetScriptPeakMemoryUsage() noexcept
+{
+    return Script::GetPeakMemoryUsage() / 1024.0;
+}
+
+void ServerFunctions::SetScriptGCParameters(int pause, int stepMultiplier) noexcept
+{
+    Script::SetGCParameters(pause, stepMultiplier);
+}
+
+void ServerFunctions::SetScriptGCAutomatic(bool automatic) noexcept
+{
+    Script::SetGCAutomatic(automatic);
+}
+
+bool ServerFunctions::StepScriptGC(int kilobytes) noexcept
+{
+    return Script::StepGC(kilobytes);
+}
+
+void ServerFunctions::CollectScriptGarbage() noexcept
+{
+    Script::CollectGarbage();
+}
+
+void ServerFunctions::StartScriptProfiler(int instructionCount) noexcept
+{
+    ScriptProfiler::Start(instructionCount);
+}
+
+void ServerFunctions::StopScriptProfiler() noexcept
+{
+    if (!ScriptProfiler::IsRunning())
+        return;
+
+    ScriptProfiler::Stop();
+    ScriptProfiler::LogSummary();
+}
+
+bool ServerFunctions::IsScriptProfilerRunning() noexcept
+{
+    return ScriptProfiler::IsRunning();
+}
+
+bool ServerFunctions::ExportScriptProfile(const char *path) noexcept
+{
+    return ScriptProfiler::Export(path);
+}
+
 void ServerFunctions::StopServer(int code) noexcept
 {
     mwmp::Networking::getPtr()->stopServer(code);
@@ -6,6 +6,19 @@
 #define SERVERAPI \
     {"LogMessage",                      ServerFunctions::LogMessage},\
     {"LogAppend",                       ServerFunctions::LogAppend},\
+    {"GetDroppedLogMessageCount",       ServerFunctions::GetDroppedLogMessageCount},\
+    \
+    {"GetScriptMemoryUsage",            ServerFunctions::GetScriptMemoryUsage},\
+    {"GetScriptPeakMemoryUsage",        ServerFunctions::GetScriptPeakMemoryUsage},\
+    {"SetScriptGCParameters",           ServerFunctions::SetScriptGCParameters},\
+    {"SetScriptGCAutomatic",            ServerFunctions::SetScriptGCAutomatic},\
+    {"StepScriptGC",                    ServerFunctions::StepScriptGC},\
+    {"CollectScriptGarbage",            ServerFunctions::CollectScriptGarbage},\
+    \
+    {"StartScriptProfiler",             ServerFunctions::StartScriptProfiler},\
+    {"StopScriptProfiler",              ServerFunctions::StopScriptProfiler},\
+    {"IsScriptProfilerRunning",         ServerFunctions::IsScriptProfilerRunning},\
+    {"ExportScriptProfile",             ServerFunctions::ExportScriptProfile},\
     \
     {"StopServer",                      ServerFunctions::StopServer},\
     \
@@ -73,6 +86,107 @@ public:
     */
     static void LogAppend(unsigned short level, const char *message) noexcept;
 
+    /**
+    * \brief Get the number of log messages dropped so far because the asynchronous log
+    *        buffer was full.
+    *
+    * \return The number of dropped log messages, which is always 0 when asynchronous
+    *         logging is disabled.
+    */
+    static unsigned int GetDroppedLogMessageCount() noexcept;
+
+    /**
+    * \brief Get the memory currently used by server scripts.
+    *
+    * \return The memory used, in kilobytes.
+    */
+    static double GetScriptMemoryUsage() noexcept;
+
+    /**
+    * \brief Get the highest memory use of server scripts since they were loaded.
+    *
+    * \return The memory used, in kilobytes.
+    */
+    static double GetScriptPeakMemoryUsage() noexcept;
+
+    /**
+    * \brief Set the parameters of the incremental garbage collector used by server scripts.
+    *
+    * \param pause How much memory use has to grow after a collection before the next one
+    *              starts, as a percentage (100 to start right away, 200 to wait for it to double).
+    * \param stepMultiplier How fast the collector runs compared to memory allocation, as a
+    *                       percentage.
+    * \return void
+    */
+    static void SetScriptGCParameters(int pause, int stepMultiplier) noexcept;
+
+    /**
+    * \brief Set whether the garbage collector of server scripts runs on its own as memory
+    *        is allocated.
+    *
+    * When disabled, garbage is only collected through StepScriptGC() and CollectScriptGarbage(),
+    * which lets scripts do it during the idle time of server ticks instead.
+    *
+    * \param automatic Whether the garbage collector runs on its own.
+    * \return void
+    */
+    static void SetScriptGCAutomatic(bool automatic) noexcept;
+
+    /**
+    * \brief Perform an incremental step of garbage collection in server scripts.
+    *
+    * \param kilobytes The size of the step, as the amount of allocation it corresponds to.
+    * \return Whether the step finished a collection cycle.
+    */
+    static bool StepScriptGC(int kilobytes) noexcept;
+
+    /**
+    * \brief Perform a full garbage collection cycle in server scripts.
+    *
+    * \return void
+    */
+    static void CollectScriptGarbage() noexcept;
+
+    /**
+    * \brief Start profiling server scripts, discarding the results of any previous profiling.
+    *
+    * The time spent in every callback and timer is measured, and the stacks of Lua scripts are
+    * sampled to find out which of their functions that time goes to. Lua scripts run without
+    * their JIT compiler while the profiler is running.
+    *
+    * \param instructionCount The number of Lua instructions between samples, with 0 or less
+    *                         using the default of 1000.
+    * \return void
+    */
+    static void StartScriptProfiler(int instructionCount) noexcept;
+
+    /**
+    * \brief Stop profiling server scripts and log a summary of the results.
+    *
+    * The results are kept until the profiler is started again, so they can still be exported.
+    *
+    * \return void
+    */
+    static void StopScriptProfiler() noexcept;
+
+    /**
+    * \brief Check whether the script profiler is running.
+    *
+    * \return Whether the script profiler is running.
+    */
+    static bool IsScriptProfilerRunning() noexcept;
+
+    /**
+    * \brief Export the results of the script profiler.
+    *
+    * Two files are written: one with the extension .folded, containing collapsed stacks for
+    * flamegraph tools, and one with the extension .json, containing a Chrome trace.
+    *
+    * \param path The path of the files, without their extensions.
+    * \return Whether both files were written.
+    */
+    static bool ExportScriptProfile(const char *path) noexcept;
+
     /**
     * \brief Shut down the server.
     *
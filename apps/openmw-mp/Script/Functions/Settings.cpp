@@ -4,6 +4,7 @@
 #include <components/openmw-mp/TimedLog.hpp>
 
 #include <apps/openmw-mp/Script/ScriptFunctions.hpp>
+#include <apps/openmw-mp/CellController.hpp>
 #include <apps/openmw-mp/Networking.hpp>
 
 #include <iostream>
@@ -83,6 +84,9 @@ void SettingFunctions::SendSettings(unsigned short pid, bool sendToOtherPlayers,
     Player *player;
     GET_PLAYER(pid, player,);
 
+    // Frame time reports are only needed by automatic actor authority assignment
+    player->frameTimeReportsRequested = CellController::get()->getAutomaticAuthority();
+
     mwmp::PlayerPacket *packet = mwmp::Networking::get().getPlayerPacketController()->GetPacket(ID_GAME_SETTINGS);
     packet->setPlayer(player);
 
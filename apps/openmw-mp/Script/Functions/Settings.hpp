@@ -137,6 +137,9 @@ public:
     /**
     * \brief Send a PlayerSettings packet to the player affected by it.
     *
+    * The packet also tells the player whether to report their frame time, which is only done
+    * while automatic actor authority assignment is enabled.
+    *
     * \param pid The player ID to send it to.
     * \return void
     */
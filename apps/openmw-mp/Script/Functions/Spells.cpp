@@ -220,12 +220,14 @@ void SpellFunctions::SendSpellbookChanges(unsigned short pid, bool sendToOtherPl
     GET_PLAYER(pid, player, );
 
     mwmp::PlayerPacket *packet = mwmp::Networking::get().getPlayerPacketController()->GetPacket(ID_PLAYER_SPELLBOOK);
-    packet->setPlayer(player);
 
     if (!skipAttachedPlayer)
-        packet->Send(false);
+        player->sendSpellbookChangesToSelf(packet);
     if (sendToOtherPlayers)
+    {
+        packet->setPlayer(player);
         packet->Send(true);
+    }
 }
 
 void SpellFunctions::SendSpellsActiveChanges(unsigned short pid, bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
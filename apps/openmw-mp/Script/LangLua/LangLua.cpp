@@ -2,6 +2,7 @@
 #include "LangLua.hpp"
 #include <Script/Script.hpp>
 #include <Script/Types.hpp>
+#include <components/openmw-mp/TimedLog.hpp>
 
 std::set<std::string> LangLua::packagePath;
 std::set<std::string> LangLua::packageCPath;
@@ -21,6 +22,12 @@ void setLuaPath(lua_State* L, const char* path, bool cpath = false)
     lua_pop(L, 1);
 }
 
+int luaPanic(lua_State* L)
+{
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_FATAL, "Unprotected error in call to Lua API (%s)", lua_tostring(L, -1));
+    return 0;
+}
+
 lib_t LangLua::GetInterface()
 {
     return reinterpret_cast<lib_t>(lua);
@@ -29,11 +36,26 @@ lib_t LangLua::GetInterface()
 LangLua::LangLua(lua_State *lua)
 {
     this->lua = lua;
+    allocator = nullptr;
 }
 
 LangLua::LangLua()
 {
-    lua = luaL_newstate();
+    allocator = new LuaAllocator();
+    lua = lua_newstate(LuaAllocator::Allocate, allocator);
+
+    // 64-bit builds of LuaJIT without GC64 only work with their own allocator
+    if (lua == nullptr)
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not use a custom allocator for Lua, so its memory use "
+                           "will only be known from its own count");
+        delete allocator;
+        allocator = nullptr;
+        lua = luaL_newstate();
+    }
+    else
+        lua_atpanic(lua, luaPanic);
+
     luaL_openlibs(lua); // load all lua std libs
 
     std::string p, cp;
@@ -192,6 +214,9 @@ void LangLua::LoadProgram(const char *filename)
 int LangLua::FreeProgram()
 {
     lua_close(lua);
+
+    delete allocator;
+    allocator = nullptr;
     return 0;
 }
 
@@ -263,47 +288,71 @@ boost::any LangLua::Call(const char *name, const char *argl, const std::vector<b
     lua_getglobal(lua, name);
 
     for (int index = 0; index < n_args; index++)
-    {
-        switch (argl[index])
-        {
-            case 'i':
-                luabridge::Stack<unsigned int>::push(lua, boost::any_cast<unsigned int>(args.at(index)));
-                break;
-
-            case 'q':
-                luabridge::Stack<signed int>::push(lua, boost::any_cast<signed int>(args.at(index)));
-                break;
-
-            case 'l':
-                luabridge::Stack<unsigned long long>::push(lua, boost::any_cast<unsigned long long>(args.at(index)));
-                break;
+        PushArgument(lua, argl[index], args.at(index));
 
-            case 'w':
-                luabridge::Stack<signed long long>::push(lua, boost::any_cast<signed long long>(args.at(index)));
-                break;
-
-            case 'f':
-                luabridge::Stack<double>::push(lua, boost::any_cast<double>(args.at(index)));
-                break;
+    luabridge::LuaException::pcall(lua, n_args, 1);
+    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
+}
 
-            case 'p':
-                luabridge::Stack<void *>::push(lua, boost::any_cast<void *>(args.at(index)));
-                break;
+void LangLua::PushFunction(lua_State *lua, int &ref, const char *name)
+{
+    // Keep the name rather than the function, so reassigning the global is still picked up, with
+    // the name interned only once instead of on every call
+    if (ref == LUA_NOREF)
+    {
+        lua_pushstring(lua, name);
+        ref = luaL_ref(lua, LUA_REGISTRYINDEX);
+    }
 
-            case 's':
-                luabridge::Stack<const char *>::push(lua, boost::any_cast<const char *>(args.at(index)));
-                break;
+    lua_rawgeti(lua, LUA_REGISTRYINDEX, ref);
+#ifdef LUA_GLOBALSINDEX
+    lua_gettable(lua, LUA_GLOBALSINDEX);
+#else
+    lua_pushglobaltable(lua);
+    lua_insert(lua, -2);
+    lua_gettable(lua, -2);
+    lua_remove(lua, -2);
+#endif
+}
 
-            case 'b':
-                luabridge::Stack<bool>::push(lua, boost::any_cast<int>(args.at(index)));
-                break;
-            default:
-                throw std::runtime_error("Lua call: Unknown argument identifier " + argl[index]);
-        }
+void LangLua::PushArgument(lua_State *lua, char type, const boost::any &arg)
+{
+    switch (type)
+    {
+        case 'i':
+            luabridge::Stack<unsigned int>::push(lua, boost::any_cast<unsigned int>(arg));
+            break;
+
+        case 'q':
+            luabridge::Stack<signed int>::push(lua, boost::any_cast<signed int>(arg));
+            break;
+
+        case 'l':
+            luabridge::Stack<unsigned long long>::push(lua, boost::any_cast<unsigned long long>(arg));
+            break;
+
+        case 'w':
+            luabridge::Stack<signed long long>::push(lua, boost::any_cast<signed long long>(arg));
+            break;
+
+        case 'f':
+            luabridge::Stack<double>::push(lua, boost::any_cast<double>(arg));
+            break;
+
+        case 'p':
+            luabridge::Stack<void *>::push(lua, boost::any_cast<void *>(arg));
+            break;
+
+        case 's':
+            luabridge::Stack<const char *>::push(lua, boost::any_cast<const char *>(arg));
+            break;
+
+        case 'b':
+            luabridge::Stack<bool>::push(lua, boost::any_cast<int>(arg));
+            break;
+        default:
+            throw std::runtime_error("Lua call: Unknown argument identifier " + std::string(1, type));
     }
-
-    luabridge::LuaException::pcall(lua, n_args, 1);
-    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
 }
 
 void LangLua::AddPackagePath(const std::string& path)
@@ -315,3 +364,57 @@ void LangLua::AddPackageCPath(const std::string& path)
 {
     packageCPath.emplace(path);
 }
+
+size_t LangLua::GetMemoryUsage()
+{
+    if (allocator != nullptr)
+        return allocator->GetUsedBytes();
+
+    return (size_t) lua_gc(lua, LUA_GCCOUNT, 0) * 1024 + lua_gc(lua, LUA_GCCOUNTB, 0);
+}
+
+void LangLua::SetGCParameters(int pause, int stepMultiplier)
+{
+    lua_gc(lua, LUA_GCSETPAUSE, pause);
+    lua_gc(lua, LUA_GCSETSTEPMUL, stepMultiplier);
+}
+
+void LangLua::SetGCAutomatic(bool automatic)
+{
+    lua_gc(lua, automatic ? LUA_GCRESTART : LUA_GCSTOP, 0);
+}
+
+bool LangLua::StepGC(int kilobytes)
+{
+    return lua_gc(lua, LUA_GCSTEP, kilobytes) == 1;
+}
+
+void LangLua::CollectGarbage()
+{
+    lua_gc(lua, LUA_GCCOLLECT, 0);
+}
+
+
+static void profilerHook(lua_State *lua, lua_Debug *debug)
+{
+    ScriptProfiler::SampleLua(lua);
+}
+
+void LangLua::SetProfilerHook(int instructionCount)
+{
+    if (instructionCount > 0)
+    {
+#ifdef LUAJIT_VERSION
+        // Compiled traces never call count hooks, so everything has to run in the interpreter
+        luaJIT_setmode(lua, 0, LUAJIT_MODE_ENGINE | LUAJIT_MODE_OFF);
+#endif
+        lua_sethook(lua, profilerHook, LUA_MASKCOUNT, instructionCount);
+    }
+    else
+    {
+        lua_sethook(lua, nullptr, 0, 0);
+#ifdef LUAJIT_VERSION
+        luaJIT_setmode(lua, 0, LUAJIT_MODE_ENGINE | LUAJIT_MODE_ON);
+#endif
+    }
+}
@@ -6,10 +6,12 @@
 #include <extern/LuaBridge/LuaBridge.h>
 #include <LuaBridge.h>
 #include <set>
+#include <unordered_map>
 
 #include <boost/any.hpp>
 #include "../ScriptFunction.hpp"
 #include "../Language.hpp"
+#include "LuaAllocator.hpp"
 
 struct LuaFuctionData
 {
@@ -41,7 +43,57 @@ public:
     virtual bool IsCallbackPresent(const char *name) override;
     virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
     virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
+
+    // Call a callback without interning its name again or creating anything for its result, with
+    // the arguments pushed according to their types as known at compile time
+    template<typename... Args>
+    void CallEvent(unsigned int identity, const char *name, Args&&... args)
+    {
+        int top = lua_gettop(lua);
+
+        auto it = callbackRefs.find(identity);
+
+        if (it == callbackRefs.end())
+            it = callbackRefs.emplace(identity, LUA_NOREF).first;
+
+        PushFunction(lua, it->second, name);
+        PushArguments(std::forward<Args>(args)...);
+
+        if (lua_pcall(lua, sizeof...(Args), 0, 0) != 0)
+        {
+            luabridge::LuaException exception(lua, 0);
+            lua_settop(lua, top);
+            throw exception;
+        }
+    }
+
+    // Push a global function, keeping a registry reference to its name after the first time
+    static void PushFunction(lua_State *lua, int &ref, const char *name);
+    static void PushArgument(lua_State *lua, char type, const boost::any &arg);
+
+    virtual size_t GetMemoryUsage() override;
+    virtual void SetGCParameters(int pause, int stepMultiplier) override;
+    virtual void SetGCAutomatic(bool automatic) override;
+    virtual bool StepGC(int kilobytes) override;
+    virtual void CollectGarbage() override;
+    virtual void SetProfilerHook(int instructionCount) override;
 private:
+    void PushArguments() {}
+
+    template<typename T, typename... Args>
+    void PushArguments(T &&arg, Args&&... args)
+    {
+        typedef typename std::remove_reference<T>::type ArgType;
+        typedef typename CharType<TypeChar<ArgType, sizeof(ArgType)>::value>::type PushType;
+
+        luabridge::Stack<PushType>::push(lua, static_cast<PushType>(arg));
+        PushArguments(std::forward<Args>(args)...);
+    }
+
+    // Null if the state had to be created with Lua's own allocator
+    LuaAllocator *allocator;
+    std::unordered_map<unsigned int, int> callbackRefs;
+
     static std::set<std::string> packageCPath;
     static std::set<std::string> packagePath;
 };
@@ -0,0 +1,154 @@
+#include "LuaAllocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+size_t LuaAllocator::totalUsedBytes = 0;
+size_t LuaAllocator::peakTotalUsedBytes = 0;
+
+LuaAllocator::LuaAllocator() : blockPos(nullptr), blockEnd(nullptr), usedBytes(0)
+{
+    std::fill(freeSlots, freeSlots + sizeClassCount, nullptr);
+}
+
+LuaAllocator::~LuaAllocator()
+{
+    // Whatever the state still held when it was closed is no longer in use
+    totalUsedBytes -= usedBytes;
+
+    for (auto block : blocks)
+        std::free(block);
+}
+
+void *LuaAllocator::Allocate(void *userData, void *ptr, size_t oldSize, size_t newSize)
+{
+    LuaAllocator *allocator = static_cast<LuaAllocator*>(userData);
+
+    // Lua only passes the old size of an existing block
+    if (ptr == nullptr)
+        oldSize = 0;
+
+    void *result;
+
+    if (newSize == 0)
+    {
+        allocator->deallocate(ptr, oldSize);
+        result = nullptr;
+    }
+    else if (ptr == nullptr)
+        result = allocator->allocate(newSize);
+    else
+        result = allocator->reallocate(ptr, oldSize, newSize);
+
+    if (result != nullptr || newSize == 0)
+    {
+        allocator->usedBytes = allocator->usedBytes - oldSize + newSize;
+        totalUsedBytes = totalUsedBytes - oldSize + newSize;
+        peakTotalUsedBytes = std::max(peakTotalUsedBytes, totalUsedBytes);
+    }
+
+    return result;
+}
+
+size_t LuaAllocator::GetUsedBytes() const
+{
+    return usedBytes;
+}
+
+size_t LuaAllocator::GetPeakTotalUsedBytes()
+{
+    return peakTotalUsedBytes;
+}
+
+size_t LuaAllocator::GetPoolBytes() const
+{
+    return blocks.size() * blockSize;
+}
+
+size_t LuaAllocator::getSizeClass(size_t size)
+{
+    return (size - 1) / granularity;
+}
+
+void *LuaAllocator::allocate(size_t size)
+{
+    if (size > maxPooledSize)
+        return std::malloc(size);
+
+    size_t sizeClass = getSizeClass(size);
+    FreeSlot *slot = freeSlots[sizeClass];
+
+    if (slot != nullptr)
+    {
+        freeSlots[sizeClass] = slot->next;
+        return slot;
+    }
+
+    size_t slotSize = (sizeClass + 1) * granularity;
+
+    if (blockPos == nullptr || static_cast<size_t>(blockEnd - blockPos) < slotSize)
+    {
+        // Whatever is left of the previous block is too small for this slot, so hand it out as
+        // slots of the largest size class that still fits instead of letting it go to waste
+        while (blockPos != nullptr && static_cast<size_t>(blockEnd - blockPos) >= granularity)
+        {
+            size_t leftoverClass = getSizeClass(static_cast<size_t>(blockEnd - blockPos) / granularity * granularity);
+            FreeSlot *leftover = reinterpret_cast<FreeSlot*>(blockPos);
+            leftover->next = freeSlots[leftoverClass];
+            freeSlots[leftoverClass] = leftover;
+            blockPos += (leftoverClass + 1) * granularity;
+        }
+
+        char *block = static_cast<char*>(std::malloc(blockSize));
+
+        if (block == nullptr)
+            return nullptr;
+
+        blocks.push_back(block);
+        blockPos = block;
+        blockEnd = block + blockSize;
+    }
+
+    void *result = blockPos;
+    blockPos += slotSize;
+    return result;
+}
+
+void LuaAllocator::deallocate(void *ptr, size_t size)
+{
+    if (ptr == nullptr)
+        return;
+
+    if (size > maxPooledSize)
+    {
+        std::free(ptr);
+        return;
+    }
+
+    size_t sizeClass = getSizeClass(size);
+    FreeSlot *slot = static_cast<FreeSlot*>(ptr);
+    slot->next = freeSlots[sizeClass];
+    freeSlots[sizeClass] = slot;
+}
+
+void *LuaAllocator::reallocate(void *ptr, size_t oldSize, size_t newSize)
+{
+    bool wasPooled = oldSize <= maxPooledSize;
+    bool isPooled = newSize <= maxPooledSize;
+
+    if (!wasPooled && !isPooled)
+        return std::realloc(ptr, newSize);
+
+    if (wasPooled && isPooled && getSizeClass(oldSize) == getSizeClass(newSize))
+        return ptr;
+
+    void *result = allocate(newSize);
+
+    if (result == nullptr)
+        return nullptr;
+
+    std::memcpy(result, ptr, std::min(oldSize, newSize));
+    deallocate(ptr, oldSize);
+    return result;
+}
@@ -0,0 +1,61 @@
+#ifndef OPENMW_LUAALLOCATOR_HPP
+#define OPENMW_LUAALLOCATOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+/*
+    Allocator for a single Lua state, passed to lua_newstate()
+
+    Small allocations, which make up most of what Lua allocates for its strings, tables and
+    closures, are served from free lists of fixed size slots carved out of larger blocks, so
+    creating and collecting them doesn't go through malloc and free every time. Anything larger
+    goes through the regular allocator
+
+    The server runs all of its Lua states on the main thread, so nothing here is synchronized
+*/
+class LuaAllocator
+{
+public:
+    LuaAllocator();
+    ~LuaAllocator();
+
+    static void *Allocate(void *userData, void *ptr, size_t oldSize, size_t newSize);
+
+    // The number of bytes currently requested by Lua, which is what the state is holding on to
+    size_t GetUsedBytes() const;
+    // The highest number of bytes requested by all Lua states together at any one time, which is
+    // lower than the sum of their own highest numbers because they don't all peak at once
+    static size_t GetPeakTotalUsedBytes();
+    // The number of bytes taken from the system for the pools, whether their slots are in use or not
+    size_t GetPoolBytes() const;
+
+private:
+    static const size_t granularity = 16;
+    static const size_t maxPooledSize = 256;
+    static const size_t sizeClassCount = maxPooledSize / granularity;
+    static const size_t blockSize = 64 * 1024;
+
+    struct FreeSlot
+    {
+        FreeSlot *next;
+    };
+
+    static size_t getSizeClass(size_t size);
+
+    void *allocate(size_t size);
+    void deallocate(void *ptr, size_t size);
+    void *reallocate(void *ptr, size_t oldSize, size_t newSize);
+
+    FreeSlot *freeSlots[sizeClassCount];
+    std::vector<char*> blocks;
+    char *blockPos;
+    char *blockEnd;
+
+    size_t usedBytes;
+
+    static size_t totalUsedBytes;
+    static size_t peakTotalUsedBytes;
+};
+
+#endif //OPENMW_LUAALLOCATOR_HPP
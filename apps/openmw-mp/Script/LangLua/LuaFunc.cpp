@@ -76,6 +76,10 @@ int LangLua::CallPublic(lua_State *lua)
 
     int args_n = lua_gettop(lua) - 1;
 
+    // Arguments for other Lua publics don't need to be converted into a list first
+    if (Public::IsLua(name))
+        return Public::CallFromLua(name, lua, 2, args_n);
+
     std::string types = Public::GetDefinition(name);
 
     if (args_n  != (long)types.size())
@@ -18,6 +18,15 @@ public:
 
     virtual lib_t GetInterface() = 0;
 
+    // Memory use and garbage collection, for languages that have a garbage collector
+    virtual size_t GetMemoryUsage() { return 0; }
+    virtual void SetGCParameters(int pause, int stepMultiplier) {}
+    virtual void SetGCAutomatic(bool automatic) {}
+    virtual bool StepGC(int kilobytes) { return false; }
+    virtual void CollectGarbage() {}
+    // Sample the script every instructionCount instructions for the ScriptProfiler, or stop if it's 0
+    virtual void SetProfilerHook(int instructionCount) {}
+
 };
 
 
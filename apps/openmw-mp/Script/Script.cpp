@@ -1,4 +1,7 @@
 #include "Script.hpp"
+
+#include <algorithm>
+
 #include "LangNative/LangNative.hpp"
 
 #if defined (ENABLE_LUA)
@@ -100,3 +103,63 @@ const char* Script::GetModDir()
 {
     return moddir.c_str();
 }
+
+size_t Script::GetMemoryUsage()
+{
+    size_t usage = 0;
+
+    for (auto &script : scripts)
+        usage += script->lang->GetMemoryUsage();
+
+    return usage;
+}
+
+size_t Script::GetPeakMemoryUsage()
+{
+    // Scripts don't all peak at once, so this is one high-water mark for all of them together,
+    // and the current use for Lua states that had to be created without the pooled allocator
+    size_t usage = GetMemoryUsage();
+
+#if defined (ENABLE_LUA)
+    usage = std::max(usage, LuaAllocator::GetPeakTotalUsedBytes());
+#endif
+
+    return usage;
+}
+
+void Script::SetGCParameters(int pause, int stepMultiplier)
+{
+    for (auto &script : scripts)
+        script->lang->SetGCParameters(pause, stepMultiplier);
+}
+
+void Script::SetGCAutomatic(bool automatic)
+{
+    for (auto &script : scripts)
+        script->lang->SetGCAutomatic(automatic);
+}
+
+bool Script::StepGC(int kilobytes)
+{
+    bool hasFinishedCycle = false;
+
+    for (auto &script : scripts)
+    {
+        if (script->lang->StepGC(kilobytes))
+            hasFinishedCycle = true;
+    }
+
+    return hasFinishedCycle;
+}
+
+void Script::CollectGarbage()
+{
+    for (auto &script : scripts)
+        script->lang->CollectGarbage();
+}
+
+void Script::SetProfilerHooks(int instructionCount)
+{
+    for (auto &script : scripts)
+        script->lang->SetProfilerHook(instructionCount);
+}
@@ -10,6 +10,7 @@
 #include "ScriptFunction.hpp"
 #include "ScriptFunctions.hpp"
 #include "Language.hpp"
+#include "ScriptProfiler.hpp"
 
 #include "Networking.hpp"
 
@@ -61,6 +62,15 @@ public:
     static void SetModDir(const std::string &moddir);
     static const char* GetModDir();
 
+    // Memory use and garbage collection, across all loaded scripts
+    static size_t GetMemoryUsage();
+    static size_t GetPeakMemoryUsage();
+    static void SetGCParameters(int pause, int stepMultiplier);
+    static void SetGCAutomatic(bool automatic);
+    static bool StepGC(int kilobytes);
+    static void CollectGarbage();
+    static void SetProfilerHooks(int instructionCount);
+
     static constexpr ScriptCallbackData const& CallBackData(const unsigned int I, const unsigned int N = 0) {
         return callbacks[N].index == I ? callbacks[N] : CallBackData(I, N + 1);
     }
@@ -77,6 +87,8 @@ public:
         static_assert(data.callback.matches(TypeString<typename std::remove_reference<Args>::type...>::value),
                       "Wrong number or types of arguments");
 
+        ScriptProfiler::Scope profilerScope(data.name, ScriptProfiler::SCOPE_CALLBACK);
+
         unsigned int count = 0;
 
         for (auto& script : scripts)
@@ -96,7 +108,7 @@ public:
             {
                 try
                 {
-                    script->lang->Call(data.name, data.callback.types, B, std::forward<Args>(args)...);
+                    static_cast<LangLua*>(script->lang)->CallEvent(I, data.name, std::forward<Args>(args)...);
                 }
                 catch (std::exception &e)
                 {
@@ -13,7 +13,7 @@ ScriptFunction::ScriptFunction(ScriptFunc fCpp,char ret_type, const std::string
 }
 #if defined (ENABLE_LUA)
 ScriptFunction::ScriptFunction(const ScriptFuncLua &fLua, lua_State *lua, char ret_type, const std::string &def) :
-        fLua({lua, fLua}), ret_type(ret_type), def(def), script_type(SCRIPT_LUA)
+        fLua({lua, fLua, LUA_NOREF}), ret_type(ret_type), def(def), script_type(SCRIPT_LUA)
 {
 
 }
@@ -24,7 +24,12 @@ ScriptFunction::~ScriptFunction()
 {
 #if defined (ENABLE_LUA)
     if (script_type == SCRIPT_LUA)
+    {
+        if (fLua.ref != LUA_NOREF)
+            luaL_unref(fLua.lua, LUA_REGISTRYINDEX, fLua.ref);
+
         fLua.name.~ScriptFuncLua();
+    }
 #endif
 }
 
@@ -37,33 +42,125 @@ boost::any ScriptFunction::Call(const std::vector<boost::any> &args)
 #if defined (ENABLE_LUA)
     else if (script_type == SCRIPT_LUA)
     {
-        LangLua langLua(fLua.lua);
-        boost::any any = langLua.Call(fLua.name.c_str(), def.c_str(), args);
+        lua_State *lua = fLua.lua;
+        int top = lua_gettop(lua);
+
+        LangLua::PushFunction(lua, fLua.ref, fLua.name.c_str());
+
+        for (size_t i = 0; i < args.size(); i++)
+            LangLua::PushArgument(lua, def[i], args[i]);
+
+        if (lua_pcall(lua, (int) args.size(), ret_type == 'v' ? 0 : 1, 0) != 0)
+        {
+            luabridge::LuaException exception(lua, 0);
+            lua_settop(lua, top);
+            throw exception;
+        }
 
         switch (ret_type)
         {
             case 'i':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<unsigned int>();
+                result = luabridge::Stack<unsigned int>::get(lua, -1);
                 break;
             case 'q':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<signed int>();
+                result = luabridge::Stack<signed int>::get(lua, -1);
                 break;
             case 'f':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<double>();
+                result = luabridge::Stack<double>::get(lua, -1);
                 break;
             case 's':
-                result = boost::any_cast<luabridge::LuaRef>(any).cast<const char*>();
+                result = luabridge::Stack<const char*>::get(lua, -1);
                 break;
             case 'v':
-                result = boost::any();
                 break;
             default:
-                throw std::runtime_error("Lua call: Unknown return type" + ret_type);
+                lua_settop(lua, top);
+                throw std::runtime_error("Lua call: Unknown return type " + std::string(1, ret_type));
         }
 
-        lua_settop(fLua.lua, 0);
+        lua_settop(lua, top);
     }
 #endif
 
     return result;
 }
+
+#if defined (ENABLE_LUA)
+int ScriptFunction::CallFromLua(lua_State *caller, int firstArg)
+{
+    // Only types that are held the same way on both stacks can be moved between them, so reject
+    // anything else before either stack is touched
+    std::string::size_type unsupported = def.find_first_not_of("iqfsb");
+
+    if (unsupported != std::string::npos)
+        throw std::invalid_argument("Lua call: Argument type " + std::string(1, def[unsupported]) +
+            " is not supported in calls between Lua publics");
+
+    if (std::string("viqfs").find(ret_type) == std::string::npos)
+        throw std::invalid_argument("Lua call: Return type " + std::string(1, ret_type) +
+            " is not supported in calls between Lua publics");
+
+    lua_State *lua = fLua.lua;
+    int top = lua_gettop(lua);
+
+    LangLua::PushFunction(lua, fLua.ref, fLua.name.c_str());
+
+    for (size_t i = 0; i < def.length(); i++)
+    {
+        int index = firstArg + (int) i;
+
+        switch (def[i])
+        {
+            case 'i':
+                luabridge::Stack<unsigned int>::push(lua, luabridge::Stack<unsigned int>::get(caller, index));
+                break;
+            case 'q':
+                luabridge::Stack<signed int>::push(lua, luabridge::Stack<signed int>::get(caller, index));
+                break;
+            case 'f':
+                luabridge::Stack<double>::push(lua, luabridge::Stack<double>::get(caller, index));
+                break;
+            case 's':
+                luabridge::Stack<const char*>::push(lua, luabridge::Stack<const char*>::get(caller, index));
+                break;
+            case 'b':
+                luabridge::Stack<bool>::push(lua, luabridge::Stack<bool>::get(caller, index));
+                break;
+        }
+    }
+
+    if (lua_pcall(lua, (int) def.length(), ret_type == 'v' ? 0 : 1, 0) != 0)
+    {
+        luabridge::LuaException exception(lua, 0);
+        lua_settop(lua, top);
+        throw exception;
+    }
+
+    if (ret_type == 'v')
+        return 0;
+
+    switch (ret_type)
+    {
+        case 'i':
+            luabridge::Stack<unsigned int>::push(caller, luabridge::Stack<unsigned int>::get(lua, top + 1));
+            break;
+        case 'q':
+            luabridge::Stack<signed int>::push(caller, luabridge::Stack<signed int>::get(lua, top + 1));
+            break;
+        case 'f':
+            luabridge::Stack<double>::push(caller, luabridge::Stack<double>::get(lua, top + 1));
+            break;
+        case 's':
+            luabridge::Stack<const char*>::push(caller, luabridge::Stack<const char*>::get(lua, top + 1));
+            break;
+    }
+
+    // With both ends on the same stack, the copy of the result sits right above the original
+    if (caller == lua)
+        lua_remove(lua, top + 1);
+    else
+        lua_settop(lua, top);
+
+    return 1;
+}
+#endif
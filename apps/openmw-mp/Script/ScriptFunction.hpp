@@ -24,6 +24,7 @@ protected:
         {
             lua_State *lua;
             ScriptFuncLua name;
+            int ref;
         } fLua;
 #endif
     };
@@ -45,6 +46,11 @@ protected:
     virtual ~ScriptFunction();
 
     boost::any Call(const std::vector<boost::any> &args);
+#if defined (ENABLE_LUA)
+    // Call a Lua function with its arguments taken straight from a Lua stack, which can belong to
+    // the same state, and push its result onto that stack, returning the number of values pushed
+    int CallFromLua(lua_State *caller, int firstArg);
+#endif
 };
 
 #endif //SCRIPTFUNCTION_HPP
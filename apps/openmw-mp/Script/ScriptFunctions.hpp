@@ -210,6 +210,7 @@ public:
             {"OnActorSpellsActive",      Callback<unsigned short, const char*>()},
             {"OnActorCellChange",        Callback<unsigned short, const char*>()},
             {"OnActorTest",              Callback<unsigned short, const char*>()},
+            {"OnActorAuthorityChange",   Callback<unsigned short, const char*>()},
             {"OnPlayerSendMessage",      Callback<unsigned short, const char*>()},
             {"OnPlayerEndCharGen",       Callback<unsigned short>()},
             {"OnGUIAction",              Callback<unsigned short, int, const char*>()},
@@ -0,0 +1,314 @@
+#include "ScriptProfiler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <components/openmw-mp/TimedLog.hpp>
+
+#include "Script.hpp"
+
+namespace
+{
+    // Keep a long profiling session from eating up all the memory with trace events
+    const size_t maxTraceEvents = 1000000;
+    const int defaultInstructionCount = 1000;
+
+    std::string escapeJson(const std::string &text)
+    {
+        std::string result;
+        result.reserve(text.size());
+
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                result += '\\';
+                result += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+                result += ' ';
+            else
+                result += c;
+        }
+
+        return result;
+    }
+
+#if defined (ENABLE_LUA)
+    std::string describeFrame(lua_State *lua, lua_Debug &debug)
+    {
+        lua_getinfo(lua, "Sn", &debug);
+
+        std::string frame = debug.name != nullptr ? debug.name : "?";
+
+        if (debug.what != nullptr && debug.what[0] == 'C')
+            return frame + " [C]";
+
+        frame += " (";
+        frame += debug.short_src;
+        frame += ":" + std::to_string(debug.linedefined) + ")";
+
+        // Semicolons separate frames in collapsed stacks
+        std::replace(frame.begin(), frame.end(), ';', ',');
+        return frame;
+    }
+#endif
+}
+
+bool ScriptProfiler::running = false;
+ScriptProfiler::Clock::time_point ScriptProfiler::startTime;
+ScriptProfiler::Clock::time_point ScriptProfiler::lastSampleTime;
+std::vector<ScriptProfiler::OpenScope> ScriptProfiler::openScopes;
+std::unordered_map<std::string, ScriptProfiler::CallbackStats> ScriptProfiler::callbackStats;
+std::unordered_map<std::string, ScriptProfiler::FunctionStats> ScriptProfiler::functionStats;
+std::unordered_map<std::string, double> ScriptProfiler::collapsedStacks;
+std::vector<ScriptProfiler::TraceEvent> ScriptProfiler::traceEvents;
+unsigned long long ScriptProfiler::droppedTraceEvents = 0;
+
+void ScriptProfiler::Start(int instructionCount)
+{
+    if (instructionCount <= 0)
+        instructionCount = defaultInstructionCount;
+
+    openScopes.clear();
+    callbackStats.clear();
+    functionStats.clear();
+    collapsedStacks.clear();
+    traceEvents.clear();
+    droppedTraceEvents = 0;
+
+    startTime = Clock::now();
+    lastSampleTime = startTime;
+    running = true;
+
+    Script::SetProfilerHooks(instructionCount);
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Script profiler started, sampling Lua every %i instructions", instructionCount);
+}
+
+void ScriptProfiler::Stop()
+{
+    if (!running)
+        return;
+
+    running = false;
+    openScopes.clear();
+
+    Script::SetProfilerHooks(0);
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Script profiler stopped");
+}
+
+bool ScriptProfiler::Export(const std::string &path)
+{
+    std::ofstream folded(path + ".folded");
+
+    if (!folded.is_open())
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Could not write script profile to %s.folded", path.c_str());
+        return false;
+    }
+
+    for (auto &&stack : collapsedStacks)
+        folded << stack.first << " " << static_cast<unsigned long long>(stack.second + 0.5) << "\n";
+
+    std::ofstream trace(path + ".json");
+
+    if (!trace.is_open())
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Could not write script profile to %s.json", path.c_str());
+        return false;
+    }
+
+    trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool isFirst = true;
+
+    for (auto &&event : traceEvents)
+    {
+        if (!isFirst)
+            trace << ",";
+        isFirst = false;
+
+        trace << "\n{\"name\":\"" << escapeJson(event.name) << "\",\"cat\":\"" << event.category
+              << "\",\"pid\":1,\"tid\":1,\"ts\":" << event.timestamp;
+
+        if (event.isInstant)
+            trace << ",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"stack\":\"" << escapeJson(event.stack) << "\"}}";
+        else
+            trace << ",\"ph\":\"X\",\"dur\":" << event.duration << "}";
+    }
+
+    trace << "\n]}\n";
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Wrote script profile to %s.folded and %s.json", path.c_str(), path.c_str());
+
+    if (droppedTraceEvents > 0)
+        LOG_APPEND(TimedLog::LOG_WARN, "- %llu trace events were left out after reaching the limit of %zu",
+                   droppedTraceEvents, maxTraceEvents);
+
+    return true;
+}
+
+void ScriptProfiler::LogSummary()
+{
+    typedef std::pair<std::string, CallbackStats> CallbackEntry;
+    typedef std::pair<std::string, FunctionStats> FunctionEntry;
+
+    std::vector<CallbackEntry> callbacks(callbackStats.begin(), callbackStats.end());
+    std::sort(callbacks.begin(), callbacks.end(), [](const CallbackEntry &a, const CallbackEntry &b) {
+        return a.second.totalMicroseconds > b.second.totalMicroseconds;
+    });
+
+    std::vector<FunctionEntry> functions(functionStats.begin(), functionStats.end());
+    std::sort(functions.begin(), functions.end(), [](const FunctionEntry &a, const FunctionEntry &b) {
+        return a.second.selfMicroseconds > b.second.selfMicroseconds;
+    });
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Script profile, callbacks by total time:");
+
+    for (size_t i = 0; i < callbacks.size() && i < 10; ++i)
+    {
+        const CallbackStats &stats = callbacks[i].second;
+        LOG_APPEND(TimedLog::LOG_INFO, "- %s: %llu calls, %.3f ms total, %.3f ms average, %.3f ms max",
+                   callbacks[i].first.c_str(), stats.calls, stats.totalMicroseconds / 1000,
+                   stats.totalMicroseconds / 1000 / stats.calls, stats.maxMicroseconds / 1000);
+    }
+
+    LOG_APPEND(TimedLog::LOG_INFO, "Lua functions by self time:");
+
+    for (size_t i = 0; i < functions.size() && i < 10; ++i)
+    {
+        const FunctionStats &stats = functions[i].second;
+        LOG_APPEND(TimedLog::LOG_INFO, "- %s: %.3f ms self, %.3f ms total, %llu samples",
+                   functions[i].first.c_str(), stats.selfMicroseconds / 1000, stats.totalMicroseconds / 1000,
+                   stats.samples);
+    }
+}
+
+bool ScriptProfiler::HandleCommand(const std::string &command)
+{
+    std::istringstream stream(command);
+    std::string word, action, argument, rest;
+
+    stream >> word >> action >> argument >> rest;
+
+    // Leave anything that isn't exactly one of the profiler's commands to the scripts
+    if (word != "profiler" || !rest.empty())
+        return false;
+
+    if (action == "start")
+    {
+        if (argument.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+
+        Start(argument.empty() ? defaultInstructionCount : atoi(argument.c_str()));
+    }
+    else if (action == "stop")
+    {
+        Stop();
+        LogSummary();
+        Export(argument.empty() ? "script-profile-" + TimedLog::getFilenameTimestamp() : argument);
+    }
+    else if (action == "summary" && argument.empty())
+        LogSummary();
+    else
+        return false;
+
+    return true;
+}
+
+#if defined (ENABLE_LUA)
+void ScriptProfiler::SampleLua(lua_State *lua)
+{
+    if (!running)
+        return;
+
+    Clock::time_point now = Clock::now();
+    double elapsed = std::chrono::duration<double, std::micro>(now - lastSampleTime).count();
+    lastSampleTime = now;
+
+    std::vector<std::string> frames;
+    lua_Debug debug;
+
+    for (int level = 0; lua_getstack(lua, level, &debug) != 0; ++level)
+        frames.push_back(describeFrame(lua, debug));
+
+    if (frames.empty())
+        return;
+
+    std::string stack = openScopes.empty() ? "(outside callbacks)" : openScopes.front().name;
+
+    for (auto it = frames.rbegin(); it != frames.rend(); ++it)
+    {
+        stack += ";";
+        stack += *it;
+    }
+
+    collapsedStacks[stack] += elapsed;
+
+    FunctionStats &leafStats = functionStats[frames.front()];
+    leafStats.samples++;
+    leafStats.selfMicroseconds += elapsed;
+
+    // Count recursive functions only once towards their total time
+    std::sort(frames.begin(), frames.end());
+    frames.erase(std::unique(frames.begin(), frames.end()), frames.end());
+
+    for (auto &&frame : frames)
+        functionStats[frame].totalMicroseconds += elapsed;
+
+    addTraceEvent({frames.size() == 1 ? frames.front() : stack.substr(stack.rfind(';') + 1), "sample", true,
+                   getTimestamp(now), 0, stack});
+}
+#endif
+
+void ScriptProfiler::enterScope(const char *name, ScopeType type)
+{
+    Clock::time_point now = Clock::now();
+
+    // Time between callbacks doesn't belong to whichever Lua function gets sampled next
+    if (openScopes.empty())
+        lastSampleTime = now;
+
+    openScopes.push_back({type == SCOPE_TIMER ? std::string("timer: ") + name : std::string(name), now});
+}
+
+void ScriptProfiler::leaveScope()
+{
+    // The profiler can be stopped or restarted from within a callback
+    if (openScopes.empty())
+        return;
+
+    Clock::time_point now = Clock::now();
+    OpenScope &scope = openScopes.back();
+    double elapsed = std::chrono::duration<double, std::micro>(now - scope.startTime).count();
+
+    CallbackStats &stats = callbackStats[scope.name];
+    stats.calls++;
+    stats.totalMicroseconds += elapsed;
+    stats.maxMicroseconds = std::max(stats.maxMicroseconds, elapsed);
+
+    addTraceEvent({scope.name, scope.name.compare(0, 7, "timer: ") == 0 ? "timer" : "callback", false,
+                   getTimestamp(scope.startTime), static_cast<long long>(elapsed), std::string()});
+
+    openScopes.pop_back();
+}
+
+void ScriptProfiler::addTraceEvent(TraceEvent &&event)
+{
+    if (traceEvents.size() >= maxTraceEvents)
+    {
+        droppedTraceEvents++;
+        return;
+    }
+
+    traceEvents.push_back(std::move(event));
+}
+
+long long ScriptProfiler::getTimestamp(Clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - startTime).count();
+}
@@ -0,0 +1,125 @@
+#ifndef OPENMW_SCRIPTPROFILER_HPP
+#define OPENMW_SCRIPTPROFILER_HPP
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined (ENABLE_LUA)
+#include "lua.hpp"
+#endif
+
+/*
+    Measures the wall time of every script callback and timer while it's running, and samples
+    the stacks of Lua scripts every given number of instructions, attributing the time since the
+    previous sample to the functions on the stack
+
+    Everything it gathers can be exported as collapsed stacks, for flamegraph tools, and as a
+    Chrome trace, for chrome://tracing and similar viewers
+
+    When it isn't running, the only cost is a check of whether it is
+*/
+class ScriptProfiler
+{
+public:
+    enum ScopeType
+    {
+        SCOPE_CALLBACK = 0,
+        SCOPE_TIMER
+    };
+
+    class Scope
+    {
+    public:
+        Scope(const char *name, ScopeType type) : isActive(running)
+        {
+            if (isActive)
+                enterScope(name, type);
+        }
+
+        ~Scope()
+        {
+            if (isActive)
+                leaveScope();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool isActive;
+    };
+
+    static bool IsRunning()
+    {
+        return running;
+    }
+
+    // Start profiling from scratch, sampling Lua stacks every instructionCount instructions
+    static void Start(int instructionCount);
+    static void Stop();
+
+    // Write path.folded and path.json, returning false if either couldn't be written
+    static bool Export(const std::string &path);
+    static void LogSummary();
+
+    // Handle "profiler start [instructions]", "profiler stop [path]" or "profiler summary" typed into
+    // the server window, returning false for anything else so it can be passed on to scripts
+    static bool HandleCommand(const std::string &command);
+
+#if defined (ENABLE_LUA)
+    static void SampleLua(lua_State *lua);
+#endif
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct OpenScope
+    {
+        std::string name;
+        Clock::time_point startTime;
+    };
+
+    struct CallbackStats
+    {
+        unsigned long long calls;
+        double totalMicroseconds;
+        double maxMicroseconds;
+    };
+
+    struct FunctionStats
+    {
+        unsigned long long samples;
+        double selfMicroseconds;
+        double totalMicroseconds;
+    };
+
+    struct TraceEvent
+    {
+        std::string name;
+        const char *category;
+        bool isInstant;
+        long long timestamp;
+        long long duration;
+        std::string stack;
+    };
+
+    static void enterScope(const char *name, ScopeType type);
+    static void leaveScope();
+    static void addTraceEvent(TraceEvent &&event);
+    static long long getTimestamp(Clock::time_point time);
+
+    static bool running;
+    static Clock::time_point startTime;
+    static Clock::time_point lastSampleTime;
+
+    static std::vector<OpenScope> openScopes;
+    static std::unordered_map<std::string, CallbackStats> callbackStats;
+    static std::unordered_map<std::string, FunctionStats> functionStats;
+    static std::unordered_map<std::string, double> collapsedStacks;
+    static std::vector<TraceEvent> traceEvents;
+    static unsigned long long droppedTraceEvents;
+};
+
+#endif //OPENMW_SCRIPTPROFILER_HPP
@@ -188,6 +188,16 @@ int main(int argc, char *argv[])
 
     LOG_INIT(logLevel);
 
+    if (mgr.getBool("asyncLogging", "General"))
+    {
+        int overflowPolicy = mgr.getInt("asyncLogOverflowPolicy", "General");
+        if (overflowPolicy != TimedLog::OVERFLOW_BLOCK)
+            overflowPolicy = TimedLog::OVERFLOW_DROP;
+
+        TimedLog::EnableAsync((unsigned) std::max(mgr.getInt("asyncLogCapacity", "General"), 2),
+            (TimedLog::OverflowPolicy) overflowPolicy);
+    }
+
     int players = mgr.getInt("maximumPlayers", "General");
     std::string address = mgr.getString("localAddress", "General");
     int port = mgr.getInt("port", "General");
@@ -268,6 +278,15 @@ int main(int argc, char *argv[])
         Networking networking(peer);
         networking.setServerPassword(password);
 
+        networking.getOutgoingScheduler()->setBudget((unsigned) std::max(mgr.getInt("outgoingBudget", "Network"), 0));
+        networking.getOutgoingScheduler()->setDistanceScale(mgr.getFloat("priorityDistanceScale", "Network"));
+        networking.getPacketDecoder()->setWorkerCount((unsigned) std::max(mgr.getInt("decodeThreads", "Network"), 0));
+
+        CellController::get()->setAutomaticAuthority(mgr.getBool("automaticAssignment", "Authority"));
+        CellController::get()->setAuthorityTuning(mgr.getInt("rebalanceInterval", "Authority"),
+            mgr.getInt("minimumHoldTime", "Authority"), mgr.getFloat("hysteresis", "Authority"),
+            mgr.getFloat("frameTimeWeight", "Authority"), mgr.getFloat("actorWeight", "Authority"));
+
         if (mgr.getBool("enabled", "MasterServer"))
         {
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sharing server query info to master enabled.");
@@ -11,12 +11,17 @@ void ActorProcessor::Do(ActorPacket &packet, Player &player, BaseActorList &acto
     packet.Send(true);
 }
 
-bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept
+bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList, BaseActorList *decodedActorList) noexcept
 {
-    // Clear our BaseActorList before loading new data in it
-    actorList.cell.blank();
-    actorList.baseActors.clear();
-    actorList.guid = packet.guid;
+    if (decodedActorList != nullptr)
+        actorList = std::move(*decodedActorList);
+    else
+    {
+        // Clear our BaseActorList before loading new data in it
+        actorList.cell.blank();
+        actorList.baseActors.clear();
+        actorList.guid = packet.guid;
+    }
 
     for (auto &processor : processors)
     {
@@ -26,10 +31,14 @@ bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) n
             ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
 
             myPacket->setActorList(&actorList);
-            actorList.isValid = true;
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+            if (decodedActorList == nullptr)
+            {
+                actorList.isValid = true;
+
+                if (!processor.second->avoidReading)
+                    myPacket->Read();
+            }
 
             if (actorList.isValid)
                 processor.second->Do(*myPacket, *player, actorList);
@@ -41,3 +50,9 @@ bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) n
     }
     return false;
 }
+
+bool ActorProcessor::IsDecodable(unsigned char packetID) noexcept
+{
+    auto it = processors.find(packetID);
+    return it != processors.end() && !it->second->avoidReading;
+}
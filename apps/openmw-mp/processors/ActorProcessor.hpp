@@ -17,7 +17,10 @@ namespace mwmp
 
         virtual void Do(ActorPacket &packet, Player &player, BaseActorList &actorList);
 
-        static bool Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept;
+        // Process a packet, reading it into actorList unless it was already read into decodedActorList
+        static bool Process(RakNet::Packet &packet, BaseActorList &actorList, BaseActorList *decodedActorList = nullptr) noexcept;
+        // Whether a packet can be read ahead of being processed, away from the main thread
+        static bool IsDecodable(unsigned char packetID) noexcept;
     };
 }
 
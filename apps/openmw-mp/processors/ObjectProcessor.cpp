@@ -1,5 +1,6 @@
 #include "ObjectProcessor.hpp"
 #include "Networking.hpp"
+#include "CellController.hpp"
 
 using namespace mwmp;
 
@@ -9,14 +10,20 @@ typename BasePacketProcessor<T>::processors_t BasePacketProcessor<T>::processors
 void ObjectProcessor::Do(ObjectPacket &packet, Player &player, BaseObjectList &objectList)
 {
     packet.Send(true);
+    CellController::get()->recordObjectList(packet.GetPacketID(), objectList);
 }
 
-bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
+bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList, BaseObjectList *decodedObjectList) noexcept
 {
-    // Clear our BaseObjectList before loading new data in it
-    objectList.cell.blank();
-    objectList.baseObjects.clear();
-    objectList.guid = packet.guid;
+    if (decodedObjectList != nullptr)
+        objectList = std::move(*decodedObjectList);
+    else
+    {
+        // Clear our BaseObjectList before loading new data in it
+        objectList.cell.blank();
+        objectList.baseObjects.clear();
+        objectList.guid = packet.guid;
+    }
 
     for (auto &processor : processors)
     {
@@ -26,10 +33,14 @@ bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList
             ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
 
             myPacket->setObjectList(&objectList);
-            objectList.isValid = true;
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+            if (decodedObjectList == nullptr)
+            {
+                objectList.isValid = true;
+
+                if (!processor.second->avoidReading)
+                    myPacket->Read();
+            }
 
             if (objectList.isValid)
                 processor.second->Do(*myPacket, *player, objectList);
@@ -41,3 +52,9 @@ bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList
     }
     return false;
 }
+
+bool ObjectProcessor::IsDecodable(unsigned char packetID) noexcept
+{
+    auto it = processors.find(packetID);
+    return it != processors.end() && !it->second->avoidReading;
+}
@@ -17,7 +17,10 @@ namespace mwmp
 
         virtual void Do(ObjectPacket &packet, Player &player, BaseObjectList &objectList);
 
-        static bool Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept;
+        // Process a packet, reading it into objectList unless it was already read into decodedObjectList
+        static bool Process(RakNet::Packet &packet, BaseObjectList &objectList, BaseObjectList *decodedObjectList = nullptr) noexcept;
+        // Whether a packet can be read ahead of being processed, away from the main thread
+        static bool IsDecodable(unsigned char packetID) noexcept;
     };
 }
 
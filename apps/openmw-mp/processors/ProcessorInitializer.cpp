@@ -51,6 +51,7 @@
 #include "actor/ProcessorActorCellChange.hpp"
 #include "actor/ProcessorActorDeath.hpp"
 #include "actor/ProcessorActorEquipment.hpp"
+#include "actor/ProcessorActorFrame.hpp"
 #include "actor/ProcessorActorPosition.hpp"
 #include "actor/ProcessorActorSpeech.hpp"
 #include "actor/ProcessorActorSpellsActive.hpp"
@@ -136,6 +137,7 @@ void ProcessorInitializer()
     ActorProcessor::AddProcessor(new ProcessorActorCellChange());
     ActorProcessor::AddProcessor(new ProcessorActorDeath());
     ActorProcessor::AddProcessor(new ProcessorActorEquipment());
+    ActorProcessor::AddProcessor(new ProcessorActorFrame());
     ActorProcessor::AddProcessor(new ProcessorActorPosition());
     ActorProcessor::AddProcessor(new ProcessorActorSpeech());
     ActorProcessor::AddProcessor(new ProcessorActorSpellsActive());
@@ -11,9 +11,12 @@ void WorldstateProcessor::Do(WorldstatePacket &packet, Player &player, BaseWorld
     packet.Send(true);
 }
 
-bool WorldstateProcessor::Process(RakNet::Packet &packet, BaseWorldstate &worldstate) noexcept
+bool WorldstateProcessor::Process(RakNet::Packet &packet, BaseWorldstate &worldstate, BaseWorldstate *decodedWorldstate) noexcept
 {
-    worldstate.guid = packet.guid;
+    if (decodedWorldstate != nullptr)
+        worldstate = std::move(*decodedWorldstate);
+    else
+        worldstate.guid = packet.guid;
 
     for (auto &processor : processors)
     {
@@ -23,10 +26,14 @@ bool WorldstateProcessor::Process(RakNet::Packet &packet, BaseWorldstate &worlds
             WorldstatePacket *myPacket = Networking::get().getWorldstatePacketController()->GetPacket(packet.data[0]);
 
             myPacket->setWorldstate(&worldstate);
-            worldstate.isValid = true;
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+            if (decodedWorldstate == nullptr)
+            {
+                worldstate.isValid = true;
+
+                if (!processor.second->avoidReading)
+                    myPacket->Read();
+            }
 
             if (worldstate.isValid)
                 processor.second->Do(*myPacket, *player, worldstate);
@@ -38,3 +45,9 @@ bool WorldstateProcessor::Process(RakNet::Packet &packet, BaseWorldstate &worlds
     }
     return false;
 }
+
+bool WorldstateProcessor::IsDecodable(unsigned char packetID) noexcept
+{
+    auto it = processors.find(packetID);
+    return it != processors.end() && !it->second->avoidReading;
+}
@@ -15,7 +15,10 @@ namespace mwmp
 
         virtual void Do(WorldstatePacket &packet, Player &player, BaseWorldstate &worldstate);
 
-        static bool Process(RakNet::Packet &packet, BaseWorldstate &worldstate) noexcept;
+        // Process a packet, reading it into worldstate unless it was already read into decodedWorldstate
+        static bool Process(RakNet::Packet &packet, BaseWorldstate &worldstate, BaseWorldstate *decodedWorldstate = nullptr) noexcept;
+        // Whether a packet can be read ahead of being processed, away from the main thread
+        static bool IsDecodable(unsigned char packetID) noexcept;
     };
 }
 
@@ -0,0 +1,108 @@
+#ifndef OPENMW_PROCESSORACTORFRAME_HPP
+#define OPENMW_PROCESSORACTORFRAME_HPP
+
+#include "../ActorProcessor.hpp"
+#include "apps/openmw-mp/Networking.hpp"
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+
+namespace mwmp
+{
+    class ProcessorActorFrame : public ActorProcessor
+    {
+    public:
+        ProcessorActorFrame()
+        {
+            BPP_INIT(ID_ACTOR_FRAME)
+        }
+
+        void Do(ActorPacket &packet, Player &player, BaseActorList &actorList) override
+        {
+            Cell *serverCell = CellController::get()->getCell(&actorList.cell);
+
+            // Frames are only sent by a cell's authority
+            if (serverCell == nullptr || *serverCell->getAuthority() != actorList.guid)
+                return;
+
+            BaseActorList positionActorList = getFacetActors(actorList, BaseActor::FACET_POSITION);
+            BaseActorList statsDynamicActorList = getFacetActors(actorList, BaseActor::FACET_STATS_DYNAMIC);
+            BaseActorList deathActorList = getFacetActors(actorList, BaseActor::FACET_DEATH);
+            BaseActorList equipmentActorList = getFacetActors(actorList, BaseActor::FACET_EQUIPMENT);
+            BaseActorList cellChangeActorList = getFacetActors(actorList, BaseActor::FACET_CELL_CHANGE);
+
+            if (positionActorList.count > 0)
+                serverCell->readActorList(ID_ACTOR_POSITION, &positionActorList);
+
+            if (statsDynamicActorList.count > 0)
+                serverCell->readActorList(ID_ACTOR_STATS_DYNAMIC, &statsDynamicActorList);
+
+            // Scripts read the received actor list, so let them see only the actors each event is about
+            if (deathActorList.count > 0)
+            {
+                std::swap(actorList, deathActorList);
+                Script::Call<Script::CallbackIdentity("OnActorDeath")>(player.getId(), actorList.cell.getDescription().c_str());
+                std::swap(actorList, deathActorList);
+            }
+
+            if (equipmentActorList.count > 0)
+            {
+                std::swap(actorList, equipmentActorList);
+                Script::Call<Script::CallbackIdentity("OnActorEquipment")>(player.getId(), actorList.cell.getDescription().c_str());
+                std::swap(actorList, equipmentActorList);
+            }
+
+            // Cell changes are relevant to everyone rather than just the players who have the cell loaded,
+            // so they are split off and sent on their own
+            if (cellChangeActorList.count > 0)
+            {
+                serverCell->removeActors(&cellChangeActorList);
+
+                std::swap(actorList, cellChangeActorList);
+                Script::Call<Script::CallbackIdentity("OnActorCellChange")>(player.getId(), actorList.cell.getDescription().c_str());
+                std::swap(actorList, cellChangeActorList);
+
+                ActorPacket *cellChangePacket = Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_CELL_CHANGE);
+                cellChangePacket->setActorList(&cellChangeActorList);
+                cellChangePacket->Send(true);
+
+                for (auto it = actorList.baseActors.begin(); it != actorList.baseActors.end();)
+                {
+                    it->frameFacets &= ~BaseActor::FACET_CELL_CHANGE;
+
+                    if (it->frameFacets == 0)
+                        it = actorList.baseActors.erase(it);
+                    else
+                        ++it;
+                }
+
+                actorList.count = actorList.baseActors.size();
+
+                if (actorList.count == 0)
+                    return;
+            }
+
+            // Send the rest only to players who have the cell loaded
+            serverCell->sendToLoaded(&packet, &actorList);
+        }
+
+    private:
+        static BaseActorList getFacetActors(const BaseActorList &actorList, uint16_t facet)
+        {
+            BaseActorList facetActorList;
+            facetActorList.guid = actorList.guid;
+            facetActorList.cell = actorList.cell;
+            facetActorList.action = actorList.action;
+            facetActorList.isValid = true;
+
+            for (const auto &baseActor : actorList.baseActors)
+            {
+                if (baseActor.frameFacets & facet)
+                    facetActorList.baseActors.push_back(baseActor);
+            }
+
+            facetActorList.count = facetActorList.baseActors.size();
+            return facetActorList;
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORACTORFRAME_HPP
@@ -2,6 +2,7 @@
 #define OPENMW_PROCESSORDOORSTATE_HPP
 
 #include "../ObjectProcessor.hpp"
+#include <apps/openmw-mp/CellController.hpp>
 
 namespace mwmp
 {
@@ -16,6 +17,7 @@ namespace mwmp
         void Do(ObjectPacket &packet, Player &player, BaseObjectList &objectList) override
         {
             packet.Send(true);
+            CellController::get()->recordObjectList(packet.GetPacketID(), objectList);
 
             Script::Call<Script::CallbackIdentity("OnDoorState")>(player.getId(), objectList.cell.getDescription().c_str());
         }
@@ -17,6 +17,15 @@ namespace mwmp
         {
             DEBUG_PRINTF(strPacketID.c_str());
 
+            // A player asking for all of their inventory again is not something scripts need to know about
+            if (player.inventoryChanges.action == InventoryChanges::REQUEST_SET)
+            {
+                player.handleInventoryRequest(&packet);
+                return;
+            }
+
+            player.resolveInventoryChanges();
+
             Script::Call<Script::CallbackIdentity("OnPlayerInventory")>(player.getId());
         }
     };
@@ -17,6 +17,10 @@ namespace mwmp
         {
             DEBUG_PRINTF(strPacketID.c_str());
 
+            // Frame time reports are only used by the server's authority scheduler
+            if (player.miscellaneousChangeType == mwmp::MISCELLANEOUS_CHANGE_TYPE::FRAME_TIME)
+                return;
+
             Script::Call<Script::CallbackIdentity("OnPlayerMiscellaneous")>(player.getId());
         }
     };
@@ -17,6 +17,15 @@ namespace mwmp
         {
             DEBUG_PRINTF(strPacketID.c_str());
 
+            // A player asking for all of their spellbook again is not something scripts need to know about
+            if (player.spellbookChanges.action == SpellbookChanges::REQUEST_SET)
+            {
+                player.handleSpellbookRequest(&packet);
+                return;
+            }
+
+            player.resolveSpellbookChanges();
+
             Script::Call<Script::CallbackIdentity("OnPlayerSpellbook")>(player.getId());
         }
     };
@@ -44,6 +44,7 @@
 #include <components/openmw-mp/TimedLog.hpp>
 #include "mwmp/Main.hpp"
 #include "mwmp/GUIController.hpp"
+#include "mwmp/Networking.hpp"
 /*
     End of tes3mp addition
 */
@@ -451,6 +452,17 @@ bool OMW::Engine::frame(float frametime)
             stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
 
             mEnvironment.reportStats(frameNumber, *stats);
+
+            /*
+                Start of tes3mp addition
+
+                Report what the networking cost during the last frame
+            */
+            if (mwmp::Main::isInitialized())
+                mwmp::Main::get().getNetworking()->getNetworkStats()->reportStats(frameNumber, *stats);
+            /*
+                End of tes3mp addition
+            */
         }
     }
     catch (const std::exception& e)
@@ -775,10 +787,42 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mVFS.reset(new VFS::Manager(mFSStrict));
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
+    /*
+        Start of tes3mp addition
+
+        Keep the listings of the data directories between sessions
+    */
+    mVFS->setIndexCache((mCfgMgr.getUserDataPath() / "vfs.cache").string());
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp change (minor)
+
+        Keep the files decompressed from compressed BSA archives in a cache of the configured size
+    */
+    const int archiveCacheSize = std::max(0, settings.getInt("archive cache size", "Cells"));
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, static_cast<std::size_t>(archiveCacheSize) * 1024 * 1024);
+    /*
+        End of tes3mp change (minor)
+    */
 
     mResourceSystem.reset(new Resource::ResourceSystem(mVFS.get()));
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(false); // keep to Off for now to allow better state sharing
+
+    /*
+        Start of tes3mp addition
+
+        Keep the scene graphs converted from NIF files between sessions, if there is room for them
+    */
+    const int sceneCacheSize = std::max(0, settings.getInt("scene cache size", "Models"));
+    if (sceneCacheSize > 0)
+        mResourceSystem->getSceneManager()->setSceneCache((mCfgMgr.getUserDataPath() / "scenecache").string(),
+            static_cast<std::size_t>(sceneCacheSize) * 1024 * 1024);
+    /*
+        End of tes3mp addition
+    */
     mResourceSystem->getSceneManager()->setFilterSettings(
         Settings::Manager::getString("texture mag filter", "General"),
         Settings::Manager::getString("texture min filter", "General"),
@@ -855,16 +899,13 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     mEnvironment.setWorld( new MWWorld::World (mViewer, rootNode, mResourceSystem.get(), mWorkQueue.get(),
         mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder, mActivationDistanceOverride, mCellName,
         mStartupScript, mResDir.string(), mCfgMgr.getUserDataPath().string()));
-    mEnvironment.getWorld()->setupPlayer();
-
-    window->setStore(mEnvironment.getWorld()->getStore());
-    window->initUI();
 
-    //Load translation data
-    mTranslationDataStorage.setEncoder(mEncoder);
-    for (size_t i = 0; i < mContentFiles.size(); i++)
-      mTranslationDataStorage.loadTranslationData(mFileCollections, mContentFiles[i]);
+    /*
+        Start of tes3mp change (major)
 
+        Create the script system as soon as the world has been loaded, so it can be started
+        compiling in the background once the rest of the engine has been set up
+    */
     Compiler::registerExtensions (mExtensions);
 
     // Create script system
@@ -873,6 +914,19 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mEnvironment.setScriptManager (new MWScript::ScriptManager (mEnvironment.getWorld()->getStore(), *mScriptContext, mWarningsMode,
         mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>()));
+    /*
+        End of tes3mp change (major)
+    */
+
+    mEnvironment.getWorld()->setupPlayer();
+
+    window->setStore(mEnvironment.getWorld()->getStore());
+    window->initUI();
+
+    //Load translation data
+    mTranslationDataStorage.setEncoder(mEncoder);
+    for (size_t i = 0; i < mContentFiles.size(); i++)
+      mTranslationDataStorage.loadTranslationData(mFileCollections, mContentFiles[i]);
 
     // Create game mechanics system
     MWMechanics::MechanicsManager* mechanics = new MWMechanics::MechanicsManager;
@@ -902,6 +956,18 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
                 << 100*static_cast<double> (result.second)/result.first
                 << "%)";
     }
+
+    /*
+        Start of tes3mp addition
+
+        Compile all scripts ahead of the first frame, reusing the ones compiled during earlier
+        sessions, only now that nothing else in the setup changes the world or its store
+    */
+    mEnvironment.getScriptManager()->precompileAll ((mCfgMgr.getUserDataPath() / "scriptcache").string(),
+        mwmp::Main::get().getNetworking()->getContentChecksums(), Version::getOpenmwVersionDescription(mResDir.string()));
+    /*
+        End of tes3mp addition
+    */
 }
 
 class WriteScreenshotToFileOperation : public osgViewer::ScreenCaptureHandler::CaptureOperation
@@ -1016,6 +1082,16 @@ void OMW::Engine::go()
             Log(Debug::Warning) << "Failed to open file for stats: " << path;
     }
 
+    /*
+        Start of tes3mp addition
+
+        Finish compiling scripts before the new game changes the records they are compiled against
+    */
+    mEnvironment.getScriptManager()->waitForPrecompile();
+    /*
+        End of tes3mp addition
+    */
+
     /*
         Start of tes3mp addition
 
@@ -2,6 +2,7 @@
 #define GAME_MWBASE_SCRIPTMANAGER_H
 
 #include <string>
+#include <vector>
 
 namespace Interpreter
 {
@@ -52,6 +53,32 @@ namespace MWBase
             ///< Return locals for script \a name.
 
             virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
+
+            /*
+                Start of tes3mp addition
+
+                Allow scripts to be compiled ahead of time, in the background, and to be kept on disk
+                between sessions
+            */
+            virtual void precompileAll (const std::string& cacheDirectory,
+                const std::vector<unsigned int>& contentChecksums, const std::string& engineVersion) = 0;
+            ///< Start compiling every script in the background, reusing the compiled scripts from
+            /// the cache in \a cacheDirectory that match \a contentChecksums and \a engineVersion.
+            /// Nothing may change the ESM store until waitForPrecompile or setStoreModified has returned.
+
+            virtual void waitForPrecompile() = 0;
+            ///< Wait for the scripts started by precompileAll to finish compiling and save the cache.
+
+            virtual void invalidate (const std::string& name) = 0;
+            ///< Forget the compiled form and locals of script \a name, in memory and in the cache,
+            /// so it is compiled again from its current record.
+
+            virtual void setStoreModified() = 0;
+            ///< The ESM store is about to hold records that don't come from the content files, so
+            /// stop the background compile and neither read nor add to the cache from now on.
+            /*
+                End of tes3mp addition
+            */
    };
 }
 
@@ -249,9 +249,11 @@ namespace MWBase
             /*
                 Start of tes3mp addition
 
-                Make it possible to update all Ptrs in active cells that have a certain refId
+                Make it possible to update all Ptrs in active cells that have a certain refId,
+                or any of several lowercase refIds in a single pass over those cells
             */
             virtual void updatePtrsWithRefId(std::string refId) = 0;
+            virtual void updatePtrsWithRefIds(const std::set<std::string>& refIds) = 0;
             /*
                 End of tes3mp addition
             */
@@ -11,12 +11,32 @@
 #include "../mwworld/esmstore.hpp"
 #include "../mwworld/inventorystore.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include "../mwmp/Main.hpp"
+#include "../mwmp/LocalPlayer.hpp"
+/*
+    End of tes3mp addition
+*/
+
 namespace MWGui
 {
     // mWatchedTimeToStartDrowning = -1 for correct drowning state check,
     // if stats.getTimeToStartDrowning() == 0 already on game start
     StatsWatcher::StatsWatcher()
       : mWatchedLevel(-1), mWatchedTimeToStartDrowning(-1), mWatchedStatsEmpty(true)
+      /*
+          Start of tes3mp addition
+
+          Keep track of the bounty and reputation too, so the LocalPlayer knows when to send them
+      */
+      , mWatchedBounty(-1), mWatchedReputation(-1)
+      /*
+          End of tes3mp addition
+      */
     {
     }
 
@@ -32,10 +52,30 @@ namespace MWGui
 
         MWBase::WindowManager *winMgr = MWBase::Environment::get().getWindowManager();
         const MWMechanics::NpcStats &stats = mWatched.getClass().getNpcStats(mWatched);
+
+        /*
+            Start of tes3mp addition
+
+            Collect the categories of stats that have changed here, so the LocalPlayer doesn't have
+            to compare all of them on every update
+        */
+        unsigned int dirtyCategories = 0;
+        /*
+            End of tes3mp addition
+        */
+
         for (int i = 0;i < ESM::Attribute::Length;++i)
         {
             if (stats.getAttribute(i) != mWatchedAttributes[i] || mWatchedStatsEmpty)
             {
+                /*
+                    Start of tes3mp addition
+                */
+                dirtyCategories |= mwmp::LocalPlayer::DIRTY_ATTRIBUTES;
+                /*
+                    End of tes3mp addition
+                */
+
                 std::stringstream attrname;
                 attrname << "AttribVal"<<(i+1);
 
@@ -86,6 +126,18 @@ namespace MWGui
         {
             if(stats.getSkill(i) != mWatchedSkills[i] || mWatchedStatsEmpty)
             {
+                /*
+                    Start of tes3mp addition
+
+                    Skill increases also change level progress and the attribute multipliers
+                    for the next level up
+                */
+                dirtyCategories |= mwmp::LocalPlayer::DIRTY_SKILLS | mwmp::LocalPlayer::DIRTY_ATTRIBUTES |
+                    mwmp::LocalPlayer::DIRTY_LEVEL;
+                /*
+                    End of tes3mp addition
+                */
+
                 mWatchedSkills[i] = stats.getSkill(i);
                 setValue((ESM::Skill::SkillEnum)i, stats.getSkill(i));
             }
@@ -93,6 +145,14 @@ namespace MWGui
 
         if (stats.getLevel() != mWatchedLevel || mWatchedStatsEmpty)
         {
+            /*
+                Start of tes3mp addition
+            */
+            dirtyCategories |= mwmp::LocalPlayer::DIRTY_LEVEL;
+            /*
+                End of tes3mp addition
+            */
+
             mWatchedLevel = stats.getLevel();
             setValue("level", mWatchedLevel);
         }
@@ -135,6 +195,29 @@ namespace MWGui
             }
         }
 
+        /*
+            Start of tes3mp addition
+
+            Mark the changed categories of stats as dirty for the LocalPlayer
+        */
+        if (stats.getBounty() != mWatchedBounty || mWatchedStatsEmpty)
+        {
+            mWatchedBounty = stats.getBounty();
+            dirtyCategories |= mwmp::LocalPlayer::DIRTY_BOUNTY;
+        }
+
+        if (stats.getReputation() != mWatchedReputation || mWatchedStatsEmpty)
+        {
+            mWatchedReputation = stats.getReputation();
+            dirtyCategories |= mwmp::LocalPlayer::DIRTY_REPUTATION;
+        }
+
+        if (dirtyCategories != 0 && mWatched == MWBase::Environment::get().getWorld()->getPlayerPtr())
+            mwmp::Main::get().getLocalPlayer()->markDirty(dirtyCategories);
+        /*
+            End of tes3mp addition
+        */
+
         mWatchedStatsEmpty = false;
     }
 
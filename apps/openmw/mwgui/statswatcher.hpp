@@ -43,6 +43,17 @@ namespace MWGui
 
         float mWatchedTimeToStartDrowning;
 
+        /*
+            Start of tes3mp addition
+
+            Keep track of the bounty and reputation too, so the LocalPlayer knows when to send them
+        */
+        int mWatchedBounty;
+        int mWatchedReputation;
+        /*
+            End of tes3mp addition
+        */
+
         bool mWatchedStatsEmpty;
 
         std::set<StatsListener*> mListeners;
@@ -1,9 +1,11 @@
 #include "spelllist.hpp"
 
 #include <algorithm>
+#include <map>
 
 #include <components/esm/loadspel.hpp>
 #include <components/misc/rng.hpp>
+#include <components/misc/stringops.hpp>
 
 #include "spells.hpp"
 
@@ -35,6 +37,37 @@ namespace MWMechanics
 {
     SpellList::SpellList(const std::string& id, int type) : mId(id), mType(type) {}
 
+    /*
+        Start of tes3mp change (minor)
+
+        Keep the shared spell lists here instead of in the store, which is a component that doesn't
+        know about the engine's mechanics
+    */
+    std::pair<std::shared_ptr<SpellList>, bool> SpellList::getForActor(const std::string& originalId)
+    {
+        static std::map<std::string, std::weak_ptr<SpellList> > sCache;
+
+        const std::string id = Misc::StringUtils::lowerCase(originalId);
+        auto result = sCache.find(id);
+        std::shared_ptr<SpellList> ptr;
+        if (result != sCache.end())
+            ptr = result->second.lock();
+        if (!ptr)
+        {
+            int type = MWBase::Environment::get().getWorld()->getStore().find(id);
+            ptr = std::make_shared<SpellList>(id, type);
+            if (result != sCache.end())
+                result->second = ptr;
+            else
+                sCache.insert({id, ptr});
+            return {ptr, false};
+        }
+        return {ptr, true};
+    }
+    /*
+        End of tes3mp change (minor)
+    */
+
     bool SpellList::withBaseRecord(const std::function<bool(std::vector<std::string>&)>& function)
     {
         switch(mType)
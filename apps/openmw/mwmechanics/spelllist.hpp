@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <set>
 #include <vector>
@@ -47,6 +48,18 @@ namespace MWMechanics
             /// Get spell from ID, throws exception if not found
             static const ESM::Spell* getSpell(const std::string& id);
 
+            /*
+                Start of tes3mp addition
+
+                Moved here from the store
+            */
+            /// Actors with the same ID share spells, abilities, etc.
+            /// @return The shared spell list to use for this actor and whether or not it has already been initialized.
+            static std::pair<std::shared_ptr<SpellList>, bool> getForActor(const std::string& id);
+            /*
+                End of tes3mp addition
+            */
+
             void add (const ESM::Spell* spell);
             ///< Adding a spell that is already listed in *this is a no-op.
 
@@ -500,7 +500,15 @@ namespace MWMechanics
     bool Spells::setSpells(const std::string& actorId)
     {
         bool result;
-        std::tie(mSpellList, result) = MWBase::Environment::get().getWorld()->getStore().getSpellList(actorId);
+        /*
+            Start of tes3mp change (minor)
+
+            Get shared spell lists from SpellList instead of the store
+        */
+        std::tie(mSpellList, result) = SpellList::getForActor(actorId);
+        /*
+            End of tes3mp change (minor)
+        */
         mSpellList->addListener(this);
         addAllToInstance(mSpellList->getSpells());
         return result;
@@ -1,4 +1,5 @@
 #include "ActorList.hpp"
+#include "CellController.hpp"
 #include "Main.hpp"
 #include "Networking.hpp"
 #include "LocalPlayer.hpp"
@@ -8,8 +9,102 @@
 
 #include <components/openmw-mp/TimedLog.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
 using namespace mwmp;
 
+// Copy over the fields that make up a facet of an actor in an ID_ACTOR_FRAME
+static void copyFrameFacet(BaseActor &frameActor, const BaseActor &facetActor, uint16_t facet)
+{
+    switch (facet)
+    {
+    case BaseActor::FACET_POSITION:
+
+        frameActor.position = facetActor.position;
+        frameActor.direction = facetActor.direction;
+        frameActor.hasPositionTimestamp = facetActor.hasPositionTimestamp;
+        frameActor.positionTimestamp = facetActor.positionTimestamp;
+        break;
+
+    case BaseActor::FACET_ANIM_FLAGS:
+
+        frameActor.movementFlags = facetActor.movementFlags;
+        frameActor.drawState = facetActor.drawState;
+        frameActor.isFlying = facetActor.isFlying;
+        break;
+
+    case BaseActor::FACET_ANIM_PLAY:
+
+        frameActor.animation = facetActor.animation;
+        break;
+
+    case BaseActor::FACET_SPEECH:
+
+        frameActor.sound = facetActor.sound;
+        break;
+
+    case BaseActor::FACET_DEATH:
+
+        frameActor.refId = facetActor.refId;
+        frameActor.deathState = facetActor.deathState;
+        frameActor.isInstantDeath = facetActor.isInstantDeath;
+        frameActor.killer = facetActor.killer;
+        break;
+
+    case BaseActor::FACET_STATS_DYNAMIC:
+
+        frameActor.creatureStats = facetActor.creatureStats;
+        break;
+
+    case BaseActor::FACET_EQUIPMENT:
+
+        std::copy(std::begin(facetActor.equipmentItems), std::end(facetActor.equipmentItems),
+            std::begin(frameActor.equipmentItems));
+        break;
+
+    case BaseActor::FACET_ATTACK:
+
+        frameActor.attack = facetActor.attack;
+        break;
+
+    case BaseActor::FACET_CAST:
+
+        frameActor.cast = facetActor.cast;
+        break;
+
+    case BaseActor::FACET_CELL_CHANGE:
+
+        frameActor.cell = facetActor.cell;
+        frameActor.position = facetActor.position;
+        frameActor.direction = facetActor.direction;
+        frameActor.isFollowerCellChange = facetActor.isFollowerCellChange;
+        break;
+    }
+}
+
+static void addFrameFacet(std::vector<BaseActor> &frameActors, std::unordered_map<uint64_t, size_t> &frameIndexes,
+    const std::vector<BaseActor> &facetActors, uint16_t facet)
+{
+    for (const auto &facetActor : facetActors)
+    {
+        uint64_t mapIndex = CellController::generateMapIndex(facetActor);
+        auto it = frameIndexes.find(mapIndex);
+
+        if (it == frameIndexes.end())
+        {
+            it = frameIndexes.insert(std::make_pair(mapIndex, frameActors.size())).first;
+            frameActors.push_back(facetActor);
+            frameActors.back().frameFacets = 0;
+        }
+
+        BaseActor &frameActor = frameActors.at(it->second);
+        copyFrameFacet(frameActor, facetActor, facet);
+        frameActor.frameFacets |= facet;
+    }
+}
+
 ActorList::ActorList()
 {
 
@@ -247,6 +342,31 @@ void ActorList::sendCellChangeActors()
     }
 }
 
+void ActorList::sendFrameActors()
+{
+    std::vector<BaseActor> frameActors;
+    std::unordered_map<uint64_t, size_t> frameIndexes;
+
+    // Add the facets in the order their separate packets used to be sent in
+    addFrameFacet(frameActors, frameIndexes, positionActors, BaseActor::FACET_POSITION);
+    addFrameFacet(frameActors, frameIndexes, animFlagsActors, BaseActor::FACET_ANIM_FLAGS);
+    addFrameFacet(frameActors, frameIndexes, animPlayActors, BaseActor::FACET_ANIM_PLAY);
+    addFrameFacet(frameActors, frameIndexes, speechActors, BaseActor::FACET_SPEECH);
+    addFrameFacet(frameActors, frameIndexes, deathActors, BaseActor::FACET_DEATH);
+    addFrameFacet(frameActors, frameIndexes, statsDynamicActors, BaseActor::FACET_STATS_DYNAMIC);
+    addFrameFacet(frameActors, frameIndexes, equipmentActors, BaseActor::FACET_EQUIPMENT);
+    addFrameFacet(frameActors, frameIndexes, attackActors, BaseActor::FACET_ATTACK);
+    addFrameFacet(frameActors, frameIndexes, castActors, BaseActor::FACET_CAST);
+    addFrameFacet(frameActors, frameIndexes, cellChangeActors, BaseActor::FACET_CELL_CHANGE);
+
+    if (frameActors.size() > 0)
+    {
+        baseActors = std::move(frameActors);
+        Main::get().getNetworking()->getActorPacket(ID_ACTOR_FRAME)->setActorList(this);
+        Main::get().getNetworking()->getActorPacket(ID_ACTOR_FRAME)->Send();
+    }
+}
+
 void ActorList::sendActorsInCell(MWWorld::CellStore* cellStore)
 {
     reset();
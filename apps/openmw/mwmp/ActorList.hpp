@@ -46,6 +46,9 @@ namespace mwmp
         void sendCastActors();
         void sendCellChangeActors();
 
+        // Send every facet added for this update in a single ID_ACTOR_FRAME instead of one packet per facet
+        void sendFrameActors();
+
         void sendActorsInCell(MWWorld::CellStore* cellStore);
 
     private:
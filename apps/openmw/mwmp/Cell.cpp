@@ -56,21 +56,21 @@ void Cell::updateLocal(bool forceUpdate)
         if (newStore != store)
         {
             actor->updateCell();
-            std::string mapIndex = it->first;
+            uint64_t mapIndex = it->first;
 
             // If the cell this actor has moved to is under our authority, move them to it
             if (cellController->hasLocalAuthority(actor->cell))
             {
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving LocalActor %s to our authority in %s",
-                    mapIndex.c_str(), actor->cell.getDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving LocalActor %u-%u to our authority in %s",
+                    actor->refNum, actor->mpNum, actor->cell.getDescription().c_str());
                 Cell *newCell = cellController->getCell(actor->cell);
                 newCell->localActors[mapIndex] = actor;
-                cellController->setLocalActorRecord(mapIndex, newCell->getDescription());
+                cellController->setLocalActorRecord(mapIndex, newCell);
             }
             else
             {
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %s which is no longer under our authority",
-                    mapIndex.c_str(), getDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %u-%u which is no longer under our authority",
+                    actor->refNum, actor->mpNum, getDescription().c_str());
                 cellController->removeLocalActorRecord(mapIndex);
                 delete actor;
             }
@@ -88,16 +88,7 @@ void Cell::updateLocal(bool forceUpdate)
         }
     }
 
-    actorList->sendPositionActors();
-    actorList->sendAnimFlagsActors();
-    actorList->sendAnimPlayActors();
-    actorList->sendSpeechActors();
-    actorList->sendDeathActors();
-    actorList->sendStatsDynamicActors();
-    actorList->sendEquipmentActors();
-    actorList->sendAttackActors();
-    actorList->sendCastActors();
-    actorList->sendCellChangeActors();
+    actorList->sendFrameActors();
 }
 
 void Cell::updateDedicated(float dt)
@@ -121,13 +112,15 @@ void Cell::readPositions(ActorList& actorList)
     
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->position = baseActor.position;
             actor->direction = baseActor.direction;
+            actor->hasPositionTimestamp = baseActor.hasPositionTimestamp;
+            actor->positionTimestamp = baseActor.positionTimestamp;
 
             if (!actor->hasPositionData)
             {
@@ -140,6 +133,8 @@ void Cell::readPositions(ActorList& actorList)
                 // received from the server still gets set
                 actor->setPosition();
             }
+            else
+                actor->addPositionSnapshot();
         }
     }
 }
@@ -148,11 +143,11 @@ void Cell::readAnimFlags(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->movementFlags = baseActor.movementFlags;
             actor->drawState = baseActor.drawState;
             actor->isFlying = baseActor.isFlying;
@@ -164,11 +159,11 @@ void Cell::readAnimPlay(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->animation.groupname = baseActor.animation.groupname;
             actor->animation.mode = baseActor.animation.mode;
             actor->animation.count = baseActor.animation.count;
@@ -186,11 +181,11 @@ void Cell::readStatsDynamic(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->creatureStats = baseActor.creatureStats;
 
             if (!actor->hasStatsDynamicData)
@@ -216,11 +211,11 @@ void Cell::readDeath(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->creatureStats.mDead = true;
             actor->creatureStats.mDynamic[0].mCurrent = 0;
 
@@ -247,11 +242,11 @@ void Cell::readEquipment(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
 
             for (int slot = 0; slot < 19; ++slot)
                 actor->equipmentItems[slot] = baseActor.equipmentItems[slot];
@@ -272,11 +267,11 @@ void Cell::readSpeech(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->sound = baseActor.sound;
             actor->playSound();
         }
@@ -294,11 +289,11 @@ void Cell::readSpellsActive(ActorList& actorList)
 
     for (const auto& baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor* actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->spellsActiveChanges = baseActor.spellsActiveChanges;
 
             int spellsActiveAction = baseActor.spellsActiveChanges.action;
@@ -324,11 +319,11 @@ void Cell::readAi(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->aiAction = baseActor.aiAction;
             actor->aiDistance = baseActor.aiDistance;
             actor->aiDuration = baseActor.aiDuration;
@@ -348,13 +343,13 @@ void Cell::readAttack(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %s", mapIndex.c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %u-%u", baseActor.refNum, baseActor.mpNum);
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->attack = baseActor.attack;
 
             MechanicsHelper::processAttack(actor->attack, actor->getPtr());
@@ -366,13 +361,13 @@ void Cell::readCast(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        auto it = dedicatedActors.find(CellController::generateMapIndex(baseActor));
 
-        if (dedicatedActors.count(mapIndex) > 0)
+        if (it != dedicatedActors.end())
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %s", mapIndex.c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %u-%u", baseActor.refNum, baseActor.mpNum);
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
+            DedicatedActor *actor = it->second;
             actor->cast = baseActor.cast;
 
             // Set the correct drawState here if we've somehow we've missed a previous
@@ -398,13 +393,13 @@ void Cell::readCellChange(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
 
         // Is a packet mistakenly moving the actor to the cell it's already in? If so, ignore it
         if (Misc::StringUtils::ciEqual(getDescription(), baseActor.cell.getDescription()))
         {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Server says DedicatedActor %s moved to %s, but it was already there",
-                mapIndex.c_str(), getDescription().c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Server says DedicatedActor %u-%u moved to %s, but it was already there",
+                baseActor.refNum, baseActor.mpNum, getDescription().c_str());
             continue;
         }
 
@@ -415,8 +410,8 @@ void Cell::readCellChange(ActorList& actorList)
             dedicatedActor->position = baseActor.position;
             dedicatedActor->direction = baseActor.direction;
 
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server says DedicatedActor %s moved to %s",
-                mapIndex.c_str(), dedicatedActor->cell.getDescription().c_str());
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server says DedicatedActor %u-%u moved to %s",
+                baseActor.refNum, baseActor.mpNum, dedicatedActor->cell.getDescription().c_str());
 
             MWWorld::CellStore *newStore = cellController->getCellStore(dedicatedActor->cell);
             dedicatedActor->setCell(newStore);
@@ -424,19 +419,19 @@ void Cell::readCellChange(ActorList& actorList)
             // If the cell this actor has moved to is active and not under our authority, move them to it
             if (cellController->isActiveWorldCell(dedicatedActor->cell) && !cellController->hasLocalAuthority(dedicatedActor->cell))
             {
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving DedicatedActor %s to our active cell %s",
-                    mapIndex.c_str(), dedicatedActor->cell.getDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving DedicatedActor %u-%u to our active cell %s",
+                    baseActor.refNum, baseActor.mpNum, dedicatedActor->cell.getDescription().c_str());
                 cellController->initializeCell(dedicatedActor->cell);
                 Cell *newCell = cellController->getCell(dedicatedActor->cell);
                 newCell->dedicatedActors[mapIndex] = dedicatedActor;
-                cellController->setDedicatedActorRecord(mapIndex, newCell->getDescription());
+                cellController->setDedicatedActorRecord(mapIndex, newCell);
             }
             else
             {
                 if (cellController->hasLocalAuthority(dedicatedActor->cell))
                 {
-                    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Creating new LocalActor based on %s in %s",
-                        mapIndex.c_str(), dedicatedActor->cell.getDescription().c_str());
+                    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Creating new LocalActor based on %u-%u in %s",
+                        baseActor.refNum, baseActor.mpNum, dedicatedActor->cell.getDescription().c_str());
                     Cell *newCell = cellController->getCell(dedicatedActor->cell);
                     LocalActor *localActor = new LocalActor();
                     localActor->cell = dedicatedActor->cell;
@@ -449,11 +444,11 @@ void Cell::readCellChange(ActorList& actorList)
                     localActor->creatureStats = dedicatedActor->creatureStats;
 
                     newCell->localActors[mapIndex] = localActor;
-                    cellController->setLocalActorRecord(mapIndex, newCell->getDescription());
+                    cellController->setLocalActorRecord(mapIndex, newCell);
                 }
 
-                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting DedicatedActor %s which is no longer needed",
-                    mapIndex.c_str(), getDescription().c_str());
+                LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting DedicatedActor %u-%u which is no longer needed",
+                    baseActor.refNum, baseActor.mpNum, getDescription().c_str());
                 cellController->removeDedicatedActorRecord(mapIndex);
                 delete dedicatedActor;
             }
@@ -465,8 +460,9 @@ void Cell::readCellChange(ActorList& actorList)
 
 void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %s in %s", mapIndex.c_str(), getDescription().c_str());
+    uint64_t mapIndex = CellController::generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %u-%u in %s",
+        ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum(), getDescription().c_str());
 
     LocalActor *actor = new LocalActor();
     actor->cell = *store->getCell();
@@ -474,9 +470,10 @@ void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 
     localActors[mapIndex] = actor;
 
-    Main::get().getCellController()->setLocalActorRecord(mapIndex, getDescription());
+    Main::get().getCellController()->setLocalActorRecord(mapIndex, this);
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %s in %s", mapIndex.c_str(), getDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %u-%u in %s",
+        ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum(), getDescription().c_str());
 }
 
 void Cell::initializeLocalActors()
@@ -495,7 +492,7 @@ void Cell::initializeLocalActors()
             // If this Ptr is disabled or deleted, ignore it
             if (!ptr.getRefData().isEnabled() || ptr.getRefData().isDeleted()) continue;
 
-            std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+            uint64_t mapIndex = CellController::generateMapIndex(ptr);
 
             // Only initialize this actor if it isn't already initialized
             if (localActors.count(mapIndex) == 0)
@@ -508,8 +505,9 @@ void Cell::initializeLocalActors()
 
 void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %s in %s", mapIndex.c_str(), getDescription().c_str());
+    uint64_t mapIndex = CellController::generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %u-%u in %s",
+        ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum(), getDescription().c_str());
 
     DedicatedActor *actor = new DedicatedActor();
     actor->cell = *store->getCell();
@@ -517,16 +515,17 @@ void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 
     dedicatedActors[mapIndex] = actor;
 
-    Main::get().getCellController()->setDedicatedActorRecord(mapIndex, getDescription());
+    Main::get().getCellController()->setDedicatedActorRecord(mapIndex, this);
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %s in %s", mapIndex.c_str(), getDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %u-%u in %s",
+        ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum(), getDescription().c_str());
 }
 
 void Cell::initializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
 
         // If this key doesn't exist, create it
         if (dedicatedActors.count(mapIndex) == 0)
@@ -555,7 +554,7 @@ void Cell::uninitializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        uint64_t mapIndex = CellController::generateMapIndex(baseActor);
         Main::get().getCellController()->removeDedicatedActorRecord(mapIndex);
         delete dedicatedActors.at(mapIndex);
         dedicatedActors.erase(mapIndex);
@@ -573,12 +572,12 @@ void Cell::uninitializeDedicatedActors()
     dedicatedActors.clear();
 }
 
-LocalActor *Cell::getLocalActor(std::string actorIndex)
+LocalActor *Cell::getLocalActor(uint64_t actorIndex)
 {
     return localActors.at(actorIndex);
 }
 
-DedicatedActor *Cell::getDedicatedActor(std::string actorIndex)
+DedicatedActor *Cell::getDedicatedActor(uint64_t actorIndex)
 {
     return dedicatedActors.at(actorIndex);
 }
@@ -16,9 +16,9 @@
 using namespace mwmp;
 
 std::map<std::string, mwmp::Cell *> CellController::cellsInitialized;
-std::map<std::string, std::string> CellController::localActorsToCells;
-std::map<std::string, std::string> CellController::dedicatedActorsToCells;
-std::map<std::string, unsigned int> CellController::queuedDeathStates;
+std::unordered_map<uint64_t, mwmp::Cell *> CellController::localActorsToCells;
+std::unordered_map<uint64_t, mwmp::Cell *> CellController::dedicatedActorsToCells;
+std::unordered_map<uint64_t, unsigned int> CellController::queuedDeathStates;
 
 mwmp::CellController::CellController()
 {
@@ -268,38 +268,38 @@ void CellController::readCellChange(ActorList& actorList)
 
 bool CellController::hasQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return queuedDeathStates.count(actorIndex) > 0;
 }
 
 unsigned int CellController::getQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return queuedDeathStates[actorIndex];
 }
 
 void CellController::clearQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     queuedDeathStates.erase(actorIndex);
 }
 
 void CellController::setQueuedDeathState(MWWorld::Ptr ptr, unsigned int deathState)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     queuedDeathStates[actorIndex] = deathState;
 }
 
-void CellController::setLocalActorRecord(std::string actorIndex, std::string cellIndex)
+void CellController::setLocalActorRecord(uint64_t actorIndex, Cell *cell)
 {
-    localActorsToCells[actorIndex] = cellIndex;
+    localActorsToCells[actorIndex] = cell;
 }
 
-void CellController::removeLocalActorRecord(std::string actorIndex)
+void CellController::removeLocalActorRecord(uint64_t actorIndex)
 {
     localActorsToCells.erase(actorIndex);
 }
@@ -309,40 +309,36 @@ bool CellController::isLocalActor(MWWorld::Ptr ptr)
     if (ptr.mRef == nullptr)
         return false;
 
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return localActorsToCells.count(actorIndex) > 0;
 }
 
 bool CellController::isLocalActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
 
     return localActorsToCells.count(actorIndex) > 0;
 }
 
 LocalActor *CellController::getLocalActor(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
-    std::string cellIndex = localActorsToCells.at(actorIndex);
-
-    return cellsInitialized.at(cellIndex)->getLocalActor(actorIndex);
+    uint64_t actorIndex = generateMapIndex(ptr);
+    return localActorsToCells.at(actorIndex)->getLocalActor(actorIndex);
 }
 
 LocalActor *CellController::getLocalActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
-    std::string cellIndex = localActorsToCells.at(actorIndex);
-
-    return cellsInitialized.at(cellIndex)->getLocalActor(actorIndex);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
+    return localActorsToCells.at(actorIndex)->getLocalActor(actorIndex);
 }
 
-void CellController::setDedicatedActorRecord(std::string actorIndex, std::string cellIndex)
+void CellController::setDedicatedActorRecord(uint64_t actorIndex, Cell *cell)
 {
-    dedicatedActorsToCells[actorIndex] = cellIndex;
+    dedicatedActorsToCells[actorIndex] = cell;
 }
 
-void CellController::removeDedicatedActorRecord(std::string actorIndex)
+void CellController::removeDedicatedActorRecord(uint64_t actorIndex)
 {
     dedicatedActorsToCells.erase(actorIndex);
 }
@@ -352,47 +348,41 @@ bool CellController::isDedicatedActor(MWWorld::Ptr ptr)
     if (ptr.mRef == nullptr)
         return false;
 
-    std::string actorIndex = generateMapIndex(ptr);
+    uint64_t actorIndex = generateMapIndex(ptr);
 
     return dedicatedActorsToCells.count(actorIndex) > 0;
 }
 
 bool CellController::isDedicatedActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
 
     return dedicatedActorsToCells.count(actorIndex) > 0;
 }
 
 DedicatedActor *CellController::getDedicatedActor(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
-    std::string cellIndex = dedicatedActorsToCells.at(actorIndex);
-
-    return cellsInitialized.at(cellIndex)->getDedicatedActor(actorIndex);
+    uint64_t actorIndex = generateMapIndex(ptr);
+    return dedicatedActorsToCells.at(actorIndex)->getDedicatedActor(actorIndex);
 }
 
 DedicatedActor *CellController::getDedicatedActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
-    std::string cellIndex = dedicatedActorsToCells.at(actorIndex);
-
-    return cellsInitialized.at(cellIndex)->getDedicatedActor(actorIndex);
+    uint64_t actorIndex = generateMapIndex(refNum, mpNum);
+    return dedicatedActorsToCells.at(actorIndex)->getDedicatedActor(actorIndex);
 }
 
-std::string CellController::generateMapIndex(int refNum, int mpNum)
+uint64_t CellController::generateMapIndex(unsigned int refNum, unsigned int mpNum)
 {
-    std::string mapIndex = "";
-    mapIndex = Utils::toString(refNum) + "-" + Utils::toString(mpNum);
-    return mapIndex;
+    return (static_cast<uint64_t>(refNum) << 32) | mpNum;
 }
 
-std::string CellController::generateMapIndex(MWWorld::Ptr ptr)
+uint64_t CellController::generateMapIndex(const MWWorld::Ptr& ptr)
 {
     return generateMapIndex(ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum());
 }
 
-std::string CellController::generateMapIndex(BaseActor baseActor)
+uint64_t CellController::generateMapIndex(const BaseActor& baseActor)
 {
     return generateMapIndex(baseActor.refNum, baseActor.mpNum);
 }
@@ -1,6 +1,9 @@
 #ifndef OPENMW_CELLCONTROLLER_HPP
 #define OPENMW_CELLCONTROLLER_HPP
 
+#include <cstdint>
+#include <unordered_map>
+
 #include "Cell.hpp"
 #include "ActorList.hpp"
 #include "LocalActor.hpp"
@@ -41,25 +44,26 @@ namespace mwmp
         void clearQueuedDeathState(MWWorld::Ptr ptr);
         void setQueuedDeathState(MWWorld::Ptr ptr, unsigned int deathState);
 
-        void setLocalActorRecord(std::string actorIndex, std::string cellIndex);
-        void removeLocalActorRecord(std::string actorIndex);
+        void setLocalActorRecord(uint64_t actorIndex, Cell *cell);
+        void removeLocalActorRecord(uint64_t actorIndex);
         
         bool isLocalActor(MWWorld::Ptr ptr);
         bool isLocalActor(int refNum, int mpNum);
         virtual LocalActor *getLocalActor(MWWorld::Ptr ptr);
         virtual LocalActor *getLocalActor(int refNum, int mpNum);
 
-        void setDedicatedActorRecord(std::string actorIndex, std::string cellIndex);
-        void removeDedicatedActorRecord(std::string actorIndex);
+        void setDedicatedActorRecord(uint64_t actorIndex, Cell *cell);
+        void removeDedicatedActorRecord(uint64_t actorIndex);
         
         bool isDedicatedActor(MWWorld::Ptr ptr);
         bool isDedicatedActor(int refNum, int mpNum);
         virtual DedicatedActor *getDedicatedActor(MWWorld::Ptr ptr);
         virtual DedicatedActor *getDedicatedActor(int refNum, int mpNum);
 
-        std::string generateMapIndex(int refNumindex, int mpNum);
-        std::string generateMapIndex(MWWorld::Ptr ptr);
-        std::string generateMapIndex(mwmp::BaseActor baseActor);
+        // Pack an actor's refNum and mpNum into the key used for it in the actor maps
+        static uint64_t generateMapIndex(unsigned int refNum, unsigned int mpNum);
+        static uint64_t generateMapIndex(const MWWorld::Ptr& ptr);
+        static uint64_t generateMapIndex(const mwmp::BaseActor& baseActor);
 
         bool hasLocalAuthority(const ESM::Cell& cell);
         bool isInitializedCell(const std::string& cellDescription);
@@ -75,9 +79,9 @@ namespace mwmp
 
     private:
         static std::map<std::string, mwmp::Cell *> cellsInitialized;
-        static std::map<std::string, std::string> localActorsToCells;
-        static std::map<std::string, std::string> dedicatedActorsToCells;
-        static std::map<std::string, unsigned int> queuedDeathStates;
+        static std::unordered_map<uint64_t, mwmp::Cell *> localActorsToCells;
+        static std::unordered_map<uint64_t, mwmp::Cell *> dedicatedActorsToCells;
+        static std::unordered_map<uint64_t, unsigned int> queuedDeathStates;
     };
 }
 
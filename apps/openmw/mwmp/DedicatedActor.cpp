@@ -29,6 +29,7 @@
 #include "Main.hpp"
 #include "CellController.hpp"
 #include "MechanicsHelper.hpp"
+#include "Networking.hpp"
 
 using namespace mwmp;
 
@@ -42,7 +43,6 @@ DedicatedActor::DedicatedActor()
     hasPositionData = false;
     hasStatsDynamicData = false;
     hasReceivedInitialEquipment = false;
-    hasChangedCell = true;
 
     attack.pressed = false;
     cast.pressed = false;
@@ -72,38 +72,37 @@ void DedicatedActor::setCell(MWWorld::CellStore *cellStore)
     ptr = world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]);
     setMovementSettings();
 
-    hasChangedCell = true;
+    // Positions from the previous cell can't be interpolated from, so start over
+    positionSnapshots.reset(position);
 }
 
 void DedicatedActor::move(float dt)
 {
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 40;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate = abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance && abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance && abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    // Display the position interpolated from the ones received, falling back to the latest
+    // position known if none have been received yet
+    ESM::Position displayedPosition;
 
-    // Don't apply linear interpolation if the DedicatedActor has just gone through a cell change, because
-    // the interpolated position will be invalid, causing a slight hopping glitch
-    if (shouldInterpolate && !hasChangedCell)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-        refPos.pos[0] = lerp.x();
-        refPos.pos[1] = lerp.y();
-        refPos.pos[2] = lerp.z();
-
-        world->moveObject(ptr, refPos.pos[0], refPos.pos[1], refPos.pos[2]);
-    }
+    if (positionSnapshots.getPosition(displayedPosition))
+        mwmp::Main::get().getNetworking()->getNetworkStats()->countInterpolatedActor();
     else
-    {
-        setPosition();
-        hasChangedCell = false;
-    }
+        displayedPosition = position;
+
+    world->moveObject(ptr, displayedPosition.pos[0], displayedPosition.pos[1], displayedPosition.pos[2]);
 
     setMovementSettings();
-    world->rotateObject(ptr, position.rot[0], position.rot[1], position.rot[2]);
+    world->rotateObject(ptr, displayedPosition.rot[0], displayedPosition.rot[1], displayedPosition.rot[2]);
+}
+
+void DedicatedActor::addPositionSnapshot()
+{
+    bool isMoving = direction.pos[0] != 0 || direction.pos[1] != 0 || direction.pos[2] != 0;
+
+    if (hasPositionTimestamp)
+        positionSnapshots.addSnapshot(position, positionTimestamp, isMoving);
+    else
+        positionSnapshots.reset(position);
 }
 
 void DedicatedActor::setMovementSettings()
@@ -126,6 +125,7 @@ void DedicatedActor::setPosition()
 {
     MWBase::World *world = MWBase::Environment::get().getWorld();
     world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
+    positionSnapshots.reset(position);
 }
 
 void DedicatedActor::setAnimFlags()
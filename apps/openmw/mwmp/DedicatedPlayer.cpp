@@ -35,6 +35,7 @@
 #include "GUIController.hpp"
 #include "CellController.hpp"
 #include "MechanicsHelper.hpp"
+#include "Networking.hpp"
 #include "RecordHelper.hpp"
 
 
@@ -115,27 +116,19 @@ void DedicatedPlayer::move(float dt)
 {
     if (!reference) return;
 
-    ESM::Position refPos = ptr.getRefData().getPosition();
     MWBase::World *world = MWBase::Environment::get().getWorld();
-    const int maxInterpolationDistance = 40;
 
-    // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate =
-            abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance &&
-            abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance &&
-            abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    // Display the position interpolated from the ones received, falling back to the latest
+    // position known if none have been received yet
+    ESM::Position displayedPosition;
 
-    if (shouldInterpolate)
-    {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-
-        world->moveObject(ptr, lerp.x(), lerp.y(), lerp.z());
-    }
+    if (positionSnapshots.getPosition(displayedPosition))
+        mwmp::Main::get().getNetworking()->getNetworkStats()->countInterpolatedPlayer();
     else
-        world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
+        displayedPosition = position;
 
-    world->rotateObject(ptr, position.rot[0], 0, position.rot[2]);
+    world->moveObject(ptr, displayedPosition.pos[0], displayedPosition.pos[1], displayedPosition.pos[2]);
+    world->rotateObject(ptr, displayedPosition.rot[0], 0, displayedPosition.rot[2]);
 
     MWMechanics::Movement *move = &ptr.getClass().getMovementSettings(ptr);
     move->mPosition[0] = direction.pos[0];
@@ -151,6 +144,16 @@ void DedicatedPlayer::move(float dt)
     }
 }
 
+void DedicatedPlayer::addPositionSnapshot()
+{
+    bool isMoving = direction.pos[0] != 0 || direction.pos[1] != 0 || direction.pos[2] != 0;
+
+    if (hasPositionTimestamp)
+        positionSnapshots.addSnapshot(position, positionTimestamp, isMoving);
+    else
+        positionSnapshots.reset(position);
+}
+
 void DedicatedPlayer::setBaseInfo()
 {
     // Use the previous race if the new one doesn't exist
@@ -402,6 +405,7 @@ void DedicatedPlayer::setCell()
     // Allow this player's reference to move across a cell now that a manual cell
     // update has been called
     setPtr(world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]));
+    positionSnapshots.reset(position);
 
     // Remove the marker entirely if this player has moved to an interior that is inactive for us
     if (!cell.isExterior() && !Main::get().getCellController()->isActiveWorldCell(cell))
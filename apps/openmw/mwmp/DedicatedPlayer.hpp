@@ -12,6 +12,8 @@
 
 #include "../mwworld/manualref.hpp"
 
+#include "SnapshotBuffer.hpp"
+
 #include <map>
 #include <RakNetTypes.h>
 
@@ -33,6 +35,7 @@ namespace mwmp
         void update(float dt);
 
         void move(float dt);
+        void addPositionSnapshot();
         void setBaseInfo();
         void setStatsDynamic();
         void setAnimFlags();
@@ -75,6 +78,8 @@ namespace mwmp
 
         MWWorld::Ptr ptr;
 
+        SnapshotBuffer positionSnapshots;
+
         ESM::CustomMarker marker;
         bool markerEnabled;
 
@@ -1,4 +1,5 @@
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Utils.hpp>
 
 #include "../mwbase/environment.hpp"
 
@@ -105,6 +106,8 @@ void LocalActor::updatePosition(bool forceUpdate)
     {
         posWasChanged = posIsChanging;
         position = ptr.getRefData().getPosition();
+        hasPositionTimestamp = true;
+        positionTimestamp = Utils::getSteadyMilliseconds();
         mwmp::Main::get().getNetworking()->getActorList()->addPositionActor(*this);
     }
 }
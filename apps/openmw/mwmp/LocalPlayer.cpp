@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <cmath>
+
+#include <osg/Math>
+
 #include <components/esm/esmwriter.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Base/InventorySync.hpp>
 #include <components/openmw-mp/Utils.hpp>
 
 #include "../mwbase/environment.hpp"
@@ -81,6 +87,11 @@ LocalPlayer::LocalPlayer()
     isReceivingQuickKeys = false;
     isPlayingAnimation = false;
     diedSinceArrestAttempt = false;
+
+    dirtyCategories = DIRTY_ALL;
+    timeSinceDirtySweep = 0;
+    timeSincePositionSent = 0;
+    lastSentPosition = {};
 }
 
 LocalPlayer::~LocalPlayer()
@@ -88,6 +99,82 @@ LocalPlayer::~LocalPlayer()
 
 }
 
+void LocalPlayer::removeItem(const mwmp::Item& item, int count)
+{
+    MWWorld::Ptr ptrPlayer = getPlayerPtr();
+    MWWorld::ContainerStore &ptrStore = ptrPlayer.getClass().getContainerStore(ptrPlayer);
+
+    // Take the items from the stack closest to the one the server meant, the same way the server
+    // keeps track of which stacks are left, before falling back to any stacks with the same refId
+    MWWorld::Ptr itemPtr;
+
+    for (MWWorld::ContainerStoreIterator storeIterator = ptrStore.begin(); storeIterator != ptrStore.end(); ++storeIterator)
+    {
+        if (Misc::StringUtils::ciEqual(item.refId, storeIterator->getCellRef().getRefId()) &&
+            item.charge == storeIterator->getCellRef().getCharge() &&
+            Misc::StringUtils::ciEqual(item.soul, storeIterator->getCellRef().getSoul()))
+        {
+            if (!itemPtr || std::abs(storeIterator->getCellRef().getEnchantmentCharge() - item.enchantmentCharge) <
+                std::abs(itemPtr.getCellRef().getEnchantmentCharge() - item.enchantmentCharge))
+            {
+                itemPtr = *storeIterator;
+            }
+        }
+    }
+
+    if (itemPtr)
+        count -= ptrStore.remove(itemPtr, count, ptrPlayer);
+
+    if (count > 0)
+        ptrStore.remove(item.refId, count, ptrPlayer);
+}
+
+std::vector<mwmp::Item> LocalPlayer::getInventoryItems()
+{
+    MWWorld::Ptr ptrPlayer = getPlayerPtr();
+    MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
+    std::vector<mwmp::Item> items;
+    mwmp::Item item;
+
+    for (const auto &iter : ptrInventory)
+    {
+        item.refId = iter.getCellRef().getRefId();
+
+        // Skip any items that somehow have clientside-only dynamic IDs
+        if (item.refId.find("$dynamic") != std::string::npos)
+            continue;
+
+        // Skip bound items
+        if (MWBase::Environment::get().getMechanicsManager()->isBoundItem(item.refId))
+            continue;
+
+        item.count = iter.getRefData().getCount();
+        item.charge = iter.getCellRef().getCharge();
+        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
+        item.soul = iter.getCellRef().getSoul();
+
+        items.push_back(item);
+    }
+
+    return items;
+}
+
+std::vector<ESM::Spell> LocalPlayer::getSpellbookSpells()
+{
+    MWWorld::Ptr ptrPlayer = getPlayerPtr();
+    MWMechanics::Spells &ptrSpells = ptrPlayer.getClass().getCreatureStats(ptrPlayer).getSpells();
+    std::vector<ESM::Spell> spells;
+
+    // Only include spells in the spellbook, while ignoring abilities, powers, etc.
+    for (const auto &spell : ptrSpells)
+    {
+        if (spell.first->mData.mType == ESM::Spell::ST_Spell)
+            spells.push_back(*spell.first);
+    }
+
+    return spells;
+}
+
 Networking *LocalPlayer::getNetworking()
 {
     return mwmp::Main::get().getNetworking();
@@ -103,21 +190,53 @@ void LocalPlayer::update()
     static float updateTimer = 0;
     const float timeoutSec = 0.015;
 
+    // Everything gets compared once in a while regardless of what was marked as dirty, to catch
+    // changes made by code that doesn't mark them, such as equipment wearing down in combat
+    const float dirtySweepSec = 1.0;
+
     if ((updateTimer += MWBase::Environment::get().getFrameDuration()) >= timeoutSec)
     {
+        timeSincePositionSent += updateTimer;
+        timeSinceDirtySweep += updateTimer;
         updateTimer = 0;
+
+        if (timeSinceDirtySweep >= dirtySweepSec)
+        {
+            timeSinceDirtySweep = 0;
+            dirtyCategories = DIRTY_ALL;
+        }
+
+        unsigned int categories = dirtyCategories;
+        dirtyCategories = 0;
+
         updateCell();
         updatePosition();
         updateAnimFlags();
         updateAttackOrCast();
-        updateEquipment();
+
+        // Dynamic stats regenerate and drain all the time, so they are always compared
         updateStatsDynamic();
-        updateAttributes();
-        updateSkills();
-        updateLevel();
-        updateBounty();
-        updateReputation();
+
+        if (categories & DIRTY_EQUIPMENT)
+            updateEquipment();
+        if (categories & DIRTY_ATTRIBUTES)
+            updateAttributes();
+        if (categories & DIRTY_SKILLS)
+            updateSkills();
+        if (categories & DIRTY_LEVEL)
+            updateLevel();
+        if (categories & DIRTY_BOUNTY)
+            updateBounty();
+        if (categories & DIRTY_REPUTATION)
+            updateReputation();
     }
+
+    updateFrameTime();
+}
+
+void LocalPlayer::markDirty(unsigned int categories)
+{
+    dirtyCategories |= categories;
 }
 
 bool LocalPlayer::processCharGen()
@@ -367,36 +486,66 @@ void LocalPlayer::updatePosition(bool forceUpdate)
     MWBase::World *world = MWBase::Environment::get().getWorld();
     MWWorld::Ptr ptrPlayer = world->getPlayerPtr();
 
+    // Players who aren't moving only send their position this often
+    const float heartbeatSec = 2.0;
+
     static bool posWasChanged = false;
     static bool isJumping = false;
     static bool sentJumpEnd = true;
-    static float oldRot[2] = {0};
 
     position = ptrPlayer.getRefData().getPosition();
 
     bool posIsChanging = (direction.pos[0] != 0 || direction.pos[1] != 0 ||
         direction.rot[0] != 0 || direction.rot[1] != 0 || direction.rot[2] != 0);
+    bool isAnimating = false;
 
     // Animations can change a player's position without actually creating directional movement,
     // so update positions accordingly
     if (!posIsChanging && isPlayingAnimation)
     {
         if (MWBase::Environment::get().getMechanicsManager()->checkAnimationPlaying(ptrPlayer, animation.groupname))
-            posIsChanging = true;
+            posIsChanging = isAnimating = true;
         else
             isPlayingAnimation = false;
     }
 
-    if (forceUpdate || posIsChanging || posWasChanged)
+    float distanceMoved = (position.asVec3() - lastSentPosition.asVec3()).length();
+    float rotationChanged = 0;
+
+    for (int i = 0; i < 3; i += 2)
     {
-        oldRot[0] = position.rot[0];
-        oldRot[1] = position.rot[2];
+        float angle = std::fmod(std::abs(position.rot[i] - lastSentPosition.rot[i]), 2 * osg::PIf);
+        rotationChanged += std::min(angle, 2 * osg::PIf - angle);
+    }
+
+    // Players can also be moved without any input of their own, such as when falling or
+    // being pushed by a script
+    if (distanceMoved > 1 || rotationChanged > 0.01)
+        posIsChanging = true;
+
+    bool shouldSend;
+
+    if (forceUpdate)
+        shouldSend = true;
+    else if (posIsChanging)
+        shouldSend = timeSincePositionSent >= getPositionSendInterval(distanceMoved, rotationChanged, isAnimating);
+    // Send the position a player stopped at right away
+    else if (posWasChanged)
+        shouldSend = true;
+    else
+        shouldSend = timeSincePositionSent >= heartbeatSec;
 
+    if (shouldSend)
+    {
         posWasChanged = posIsChanging;
+        lastSentPosition = position;
+        timeSincePositionSent = 0;
 
         if (!isJumping && !world->isOnGround(ptrPlayer) && !world->isFlying(ptrPlayer))
             isJumping = true;
 
+        hasPositionTimestamp = true;
+        positionTimestamp = Utils::getSteadyMilliseconds();
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
@@ -410,11 +559,34 @@ void LocalPlayer::updatePosition(bool forceUpdate)
     {
         sentJumpEnd = true;
         position = ptrPlayer.getRefData().getPosition();
+        lastSentPosition = position;
+        timeSincePositionSent = 0;
+        hasPositionTimestamp = true;
+        positionTimestamp = Utils::getSteadyMilliseconds();
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->setPlayer(this);
         getNetworking()->getPlayerPacket(ID_PLAYER_POSITION)->Send();
     }
 }
 
+float LocalPlayer::getPositionSendInterval(float distanceMoved, float rotationChanged, bool isAnimating) const
+{
+    // Running, turning quickly and animations are sent on every update, while slower movement is
+    // sent less often because others can't tell much apart between its packets
+    const float minIntervalSec = 0.015;
+    const float maxIntervalSec = 0.06;
+    const float fastSpeed = 300; // in units per second
+    const float fastTurnSpeed = 1.5; // in radians per second
+
+    if (isAnimating || timeSincePositionSent <= 0)
+        return minIntervalSec;
+
+    if (rotationChanged / timeSincePositionSent >= fastTurnSpeed)
+        return minIntervalSec;
+
+    float speedFraction = std::min(distanceMoved / timeSincePositionSent / fastSpeed, 1.0f);
+    return maxIntervalSec - (maxIntervalSec - minIntervalSec) * speedFraction;
+}
+
 void LocalPlayer::updateCell(bool forceUpdate)
 {
     const ESM::Cell *ptrCell = MWBase::Environment::get().getWorld()->getPlayerPtr().getCell()->getCell();
@@ -659,6 +831,32 @@ void LocalPlayer::updateAnimFlags(bool forceUpdate)
     }
 }
 
+void LocalPlayer::updateFrameTime()
+{
+    // Report our average frame time every few seconds, so the server can take it into account
+    // when choosing which player should have authority over the actors in a cell
+    static float reportTimer = 0;
+    static unsigned int frameCount = 0;
+    const float reportIntervalSec = 5;
+
+    if (!frameTimeReportsRequested)
+    {
+        reportTimer = 0;
+        frameCount = 0;
+        return;
+    }
+
+    reportTimer += MWBase::Environment::get().getFrameDuration();
+    frameCount++;
+
+    if (reportTimer >= reportIntervalSec)
+    {
+        sendFrameTime(reportTimer / frameCount);
+        reportTimer = 0;
+        frameCount = 0;
+    }
+}
+
 void LocalPlayer::addItems()
 {
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
@@ -794,12 +992,9 @@ void LocalPlayer::addTopics()
 
 void LocalPlayer::removeItems()
 {
-    MWWorld::Ptr ptrPlayer = getPlayerPtr();
-    MWWorld::ContainerStore &ptrStore = ptrPlayer.getClass().getContainerStore(ptrPlayer);
-
     for (const auto &item : inventoryChanges.items)
     {
-        ptrStore.remove(item.refId, item.count, ptrPlayer);
+        removeItem(item, item.count);
 
         LOG_APPEND(TimedLog::LOG_INFO, "- Removing inventory item %s with count %i", item.refId.c_str(), item.count);
     }
@@ -819,6 +1014,65 @@ void LocalPlayer::removeSpells()
     }
 }
 
+void LocalPlayer::applyInventoryDelta()
+{
+    // The delta only turns our inventory into the one the server wants if we have what the server
+    // thinks we have, so ask for all of it otherwise
+    if (mwmp::InventorySync::getInventoryChecksum(getInventoryItems()) != inventoryChanges.baseChecksum)
+    {
+        LOG_APPEND(TimedLog::LOG_INFO, "- Inventory differs from the one the changes are for, requesting all of it");
+
+        inventoryChanges.items.clear();
+        inventoryChanges.action = InventoryChanges::REQUEST_SET;
+        getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->setPlayer(this);
+        getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->Send();
+        return;
+    }
+
+    std::vector<mwmp::Item> addedItems;
+
+    for (const auto &item : inventoryChanges.items)
+    {
+        if (item.count < 0)
+        {
+            removeItem(item, -item.count);
+
+            LOG_APPEND(TimedLog::LOG_INFO, "- Removing inventory item %s with count %i", item.refId.c_str(), -item.count);
+        }
+        else
+            addedItems.push_back(item);
+    }
+
+    inventoryChanges.items.swap(addedItems);
+    addItems();
+    inventoryChanges.items.swap(addedItems);
+}
+
+void LocalPlayer::applySpellbookDelta()
+{
+    std::vector<std::string> spellIds;
+
+    for (const auto &spell : getSpellbookSpells())
+        spellIds.push_back(spell.mId);
+
+    if (mwmp::InventorySync::getSpellbookChecksum(spellIds) != spellbookChanges.baseChecksum)
+    {
+        LOG_APPEND(TimedLog::LOG_INFO, "- Spellbook differs from the one the changes are for, requesting all of it");
+
+        spellbookChanges.spells.clear();
+        spellbookChanges.action = SpellbookChanges::REQUEST_SET;
+        getNetworking()->getPlayerPacket(ID_PLAYER_SPELLBOOK)->setPlayer(this);
+        getNetworking()->getPlayerPacket(ID_PLAYER_SPELLBOOK)->Send();
+        return;
+    }
+
+    spellbookChanges.spells.swap(spellbookChanges.removedSpells);
+    removeSpells();
+    spellbookChanges.spells.swap(spellbookChanges.removedSpells);
+
+    addSpells();
+}
+
 void LocalPlayer::removeSpellsActive()
 {
     MWWorld::Ptr ptrPlayer = getPlayerPtr();
@@ -1439,32 +1693,7 @@ void LocalPlayer::sendInventory()
 {
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending entire inventory to server");
 
-    MWWorld::Ptr ptrPlayer = getPlayerPtr();
-    MWWorld::InventoryStore &ptrInventory = ptrPlayer.getClass().getInventoryStore(ptrPlayer);
-    mwmp::Item item;
-
-    inventoryChanges.items.clear();
-
-    for (const auto &iter : ptrInventory)
-    {
-        item.refId = iter.getCellRef().getRefId();
-
-        // Skip any items that somehow have clientside-only dynamic IDs
-        if (item.refId.find("$dynamic") != std::string::npos)
-            continue;
-
-        // Skip bound items
-        if (MWBase::Environment::get().getMechanicsManager()->isBoundItem(item.refId))
-            continue;
-
-        item.count = iter.getRefData().getCount();
-        item.charge = iter.getCellRef().getCharge();
-        item.enchantmentCharge = iter.getCellRef().getEnchantmentCharge();
-        item.soul = iter.getCellRef().getSoul();
-
-        inventoryChanges.items.push_back(item);
-    }
-
+    inventoryChanges.items = getInventoryItems();
     inventoryChanges.action = InventoryChanges::SET;
     getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->setPlayer(this);
     getNetworking()->getPlayerPacket(ID_PLAYER_INVENTORY)->Send();
@@ -1538,18 +1767,7 @@ void LocalPlayer::sendStoredItemRemovals()
 
 void LocalPlayer::sendSpellbook()
 {
-    MWWorld::Ptr ptrPlayer = getPlayerPtr();
-    MWMechanics::Spells &ptrSpells = ptrPlayer.getClass().getCreatureStats(ptrPlayer).getSpells();
-
-    spellbookChanges.spells.clear();
-
-    // Send spells in spellbook, while ignoring abilities, powers, etc.
-    for (const auto &spell : ptrSpells)
-    {
-        if (spell.first->mData.mType == ESM::Spell::ST_Spell)
-            spellbookChanges.spells.push_back(*spell.first);
-    }
-
+    spellbookChanges.spells = getSpellbookSpells();
     spellbookChanges.action = SpellbookChanges::SET;
     getNetworking()->getPlayerPacket(ID_PLAYER_SPELLBOOK)->setPlayer(this);
     getNetworking()->getPlayerPacket(ID_PLAYER_SPELLBOOK)->Send();
@@ -1788,6 +2006,15 @@ void LocalPlayer::sendSelectedSpell(const std::string& newSelectedSpellId)
     getNetworking()->getPlayerPacket(ID_PLAYER_MISCELLANEOUS)->Send();
 }
 
+void LocalPlayer::sendFrameTime(float newAverageFrameTime)
+{
+    miscellaneousChangeType = mwmp::MISCELLANEOUS_CHANGE_TYPE::FRAME_TIME;
+    averageFrameTime = newAverageFrameTime;
+
+    getNetworking()->getPlayerPacket(ID_PLAYER_MISCELLANEOUS)->setPlayer(this);
+    getNetworking()->getPlayerPacket(ID_PLAYER_MISCELLANEOUS)->Send();
+}
+
 void LocalPlayer::sendItemUse(const MWWorld::Ptr& itemPtr, bool itemMagicState, char currentDrawState)
 {
     usedItem.refId = itemPtr.getCellRef().getRefId();
@@ -12,6 +12,19 @@ namespace mwmp
     {
     public:
 
+        // Categories of player state that have to be compared against what was last sent
+        // on the next update, set by the mechanics and inventory code that changes them
+        enum DIRTY_CATEGORY
+        {
+            DIRTY_EQUIPMENT = 1 << 0,
+            DIRTY_ATTRIBUTES = 1 << 1,
+            DIRTY_SKILLS = 1 << 2,
+            DIRTY_LEVEL = 1 << 3,
+            DIRTY_BOUNTY = 1 << 4,
+            DIRTY_REPUTATION = 1 << 5,
+            DIRTY_ALL = (1 << 6) - 1
+        };
+
         LocalPlayer();
         virtual ~LocalPlayer();
 
@@ -26,6 +39,7 @@ namespace mwmp
         unsigned int lastEnchantmentQuantity;
 
         void update();
+        void markDirty(unsigned int categories);
 
         bool processCharGen();
         bool isLoggedIn();
@@ -42,6 +56,7 @@ namespace mwmp
         void updateInventory(bool forceUpdate = false);
         void updateAttackOrCast();
         void updateAnimFlags(bool forceUpdate = false);
+        void updateFrameTime();
 
         void addItems();
         void addSpells();
@@ -53,6 +68,9 @@ namespace mwmp
         void removeSpells();
         void removeSpellsActive();
 
+        void applyInventoryDelta();
+        void applySpellbookDelta();
+
         void die();
         void resurrect();
 
@@ -104,6 +122,7 @@ namespace mwmp
         void sendWerewolfState(bool isWerewolf);
         void sendMarkLocation(const ESM::Cell& newMarkCell, const ESM::Position& newMarkPosition);
         void sendSelectedSpell(const std::string& newSelectedSpellId);
+        void sendFrameTime(float newAverageFrameTime);
         void sendItemUse(const MWWorld::Ptr& itemPtr, bool usingItemMagic = false, char currentDrawState = 0);
         void sendCellStates();
 
@@ -123,6 +142,16 @@ namespace mwmp
     private:
         Networking *getNetworking();
 
+        void removeItem(const mwmp::Item& item, int count);
+        std::vector<mwmp::Item> getInventoryItems();
+        std::vector<ESM::Spell> getSpellbookSpells();
+        float getPositionSendInterval(float distanceMoved, float rotationChanged, bool isAnimating) const;
+
+        unsigned int dirtyCategories;
+        float timeSinceDirtySweep;
+        float timeSincePositionSent;
+        ESM::Position lastSentPosition;
+
     };
 }
 
@@ -46,6 +46,7 @@
 #include "CellController.hpp"
 #include "MechanicsHelper.hpp"
 #include "RecordHelper.hpp"
+#include "SnapshotBuffer.hpp"
 
 using namespace mwmp;
 
@@ -133,6 +134,9 @@ bool Main::init(std::vector<std::string> &content, Files::Collections &collectio
 
     int logLevel = manager.getInt("logLevel", "General");
     TimedLog::SetLevel(logLevel);
+
+    SnapshotBuffer::setInterpolationDelay(manager.getFloat("interpolationDelay", "Movement"));
+    SnapshotBuffer::setMaxExtrapolation(manager.getFloat("maxExtrapolation", "Movement"));
     if (address.empty())
     {
         pMain->server = manager.getString("destinationAddress", "General");
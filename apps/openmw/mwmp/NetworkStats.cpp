@@ -0,0 +1,181 @@
+#include "NetworkStats.hpp"
+
+#include <cstdlib>
+#include <string>
+
+#include <osg/Stats>
+
+#include <RakNetStatistics.h>
+
+#include <components/debug/debuglog.hpp>
+#include <components/openmw-mp/Packets/BasePacket.hpp>
+
+using namespace mwmp;
+
+NetworkStats::CountingScheduler::CountingScheduler() : networkStats(nullptr), family(SYSTEM)
+{
+
+}
+
+uint32_t NetworkStats::CountingScheduler::Send(BasePacket *packet, RakNet::BitStream *bitStream, PacketPriority priority,
+                                               PacketReliability reliability, char orderChannel,
+                                               RakNet::AddressOrGUID destination, bool broadcast)
+{
+    networkStats->recordOutgoing(family, bitStream->GetNumberOfBytesUsed());
+    return networkStats->peer->Send(bitStream, priority, reliability, orderChannel, destination, broadcast);
+}
+
+NetworkStats::NetworkStats(RakNet::RakPeerInterface *peer) : peer(peer), currentFrame(), lastFrame(), frameCount(0)
+{
+    for (int i = 0; i < FAMILY_COUNT; ++i)
+    {
+        schedulers[i].networkStats = this;
+        schedulers[i].family = static_cast<PacketFamily>(i);
+    }
+
+    lastFrame.roundTripTime = -1;
+
+    if (const auto path = std::getenv("TES3MP_NET_STATS_FILE"))
+    {
+        dumpFile.open(path, std::ios_base::out);
+
+        if (dumpFile.is_open())
+        {
+            Log(Debug::Info) << "Network stats will be written to: " << path;
+            dumpFile << "Frame,Stat,Value\n";
+        }
+        else
+            Log(Debug::Warning) << "Failed to open file for network stats: " << path;
+    }
+}
+
+PacketScheduler *NetworkStats::getScheduler(PacketFamily family)
+{
+    return &schedulers[family];
+}
+
+void NetworkStats::recordIncoming(PacketFamily family, uint8_t packetID, uint32_t bytes, double processingTime)
+{
+    FamilyTotals &totals = currentFrame.families[family];
+    totals.packetsIn++;
+    totals.bytesIn += bytes;
+    totals.processingTime += processingTime;
+
+    currentFrame.processingTimes[packetID] += processingTime;
+    currentFrame.processedTypes[packetID] = true;
+}
+
+void NetworkStats::recordOutgoing(PacketFamily family, uint32_t bytes)
+{
+    FamilyTotals &totals = currentFrame.families[family];
+    totals.packetsOut++;
+    totals.bytesOut += bytes;
+}
+
+void NetworkStats::countInterpolatedPlayer()
+{
+    currentFrame.interpolatedPlayers++;
+}
+
+void NetworkStats::countInterpolatedActor()
+{
+    currentFrame.interpolatedActors++;
+}
+
+void NetworkStats::endFrame(RakNet::SystemAddress serverAddress)
+{
+    currentFrame.roundTripTime = peer->GetAveragePing(serverAddress);
+
+    RakNet::RakNetStatistics statistics;
+
+    if (peer->GetStatistics(serverAddress, &statistics) != nullptr)
+        currentFrame.packetLoss = statistics.packetlossLastSecond;
+
+    lastFrame = currentFrame;
+    currentFrame = FrameTotals();
+    frameCount++;
+
+    if (dumpFile.is_open())
+        writeFrame();
+}
+
+void NetworkStats::reportStats(unsigned int frameNumber, osg::Stats &stats) const
+{
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    double processingTime = 0;
+
+    for (int i = 0; i < FAMILY_COUNT; ++i)
+    {
+        const FamilyTotals &totals = lastFrame.families[i];
+        const std::string familyName = getFamilyName(static_cast<PacketFamily>(i));
+
+        stats.setAttribute(frameNumber, "Net " + familyName + " In", totals.packetsIn);
+        stats.setAttribute(frameNumber, "Net " + familyName + " Out", totals.packetsOut);
+        stats.setAttribute(frameNumber, "Net " + familyName + " Bytes In", totals.bytesIn);
+        stats.setAttribute(frameNumber, "Net " + familyName + " Bytes Out", totals.bytesOut);
+        stats.setAttribute(frameNumber, "Net " + familyName + " Process us", totals.processingTime * 1000000);
+
+        bytesIn += totals.bytesIn;
+        bytesOut += totals.bytesOut;
+        processingTime += totals.processingTime;
+    }
+
+    stats.setAttribute(frameNumber, "Net Bytes In", bytesIn);
+    stats.setAttribute(frameNumber, "Net Bytes Out", bytesOut);
+    stats.setAttribute(frameNumber, "Net Process us", processingTime * 1000000);
+
+    // Leave the round trip time out until RakNet has measured it
+    if (lastFrame.roundTripTime >= 0)
+        stats.setAttribute(frameNumber, "Net RTT ms", lastFrame.roundTripTime);
+
+    stats.setAttribute(frameNumber, "Net Loss %", lastFrame.packetLoss * 100);
+    stats.setAttribute(frameNumber, "Net Interp Players", lastFrame.interpolatedPlayers);
+    stats.setAttribute(frameNumber, "Net Interp Actors", lastFrame.interpolatedActors);
+}
+
+const char *NetworkStats::getFamilyName(PacketFamily family)
+{
+    switch (family)
+    {
+        case SYSTEM:
+            return "System";
+        case PLAYER:
+            return "Player";
+        case ACTOR:
+            return "Actor";
+        case OBJECT:
+            return "Object";
+        case WORLDSTATE:
+            return "Worldstate";
+        default:
+            return "Unknown";
+    }
+}
+
+void NetworkStats::writeFrame()
+{
+    for (int i = 0; i < FAMILY_COUNT; ++i)
+    {
+        const FamilyTotals &totals = lastFrame.families[i];
+        const char *familyName = getFamilyName(static_cast<PacketFamily>(i));
+
+        dumpFile << frameCount << "," << familyName << " Packets In," << totals.packetsIn << "\n";
+        dumpFile << frameCount << "," << familyName << " Packets Out," << totals.packetsOut << "\n";
+        dumpFile << frameCount << "," << familyName << " Bytes In," << totals.bytesIn << "\n";
+        dumpFile << frameCount << "," << familyName << " Bytes Out," << totals.bytesOut << "\n";
+        dumpFile << frameCount << "," << familyName << " Process us," << totals.processingTime * 1000000 << "\n";
+    }
+
+    // Only list the types of packets that were actually received during the frame
+    for (int packetID = 0; packetID < 256; ++packetID)
+    {
+        if (lastFrame.processedTypes[packetID])
+            dumpFile << frameCount << ",Process us " << packetID << "," << lastFrame.processingTimes[packetID] * 1000000 << "\n";
+    }
+
+    dumpFile << frameCount << ",RTT ms," << lastFrame.roundTripTime << "\n";
+    dumpFile << frameCount << ",Loss %," << lastFrame.packetLoss * 100 << "\n";
+    dumpFile << frameCount << ",Interp Players," << lastFrame.interpolatedPlayers << "\n";
+    dumpFile << frameCount << ",Interp Actors," << lastFrame.interpolatedActors << "\n";
+}
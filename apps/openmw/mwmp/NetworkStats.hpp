@@ -0,0 +1,110 @@
+#ifndef OPENMW_NETWORKSTATS_HPP
+#define OPENMW_NETWORKSTATS_HPP
+
+#include <cstdint>
+#include <fstream>
+
+#include <RakPeerInterface.h>
+
+#include <components/openmw-mp/Packets/PacketScheduler.hpp>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace mwmp
+{
+    /*
+        Records what the networking costs the client in every frame: the packets and bytes
+        received and sent for every family of packets, the time spent processing every type of
+        received packet, the round trip time and packet loss of the connection to the server, and
+        the number of dedicated players and actors whose positions got interpolated
+
+        Each frame's totals are reported through the profiler overlay and, if the
+        TES3MP_NET_STATS_FILE environment variable holds the path of a file, written to it as CSV
+        rows of frame, stat and value
+    */
+    class NetworkStats
+    {
+    public:
+
+        enum PacketFamily
+        {
+            SYSTEM = 0,
+            PLAYER,
+            ACTOR,
+            OBJECT,
+            WORLDSTATE,
+            FAMILY_COUNT
+        };
+
+        NetworkStats(RakNet::RakPeerInterface *peer);
+
+        // Get the scheduler that counts the packets of a family as they are sent
+        PacketScheduler *getScheduler(PacketFamily family);
+
+        void recordIncoming(PacketFamily family, uint8_t packetID, uint32_t bytes, double processingTime);
+        void recordOutgoing(PacketFamily family, uint32_t bytes);
+
+        void countInterpolatedPlayer();
+        void countInterpolatedActor();
+
+        // Close the frame being recorded, making its totals the ones reported, and start a new one
+        void endFrame(RakNet::SystemAddress serverAddress);
+
+        void reportStats(unsigned int frameNumber, osg::Stats &stats) const;
+
+    private:
+
+        class CountingScheduler : public PacketScheduler
+        {
+        public:
+            CountingScheduler();
+
+            uint32_t Send(BasePacket *packet, RakNet::BitStream *bitStream, PacketPriority priority,
+                          PacketReliability reliability, char orderChannel, RakNet::AddressOrGUID destination,
+                          bool broadcast) override;
+
+            NetworkStats *networkStats;
+            PacketFamily family;
+        };
+
+        struct FamilyTotals
+        {
+            unsigned int packetsIn;
+            unsigned int packetsOut;
+            uint64_t bytesIn;
+            uint64_t bytesOut;
+            double processingTime;
+        };
+
+        struct FrameTotals
+        {
+            FamilyTotals families[FAMILY_COUNT];
+            double processingTimes[256];
+            bool processedTypes[256];
+
+            unsigned int interpolatedPlayers;
+            unsigned int interpolatedActors;
+
+            int roundTripTime;
+            float packetLoss;
+        };
+
+        static const char *getFamilyName(PacketFamily family);
+
+        void writeFrame();
+
+        RakNet::RakPeerInterface *peer;
+        CountingScheduler schedulers[FAMILY_COUNT];
+
+        FrameTotals currentFrame;
+        FrameTotals lastFrame;
+        unsigned int frameCount;
+
+        std::ofstream dumpFile;
+    };
+}
+
+#endif //OPENMW_NETWORKSTATS_HPP
@@ -1,3 +1,4 @@
+#include <chrono>
 #include <stdexcept>
 #include <iostream>
 #include <string>
@@ -195,7 +196,7 @@ std::string listComparison(PacketPreInit::PluginContainer checksums, PacketPreIn
 
 Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemPacketController(peer),
     playerPacketController(peer), actorPacketController(peer), objectPacketController(peer),
-    worldstatePacketController(peer)
+    worldstatePacketController(peer), networkStats(peer)
 {
 
     RakNet::SocketDescriptor sd;
@@ -209,6 +210,13 @@ Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemP
     objectPacketController.SetStream(0, &bsOut);
     worldstatePacketController.SetStream(0, &bsOut);
 
+    // Count every packet sent, by family, for the network stats
+    systemPacketController.SetScheduler(networkStats.getScheduler(NetworkStats::SYSTEM));
+    playerPacketController.SetScheduler(networkStats.getScheduler(NetworkStats::PLAYER));
+    actorPacketController.SetScheduler(networkStats.getScheduler(NetworkStats::ACTOR));
+    objectPacketController.SetScheduler(networkStats.getScheduler(NetworkStats::OBJECT));
+    worldstatePacketController.SetScheduler(networkStats.getScheduler(NetworkStats::WORLDSTATE));
+
     connected = 0;
     ProcessorInitializer();
 }
@@ -225,6 +233,9 @@ void Networking::update()
     RakNet::Packet *packet;
     std::string errmsg = "";
 
+    // Everything sent, received and interpolated since the last update belongs to the previous frame
+    networkStats.endFrame(serverAddr);
+
     for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
     {
         switch (packet->data[0])
@@ -366,6 +377,7 @@ void Networking::preInit(std::vector<std::string> &content, Files::Collections &
             unsigned crc32 = Utils::crc32Checksum(col.getPath(*it).string());
             hashList.push_back(crc32);
             checksums.push_back(make_pair(*it, hashList));
+            contentChecksums.push_back(crc32);
 
             LOG_APPEND(TimedLog::LOG_WARN, "idx: %d\tchecksum: %X\tfile: %s\n", idx, crc32, col.getPath(*it).string().c_str());
         }
@@ -428,31 +440,49 @@ void Networking::receiveMessage(RakNet::Packet *packet)
     if (packet->length < 2)
         return;
 
+    auto processingStart = std::chrono::steady_clock::now();
+    NetworkStats::PacketFamily family;
+
     if (systemPacketController.ContainsPacket(packet->data[0]))
     {
+        family = NetworkStats::SYSTEM;
+
         if (!SystemProcessor::Process(*packet))
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled SystemPacket with identifier %i has arrived", packet->data[0]);
     }
     else if (playerPacketController.ContainsPacket(packet->data[0]))
     {
+        family = NetworkStats::PLAYER;
+
         if (!PlayerProcessor::Process(*packet))
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled PlayerPacket with identifier %i has arrived", packet->data[0]);
     }
     else if (actorPacketController.ContainsPacket(packet->data[0]))
     {
+        family = NetworkStats::ACTOR;
+
         if (!ActorProcessor::Process(*packet, actorList))
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
     }
     else if (objectPacketController.ContainsPacket(packet->data[0]))
     {
+        family = NetworkStats::OBJECT;
+
         if (!ObjectProcessor::Process(*packet, objectList))
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
     }
     else if (worldstatePacketController.ContainsPacket(packet->data[0]))
     {
+        family = NetworkStats::WORLDSTATE;
+
         if (!WorldstateProcessor::Process(*packet, worldstate))
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled WorldstatePacket with identifier %i has arrived", packet->data[0]);
     }
+    else
+        return;
+
+    std::chrono::duration<double> processingTime = std::chrono::steady_clock::now() - processingStart;
+    networkStats.recordIncoming(family, packet->data[0], packet->length, processingTime.count());
 }
 
 SystemPacket *Networking::getSystemPacket(RakNet::MessageID id)
@@ -505,6 +535,16 @@ Worldstate *Networking::getWorldstate()
     return &worldstate;
 }
 
+NetworkStats *Networking::getNetworkStats()
+{
+    return &networkStats;
+}
+
+const std::vector<unsigned int> &Networking::getContentChecksums() const
+{
+    return contentChecksums;
+}
+
 bool Networking::isConnected()
 {
     return connected;
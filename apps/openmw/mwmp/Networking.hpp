@@ -16,6 +16,7 @@
 #include <components/files/collections.hpp>
 
 #include "LocalSystem.hpp"
+#include "NetworkStats.hpp"
 #include "ActorList.hpp"
 #include "ObjectList.hpp"
 #include "Worldstate.hpp"
@@ -50,6 +51,10 @@ namespace mwmp
         ActorList *getActorList();
         ObjectList *getObjectList();
         Worldstate *getWorldstate();
+        NetworkStats *getNetworkStats();
+
+        // Get the checksums of the content files, in load order
+        const std::vector<unsigned int> &getContentChecksums() const;
 
     private:
         bool connected;
@@ -67,6 +72,10 @@ namespace mwmp
         ObjectList objectList;
         Worldstate worldstate;
 
+        NetworkStats networkStats;
+
+        std::vector<unsigned int> contentChecksums;
+
         void receiveMessage(RakNet::Packet *packet);
 
         void preInit(std::vector<std::string> &content, Files::Collections &collections);
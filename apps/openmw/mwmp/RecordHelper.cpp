@@ -1,5 +1,9 @@
 #include <components/openmw-mp/TimedLog.hpp>
 
+#include <set>
+
+#include "../mwbase/scriptmanager.hpp"
+
 #include "../mwworld/cellstore.hpp"
 #include "../mwworld/worldimp.hpp"
 
@@ -8,6 +12,124 @@
 #include "CellController.hpp"
 #include "Cell.hpp"
 
+// The state of the current batch of record overrides
+static struct
+{
+    bool isActive = false;
+    std::set<std::string> refIds;
+
+    bool hasPlayerReturn = false;
+    ESM::Cell playerCell;
+    ESM::Position playerPos;
+} batch;
+
+static void returnPlayerToCell(const ESM::Cell& playerCell, const ESM::Position& playerPos)
+{
+    MWBase::World *world = MWBase::Environment::get().getWorld();
+
+    if (playerCell.isExterior())
+        world->changeToExteriorCell(playerPos, true, true);
+    else
+        world->changeToInteriorCell(playerCell.mName, playerPos, true, true);
+}
+
+template<class RecordType>
+static void insertPendingRecords()
+{
+    std::vector<RecordType> &records = RecordHelper::PendingRecords<RecordType>::records;
+
+    if (records.empty())
+        return;
+
+    MWBase::World *world = MWBase::Environment::get().getWorld();
+    world->getModifiableStore().overrideRecords(records);
+
+    records.clear();
+    RecordHelper::PendingRecords<RecordType>::indexes.clear();
+}
+
+void RecordHelper::beginBatch()
+{
+    batch.isActive = true;
+}
+
+void RecordHelper::endBatch()
+{
+    if (!batch.isActive)
+        return;
+
+    batch.isActive = false;
+
+    insertPendingRecords<ESM::Activator>();
+    insertPendingRecords<ESM::Apparatus>();
+    insertPendingRecords<ESM::Armor>();
+    insertPendingRecords<ESM::BodyPart>();
+    insertPendingRecords<ESM::Book>();
+    insertPendingRecords<ESM::Clothing>();
+    insertPendingRecords<ESM::Container>();
+    insertPendingRecords<ESM::Creature>();
+    insertPendingRecords<ESM::Door>();
+    insertPendingRecords<ESM::Enchantment>();
+    insertPendingRecords<ESM::Ingredient>();
+    insertPendingRecords<ESM::Light>();
+    insertPendingRecords<ESM::Lockpick>();
+    insertPendingRecords<ESM::Miscellaneous>();
+    insertPendingRecords<ESM::NPC>();
+    insertPendingRecords<ESM::Potion>();
+    insertPendingRecords<ESM::Probe>();
+    insertPendingRecords<ESM::Repair>();
+    insertPendingRecords<ESM::Script>();
+    insertPendingRecords<ESM::Sound>();
+    insertPendingRecords<ESM::Spell>();
+    insertPendingRecords<ESM::Static>();
+    insertPendingRecords<ESM::Weapon>();
+
+    MWBase::World *world = MWBase::Environment::get().getWorld();
+    std::set<std::string> refIds;
+    refIds.swap(batch.refIds);
+    world->updatePtrsWithRefIds(refIds);
+
+    if (batch.hasPlayerReturn)
+    {
+        batch.hasPlayerReturn = false;
+        returnPlayerToCell(batch.playerCell, batch.playerPos);
+    }
+}
+
+bool RecordHelper::isBatchActive()
+{
+    return batch.isActive;
+}
+
+RecordHelper::ScopedBatch::ScopedBatch()
+{
+    beginBatch();
+}
+
+RecordHelper::ScopedBatch::~ScopedBatch()
+{
+    try
+    {
+        endBatch();
+    }
+    catch (std::exception &e)
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Failed to end a batch of record overrides: %s", e.what());
+    }
+}
+
+void RecordHelper::updatePtrsWithRefId(const std::string& refId)
+{
+    if (batch.isActive)
+    {
+        batch.refIds.insert(Misc::StringUtils::lowerCase(refId));
+        return;
+    }
+
+    MWBase::World *world = MWBase::Environment::get().getWorld();
+    world->updatePtrsWithRefId(refId);
+}
+
 void RecordHelper::overrideRecord(const mwmp::ActivatorRecord& record)
 {
     const ESM::Activator &recordData = record.data;
@@ -19,15 +141,14 @@ void RecordHelper::overrideRecord(const mwmp::ActivatorRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Activator>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Activator>(record.baseId))
     {
-        const ESM::Activator *baseData = world->getStore().get<ESM::Activator>().search(record.baseId);
+        const ESM::Activator *baseData = searchRecord<ESM::Activator>(record.baseId);
         ESM::Activator finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -40,7 +161,7 @@ void RecordHelper::overrideRecord(const mwmp::ActivatorRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -49,7 +170,7 @@ void RecordHelper::overrideRecord(const mwmp::ActivatorRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::ApparatusRecord& record)
@@ -63,15 +184,14 @@ void RecordHelper::overrideRecord(const mwmp::ApparatusRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Apparatus>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Apparatus>(record.baseId))
     {
-        const ESM::Apparatus *baseData = world->getStore().get<ESM::Apparatus>().search(record.baseId);
+        const ESM::Apparatus *baseData = searchRecord<ESM::Apparatus>(record.baseId);
         ESM::Apparatus finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -99,7 +219,7 @@ void RecordHelper::overrideRecord(const mwmp::ApparatusRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -108,7 +228,7 @@ void RecordHelper::overrideRecord(const mwmp::ApparatusRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::ArmorRecord& record)
@@ -122,7 +242,6 @@ void RecordHelper::overrideRecord(const mwmp::ArmorRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Armor>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
@@ -132,11 +251,11 @@ void RecordHelper::overrideRecord(const mwmp::ArmorRecord& record)
             return;
         }
         else
-            world->getModifiableStore().overrideRecord(recordData);
+            overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Armor>(record.baseId))
     {
-        const ESM::Armor *baseData = world->getStore().get<ESM::Armor>().search(record.baseId);
+        const ESM::Armor *baseData = searchRecord<ESM::Armor>(record.baseId);
         ESM::Armor finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -183,7 +302,7 @@ void RecordHelper::overrideRecord(const mwmp::ArmorRecord& record)
         if (record.baseOverrides.hasBodyParts)
             finalData.mParts.mParts = recordData.mParts.mParts;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -192,7 +311,7 @@ void RecordHelper::overrideRecord(const mwmp::ArmorRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::BodyPartRecord& record)
@@ -205,15 +324,13 @@ void RecordHelper::overrideRecord(const mwmp::BodyPartRecord& record)
         return;
     }
 
-    MWBase::World *world = MWBase::Environment::get().getWorld();
-
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::BodyPart>(record.baseId))
     {
-        const ESM::BodyPart *baseData = world->getStore().get<ESM::BodyPart>().search(record.baseId);
+        const ESM::BodyPart *baseData = searchRecord<ESM::BodyPart>(record.baseId);
         ESM::BodyPart finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -235,7 +352,7 @@ void RecordHelper::overrideRecord(const mwmp::BodyPartRecord& record)
         if (record.baseOverrides.hasFlags)
             finalData.mData.mFlags = recordData.mData.mFlags;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -255,7 +372,6 @@ void RecordHelper::overrideRecord(const mwmp::BookRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Book>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
@@ -265,11 +381,11 @@ void RecordHelper::overrideRecord(const mwmp::BookRecord& record)
             return;
         }
         else
-            world->getModifiableStore().overrideRecord(recordData);
+            overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Book>(record.baseId))
     {
-        const ESM::Book *baseData = world->getStore().get<ESM::Book>().search(record.baseId);
+        const ESM::Book *baseData = searchRecord<ESM::Book>(record.baseId);
         ESM::Book finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -311,7 +427,7 @@ void RecordHelper::overrideRecord(const mwmp::BookRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -320,7 +436,7 @@ void RecordHelper::overrideRecord(const mwmp::BookRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::CellRecord& record)
@@ -345,6 +461,14 @@ void RecordHelper::overrideRecord(const mwmp::CellRecord& record)
     {
         mwmp::Main::get().getCellController()->uninitializeCell(recordData);
 
+        // During a batch, only move the player back once all of its records have been applied
+        if (batch.isActive && !batch.hasPlayerReturn)
+        {
+            batch.hasPlayerReturn = true;
+            batch.playerCell = playerCell;
+            batch.playerPos = playerPos;
+        }
+
         // Change to temporary holding interior cell
         world->changeToInteriorCell(RecordHelper::getPlaceholderInteriorCellName(), playerPos, true, true);
     }
@@ -360,7 +484,7 @@ void RecordHelper::overrideRecord(const mwmp::CellRecord& record)
     }
     else if (doesRecordIdExist<ESM::Cell>(record.baseId))
     {
-        const ESM::Cell *baseData = world->getStore().get<ESM::Cell>().search(record.baseId);
+        const ESM::Cell *baseData = searchRecord<ESM::Cell>(record.baseId);
         ESM::Cell finalData = *baseData;
         finalData.mName = recordData.mName;
         finalData.mCellId.mWorldspace = Misc::StringUtils::lowerCase(recordData.mName);
@@ -376,13 +500,8 @@ void RecordHelper::overrideRecord(const mwmp::CellRecord& record)
     }
 
     // Move the player back to the cell they were in
-    if (isActiveCell)
-    {
-        if (playerCell.isExterior())
-            world->changeToExteriorCell(playerPos, true, true);
-        else
-            world->changeToInteriorCell(playerCell.mName, playerPos, true, true);
-    }
+    if (isActiveCell && !isBatchActive())
+        returnPlayerToCell(playerCell, playerPos);
 }
 
 void RecordHelper::overrideRecord(const mwmp::ClothingRecord& record)
@@ -396,7 +515,6 @@ void RecordHelper::overrideRecord(const mwmp::ClothingRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Clothing>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
@@ -406,11 +524,11 @@ void RecordHelper::overrideRecord(const mwmp::ClothingRecord& record)
             return;
         }
         else
-            world->getModifiableStore().overrideRecord(recordData);
+            overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Clothing>(record.baseId))
     {
-        const ESM::Clothing *baseData = world->getStore().get<ESM::Clothing>().search(record.baseId);
+        const ESM::Clothing *baseData = searchRecord<ESM::Clothing>(record.baseId);
         ESM::Clothing finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -449,7 +567,7 @@ void RecordHelper::overrideRecord(const mwmp::ClothingRecord& record)
         if (record.baseOverrides.hasBodyParts)
             finalData.mParts.mParts = recordData.mParts.mParts;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -458,7 +576,7 @@ void RecordHelper::overrideRecord(const mwmp::ClothingRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::ContainerRecord& record)
@@ -472,15 +590,14 @@ void RecordHelper::overrideRecord(const mwmp::ContainerRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Container>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Container>(record.baseId))
     {
-        const ESM::Container *baseData = world->getStore().get<ESM::Container>().search(record.baseId);
+        const ESM::Container *baseData = searchRecord<ESM::Container>(record.baseId);
         ESM::Container finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -502,7 +619,7 @@ void RecordHelper::overrideRecord(const mwmp::ContainerRecord& record)
         if (record.baseOverrides.hasInventory)
             finalData.mInventory.mList = recordData.mInventory.mList;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -511,7 +628,7 @@ void RecordHelper::overrideRecord(const mwmp::ContainerRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::CreatureRecord& record)
@@ -525,15 +642,14 @@ void RecordHelper::overrideRecord(const mwmp::CreatureRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Creature>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Creature>(record.baseId))
     {
-        const ESM::Creature *baseData = world->getStore().get<ESM::Creature>().search(record.baseId);
+        const ESM::Creature *baseData = searchRecord<ESM::Creature>(record.baseId);
         ESM::Creature finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -583,11 +699,11 @@ void RecordHelper::overrideRecord(const mwmp::CreatureRecord& record)
             finalData.mScript = recordData.mScript;
 
         if (!record.inventoryBaseId.empty() && doesRecordIdExist<ESM::Creature>(record.inventoryBaseId))
-            finalData.mInventory.mList = world->getStore().get<ESM::Creature>().search(record.inventoryBaseId)->mInventory.mList;
+            finalData.mInventory.mList = searchRecord<ESM::Creature>(record.inventoryBaseId)->mInventory.mList;
         else if (record.baseOverrides.hasInventory)
             finalData.mInventory.mList = recordData.mInventory.mList;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -596,7 +712,7 @@ void RecordHelper::overrideRecord(const mwmp::CreatureRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::DoorRecord& record)
@@ -610,15 +726,14 @@ void RecordHelper::overrideRecord(const mwmp::DoorRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Door>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Door>(record.baseId))
     {
-        const ESM::Door *baseData = world->getStore().get<ESM::Door>().search(record.baseId);
+        const ESM::Door *baseData = searchRecord<ESM::Door>(record.baseId);
         ESM::Door finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -637,7 +752,7 @@ void RecordHelper::overrideRecord(const mwmp::DoorRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -646,7 +761,7 @@ void RecordHelper::overrideRecord(const mwmp::DoorRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::EnchantmentRecord& record)
@@ -659,8 +774,6 @@ void RecordHelper::overrideRecord(const mwmp::EnchantmentRecord& record)
         return;
     }
 
-    MWBase::World *world = MWBase::Environment::get().getWorld();
-
     if (record.baseId.empty())
     {
         if (recordData.mEffects.mList.empty())
@@ -669,11 +782,11 @@ void RecordHelper::overrideRecord(const mwmp::EnchantmentRecord& record)
             return;
         }
         else
-            world->getModifiableStore().overrideRecord(recordData);
+            overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Enchantment>(record.baseId))
     {
-        const ESM::Enchantment *baseData = world->getStore().get<ESM::Enchantment>().search(record.baseId);
+        const ESM::Enchantment *baseData = searchRecord<ESM::Enchantment>(record.baseId);
         ESM::Enchantment finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -692,7 +805,7 @@ void RecordHelper::overrideRecord(const mwmp::EnchantmentRecord& record)
         if (record.baseOverrides.hasEffects)
             finalData.mEffects.mList = recordData.mEffects.mList;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -712,15 +825,14 @@ void RecordHelper::overrideRecord(const mwmp::IngredientRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Ingredient>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Ingredient>(record.baseId))
     {
-        const ESM::Ingredient *baseData = world->getStore().get<ESM::Ingredient>().search(record.baseId);
+        const ESM::Ingredient *baseData = searchRecord<ESM::Ingredient>(record.baseId);
         ESM::Ingredient finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -754,7 +866,7 @@ void RecordHelper::overrideRecord(const mwmp::IngredientRecord& record)
             }
         }
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -763,7 +875,7 @@ void RecordHelper::overrideRecord(const mwmp::IngredientRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::LightRecord& record)
@@ -777,15 +889,14 @@ void RecordHelper::overrideRecord(const mwmp::LightRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Light>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Light>(record.baseId))
     {
-        const ESM::Light *baseData = world->getStore().get<ESM::Light>().search(record.baseId);
+        const ESM::Light *baseData = searchRecord<ESM::Light>(record.baseId);
         ESM::Light finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -822,7 +933,7 @@ void RecordHelper::overrideRecord(const mwmp::LightRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -831,7 +942,7 @@ void RecordHelper::overrideRecord(const mwmp::LightRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::LockpickRecord& record)
@@ -845,15 +956,14 @@ void RecordHelper::overrideRecord(const mwmp::LockpickRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Lockpick>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Lockpick>(record.baseId))
     {
-        const ESM::Lockpick *baseData = world->getStore().get<ESM::Lockpick>().search(record.baseId);
+        const ESM::Lockpick *baseData = searchRecord<ESM::Lockpick>(record.baseId);
         ESM::Lockpick finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -881,7 +991,7 @@ void RecordHelper::overrideRecord(const mwmp::LockpickRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -890,7 +1000,7 @@ void RecordHelper::overrideRecord(const mwmp::LockpickRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::MiscellaneousRecord& record)
@@ -904,15 +1014,14 @@ void RecordHelper::overrideRecord(const mwmp::MiscellaneousRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Miscellaneous>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Miscellaneous>(record.baseId))
     {
-        const ESM::Miscellaneous *baseData = world->getStore().get<ESM::Miscellaneous>().search(record.baseId);
+        const ESM::Miscellaneous *baseData = searchRecord<ESM::Miscellaneous>(record.baseId);
         ESM::Miscellaneous finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -937,7 +1046,7 @@ void RecordHelper::overrideRecord(const mwmp::MiscellaneousRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -946,7 +1055,7 @@ void RecordHelper::overrideRecord(const mwmp::MiscellaneousRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::NpcRecord& record)
@@ -960,7 +1069,6 @@ void RecordHelper::overrideRecord(const mwmp::NpcRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::NPC>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
@@ -975,11 +1083,11 @@ void RecordHelper::overrideRecord(const mwmp::NpcRecord& record)
             return;
         }
         else
-            world->getModifiableStore().overrideRecord(recordData);
+            overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::NPC>(record.baseId))
     {
-        const ESM::NPC *baseData = world->getStore().get<ESM::NPC>().search(record.baseId);
+        const ESM::NPC *baseData = searchRecord<ESM::NPC>(record.baseId);
         ESM::NPC finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1055,11 +1163,11 @@ void RecordHelper::overrideRecord(const mwmp::NpcRecord& record)
         }
 
         if (!record.inventoryBaseId.empty() && doesRecordIdExist<ESM::NPC>(record.inventoryBaseId))
-            finalData.mInventory.mList = world->getStore().get<ESM::NPC>().search(record.inventoryBaseId)->mInventory.mList;
+            finalData.mInventory.mList = searchRecord<ESM::NPC>(record.inventoryBaseId)->mInventory.mList;
         else if (record.baseOverrides.hasInventory)
             finalData.mInventory.mList = recordData.mInventory.mList;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1068,7 +1176,7 @@ void RecordHelper::overrideRecord(const mwmp::NpcRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::PotionRecord& record)
@@ -1082,15 +1190,14 @@ void RecordHelper::overrideRecord(const mwmp::PotionRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Potion>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Potion>(record.baseId))
     {
-        const ESM::Potion *baseData = world->getStore().get<ESM::Potion>().search(record.baseId);
+        const ESM::Potion *baseData = searchRecord<ESM::Potion>(record.baseId);
         ESM::Potion finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1118,7 +1225,7 @@ void RecordHelper::overrideRecord(const mwmp::PotionRecord& record)
         if (record.baseOverrides.hasEffects)
             finalData.mEffects.mList = recordData.mEffects.mList;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1127,7 +1234,7 @@ void RecordHelper::overrideRecord(const mwmp::PotionRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::ProbeRecord& record)
@@ -1141,15 +1248,14 @@ void RecordHelper::overrideRecord(const mwmp::ProbeRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Probe>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Probe>(record.baseId))
     {
-        const ESM::Probe *baseData = world->getStore().get<ESM::Probe>().search(record.baseId);
+        const ESM::Probe *baseData = searchRecord<ESM::Probe>(record.baseId);
         ESM::Probe finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1177,7 +1283,7 @@ void RecordHelper::overrideRecord(const mwmp::ProbeRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1186,7 +1292,7 @@ void RecordHelper::overrideRecord(const mwmp::ProbeRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::RepairRecord& record)
@@ -1200,15 +1306,14 @@ void RecordHelper::overrideRecord(const mwmp::RepairRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Repair>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Repair>(record.baseId))
     {
-        const ESM::Repair *baseData = world->getStore().get<ESM::Repair>().search(record.baseId);
+        const ESM::Repair *baseData = searchRecord<ESM::Repair>(record.baseId);
         ESM::Repair finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1236,7 +1341,7 @@ void RecordHelper::overrideRecord(const mwmp::RepairRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1245,7 +1350,7 @@ void RecordHelper::overrideRecord(const mwmp::RepairRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::ScriptRecord& record)
@@ -1258,28 +1363,30 @@ void RecordHelper::overrideRecord(const mwmp::ScriptRecord& record)
         return;
     }
 
-    MWBase::World *world = MWBase::Environment::get().getWorld();
-
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Script>(record.baseId))
     {
-        const ESM::Script *baseData = world->getStore().get<ESM::Script>().search(record.baseId);
+        const ESM::Script *baseData = searchRecord<ESM::Script>(record.baseId);
         ESM::Script finalData = *baseData;
         finalData.mId = recordData.mId;
 
         if (record.baseOverrides.hasScriptText)
             finalData.mScriptText = recordData.mScriptText;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
         LOG_APPEND(TimedLog::LOG_INFO, "-- Ignoring record override with invalid baseId %s", record.baseId.c_str());
         return;
     }
+
+    // Nothing compiles scripts while a batch is active, so the script is only compiled again once
+    // its new record is in the store
+    MWBase::Environment::get().getScriptManager()->invalidate(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::SoundRecord& record)
@@ -1293,15 +1400,14 @@ void RecordHelper::overrideRecord(const mwmp::SoundRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Sound>(recordData.mId);
-    MWBase::World* world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Sound>(record.baseId))
     {
-        const ESM::Sound* baseData = world->getStore().get<ESM::Sound>().search(record.baseId);
+        const ESM::Sound* baseData = searchRecord<ESM::Sound>(record.baseId);
         ESM::Sound finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1317,7 +1423,7 @@ void RecordHelper::overrideRecord(const mwmp::SoundRecord& record)
         if (record.baseOverrides.hasMaxRange)
             finalData.mData.mMaxRange = recordData.mData.mMaxRange;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1326,7 +1432,7 @@ void RecordHelper::overrideRecord(const mwmp::SoundRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::SpellRecord& record)
@@ -1340,15 +1446,14 @@ void RecordHelper::overrideRecord(const mwmp::SpellRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Spell>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Spell>(record.baseId))
     {
-        const ESM::Spell *baseData = world->getStore().get<ESM::Spell>().search(record.baseId);
+        const ESM::Spell *baseData = searchRecord<ESM::Spell>(record.baseId);
         ESM::Spell finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1367,7 +1472,7 @@ void RecordHelper::overrideRecord(const mwmp::SpellRecord& record)
         if (record.baseOverrides.hasEffects)
             finalData.mEffects.mList = recordData.mEffects.mList;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1387,22 +1492,21 @@ void RecordHelper::overrideRecord(const mwmp::StaticRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Static>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
-        world->getModifiableStore().overrideRecord(recordData);
+        overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Static>(record.baseId))
     {
-        const ESM::Static *baseData = world->getStore().get<ESM::Static>().search(record.baseId);
+        const ESM::Static *baseData = searchRecord<ESM::Static>(record.baseId);
         ESM::Static finalData = *baseData;
         finalData.mId = recordData.mId;
 
         if (record.baseOverrides.hasModel)
             finalData.mModel = recordData.mModel;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1411,7 +1515,7 @@ void RecordHelper::overrideRecord(const mwmp::StaticRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::overrideRecord(const mwmp::WeaponRecord& record)
@@ -1425,7 +1529,6 @@ void RecordHelper::overrideRecord(const mwmp::WeaponRecord& record)
     }
 
     bool isExistingId = doesRecordIdExist<ESM::Weapon>(recordData.mId);
-    MWBase::World *world = MWBase::Environment::get().getWorld();
 
     if (record.baseId.empty())
     {
@@ -1435,11 +1538,11 @@ void RecordHelper::overrideRecord(const mwmp::WeaponRecord& record)
             return;
         }
         else
-            world->getModifiableStore().overrideRecord(recordData);
+            overrideRecord(recordData);
     }
     else if (doesRecordIdExist<ESM::Weapon>(record.baseId))
     {
-        const ESM::Weapon *baseData = world->getStore().get<ESM::Weapon>().search(record.baseId);
+        const ESM::Weapon *baseData = searchRecord<ESM::Weapon>(record.baseId);
         ESM::Weapon finalData = *baseData;
         finalData.mId = recordData.mId;
 
@@ -1505,7 +1608,7 @@ void RecordHelper::overrideRecord(const mwmp::WeaponRecord& record)
         if (record.baseOverrides.hasScript)
             finalData.mScript = recordData.mScript;
 
-        world->getModifiableStore().overrideRecord(finalData);
+        overrideRecord(finalData);
     }
     else
     {
@@ -1514,7 +1617,7 @@ void RecordHelper::overrideRecord(const mwmp::WeaponRecord& record)
     }
 
     if (isExistingId)
-        world->updatePtrsWithRefId(recordData.mId);
+        updatePtrsWithRefId(recordData.mId);
 }
 
 void RecordHelper::createPlaceholderInteriorCell()
@@ -1,12 +1,56 @@
 #ifndef OPENMW_RECORDHELPER_HPP
 #define OPENMW_RECORDHELPER_HPP
 
+#include <components/misc/stringops.hpp>
 #include <components/openmw-mp/Base/BaseWorldstate.hpp>
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../mwbase/environment.hpp"
+#include "../mwbase/world.hpp"
+#include "../mwworld/esmstore.hpp"
 
 namespace RecordHelper
 {
+    /*
+        Records overridden between beginBatch() and endBatch() are kept aside per type and
+        inserted into the store together when the batch ends, after which the objects in
+        active cells that use any of them are recreated in a single pass over those cells
+    */
+    void beginBatch();
+    void endBatch();
+    bool isBatchActive();
+
+    // Begins a batch and ends it when going out of scope, so a record that fails to be
+    // overridden doesn't leave every later override stuck waiting for the batch to end
+    class ScopedBatch
+    {
+    public:
+        ScopedBatch();
+        ~ScopedBatch();
+
+        ScopedBatch(const ScopedBatch&) = delete;
+        ScopedBatch& operator=(const ScopedBatch&) = delete;
+    };
+
+    // The records of one type waiting for the current batch to end
+    template<class RecordType>
+    class PendingRecords
+    {
+    public:
+        static std::vector<RecordType> records;
+        // Indexes in records, by lowercase id
+        static std::unordered_map<std::string, size_t> indexes;
+    };
+
+    template<class RecordType>
+    std::vector<RecordType> PendingRecords<RecordType>::records;
+
+    template<class RecordType>
+    std::unordered_map<std::string, size_t> PendingRecords<RecordType>::indexes;
+
     void overrideRecord(const mwmp::ActivatorRecord& record);
     void overrideRecord(const mwmp::ApparatusRecord& record);
     void overrideRecord(const mwmp::ArmorRecord& record);
@@ -34,6 +78,31 @@ namespace RecordHelper
 
     template<class RecordType>
     void overrideRecord(const RecordType &record)
+    {
+        if (isBatchActive())
+        {
+            std::string id = Misc::StringUtils::lowerCase(record.mId);
+            auto it = PendingRecords<RecordType>::indexes.find(id);
+
+            if (it != PendingRecords<RecordType>::indexes.end())
+                PendingRecords<RecordType>::records[it->second] = record;
+            else
+            {
+                PendingRecords<RecordType>::indexes[id] = PendingRecords<RecordType>::records.size();
+                PendingRecords<RecordType>::records.push_back(record);
+            }
+
+            return;
+        }
+
+        MWBase::World *world = MWBase::Environment::get().getWorld();
+
+        world->getModifiableStore().overrideRecord(record);
+    }
+
+    // Cells are always overridden right away, because doing so unloads them
+    template<>
+    inline void overrideRecord<ESM::Cell>(const ESM::Cell &record)
     {
         MWBase::World *world = MWBase::Environment::get().getWorld();
 
@@ -48,14 +117,55 @@ namespace RecordHelper
         return world->createRecord(record);
     }
 
+    // Search for a record, including those waiting for the current batch to end
     template<class RecordType>
-    bool doesRecordIdExist(const std::string& id)
+    const RecordType *searchRecord(const MWWorld::RecordKey& key)
     {
+        if (!PendingRecords<RecordType>::indexes.empty())
+        {
+            auto it = PendingRecords<RecordType>::indexes.find(key.getId());
+
+            if (it != PendingRecords<RecordType>::indexes.end())
+                return &PendingRecords<RecordType>::records[it->second];
+        }
+
         MWBase::World *world = MWBase::Environment::get().getWorld();
 
-        return world->getStore().get<RecordType>().search(id);
+        return world->getStore().get<RecordType>().search(key);
+    }
+
+    // The store of cells has no hashed index to search
+    template<>
+    inline const ESM::Cell *searchRecord<ESM::Cell>(const MWWorld::RecordKey& key)
+    {
+        MWBase::World *world = MWBase::Environment::get().getWorld();
+
+        return world->getStore().get<ESM::Cell>().search(key.getId());
+    }
+
+    // Lowercases and hashes the id only once for both the pending records and the store
+    template<class RecordType>
+    const RecordType *searchRecord(const std::string& id)
+    {
+        return searchRecord<RecordType>(MWWorld::RecordKey(id));
     }
 
+    template<class RecordType>
+    bool doesRecordIdExist(const MWWorld::RecordKey& key)
+    {
+        return searchRecord<RecordType>(key) != nullptr;
+    }
+
+    template<class RecordType>
+    bool doesRecordIdExist(const std::string& id)
+    {
+        return searchRecord<RecordType>(MWWorld::RecordKey(id)) != nullptr;
+    }
+
+    // Recreate the objects in active cells that use this refId, once the current batch
+    // has ended if there is one
+    void updatePtrsWithRefId(const std::string& refId);
+
     void createPlaceholderInteriorCell();
     const std::string getPlaceholderInteriorCellName();
 
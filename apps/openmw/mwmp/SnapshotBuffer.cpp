@@ -0,0 +1,179 @@
+#include "SnapshotBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <osg/Math>
+
+using namespace mwmp;
+
+float SnapshotBuffer::interpolationDelay = 0.1f;
+float SnapshotBuffer::maxExtrapolation = 0.25f;
+
+// Consecutive positions further apart than this are treated as teleportation
+static const float maxInterpolationDistance = 512;
+
+// Timestamps further than this from the previous one, in milliseconds, are assumed to come from
+// a different clock, such as when another player becomes the authority over an actor
+static const int32_t maxTimestampJump = 10000;
+
+// How quickly the clock offset is allowed to grow, in seconds per second, so it can recover
+// after having been measured during an unusually fast stretch of the network
+static const double clockOffsetRelaxRate = 0.02;
+
+// Positions further apart in time than this, in seconds, aren't used to extrapolate movement
+static const double maxExtrapolationGap = 0.5;
+
+static float interpolateAngle(float from, float to, float percent)
+{
+    float difference = std::fmod(to - from, 2 * osg::PIf);
+
+    if (difference > osg::PIf)
+        difference -= 2 * osg::PIf;
+    else if (difference < -osg::PIf)
+        difference += 2 * osg::PIf;
+
+    return from + difference * percent;
+}
+
+SnapshotBuffer::SnapshotBuffer() : firstIndex(0), count(0), hasTimestamp(false), lastTimestamp(0),
+    lastSenderTime(0), lastReceiveTime(0), clockOffset(0)
+{
+
+}
+
+void SnapshotBuffer::setInterpolationDelay(float delay)
+{
+    interpolationDelay = std::max(delay, 0.0f);
+}
+
+void SnapshotBuffer::setMaxExtrapolation(float duration)
+{
+    maxExtrapolation = std::max(duration, 0.0f);
+}
+
+void SnapshotBuffer::addSnapshot(const ESM::Position &position, uint32_t timestamp, bool isMoving)
+{
+    double receiveTime = getLocalTime();
+    double senderTime;
+
+    int32_t elapsed = static_cast<int32_t>(timestamp - lastTimestamp);
+
+    if (!hasTimestamp || elapsed < -maxTimestampJump || elapsed > maxTimestampJump)
+    {
+        // Start over on the sender's clock, measuring its time from this timestamp onwards
+        hasTimestamp = true;
+        senderTime = 0;
+        clockOffset = receiveTime;
+        count = 0;
+    }
+    // Ignore positions that are older than ones already received
+    else if (elapsed <= 0)
+        return;
+    else
+    {
+        senderTime = lastSenderTime + elapsed / 1000.0;
+
+        // Packets delayed the least by the network give the closest estimate of the offset, so
+        // the lowest one is kept while still allowing it to grow slowly
+        double measuredOffset = receiveTime - senderTime;
+        clockOffset = std::min(measuredOffset, clockOffset + (receiveTime - lastReceiveTime) * clockOffsetRelaxRate);
+    }
+
+    lastTimestamp = timestamp;
+    lastSenderTime = senderTime;
+    lastReceiveTime = receiveTime;
+
+    if (count > 0 && (position.asVec3() - getSnapshot(count - 1).position.asVec3()).length() > maxInterpolationDistance)
+        count = 0;
+
+    if (count == capacity)
+    {
+        firstIndex = (firstIndex + 1) % capacity;
+        count--;
+    }
+
+    Snapshot &snapshot = snapshots[(firstIndex + count) % capacity];
+    snapshot.position = position;
+    snapshot.senderTime = senderTime;
+    snapshot.isMoving = isMoving;
+    count++;
+}
+
+void SnapshotBuffer::reset(const ESM::Position &position)
+{
+    firstIndex = 0;
+    count = 1;
+
+    // Place the position at the time currently being displayed, so positions received afterwards
+    // are interpolated from it
+    snapshots[0].position = position;
+    snapshots[0].senderTime = getLocalTime() - clockOffset - interpolationDelay;
+    snapshots[0].isMoving = false;
+}
+
+bool SnapshotBuffer::getPosition(ESM::Position &result)
+{
+    if (count == 0)
+        return false;
+
+    double displayTime = getLocalTime() - clockOffset - interpolationDelay;
+
+    // Drop the positions that are behind the displayed time, except for the latest of them
+    while (count > 2 && getSnapshot(1).senderTime <= displayTime)
+    {
+        firstIndex = (firstIndex + 1) % capacity;
+        count--;
+    }
+
+    const Snapshot &from = getSnapshot(0);
+
+    if (count == 1 || displayTime <= from.senderTime)
+    {
+        result = from.position;
+        return true;
+    }
+
+    const Snapshot &to = getSnapshot(1);
+    double timeBetween = to.senderTime - from.senderTime;
+
+    if (displayTime <= to.senderTime)
+    {
+        float percent = timeBetween > 0 ? static_cast<float>((displayTime - from.senderTime) / timeBetween) : 1.0f;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            result.pos[i] = from.position.pos[i] + (to.position.pos[i] - from.position.pos[i]) * percent;
+            result.rot[i] = interpolateAngle(from.position.rot[i], to.position.rot[i], percent);
+        }
+
+        return true;
+    }
+
+    // The next position is late, so keep moving the way the last two positions were going for a
+    // little while, as long as the sender was still moving
+    result = to.position;
+
+    if (to.isMoving && timeBetween > 0 && timeBetween <= maxExtrapolationGap)
+    {
+        float extrapolatedTime = static_cast<float>(std::min(displayTime - to.senderTime, static_cast<double>(maxExtrapolation)));
+        float multiplier = extrapolatedTime / static_cast<float>(timeBetween);
+
+        for (int i = 0; i < 3; ++i)
+            result.pos[i] += (to.position.pos[i] - from.position.pos[i]) * multiplier;
+    }
+
+    return true;
+}
+
+double SnapshotBuffer::getLocalTime()
+{
+    auto duration = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+}
+
+const SnapshotBuffer::Snapshot &SnapshotBuffer::getSnapshot(unsigned int index) const
+{
+    return snapshots[(firstIndex + index) % capacity];
+}
@@ -0,0 +1,71 @@
+#ifndef OPENMW_SNAPSHOTBUFFER_HPP
+#define OPENMW_SNAPSHOTBUFFER_HPP
+
+#include <components/esm/defs.hpp>
+
+#include <cstdint>
+
+namespace mwmp
+{
+    /*
+        Keeps the latest positions received about a remote player or actor along with the times
+        they were sent at, and gets the position to display for them a little in the past, so it
+        can be interpolated between two received positions regardless of when packets arrived
+
+        Sender timestamps are turned into local time through an estimate of the offset between
+        the two clocks, and the position is extrapolated for a short while when newer positions
+        are late
+    */
+    class SnapshotBuffer
+    {
+    public:
+
+        SnapshotBuffer();
+
+        static void setInterpolationDelay(float delay);
+        static void setMaxExtrapolation(float duration);
+
+        // Add a received position along with the time it was sent at, and isMoving telling whether
+        // the sender was moving on its own at the time
+        void addSnapshot(const ESM::Position &position, uint32_t timestamp, bool isMoving);
+
+        // Forget all received positions and display this one until the next one is received, for
+        // positions that should be displayed right away
+        void reset(const ESM::Position &position);
+
+        // Get the position to display at the current time, or return false if there are no
+        // positions to get it from
+        bool getPosition(ESM::Position &result);
+
+    private:
+
+        struct Snapshot
+        {
+            ESM::Position position;
+            double senderTime;
+            bool isMoving;
+        };
+
+        static const unsigned int capacity = 32;
+
+        static double getLocalTime();
+        const Snapshot &getSnapshot(unsigned int index) const;
+
+        static float interpolationDelay;
+        static float maxExtrapolation;
+
+        Snapshot snapshots[capacity];
+        unsigned int firstIndex;
+        unsigned int count;
+
+        bool hasTimestamp;
+        uint32_t lastTimestamp;
+        double lastSenderTime;
+        double lastReceiveTime;
+
+        // How far ahead local time is of the sender's time, including the network delay
+        double clockOffset;
+    };
+}
+
+#endif //OPENMW_SNAPSHOTBUFFER_HPP
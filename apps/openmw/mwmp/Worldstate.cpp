@@ -1,6 +1,7 @@
 #include <components/openmw-mp/TimedLog.hpp>
 
 #include "../mwbase/environment.hpp"
+#include "../mwbase/scriptmanager.hpp"
 
 #include "../mwgui/windowmanagerimp.hpp"
 
@@ -42,6 +43,12 @@ void Worldstate::addRecords()
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Received ID_RECORD_DYNAMIC with %i records of type %i",
         recordsCount, recordsType);
 
+    // Scripts compiled against these records shouldn't end up in the script cache
+    MWBase::Environment::get().getScriptManager()->setStoreModified();
+
+    // Insert all of these records into the store and update the objects using them at the end
+    RecordHelper::ScopedBatch batch;
+
     if (recordsType == mwmp::RECORD_TYPE::SPELL)
     {
         for (auto &&record : spellRecords)
@@ -84,6 +84,7 @@
 #include "actor/ProcessorActorCellChange.hpp"
 #include "actor/ProcessorActorDeath.hpp"
 #include "actor/ProcessorActorEquipment.hpp"
+#include "actor/ProcessorActorFrame.hpp"
 #include "actor/ProcessorActorList.hpp"
 #include "actor/ProcessorActorPosition.hpp"
 #include "actor/ProcessorActorSpeech.hpp"
@@ -188,6 +189,7 @@ void ProcessorInitializer()
     ActorProcessor::AddProcessor(new ProcessorActorCellChange());
     ActorProcessor::AddProcessor(new ProcessorActorDeath());
     ActorProcessor::AddProcessor(new ProcessorActorEquipment());
+    ActorProcessor::AddProcessor(new ProcessorActorFrame());
     ActorProcessor::AddProcessor(new ProcessorActorList());
     ActorProcessor::AddProcessor(new ProcessorActorPosition());
     ActorProcessor::AddProcessor(new ProcessorActorSpeech());
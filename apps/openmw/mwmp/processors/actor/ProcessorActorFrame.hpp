@@ -0,0 +1,61 @@
+#ifndef OPENMW_PROCESSORACTORFRAME_HPP
+#define OPENMW_PROCESSORACTORFRAME_HPP
+
+#include "../ActorProcessor.hpp"
+#include "apps/openmw/mwmp/Main.hpp"
+#include "apps/openmw/mwmp/CellController.hpp"
+
+namespace mwmp
+{
+    class ProcessorActorFrame final: public ActorProcessor
+    {
+    public:
+        ProcessorActorFrame()
+        {
+            BPP_INIT(ID_ACTOR_FRAME);
+        }
+
+        virtual void Do(ActorPacket &packet, ActorList &actorList)
+        {
+            typedef void (CellController::*FacetReader)(ActorList &);
+
+            // Read the facets in the same order as when they arrived in separate packets
+            static const std::pair<uint16_t, FacetReader> facetReaders[] = {
+                { BaseActor::FACET_POSITION, &CellController::readPositions },
+                { BaseActor::FACET_ANIM_FLAGS, &CellController::readAnimFlags },
+                { BaseActor::FACET_ANIM_PLAY, &CellController::readAnimPlay },
+                { BaseActor::FACET_SPEECH, &CellController::readSpeech },
+                { BaseActor::FACET_DEATH, &CellController::readDeath },
+                { BaseActor::FACET_STATS_DYNAMIC, &CellController::readStatsDynamic },
+                { BaseActor::FACET_EQUIPMENT, &CellController::readEquipment },
+                { BaseActor::FACET_ATTACK, &CellController::readAttack },
+                { BaseActor::FACET_CAST, &CellController::readCast },
+                { BaseActor::FACET_CELL_CHANGE, &CellController::readCellChange }
+            };
+
+            CellController *cellController = Main::get().getCellController();
+
+            for (auto &&facetReader : facetReaders)
+            {
+                ActorList facetActorList;
+                facetActorList.guid = actorList.guid;
+                facetActorList.cell = actorList.cell;
+                facetActorList.isValid = true;
+
+                for (const auto &baseActor : actorList.baseActors)
+                {
+                    if (baseActor.frameFacets & facetReader.first)
+                        facetActorList.baseActors.push_back(baseActor);
+                }
+
+                if (facetActorList.baseActors.empty())
+                    continue;
+
+                facetActorList.count = facetActorList.baseActors.size();
+                (cellController->*facetReader.second)(facetActorList);
+            }
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORACTORFRAME_HPP
@@ -34,10 +34,15 @@ namespace mwmp
                     localPlayer.addItems();
                 else if (inventoryAction == InventoryChanges::REMOVE)
                     localPlayer.removeItems();
+                else if (inventoryAction == InventoryChanges::DELTA)
+                    localPlayer.applyInventoryDelta();
                 else // InventoryChanges::SET
                     localPlayer.setInventory();
 
                 localPlayer.avoidSendingInventoryPackets = false;
+
+                // The server only uses its refId table once it's handling our packets, so we can start using ours
+                localPlayer.useRefIdTable = !localPlayer.receivedRefIds.isEmpty();
             }
         }
     };
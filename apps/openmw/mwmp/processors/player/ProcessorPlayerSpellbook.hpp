@@ -32,8 +32,12 @@ namespace mwmp
                     localPlayer.addSpells();
                 else if (spellbookAction == SpellbookChanges::REMOVE)
                     localPlayer.removeSpells();
+                else if (spellbookAction == SpellbookChanges::DELTA)
+                    localPlayer.applySpellbookDelta();
                 else // SpellbookChanges::SET
                     localPlayer.setSpellbook();
+
+                localPlayer.useRefIdTable = !localPlayer.receivedRefIds.isEmpty();
             }
         }
     };
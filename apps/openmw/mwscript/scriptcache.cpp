@@ -0,0 +1,213 @@
+#include "scriptcache.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/binarycache.hpp>
+#include <components/misc/stringops.hpp>
+
+namespace
+{
+    using Files::readValue;
+    using Files::writeValue;
+
+    const char sMagic[] = "OMWSCRIPTCACHE";
+
+    // Increase when the layout of cache files changes
+    const uint32_t sFormatVersion = 1;
+
+    uint64_t hash (const char *data, std::size_t size, uint64_t seed = 14695981039346656037ULL)
+    {
+        // 64-bit FNV-1a
+        uint64_t result = seed;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            result ^= static_cast<unsigned char> (data[i]);
+            result *= 1099511628211ULL;
+        }
+
+        return result;
+    }
+
+    uint64_t hash (const std::string& text)
+    {
+        return hash (text.data(), text.size());
+    }
+}
+
+namespace MWScript
+{
+    ScriptCache::ScriptCache (const std::string& directory, const std::vector<unsigned int>& contentChecksums,
+        const std::string& engineVersion)
+    : mEngineVersion (engineVersion), mContentChecksums (contentChecksums), mModified (false)
+    {
+        uint64_t key = hash (engineVersion);
+        key = hash (reinterpret_cast<const char *> (contentChecksums.data()),
+            contentChecksums.size() * sizeof (unsigned int), key);
+
+        std::ostringstream fileName;
+        fileName << "scripts-" << std::hex << std::setw (16) << std::setfill ('0') << key << ".cache";
+
+        mPath = (boost::filesystem::path (directory) / fileName.str()).string();
+
+        load();
+    }
+
+    void ScriptCache::load()
+    {
+        std::ifstream stream (mPath, std::ios::binary);
+
+        if (!stream.is_open())
+            return;
+
+        std::string engineVersion;
+        std::vector<unsigned int> contentChecksums;
+        uint32_t count = 0;
+
+        bool good = Files::readCacheHeader (stream, sMagic, sFormatVersion) &&
+            readValue (stream, engineVersion) && engineVersion == mEngineVersion &&
+            readValue (stream, count) && count <= Files::sMaxCacheValueSize;
+
+        for (uint32_t i = 0; good && i < count; ++i)
+        {
+            unsigned int checksum = 0;
+            good = readValue (stream, checksum);
+            contentChecksums.push_back (checksum);
+        }
+
+        // The file name only holds a hash of these, so make sure they really match
+        good = good && contentChecksums == mContentChecksums && readValue (stream, count);
+
+        std::map<std::string, Entry> entries;
+
+        for (uint32_t i = 0; good && i < count; ++i)
+        {
+            std::string name;
+            Entry entry;
+            uint32_t size = 0;
+
+            good = readValue (stream, name) && readValue (stream, entry.mSourceHash) && readValue (stream, size) &&
+                size <= Files::sMaxCacheValueSize;
+
+            if (good)
+            {
+                entry.mByteCode.resize (size);
+                good = static_cast<bool> (stream.read (reinterpret_cast<char *> (entry.mByteCode.data()),
+                    size * sizeof (Interpreter::Type_Code)));
+            }
+
+            for (char type : {'s', 'l', 'f'})
+            {
+                uint32_t localCount = 0;
+                good = good && readValue (stream, localCount);
+
+                for (uint32_t j = 0; good && j < localCount; ++j)
+                {
+                    std::string local;
+                    good = readValue (stream, local);
+                    entry.mLocals.declare (type, local);
+                }
+            }
+
+            if (good)
+                entries.emplace (name, entry);
+        }
+
+        if (!good)
+        {
+            Log(Debug::Warning) << "Ignoring outdated or damaged script cache " << mPath;
+            return;
+        }
+
+        mEntries.swap (entries);
+
+        Log(Debug::Info) << "Loaded " << mEntries.size() << " compiled scripts from " << mPath;
+    }
+
+    bool ScriptCache::get (const std::string& name, const std::string& source,
+        std::vector<Interpreter::Type_Code>& byteCode, Compiler::Locals& locals) const
+    {
+        std::map<std::string, Entry>::const_iterator iter = mEntries.find (name);
+
+        if (iter==mEntries.end() || iter->second.mSourceHash!=hash (source))
+            return false;
+
+        byteCode = iter->second.mByteCode;
+        locals = iter->second.mLocals;
+        return true;
+    }
+
+    void ScriptCache::set (const std::string& name, const std::string& source,
+        const std::vector<Interpreter::Type_Code>& byteCode, const Compiler::Locals& locals)
+    {
+        Entry& entry = mEntries[name];
+        entry.mSourceHash = hash (source);
+        entry.mByteCode = byteCode;
+        entry.mLocals = locals;
+        mModified = true;
+    }
+
+    void ScriptCache::erase (const std::string& name)
+    {
+        for (std::map<std::string, Entry>::iterator iter = mEntries.begin(); iter!=mEntries.end();)
+        {
+            if (Misc::StringUtils::ciEqual (iter->first, name))
+            {
+                iter = mEntries.erase (iter);
+                mModified = true;
+            }
+            else
+                ++iter;
+        }
+    }
+
+    void ScriptCache::save()
+    {
+        if (!mModified)
+            return;
+
+        try
+        {
+            Files::writeFileAtomically (mPath, [this] (std::ostream& stream)
+            {
+                Files::writeCacheHeader (stream, sMagic, sFormatVersion);
+                writeValue (stream, mEngineVersion);
+                writeValue (stream, static_cast<uint32_t> (mContentChecksums.size()));
+
+                for (unsigned int checksum : mContentChecksums)
+                    writeValue (stream, checksum);
+
+                writeValue (stream, static_cast<uint32_t> (mEntries.size()));
+
+                for (const auto& entry : mEntries)
+                {
+                    writeValue (stream, entry.first);
+                    writeValue (stream, entry.second.mSourceHash);
+                    writeValue (stream, static_cast<uint32_t> (entry.second.mByteCode.size()));
+                    stream.write (reinterpret_cast<const char *> (entry.second.mByteCode.data()),
+                        entry.second.mByteCode.size() * sizeof (Interpreter::Type_Code));
+
+                    for (char type : {'s', 'l', 'f'})
+                    {
+                        const std::vector<std::string>& locals = entry.second.mLocals.get (type);
+                        writeValue (stream, static_cast<uint32_t> (locals.size()));
+
+                        for (const std::string& local : locals)
+                            writeValue (stream, local);
+                    }
+                }
+            });
+
+            mModified = false;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save script cache " << mPath << ": " << e.what();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef GAME_SCRIPT_SCRIPTCACHE_H
+#define GAME_SCRIPT_SCRIPTCACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <components/compiler/locals.hpp>
+
+#include <components/interpreter/types.hpp>
+
+namespace MWScript
+{
+    /// \brief Compiled scripts kept on disk between sessions
+    ///
+    /// A cache file belongs to one set of content files and one engine version, and every script
+    /// in it is stored along with a hash of its source, so a script is only reused while neither
+    /// its source nor anything else it could have been compiled against has changed.
+    class ScriptCache
+    {
+            struct Entry
+            {
+                uint64_t mSourceHash;
+                std::vector<Interpreter::Type_Code> mByteCode;
+                Compiler::Locals mLocals;
+            };
+
+            std::string mPath;
+            std::string mEngineVersion;
+            std::vector<unsigned int> mContentChecksums;
+            std::map<std::string, Entry> mEntries;
+            bool mModified;
+
+            void load();
+
+        public:
+
+            ScriptCache (const std::string& directory, const std::vector<unsigned int>& contentChecksums,
+                const std::string& engineVersion);
+            ///< Load the cache file matching \a contentChecksums and \a engineVersion from
+            /// \a directory, if there is one.
+
+            bool get (const std::string& name, const std::string& source,
+                std::vector<Interpreter::Type_Code>& byteCode, Compiler::Locals& locals) const;
+            ///< Get the compiled form of script \a name, if it was compiled from \a source.
+
+            void set (const std::string& name, const std::string& source,
+                const std::vector<Interpreter::Type_Code>& byteCode, const Compiler::Locals& locals);
+
+            void erase (const std::string& name);
+            ///< Remove script \a name, whatever the case of its name.
+
+            void save();
+            ///< Write the cache file, if anything has been added since it was last read or written.
+    };
+}
+
+#endif
@@ -29,6 +29,15 @@ namespace MWScript
     : mErrorHandler(), mStore (store),
       mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
       mOpcodesInstalled (false), mGlobalScripts (store)
+      /*
+          Start of tes3mp addition
+
+          Keep the warnings mode for the error handler of the background compile
+      */
+      , mWarningsMode (warningsMode), mStopPrecompile (false), mStoreModified (false)
+      /*
+          End of tes3mp addition
+      */
     {
         mErrorHandler.setWarningsMode (warningsMode);
 
@@ -39,25 +48,64 @@ namespace MWScript
         std::sort (mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    /*
+        Start of tes3mp addition
+
+        Stop a background compile that is still running, then save whatever got compiled since
+    */
+    ScriptManager::~ScriptManager()
+    {
+        mStopPrecompile = true;
+        waitForPrecompile();
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp change (major)
+
+        Compile through a parser and error handler picked by the caller, so scripts can also be
+        compiled on the background thread, and reuse the compiled scripts from the cache
+    */
     bool ScriptManager::compile (const std::string& name)
     {
-        mParser.reset();
-        mErrorHandler.reset();
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+
+        return compile (name, mParser, mErrorHandler);
+    }
+
+    bool ScriptManager::compile (const std::string& name, Compiler::FileParser& parser,
+        Compiler::StreamErrorHandler& errorHandler)
+    {
+        parser.reset();
+        errorHandler.reset();
 
         if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
         {
-            mErrorHandler.setContext(name);
+            std::vector<Interpreter::Type_Code> code;
+            Compiler::Locals locals;
+
+            // Once the store holds records from the server, a cached script may have been compiled
+            // against records that have since changed
+            if (mCache && !mStoreModified && mCache->get (name, script->mScriptText, code, locals))
+            {
+                mScripts.emplace(name, CompiledScript(code, locals));
+                return true;
+            }
+
+            errorHandler.setContext(name);
 
             bool Success = true;
             try
             {
                 std::istringstream input (script->mScriptText);
 
-                Compiler::Scanner scanner (mErrorHandler, input, mCompilerContext.getExtensions());
+                Compiler::Scanner scanner (errorHandler, input, mCompilerContext.getExtensions());
 
-                scanner.scan (mParser);
+                scanner.scan (parser);
 
-                if (!mErrorHandler.isGood())
+                if (!errorHandler.isGood())
                     Success = false;
             }
             catch (const Compiler::SourceException&)
@@ -78,9 +126,13 @@ namespace MWScript
 
             if (Success)
             {
-                std::vector<Interpreter::Type_Code> code;
-                mParser.getCode(code);
-                mScripts.emplace(name, CompiledScript(code, mParser.getLocals()));
+                parser.getCode(code);
+                mScripts.emplace(name, CompiledScript(code, parser.getLocals()));
+
+                // A script compiled against records from the server could compile differently
+                // against the content files alone
+                if (mCache && !mStoreModified)
+                    mCache->set (name, script->mScriptText, code, parser.getLocals());
 
                 return true;
             }
@@ -88,9 +140,22 @@ namespace MWScript
 
         return false;
     }
+    /*
+        End of tes3mp change (major)
+    */
 
     bool ScriptManager::run (const std::string& name, Interpreter::Context& interpreterContext)
     {
+        /*
+            Start of tes3mp addition
+
+            Don't look the script up while the background compile is adding to the compiled scripts
+        */
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+        /*
+            End of tes3mp addition
+        */
+
         // compile script
         ScriptCollection::iterator iter = mScripts.find (name);
 
@@ -118,7 +183,21 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                /*
+                    Start of tes3mp change (major)
+
+                    Decode the script's byte code once and run the decoded instructions from then on,
+                    instead of looking up the opcode of every instruction each time it is run
+                */
+                CompiledScript& compiledScript = iter->second;
+
+                if (compiledScript.mDecodedCode.mCode == nullptr)
+                    mInterpreter.decode (&compiledScript.mByteCode[0], compiledScript.mByteCode.size(), compiledScript.mDecodedCode);
+
+                mInterpreter.run (compiledScript.mDecodedCode, interpreterContext);
+                /*
+                    End of tes3mp change (major)
+                */
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -136,6 +215,16 @@ namespace MWScript
 
     void ScriptManager::clear()
     {
+        /*
+            Start of tes3mp addition
+
+            Don't use the compiled scripts while the background compile is adding to them
+        */
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+        /*
+            End of tes3mp addition
+        */
+
         for (auto& script : mScripts)
         {
             script.second.mActive = true;
@@ -166,6 +255,16 @@ namespace MWScript
 
     const Compiler::Locals& ScriptManager::getLocals (const std::string& name)
     {
+        /*
+            Start of tes3mp addition
+
+            Don't use the compiled scripts while the background compile is adding to them
+        */
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+        /*
+            End of tes3mp addition
+        */
+
         std::string name2 = Misc::StringUtils::lowerCase (name);
 
         {
@@ -206,4 +305,119 @@ namespace MWScript
     {
         return mGlobalScripts;
     }
+
+    /*
+        Start of tes3mp addition
+
+        Allow scripts to be compiled ahead of time, in the background, and to be kept on disk
+        between sessions
+    */
+    void ScriptManager::precompileAll (const std::string& cacheDirectory,
+        const std::vector<unsigned int>& contentChecksums, const std::string& engineVersion)
+    {
+        if (mPrecompileThread.joinable())
+            return;
+
+        mStopPrecompile = false;
+
+        mPrecompileThread = std::thread ([this, cacheDirectory, contentChecksums, engineVersion]
+        {
+            try
+            {
+                std::unique_ptr<ScriptCache> cache (new ScriptCache (cacheDirectory, contentChecksums, engineVersion));
+
+                {
+                    std::lock_guard<std::recursive_mutex> lock (mMutex);
+                    mCache = std::move (cache);
+                }
+
+                precompile();
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Error: Failed to precompile scripts: " << e.what();
+            }
+        });
+    }
+
+    void ScriptManager::precompile()
+    {
+        // The parser and error handler of the main thread may be in use while this runs
+        Compiler::StreamErrorHandler errorHandler;
+        errorHandler.setWarningsMode (mWarningsMode);
+        Compiler::FileParser parser (errorHandler, mCompilerContext);
+
+        int count = 0;
+
+        for (const ESM::Script& script : mStore.get<ESM::Script>())
+        {
+            if (mStopPrecompile)
+                break;
+
+            if (std::binary_search (mScriptBlacklist.begin(), mScriptBlacklist.end(),
+                Misc::StringUtils::lowerCase(script.mId)))
+                continue;
+
+            // Only hold the lock for one script at a time, so the main thread is never kept
+            // waiting for long
+            std::lock_guard<std::recursive_mutex> lock (mMutex);
+
+            if (mScripts.find (script.mId)!=mScripts.end())
+                continue;
+
+            // Like in run(), a script that fails to compile is ignored from then on
+            if (!compile (script.mId, parser, errorHandler))
+                mScripts.emplace(script.mId, CompiledScript(std::vector<Interpreter::Type_Code>(), Compiler::Locals()));
+
+            ++count;
+        }
+
+        Log(Debug::Info) << "Precompiled " << count << " scripts";
+    }
+
+    void ScriptManager::waitForPrecompile()
+    {
+        if (mPrecompileThread.joinable())
+            mPrecompileThread.join();
+
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+
+        if (mCache)
+            mCache->save();
+    }
+
+    void ScriptManager::invalidate (const std::string& name)
+    {
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+
+        mStoreModified = true;
+
+        for (ScriptCollection::iterator iter = mScripts.begin(); iter!=mScripts.end();)
+        {
+            if (Misc::StringUtils::ciEqual (iter->first, name))
+                iter = mScripts.erase (iter);
+            else
+                ++iter;
+        }
+
+        mOtherLocals.erase (Misc::StringUtils::lowerCase (name));
+
+        if (mCache)
+            mCache->erase (name);
+    }
+
+    void ScriptManager::setStoreModified()
+    {
+        // The background compile reads the store without holding the lock, so it has to be done
+        // before the caller changes the store
+        mStopPrecompile = true;
+        waitForPrecompile();
+
+        std::lock_guard<std::recursive_mutex> lock (mMutex);
+
+        mStoreModified = true;
+    }
+    /*
+        End of tes3mp addition
+    */
 }
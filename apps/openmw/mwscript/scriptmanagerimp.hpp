@@ -4,6 +4,19 @@
 #include <map>
 #include <string>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/compiler/streamerrorhandler.hpp>
 #include <components/compiler/fileparser.hpp>
 
@@ -14,6 +27,16 @@
 
 #include "globalscripts.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include "scriptcache.hpp"
+/*
+    End of tes3mp addition
+*/
+
 namespace MWWorld
 {
     class ESMStore;
@@ -47,6 +70,16 @@ namespace MWScript
                 Compiler::Locals mLocals;
                 bool mActive;
 
+                /*
+                    Start of tes3mp addition
+
+                    Keep the byte code decoded after the first time the script is run
+                */
+                Interpreter::DecodedCode mDecodedCode;
+                /*
+                    End of tes3mp addition
+                */
+
                 CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
                 {
                     mByteCode = code;
@@ -62,12 +95,45 @@ namespace MWScript
             std::map<std::string, Compiler::Locals> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
 
+            /*
+                Start of tes3mp addition
+
+                Compile scripts on a background thread and keep the compiled scripts on disk
+
+                mMutex guards the compiled scripts, the locals and the cache, and is recursive because
+                compiling a script can require looking up the locals of another one
+            */
+            int mWarningsMode;
+            std::recursive_mutex mMutex;
+            std::unique_ptr<ScriptCache> mCache;
+            std::thread mPrecompileThread;
+            std::atomic<bool> mStopPrecompile;
+            bool mStoreModified;
+
+            bool compile (const std::string& name, Compiler::FileParser& parser,
+                Compiler::StreamErrorHandler& errorHandler);
+
+            void precompile();
+            /*
+                End of tes3mp addition
+            */
+
         public:
 
             ScriptManager (const MWWorld::ESMStore& store,
                 Compiler::Context& compilerContext, int warningsMode,
                 const std::vector<std::string>& scriptBlacklist);
 
+            /*
+                Start of tes3mp addition
+
+                Stop a background compile that is still running
+            */
+            ~ScriptManager();
+            /*
+                End of tes3mp addition
+            */
+
             void clear() override;
 
             bool run (const std::string& name, Interpreter::Context& interpreterContext) override;
@@ -85,6 +151,31 @@ namespace MWScript
             ///< Return locals for script \a name.
 
             GlobalScripts& getGlobalScripts() override;
+
+            /*
+                Start of tes3mp addition
+
+                Allow scripts to be compiled ahead of time, in the background, and to be kept on disk
+                between sessions
+            */
+            void precompileAll (const std::string& cacheDirectory,
+                const std::vector<unsigned int>& contentChecksums, const std::string& engineVersion) override;
+            ///< Start compiling every script in the background, reusing the compiled scripts from
+            /// the cache in \a cacheDirectory that match \a contentChecksums and \a engineVersion.
+
+            void waitForPrecompile() override;
+            ///< Wait for the scripts started by precompileAll to finish compiling and save the cache.
+
+            void invalidate (const std::string& name) override;
+            ///< Forget the compiled form and locals of script \a name, in memory and in the cache,
+            /// so it is compiled again from its current record.
+
+            void setStoreModified() override;
+            ///< The ESM store now holds records that don't come from the content files, so scripts
+            /// compiled from now on are no longer added to the cache.
+            /*
+                End of tes3mp addition
+            */
     };
 }
 
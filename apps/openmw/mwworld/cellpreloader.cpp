@@ -3,6 +3,16 @@
 #include <atomic>
 #include <limits>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <algorithm>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/debug/debuglog.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
@@ -46,6 +56,60 @@ namespace MWWorld
         std::vector<std::string>& mOut;
     };
 
+    /*
+        Start of tes3mp addition
+
+        Decompress the files a preloaded cell is going to need on other worker threads ahead of it
+    */
+    /// Worker thread item: make a batch of files ready to be opened quickly.
+    class PrefetchItem : public SceneUtil::WorkItem
+    {
+    public:
+        PrefetchItem(const VFS::Manager* vfs, std::vector<std::string>&& files)
+            : mVFS(vfs)
+            , mFiles(std::move(files))
+            , mAbort(false)
+        {
+        }
+
+        void abort() override
+        {
+            mAbort = true;
+        }
+
+        void doWork() override
+        {
+            for (const std::string& file : mFiles)
+            {
+                if (mAbort)
+                    break;
+
+                try
+                {
+                    mVFS->prefetch(file);
+                }
+                catch (std::exception&)
+                {
+                    // the error will be shown when the file is actually loaded
+                }
+            }
+        }
+
+    private:
+        const VFS::Manager* mVFS;
+        std::vector<std::string> mFiles;
+        std::atomic<bool> mAbort;
+    };
+
+    void abortPrefetchItems(const std::vector<osg::ref_ptr<SceneUtil::WorkItem> >& prefetchItems)
+    {
+        for (const osg::ref_ptr<SceneUtil::WorkItem>& prefetchItem : prefetchItems)
+            prefetchItem->abort();
+    }
+    /*
+        End of tes3mp addition
+    */
+
     /// Worker thread item: preload models in a cell.
     class PreloadItem : public SceneUtil::WorkItem
     {
@@ -74,6 +138,19 @@ namespace MWWorld
             mAbort = true;
         }
 
+        /*
+            Start of tes3mp addition
+
+            Allow the files a preloaded cell is going to need to be decompressed ahead of it
+        */
+        const std::vector<std::string>& getMeshes() const
+        {
+            return mMeshes;
+        }
+        /*
+            End of tes3mp addition
+        */
+
         /// Preload work to be called from the worker thread.
         void doWork() override
         {
@@ -232,6 +309,15 @@ namespace MWWorld
         , mMinCacheSize(0)
         , mMaxCacheSize(0)
         , mPreloadInstances(true)
+        /*
+            Start of tes3mp addition
+
+            Allow the files a preloaded cell is going to need to be decompressed ahead of it
+        */
+        , mPrefetchFiles(false)
+        /*
+            End of tes3mp addition
+        */
         , mLastResourceCacheUpdate(0.0)
         , mStoreViewsFailCount(0)
     {
@@ -253,11 +339,36 @@ namespace MWWorld
         }
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();++it)
+        {
             it->second.mWorkItem->abort();
 
+            /*
+                Start of tes3mp addition
+
+                Stop decompressing files for the cells
+            */
+            abortPrefetchItems(it->second.mPrefetchItems);
+            /*
+                End of tes3mp addition
+            */
+        }
+
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();++it)
+        {
             it->second.mWorkItem->waitTillDone();
 
+            /*
+                Start of tes3mp addition
+
+                Don't leave the worker threads reading from the VFS after the preloader is gone
+            */
+            for (const osg::ref_ptr<SceneUtil::WorkItem>& prefetchItem : it->second.mPrefetchItems)
+                prefetchItem->waitTillDone();
+            /*
+                End of tes3mp addition
+            */
+        }
+
         mPreloadCells.clear();
     }
 
@@ -300,6 +411,15 @@ namespace MWWorld
             if (oldestTimestamp + threshold < timestamp)
             {
                 oldestCell->second.mWorkItem->abort();
+                /*
+                    Start of tes3mp addition
+
+                    Stop decompressing files for a cell that is no longer being preloaded
+                */
+                abortPrefetchItems(oldestCell->second.mPrefetchItems);
+                /*
+                    End of tes3mp addition
+                */
                 mPreloadCells.erase(oldestCell);
             }
             else
@@ -307,9 +427,44 @@ namespace MWWorld
         }
 
         osg::ref_ptr<PreloadItem> item (new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager, mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+
+        /*
+            Start of tes3mp addition
+
+            Split the models of the cell into batches that other worker threads decompress while the
+            preload item works its way through them. The batches are queued first, so idle threads pick
+            them up before the preload item gets to the models.
+        */
+        PreloadEntry entry (timestamp, item);
+
+        if (mPrefetchFiles)
+        {
+            const std::vector<std::string>& meshes = item->getMeshes();
+            const std::size_t batchSize = 16;
+
+            for (std::size_t i = 0; i < meshes.size(); i += batchSize)
+            {
+                std::vector<std::string> batch (meshes.begin() + i, meshes.begin() + std::min(i + batchSize, meshes.size()));
+                osg::ref_ptr<PrefetchItem> prefetchItem (new PrefetchItem(mResourceSystem->getVFS(), std::move(batch)));
+                mWorkQueue->addWorkItem(prefetchItem);
+                entry.mPrefetchItems.push_back(prefetchItem);
+            }
+        }
+        /*
+            End of tes3mp addition
+        */
+
         mWorkQueue->addWorkItem(item);
 
-        mPreloadCells[cell] = PreloadEntry(timestamp, item);
+        /*
+            Start of tes3mp change (minor)
+
+            Keep the prefetch items of the cell along with its preload item
+        */
+        mPreloadCells[cell] = std::move(entry);
+        /*
+            End of tes3mp change (minor)
+        */
     }
 
     void CellPreloader::notifyLoaded(CellStore *cell)
@@ -324,6 +479,16 @@ namespace MWWorld
                 mUnrefQueue->push(mPreloadCells[cell].mWorkItem);
             }
 
+            /*
+                Start of tes3mp addition
+
+                Stop decompressing files for a cell that is no longer being preloaded
+            */
+            abortPrefetchItems(found->second.mPrefetchItems);
+            /*
+                End of tes3mp addition
+            */
+
             mPreloadCells.erase(found);
         }
     }
@@ -338,6 +503,16 @@ namespace MWWorld
                 mUnrefQueue->push(it->second.mWorkItem);
             }
 
+            /*
+                Start of tes3mp addition
+
+                Stop decompressing files for a cell that is no longer being preloaded
+            */
+            abortPrefetchItems(it->second.mPrefetchItems);
+            /*
+                End of tes3mp addition
+            */
+
             mPreloadCells.erase(it++);
         }
     }
@@ -353,6 +528,17 @@ namespace MWWorld
                     it->second.mWorkItem->abort();
                     mUnrefQueue->push(it->second.mWorkItem);
                 }
+
+                /*
+                    Start of tes3mp addition
+
+                    Stop decompressing files for a cell that is no longer being preloaded
+                */
+                abortPrefetchItems(it->second.mPrefetchItems);
+                /*
+                    End of tes3mp addition
+                */
+
                 mPreloadCells.erase(it++);
             }
             else
@@ -404,6 +590,19 @@ namespace MWWorld
         mPreloadInstances = preload;
     }
 
+    /*
+        Start of tes3mp addition
+
+        Allow the files a preloaded cell is going to need to be decompressed ahead of it
+    */
+    void CellPreloader::setPrefetchFiles(bool prefetch)
+    {
+        mPrefetchFiles = prefetch;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     unsigned int CellPreloader::getMaxCacheSize() const
     {
         return mMaxCacheSize;
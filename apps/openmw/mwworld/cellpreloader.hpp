@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_CELLPRELOADER_H
 
 #include <map>
+#include <vector>
 #include <osg/ref_ptr>
 #include <osg/Vec3f>
 #include <osg/Vec4i>
@@ -63,6 +64,18 @@ namespace MWWorld
         /// Enables the creation of instances in the preloading thread.
         void setPreloadInstances(bool preload);
 
+        /*
+            Start of tes3mp addition
+
+            Allow the files a preloaded cell is going to need to be decompressed ahead of it
+        */
+        /// Enables decompressing the files of a cell on other worker threads before they are preloaded.
+        /// Only worth it when decompressed files are kept in a cache.
+        void setPrefetchFiles(bool prefetch);
+        /*
+            End of tes3mp addition
+        */
+
         unsigned int getMaxCacheSize() const;
 
         void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
@@ -87,6 +100,16 @@ namespace MWWorld
         unsigned int mMaxCacheSize;
         bool mPreloadInstances;
 
+        /*
+            Start of tes3mp addition
+
+            Allow the files a preloaded cell is going to need to be decompressed ahead of it
+        */
+        bool mPrefetchFiles;
+        /*
+            End of tes3mp addition
+        */
+
         double mLastResourceCacheUpdate;
         int mStoreViewsFailCount;
 
@@ -104,6 +127,17 @@ namespace MWWorld
 
             double mTimeStamp;
             osg::ref_ptr<SceneUtil::WorkItem> mWorkItem;
+
+            /*
+                Start of tes3mp addition
+
+                Keep track of the items decompressing the files of the cell, so they can be aborted
+                together with mWorkItem
+            */
+            std::vector<osg::ref_ptr<SceneUtil::WorkItem> > mPrefetchItems;
+            /*
+                End of tes3mp addition
+            */
         };
         typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
@@ -3,18 +3,157 @@
 
 #include <components/esm/esmreader.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <exception>
+#include <memory>
+
+#include <components/sceneutil/workqueue.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace MWWorld
 {
 
+/*
+    Start of tes3mp addition
+
+    Read the records of one content file on the work queue
+*/
+class EsmLoader::DecodeWorkItem : public SceneUtil::WorkItem
+{
+public:
+  DecodeWorkItem(const ESMStore& store, ESM::ESMReader& esm, ToUTF8::Utf8Encoder* encoder)
+    : mStore(store)
+    , mEsm(esm)
+  {
+    // Encoders keep a buffer for the text they convert, so every file needs its own
+    if (encoder)
+      mEncoder.reset(new ToUTF8::Utf8Encoder(*encoder));
+
+    mEsm.setEncoder(mEncoder.get());
+  }
+
+  void doWork() override
+  {
+    try
+    {
+      mStore.decode(mEsm, mContent);
+    }
+    catch (...)
+    {
+      mError = std::current_exception();
+    }
+  }
+
+  const ESMStore& mStore;
+  ESM::ESMReader& mEsm;
+  std::unique_ptr<ToUTF8::Utf8Encoder> mEncoder;
+  ESMStore::DecodedContent mContent;
+  std::exception_ptr mError;
+};
+/*
+    End of tes3mp addition
+*/
+
 EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
   ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener)
   : ContentLoader(listener)
   , mEsm(readers)
   , mStore(store)
   , mEncoder(encoder)
+  /*
+      Start of tes3mp addition
+
+      Load content files one after another, unless given a work queue
+  */
+  , mWorkQueue(nullptr)
+  , mOpenOnly(false)
+  /*
+      End of tes3mp addition
+  */
+{
+}
+
+/*
+    Start of tes3mp addition
+
+    Read the records of the content files on a work queue, all of them at once, and only add
+    them to the store in load order when finish() is called
+*/
+EsmLoader::EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
+  ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener, SceneUtil::WorkQueue* workQueue)
+  : ContentLoader(listener)
+  , mEsm(readers)
+  , mStore(store)
+  , mEncoder(encoder)
+  , mWorkQueue(workQueue)
+  , mOpenOnly(false)
+{
+}
+
+EsmLoader::~EsmLoader()
 {
+  // Don't leave the work queue reading from readers that are about to go away
+  waitForPending();
 }
 
+void EsmLoader::finish()
+{
+  try
+  {
+    for (PendingFile& pending : mPending)
+    {
+      mListener.setLabel(MyGUI::TextIterator::toTagsString(pending.mPath));
+
+      DecodeWorkItem& workItem = *pending.mWorkItem;
+      workItem.waitTillDone();
+
+      ESM::ESMReader& esm = mEsm[pending.mIndex];
+      esm.setEncoder(mEncoder);
+
+      if (workItem.mError)
+        std::rethrow_exception(workItem.mError);
+
+      mStore.load(esm, workItem.mContent, &mListener);
+
+      // Free the decoded records
+      pending.mWorkItem = nullptr;
+    }
+  }
+  catch (...)
+  {
+    waitForPending();
+    throw;
+  }
+
+  mPending.clear();
+}
+
+void EsmLoader::setOpenOnly(bool openOnly)
+{
+  mOpenOnly = openOnly;
+}
+
+void EsmLoader::waitForPending()
+{
+  for (PendingFile& pending : mPending)
+  {
+    if (pending.mWorkItem)
+      pending.mWorkItem->waitTillDone();
+  }
+
+  mPending.clear();
+}
+/*
+    End of tes3mp addition
+*/
+
 void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
 {
   ContentLoader::load(filepath.filename(), index);
@@ -25,6 +164,31 @@ void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
   lEsm.setGlobalReaderList(&mEsm);
   lEsm.open(filepath.string());
   mEsm[index] = lEsm;
+
+  /*
+      Start of tes3mp change (major)
+
+      Leave the reading of the file's records to the work queue, if there is one, or to
+      whatever else the store gets its records from
+  */
+  if (mOpenOnly)
+    return;
+
+  if (mWorkQueue)
+  {
+    PendingFile pending;
+    pending.mPath = filepath.filename().string();
+    pending.mIndex = index;
+    pending.mWorkItem = new DecodeWorkItem(mStore, mEsm[index], mEncoder);
+    mPending.push_back(pending);
+
+    mWorkQueue->addWorkItem(pending.mWorkItem);
+    return;
+  }
+  /*
+      End of tes3mp change (major)
+  */
+
   mStore.load(mEsm[index], &mListener);
 }
 
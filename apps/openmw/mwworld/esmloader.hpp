@@ -3,6 +3,19 @@
 
 #include <vector>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <string>
+#include <utility>
+
+#include <osg/ref_ptr>
+/*
+    End of tes3mp addition
+*/
+
 #include "contentloader.hpp"
 
 namespace ToUTF8
@@ -15,6 +28,19 @@ namespace ESM
     class ESMReader;
 }
 
+/*
+    Start of tes3mp addition
+
+    Declare the work queue used to read content files in parallel
+*/
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+/*
+    End of tes3mp addition
+*/
+
 namespace MWWorld
 {
 
@@ -25,12 +51,63 @@ struct EsmLoader : public ContentLoader
     EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
       ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener);
 
+    /*
+        Start of tes3mp addition
+
+        Read the records of the content files on a work queue, all of them at once, and only add
+        them to the store in load order when finish() is called
+    */
+    EsmLoader(MWWorld::ESMStore& store, std::vector<ESM::ESMReader>& readers,
+      ToUTF8::Utf8Encoder* encoder, Loading::Listener& listener, SceneUtil::WorkQueue* workQueue);
+
+    ~EsmLoader();
+
+    void finish();
+    ///< Add the records of every content file given to load() to the store, in load order
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Allow the content files to only be opened, for a store that gets its records elsewhere
+    */
+    void setOpenOnly(bool openOnly);
+    ///< Only open the content files given to load(), without reading their records
+    /*
+        End of tes3mp addition
+    */
+
     void load(const boost::filesystem::path& filepath, int& index) override;
 
     private:
       std::vector<ESM::ESMReader>& mEsm;
       MWWorld::ESMStore& mStore;
       ToUTF8::Utf8Encoder* mEncoder;
+
+      /*
+          Start of tes3mp addition
+
+          Track the content files still being read on the work queue
+      */
+      class DecodeWorkItem;
+
+      struct PendingFile
+      {
+          std::string mPath;
+          int mIndex;
+          osg::ref_ptr<DecodeWorkItem> mWorkItem;
+      };
+
+      SceneUtil::WorkQueue* mWorkQueue;
+      std::vector<PendingFile> mPending;
+      bool mOpenOnly;
+
+      void waitForPending();
+      /*
+          End of tes3mp addition
+      */
 };
 
 } /* namespace MWWorld */
@@ -0,0 +1,14 @@
+#ifndef OPENMW_MWWORLD_ESMSTORECACHE_H
+#define OPENMW_MWWORLD_ESMSTORECACHE_H
+
+/*
+    Start of tes3mp change (minor)
+
+    The store is built as a component so esmtool can share it with the engine
+*/
+#include <components/esmstore/esmstorecache.hpp>
+/*
+    End of tes3mp change (minor)
+*/
+
+#endif
@@ -15,6 +15,7 @@
 */
 #include <components/openmw-mp/TimedLog.hpp>
 #include "../mwmp/Main.hpp"
+#include "../mwmp/LocalPlayer.hpp"
 #include "../mwmp/CellController.hpp"
 #include "../mwmp/PlayerList.hpp"
 /*
@@ -927,6 +928,17 @@ void MWWorld::InventoryStore::fireEquipmentChangedEvent(const Ptr& actor)
         End of tes3mp change (major)
     */
 
+    /*
+        Start of tes3mp addition
+
+        Let the LocalPlayer know it needs to compare its equipment on its next update
+    */
+    if (actor == MWBase::Environment::get().getWorld()->getPlayerPtr())
+        mwmp::Main::get().getLocalPlayer()->markDirty(mwmp::LocalPlayer::DIRTY_EQUIPMENT);
+    /*
+        End of tes3mp addition
+    */
+
     // if player, update inventory window
     /*
     if (actor == MWMechanics::getPlayer())
@@ -831,6 +831,16 @@ namespace MWWorld
         mPreloader->setMinCacheSize(Settings::Manager::getInt("preload cell cache min", "Cells"));
         mPreloader->setMaxCacheSize(Settings::Manager::getInt("preload cell cache max", "Cells"));
         mPreloader->setPreloadInstances(Settings::Manager::getBool("preload instances", "Cells"));
+
+        /*
+            Start of tes3mp addition
+
+            Decompress the files of preloaded cells ahead of time when they are kept in a cache
+        */
+        mPreloader->setPrefetchFiles(Settings::Manager::getInt("archive cache size", "Cells") > 0);
+        /*
+            End of tes3mp addition
+        */
     }
 
     Scene::~Scene()
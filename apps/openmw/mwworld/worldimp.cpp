@@ -26,6 +26,10 @@
 #include "../mwmp/RecordHelper.hpp"
 #include "../mwmp/CellController.hpp"
 #include "../mwmp/MechanicsHelper.hpp"
+
+#include <thread>
+
+#include <components/sceneutil/workqueue.hpp>
 /*
     End of tes3mp addition
 */
@@ -97,6 +101,16 @@
 #include "contentloader.hpp"
 #include "esmloader.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include "esmstorecache.hpp"
+/*
+    End of tes3mp addition
+*/
+
 namespace
 {
 
@@ -146,6 +160,30 @@ namespace MWWorld
           LoadersContainer mLoaders;
     };
 
+    /*
+        Start of tes3mp addition
+
+        Find out where the content files are, so the store cache can be checked against them
+        before any of them gets loaded
+    */
+    struct ContentPathCollector : public ContentLoader
+    {
+        ContentPathCollector(Loading::Listener& listener)
+          : ContentLoader(listener)
+        {
+        }
+
+        void load(const boost::filesystem::path& filepath, int& index) override
+        {
+            mPaths.push_back(filepath.string());
+        }
+
+        std::vector<std::string> mPaths;
+    };
+    /*
+        End of tes3mp addition
+    */
+
     void World::adjustSky()
     {
         if (mSky && (isCellExterior() || isCellQuasiExterior()))
@@ -181,7 +219,20 @@ namespace MWWorld
         listener->loadingOn();
 
         GameContentLoader gameContentLoader(*listener);
-        EsmLoader esmLoader(mStore, mEsm, encoder, *listener);
+
+        /*
+            Start of tes3mp change (major)
+
+            Read the records of all content files in parallel, on a work queue of their own, and
+            then add them to the store in load order
+        */
+        const int loadingThreads = std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()),
+            static_cast<int>(mEsm.size())));
+        osg::ref_ptr<SceneUtil::WorkQueue> loadingQueue = new SceneUtil::WorkQueue(loadingThreads);
+        EsmLoader esmLoader(mStore, mEsm, encoder, *listener, loadingQueue.get());
+        /*
+            End of tes3mp change (major)
+        */
 
         gameContentLoader.addLoader(".esm", &esmLoader);
         gameContentLoader.addLoader(".esp", &esmLoader);
@@ -189,8 +240,38 @@ namespace MWWorld
         gameContentLoader.addLoader(".omwaddon", &esmLoader);
         gameContentLoader.addLoader(".project", &esmLoader);
 
+        /*
+            Start of tes3mp addition
+
+            Get the store's records from the cache written by an earlier session with the same
+            content files, if there is one, and only open the content files in that case
+        */
+        ContentPathCollector contentPaths(*listener);
+        loadContentFiles(fileCollections, contentFiles, groundcoverFiles, contentPaths);
+
+        ESMStoreCache storeCache((boost::filesystem::path(userDataPath) / "esmstore.cache").string(),
+            contentPaths.mPaths, encoder, mwmp::Main::get().getNetworking()->getContentChecksums());
+        const bool useStoreCache = storeCache.open();
+        esmLoader.setOpenOnly(useStoreCache);
+        /*
+            End of tes3mp addition
+        */
+
         loadContentFiles(fileCollections, contentFiles, groundcoverFiles, gameContentLoader);
 
+        /*
+            Start of tes3mp addition
+
+            Add the records read on the work queue, or kept in the cache, to the store
+        */
+        if (useStoreCache)
+            storeCache.read(mStore, mEsm);
+        else
+            esmLoader.finish();
+        /*
+            End of tes3mp addition
+        */
+
         listener->loadingOff();
 
         // insert records that may not be present in all versions of MW
@@ -202,6 +283,19 @@ namespace MWWorld
         fillGlobalVariables();
 
         mStore.setUp(true);
+
+        /*
+            Start of tes3mp addition
+
+            Keep the loaded records for the next session, before anything but the content files
+            has changed the store
+        */
+        if (!useStoreCache)
+            storeCache.write(mStore);
+        /*
+            End of tes3mp addition
+        */
+
         mStore.movePlayerRecord();
 
         mSwimHeightScale = mStore.get<ESM::GameSetting>().find("fSwimHeightScale")->mValue.getFloat();
@@ -839,42 +933,59 @@ namespace MWWorld
     /*
         Start of tes3mp addition
 
-        Make it possible to update all Ptrs in active cells that have a certain refId
+        Make it possible to update all Ptrs in active cells that have a certain refId,
+        or any of several lowercase refIds in a single pass over those cells
     */
     void World::updatePtrsWithRefId(std::string refId)
     {
+        std::set<std::string> refIds;
+        refIds.insert(Misc::StringUtils::lowerCase(refId));
+
+        updatePtrsWithRefIds(refIds);
+    }
+
+    void World::updatePtrsWithRefIds(const std::set<std::string>& refIds)
+    {
+        if (refIds.empty())
+            return;
+
         for (Scene::CellStoreCollection::const_iterator iter(mWorldScene->getActiveCells().begin());
             iter != mWorldScene->getActiveCells().end(); ++iter)
         {
             CellStore* cellStore = *iter;
 
+            // Find the Ptrs first, because replacing them changes the cell's list of references
+            std::vector<MWWorld::Ptr> ptrsToUpdate;
+
             for (auto &mergedRef : cellStore->getMergedRefs())
             {
-                if (Misc::StringUtils::ciEqual(refId, mergedRef->mRef.getRefId()))
-                {
-                    MWWorld::Ptr ptr(mergedRef, cellStore);
-
-                    const ESM::Position* position = &ptr.getRefData().getPosition();
-                    const unsigned int refNum = ptr.getCellRef().getRefNum().mIndex;
-                    const unsigned int mpNum = ptr.getCellRef().getMpNum();
-
-                    deleteObject(ptr);
-                    ptr.getCellRef().unsetRefNum();
-                    ptr.getCellRef().setMpNum(0);
-
-                    MWWorld::ManualRef* reference = new MWWorld::ManualRef(getStore(), refId, 1);
-                    MWWorld::Ptr newPtr = placeObject(reference->getPtr(), cellStore, *position);
-                    newPtr.getCellRef().setRefNum(refNum);
-                    newPtr.getCellRef().setMpNum(mpNum);
+                if (refIds.count(Misc::StringUtils::lowerCase(mergedRef->mRef.getRefId())) > 0)
+                    ptrsToUpdate.push_back(MWWorld::Ptr(mergedRef, cellStore));
+            }
 
-                    // Update Ptrs for LocalActors and DedicatedActors
-                    if (newPtr.getClass().isActor())
-                    {
-                        if (mwmp::Main::get().getCellController()->isLocalActor(refNum, mpNum))
-                            mwmp::Main::get().getCellController()->getLocalActor(refNum, mpNum)->setPtr(newPtr);
-                        else if (mwmp::Main::get().getCellController()->isDedicatedActor(refNum, mpNum))
-                            mwmp::Main::get().getCellController()->getDedicatedActor(refNum, mpNum)->setPtr(newPtr);
-                    }
+            for (auto &ptr : ptrsToUpdate)
+            {
+                const std::string refId = ptr.getCellRef().getRefId();
+                const ESM::Position position = ptr.getRefData().getPosition();
+                const unsigned int refNum = ptr.getCellRef().getRefNum().mIndex;
+                const unsigned int mpNum = ptr.getCellRef().getMpNum();
+
+                deleteObject(ptr);
+                ptr.getCellRef().unsetRefNum();
+                ptr.getCellRef().setMpNum(0);
+
+                MWWorld::ManualRef* reference = new MWWorld::ManualRef(getStore(), refId, 1);
+                MWWorld::Ptr newPtr = placeObject(reference->getPtr(), cellStore, position);
+                newPtr.getCellRef().setRefNum(refNum);
+                newPtr.getCellRef().setMpNum(mpNum);
+
+                // Update Ptrs for LocalActors and DedicatedActors
+                if (newPtr.getClass().isActor())
+                {
+                    if (mwmp::Main::get().getCellController()->isLocalActor(refNum, mpNum))
+                        mwmp::Main::get().getCellController()->getLocalActor(refNum, mpNum)->setPtr(newPtr);
+                    else if (mwmp::Main::get().getCellController()->isDedicatedActor(refNum, mpNum))
+                        mwmp::Main::get().getCellController()->getDedicatedActor(refNum, mpNum)->setPtr(newPtr);
                 }
             }
         }
@@ -341,9 +341,11 @@ namespace MWWorld
             /*
                 Start of tes3mp addition
 
-                Make it possible to update all Ptrs in active cells that have a certain refId
+                Make it possible to update all Ptrs in active cells that have a certain refId,
+                or any of several lowercase refIds in a single pass over those cells
             */
             void updatePtrsWithRefId(std::string refId) override;
+            void updatePtrsWithRefIds(const std::set<std::string>& refIds) override;
             /*
                 End of tes3mp addition
             */
@@ -0,0 +1,63 @@
+#include <components/bsa/blobcache.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+
+    Bsa::BlobCache::Blob makeBlob(std::size_t size)
+    {
+        return std::make_shared<const std::vector<char>>(size, 'x');
+    }
+
+    TEST(BsaBlobCacheTest, should_return_cached_blob)
+    {
+        Bsa::BlobCache cache(100);
+        const Bsa::BlobCache::Blob blob = makeBlob(10);
+        cache.insert("a", blob);
+
+        EXPECT_EQ(blob, cache.get("a"));
+        EXPECT_EQ(nullptr, cache.get("b"));
+        EXPECT_EQ(10u, cache.getSize());
+    }
+
+    TEST(BsaBlobCacheTest, should_drop_least_recently_used_blobs_when_full)
+    {
+        Bsa::BlobCache cache(30);
+        cache.insert("a", makeBlob(10));
+        cache.insert("b", makeBlob(10));
+        cache.insert("c", makeBlob(10));
+
+        // Using "a" leaves "b" as the least recently used one
+        EXPECT_NE(nullptr, cache.get("a"));
+        cache.insert("d", makeBlob(10));
+
+        EXPECT_TRUE(cache.contains("a"));
+        EXPECT_FALSE(cache.contains("b"));
+        EXPECT_TRUE(cache.contains("c"));
+        EXPECT_TRUE(cache.contains("d"));
+        EXPECT_EQ(30u, cache.getSize());
+    }
+
+    TEST(BsaBlobCacheTest, should_replace_blob_with_same_key)
+    {
+        Bsa::BlobCache cache(30);
+        cache.insert("a", makeBlob(10));
+        cache.insert("a", makeBlob(20));
+
+        EXPECT_EQ(20u, cache.get("a")->size());
+        EXPECT_EQ(20u, cache.getSize());
+    }
+
+    TEST(BsaBlobCacheTest, should_not_keep_blob_bigger_than_capacity)
+    {
+        Bsa::BlobCache cache(30);
+        cache.insert("a", makeBlob(10));
+        cache.insert("b", makeBlob(40));
+
+        EXPECT_TRUE(cache.contains("a"));
+        EXPECT_FALSE(cache.contains("b"));
+        EXPECT_EQ(10u, cache.getSize());
+    }
+}
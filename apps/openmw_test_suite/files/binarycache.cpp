@@ -0,0 +1,79 @@
+#include <components/files/binarycache.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+
+    TEST(FilesBinaryCacheTest, values_should_read_back_as_written)
+    {
+        std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+        Files::writeValue(stream, static_cast<uint32_t>(42));
+        Files::writeValue(stream, std::string("value"));
+        Files::writeValue(stream, std::string());
+
+        uint32_t number = 0;
+        std::string text;
+        std::string empty = "not empty";
+
+        EXPECT_TRUE(Files::readValue(stream, number));
+        EXPECT_EQ(42u, number);
+        EXPECT_TRUE(Files::readValue(stream, text));
+        EXPECT_EQ("value", text);
+        EXPECT_TRUE(Files::readValue(stream, empty));
+        EXPECT_EQ("", empty);
+        EXPECT_FALSE(Files::readValue(stream, number));
+    }
+
+    TEST(FilesBinaryCacheTest, string_bigger_than_max_size_should_not_be_read)
+    {
+        std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+        Files::writeValue(stream, std::string("value"));
+
+        std::string text;
+        EXPECT_FALSE(Files::readValue(stream, text, 4));
+    }
+
+    TEST(FilesBinaryCacheTest, header_should_only_match_same_magic_and_version)
+    {
+        std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+        Files::writeCacheHeader(stream, "MAGIC", 2);
+        const std::string header = stream.str();
+
+        std::istringstream same(header);
+        EXPECT_TRUE(Files::readCacheHeader(same, "MAGIC", 2));
+        std::istringstream otherVersion(header);
+        EXPECT_FALSE(Files::readCacheHeader(otherVersion, "MAGIC", 3));
+        std::istringstream otherMagic(header);
+        EXPECT_FALSE(Files::readCacheHeader(otherMagic, "OTHER", 2));
+    }
+
+    TEST(FilesBinaryCacheTest, atomic_write_should_replace_file_and_leave_nothing_else_behind)
+    {
+        const boost::filesystem::path directory("files_binarycache");
+        const boost::filesystem::path path = directory / "nested" / "file.cache";
+        boost::filesystem::remove_all(directory);
+
+        Files::writeFileAtomically(path, [] (std::ostream& stream) { stream << "first"; });
+        Files::writeFileAtomically(path, [] (std::ostream& stream) { stream << "second"; });
+
+        boost::filesystem::ifstream stream(path);
+        std::string content;
+        stream >> content;
+        EXPECT_EQ("second", content);
+
+        std::size_t count = 0;
+        for (boost::filesystem::directory_iterator it(path.parent_path()), end; it != end; ++it)
+            ++count;
+        EXPECT_EQ(1u, count);
+
+        stream.close();
+        boost::filesystem::remove_all(directory);
+    }
+}
@@ -0,0 +1,68 @@
+#include <components/misc/stringindex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <map>
+#include <string>
+
+namespace
+{
+    typedef Misc::StringIndex<int, std::hash<std::string>> Index;
+
+    TEST(MiscStringIndexTest, should_find_inserted_keys_until_erased)
+    {
+        std::map<std::string, int> values;
+        Index index;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            auto inserted = values.emplace("key_" + std::to_string(i), i);
+            index.insert(inserted.first->first, &inserted.first->second);
+        }
+
+        for (int i = 0; i < 1000; i += 2)
+            EXPECT_TRUE(index.erase("key_" + std::to_string(i)));
+
+        EXPECT_EQ(500u, index.size());
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const int* value = index.search("key_" + std::to_string(i));
+
+            if (i % 2 == 0)
+                EXPECT_EQ(nullptr, value);
+            else
+                EXPECT_EQ(i, *value);
+        }
+
+        EXPECT_FALSE(index.erase("key_0"));
+        EXPECT_EQ(nullptr, index.search("KEY_1"));
+    }
+
+    TEST(MiscStringIndexTest, insert_should_replace_value_of_same_key)
+    {
+        const std::string key = "key";
+        int first = 1;
+        int second = 2;
+        Index index;
+
+        index.insert(key, &first);
+        index.insert(key, &second);
+
+        EXPECT_EQ(1u, index.size());
+        EXPECT_EQ(&second, index.search("key"));
+    }
+
+    TEST(MiscStringIndexTest, search_should_accept_custom_equality)
+    {
+        const std::string key = "key";
+        int value = 1;
+        Index index;
+
+        index.insert(key, &value);
+
+        EXPECT_EQ(&value, index.search(std::hash<std::string>()("key"), [] (const std::string& other) { return other == "key"; }));
+        EXPECT_EQ(nullptr, index.search(std::hash<std::string>()("key"), [] (const std::string&) { return false; }));
+    }
+}
@@ -8,13 +8,7 @@
 #include <components/esm/esmwriter.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 
-#include "apps/openmw/mwworld/esmstore.hpp"
-#include "apps/openmw/mwmechanics/spelllist.hpp"
-
-namespace MWMechanics
-{
-    SpellList::SpellList(const std::string& id, int type) : mId(id), mType(type) {}
-}
+#include <components/esmstore/esmstore.hpp>
 
 static Loading::Listener dummyListener;
 
@@ -318,3 +312,380 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests that overriding records in a batch gives the same result as overriding them one by one.
+TEST_F(StoreTest, override_batch_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    std::vector<RecordType> records;
+    const char* ids[] = { "zeta", "Alpha", "mid", "ALPHA", "beta" };
+
+    for (const char* id : ids)
+    {
+        RecordType record;
+        record.blank();
+        record.mId = id;
+        record.mModel = std::string("model_") + id;
+        records.push_back(record);
+    }
+
+    MWWorld::ESMStore oneByOneStore;
+
+    for (const RecordType& record : records)
+        oneByOneStore.overrideRecord(record);
+
+    mEsmStore.overrideRecords(records);
+
+    const MWWorld::Store<RecordType>& batchStore = mEsmStore.get<RecordType>();
+    const MWWorld::Store<RecordType>& expectedStore = oneByOneStore.get<RecordType>();
+
+    ASSERT_EQ(expectedStore.getSize(), batchStore.getSize());
+    ASSERT_EQ(4u, batchStore.getSize());
+
+    // The records keep the order they were received in, and the last of several with the same id wins
+    MWWorld::Store<RecordType>::iterator expectedIt = expectedStore.begin();
+    for (MWWorld::Store<RecordType>::iterator it = batchStore.begin(); it != batchStore.end(); ++it, ++expectedIt)
+    {
+        EXPECT_EQ(expectedIt->mId, it->mId);
+        EXPECT_EQ(expectedIt->mModel, it->mModel);
+    }
+
+    ASSERT_TRUE(batchStore.search("alpha") != nullptr);
+    EXPECT_EQ("model_ALPHA", batchStore.search("alpha")->mModel);
+    EXPECT_EQ(ESM::REC_APPA, mEsmStore.find("beta"));
+}
+
+/// Tests that looking records up through the id index follows inserting and erasing them.
+TEST_F(StoreTest, id_index_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    MWWorld::Store<RecordType>& store = const_cast<MWWorld::Store<RecordType>&>(mEsmStore.get<RecordType>());
+
+    // Enough records for the index to grow several times
+    for (int i = 0; i < 1000; ++i)
+    {
+        RecordType record;
+        record.blank();
+        record.mId = "record_" + std::to_string(i);
+        record.mModel = "static";
+        store.insertStatic(record);
+    }
+
+    for (int i = 0; i < 1000; i += 2)
+        store.eraseStatic("record_" + std::to_string(i));
+
+    RecordType dynamicRecord;
+    dynamicRecord.blank();
+    dynamicRecord.mId = "RECORD_1";
+    dynamicRecord.mModel = "dynamic";
+    store.insert(dynamicRecord);
+
+    ASSERT_EQ(501u, store.getSize());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::string id = "ReCoRd_" + std::to_string(i);
+        const RecordType* record = store.search(id);
+
+        EXPECT_EQ(i % 2 == 1, record != nullptr) << id;
+        EXPECT_EQ(record, store.search(MWWorld::RecordKey(id))) << id;
+    }
+
+    // Dynamic records hide the static ones with the same id, until they are erased
+    EXPECT_EQ("dynamic", store.search("record_1")->mModel);
+    EXPECT_EQ("static", store.searchStatic("record_1")->mModel);
+    EXPECT_EQ("dynamic", store.find(MWWorld::RecordKey("Record_1"))->mModel);
+
+    EXPECT_TRUE(store.erase("Record_1"));
+    EXPECT_EQ("static", store.search("record_1")->mModel);
+
+    store.insert(dynamicRecord);
+    store.clearDynamic();
+    EXPECT_EQ("static", store.search(MWWorld::RecordKey("record_1"))->mModel);
+
+    EXPECT_TRUE(store.search(MWWorld::RecordKey("record_0")) == nullptr);
+    EXPECT_THROW(store.find(MWWorld::RecordKey("record_0")), std::runtime_error);
+}
+
+/// Add a record to an in-memory ESM file that is being written.
+template <typename T>
+void writeRecord(ESM::ESMWriter& writer, const T& record, bool deleted = false)
+{
+    writer.startRecord(T::sRecordId);
+    record.save(writer, deleted);
+    writer.endRecord(T::sRecordId);
+}
+
+/// Tests that decoding a content file before adding its records gives the same result as loading it directly.
+TEST_F(StoreTest, decoded_load_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    RecordType first;
+    first.blank();
+    first.mId = "Foobar";
+    first.mModel = "first_model";
+
+    RecordType deleted;
+    deleted.blank();
+    deleted.mId = "deleted";
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "Greeting";
+    dialogue.mType = ESM::Dialogue::Topic;
+
+    ESM::DialInfo info;
+    info.blank();
+    info.mId = "info";
+
+    RecordType second = first;
+    second.mId = "foobar";
+    second.mModel = "second_model";
+
+    ESM::Script script;
+    script.blank();
+    script.mId = "script";
+
+    ESM::ESMWriter writer;
+    std::stringstream stream;
+    writer.setFormat(0);
+    writer.save(stream);
+    writeRecord(writer, first);
+    writeRecord(writer, deleted);
+    writeRecord(writer, dialogue);
+    // A deleted record doesn't end the dialogue that the following info belongs to
+    writeRecord(writer, deleted, true);
+    writeRecord(writer, info);
+    writeRecord(writer, second);
+    writeRecord(writer, script);
+
+    ESM::ESMReader reader;
+    std::vector<ESM::ESMReader> readerList;
+    readerList.push_back(reader);
+    reader.setGlobalReaderList(&readerList);
+    reader.open(Files::IStreamPtr(new std::stringstream(stream.str())), "filename");
+    mEsmStore.load(reader, &dummyListener);
+    mEsmStore.setUp();
+
+    MWWorld::ESMStore decodedStore;
+    MWWorld::ESMStore::DecodedContent content;
+    reader.open(Files::IStreamPtr(new std::stringstream(stream.str())), "filename");
+    decodedStore.decode(reader, content);
+    decodedStore.load(reader, content, &dummyListener);
+    decodedStore.setUp();
+
+    const MWWorld::Store<RecordType>& expectedStore = mEsmStore.get<RecordType>();
+    const MWWorld::Store<RecordType>& store = decodedStore.get<RecordType>();
+
+    ASSERT_EQ(1u, store.getSize());
+    ASSERT_EQ(expectedStore.getSize(), store.getSize());
+    EXPECT_EQ(expectedStore.begin()->mId, store.begin()->mId);
+    EXPECT_EQ("second_model", store.begin()->mModel);
+
+    const ESM::Dialogue* expectedDialogue = mEsmStore.get<ESM::Dialogue>().search("greeting");
+    const ESM::Dialogue* decodedDialogue = decodedStore.get<ESM::Dialogue>().search("greeting");
+
+    ASSERT_TRUE(expectedDialogue != nullptr && decodedDialogue != nullptr);
+    EXPECT_EQ(1u, decodedDialogue->mInfo.size());
+    EXPECT_EQ(expectedDialogue->mInfo.size(), decodedDialogue->mInfo.size());
+
+    EXPECT_TRUE(decodedStore.get<ESM::Script>().search("script") != nullptr);
+    EXPECT_EQ(mEsmStore.get<ESM::Script>().getSize(), decodedStore.get<ESM::Script>().getSize());
+}
+
+/// Tests that records read in order after decoding a plugin still know the plugin's master files.
+TEST_F(StoreTest, decoded_load_with_master_test)
+{
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    apparatus.mId = "apparatus";
+
+    ESM::Cell cell;
+    cell.blank();
+    cell.mName = "Test Cell";
+    cell.mData.mFlags = ESM::Cell::Interior;
+
+    ESM::ESMWriter masterWriter;
+    std::stringstream masterStream;
+    masterWriter.setFormat(0);
+    masterWriter.save(masterStream);
+    writeRecord(masterWriter, apparatus);
+
+    ESM::ESMWriter pluginWriter;
+    std::stringstream pluginStream;
+    pluginWriter.setFormat(0);
+    pluginWriter.addMaster("master.esm", 0);
+    pluginWriter.save(pluginStream);
+    writeRecord(pluginWriter, apparatus);
+    writeRecord(pluginWriter, cell);
+
+    const std::string fileNames[] = { "master.esm", "plugin.esp" };
+    const std::stringstream* streams[] = { &masterStream, &pluginStream };
+
+    std::vector<ESM::ESMReader> readerList(2);
+    std::vector<ESM::ESMReader> decodedReaderList(2);
+    MWWorld::ESMStore decodedStore;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        readerList[i].setIndex(i);
+        readerList[i].setGlobalReaderList(&readerList);
+        readerList[i].open(Files::IStreamPtr(new std::stringstream(streams[i]->str())), fileNames[i]);
+        mEsmStore.load(readerList[i], &dummyListener);
+
+        decodedReaderList[i].setIndex(i);
+        decodedReaderList[i].setGlobalReaderList(&decodedReaderList);
+        decodedReaderList[i].open(Files::IStreamPtr(new std::stringstream(streams[i]->str())), fileNames[i]);
+
+        MWWorld::ESMStore::DecodedContent content;
+        decodedStore.decode(decodedReaderList[i], content);
+        decodedStore.load(decodedReaderList[i], content, &dummyListener);
+
+        EXPECT_EQ(readerList[i].getParentFileIndices(), decodedReaderList[i].getParentFileIndices());
+    }
+
+    mEsmStore.setUp();
+    decodedStore.setUp();
+
+    const ESM::Cell* expectedCell = mEsmStore.get<ESM::Cell>().search("test cell");
+    const ESM::Cell* decodedCell = decodedStore.get<ESM::Cell>().search("test cell");
+    ASSERT_TRUE(expectedCell != nullptr && decodedCell != nullptr);
+    ASSERT_EQ(1u, decodedCell->mContextList.size());
+    EXPECT_EQ(std::vector<int>(1, 0), decodedCell->mContextList[0].parentFileIndices);
+    EXPECT_EQ(expectedCell->mContextList[0].parentFileIndices, decodedCell->mContextList[0].parentFileIndices);
+}
+
+/// Tests that writing the store to a cache and reading it back gives the same result as loading the content file.
+TEST_F(StoreTest, cache_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    RecordType zeta;
+    zeta.blank();
+    zeta.mId = "Zeta";
+    zeta.mModel = "zeta_model";
+
+    RecordType alpha = zeta;
+    alpha.mId = "alpha";
+    alpha.mModel = "alpha_model";
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = "Greeting";
+    dialogue.mType = ESM::Dialogue::Topic;
+
+    ESM::DialInfo firstInfo;
+    firstInfo.blank();
+    firstInfo.mId = "first";
+
+    ESM::DialInfo secondInfo = firstInfo;
+    secondInfo.mId = "second";
+
+    ESM::Cell interior;
+    interior.blank();
+    interior.mName = "Test Cell";
+    interior.mData.mFlags = ESM::Cell::Interior;
+
+    ESM::Cell exterior;
+    exterior.blank();
+    exterior.mRegion = "test region";
+    exterior.mData.mX = 1;
+    exterior.mData.mY = 2;
+
+    ESM::Land land;
+    land.mX = 1;
+    land.mY = 2;
+
+    ESM::LandTexture landTexture;
+    landTexture.blank();
+    landTexture.mId = "texture";
+    landTexture.mIndex = 0;
+    landTexture.mTexture = "texture.dds";
+
+    ESM::Pathgrid pathgrid;
+    pathgrid.blank();
+    pathgrid.mCell = "Test Cell";
+
+    ESM::ESMWriter writer;
+    std::stringstream stream;
+    writer.setFormat(0);
+    writer.save(stream);
+    writeRecord(writer, zeta);
+    writeRecord(writer, alpha);
+    writeRecord(writer, dialogue);
+    writeRecord(writer, firstInfo);
+    writeRecord(writer, secondInfo);
+    writeRecord(writer, interior);
+    writeRecord(writer, exterior);
+    writeRecord(writer, land);
+    writeRecord(writer, landTexture);
+    writeRecord(writer, pathgrid);
+
+    ESM::ESMReader reader;
+    std::vector<ESM::ESMReader> readerList;
+    readerList.push_back(reader);
+    readerList[0].setGlobalReaderList(&readerList);
+    readerList[0].open(Files::IStreamPtr(new std::stringstream(stream.str())), "filename");
+    readerList[0].setIndex(0);
+    mEsmStore.load(readerList[0], &dummyListener);
+    mEsmStore.setUp();
+
+    std::stringstream cacheStream;
+    ESM::ESMWriter cacheWriter;
+    cacheWriter.setFormat(0);
+    cacheWriter.setVersion(ESM::VER_13);
+    cacheWriter.save(cacheStream);
+    mEsmStore.writeCache(cacheWriter);
+    cacheWriter.close();
+
+    MWWorld::ESMStore cachedStore;
+    ESM::ESMReader cacheReader;
+    cacheReader.open(Files::IStreamPtr(new std::stringstream(cacheStream.str())), "cache");
+    cachedStore.readCache(cacheReader, readerList);
+    cachedStore.setUp();
+
+    // The records keep the order they were loaded in
+    const MWWorld::Store<RecordType>& expectedStore = mEsmStore.get<RecordType>();
+    const MWWorld::Store<RecordType>& store = cachedStore.get<RecordType>();
+
+    ASSERT_EQ(2u, store.getSize());
+    MWWorld::Store<RecordType>::iterator expectedIt = expectedStore.begin();
+    for (MWWorld::Store<RecordType>::iterator it = store.begin(); it != store.end(); ++it, ++expectedIt)
+    {
+        EXPECT_EQ(expectedIt->mId, it->mId);
+        EXPECT_EQ(expectedIt->mModel, it->mModel);
+    }
+
+    const ESM::Dialogue* cachedDialogue = cachedStore.get<ESM::Dialogue>().search("greeting");
+    ASSERT_TRUE(cachedDialogue != nullptr);
+    ASSERT_EQ(2u, cachedDialogue->mInfo.size());
+    EXPECT_EQ("first", cachedDialogue->mInfo.front().mId);
+    EXPECT_EQ("second", cachedDialogue->mInfo.back().mId);
+
+    // Cells and land still point into the content file for the parts that are read later on
+    const ESM::Cell* expectedInterior = mEsmStore.get<ESM::Cell>().search("test cell");
+    const ESM::Cell* cachedInterior = cachedStore.get<ESM::Cell>().search("test cell");
+    ASSERT_TRUE(expectedInterior != nullptr && cachedInterior != nullptr);
+    ASSERT_EQ(expectedInterior->mContextList.size(), cachedInterior->mContextList.size());
+    EXPECT_EQ(expectedInterior->mContextList[0].filePos, cachedInterior->mContextList[0].filePos);
+    EXPECT_EQ(expectedInterior->mContextList[0].leftRec, cachedInterior->mContextList[0].leftRec);
+    EXPECT_EQ("filename", cachedInterior->mContextList[0].filename);
+
+    const ESM::Cell* cachedExterior = cachedStore.get<ESM::Cell>().search(1, 2);
+    ASSERT_TRUE(cachedExterior != nullptr);
+    EXPECT_EQ("test region", cachedExterior->mRegion);
+    EXPECT_TRUE(cachedExterior->getCellId() == mEsmStore.get<ESM::Cell>().search(1, 2)->getCellId());
+
+    const ESM::Land* cachedLand = cachedStore.get<ESM::Land>().search(1, 2);
+    ASSERT_TRUE(cachedLand != nullptr);
+    EXPECT_EQ(mEsmStore.get<ESM::Land>().search(1, 2)->mContext.filePos, cachedLand->mContext.filePos);
+
+    const ESM::LandTexture* cachedLandTexture = cachedStore.get<ESM::LandTexture>().search(0, 0);
+    ASSERT_TRUE(cachedLandTexture != nullptr);
+    EXPECT_EQ("texture.dds", cachedLandTexture->mTexture);
+
+    EXPECT_TRUE(cachedStore.get<ESM::Pathgrid>().search("Test Cell") != nullptr);
+}
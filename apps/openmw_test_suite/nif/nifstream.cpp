@@ -0,0 +1,98 @@
+#include <components/nif/nifstream.hpp>
+#include <components/files/memorystream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+
+namespace
+{
+    using namespace testing;
+
+    template <class T>
+    void write(std::string& data, const T& value)
+    {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    std::string makeData()
+    {
+        std::string data = "NetImmerse File Format, Version 4.0.0.2\n";
+        write(data, 0x04000002u);
+        write(data, static_cast<short>(-2));
+        write(data, 2u);
+        for (float value : {1.f, 2.f, 3.f, 4.f, 5.f, 6.f})
+            write(data, value);
+        write(data, 5u);
+        data += "Scene";
+        write(data, 42);
+        return data;
+    }
+
+    struct Values
+    {
+        std::string mVersionString;
+        unsigned int mVersion;
+        short mShort;
+        std::vector<osg::Vec3f> mVectors;
+        std::string mName;
+        int mLast;
+        int mPastEnd;
+        std::string mPastEndString;
+    };
+
+    Values read(Files::IStreamPtr stream, bool buffered)
+    {
+        Nif::NIFStream nif(nullptr, stream, buffered);
+
+        Values values;
+        values.mVersionString = nif.getVersionString();
+        values.mVersion = nif.getUInt();
+        values.mShort = nif.getShort();
+        nif.getVector3s(values.mVectors, nif.getUInt());
+        values.mName = nif.getSizedString();
+        values.mLast = nif.getInt();
+        values.mPastEnd = buffered ? nif.getInt() : 0;
+        values.mPastEndString = buffered ? nif.getSizedString(2) : std::string(2, '\0');
+        return values;
+    }
+
+    void expectValues(const Values& values)
+    {
+        EXPECT_EQ("NetImmerse File Format, Version 4.0.0.2", values.mVersionString);
+        EXPECT_EQ(0x04000002u, values.mVersion);
+        EXPECT_EQ(-2, values.mShort);
+        ASSERT_EQ(2u, values.mVectors.size());
+        EXPECT_EQ(osg::Vec3f(1, 2, 3), values.mVectors[0]);
+        EXPECT_EQ(osg::Vec3f(4, 5, 6), values.mVectors[1]);
+        EXPECT_EQ("Scene", values.mName);
+        EXPECT_EQ(42, values.mLast);
+        EXPECT_EQ(0, values.mPastEnd);
+        EXPECT_EQ(std::string(2, '\0'), values.mPastEndString);
+    }
+
+    TEST(NifNIFStreamTest, should_read_from_stream)
+    {
+        expectValues(read(std::make_shared<std::istringstream>(makeData()), false));
+    }
+
+    TEST(NifNIFStreamTest, should_read_stream_into_buffer)
+    {
+        expectValues(read(std::make_shared<std::istringstream>(makeData()), true));
+    }
+
+    TEST(NifNIFStreamTest, should_read_memory_stream_in_place)
+    {
+        const std::string data = makeData();
+        expectValues(read(std::make_shared<Files::IMemStream>(data.data(), data.size()), true));
+    }
+
+    TEST(NifNIFStreamTest, should_read_memory_stream_from_its_position)
+    {
+        const std::string data = "skipped" + makeData();
+        Files::IStreamPtr stream = std::make_shared<Files::IMemStream>(data.data(), data.size());
+        stream->ignore(7);
+        expectValues(read(stream, true));
+    }
+}
@@ -0,0 +1,71 @@
+#include <components/openmw-mp/Base/InventorySync.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+    using namespace mwmp::InventorySync;
+
+    Item makeItem(const std::string& refId, int count, float enchantmentCharge = -1)
+    {
+        Item item;
+        item.refId = refId;
+        item.count = count;
+        item.charge = -1;
+        item.enchantmentCharge = enchantmentCharge;
+        return item;
+    }
+
+    TEST(MwmpInventorySyncTest, inventory_checksum_should_not_depend_on_order_case_or_split_stacks)
+    {
+        const std::vector<Item> inventory = { makeItem("iron dagger", 1), makeItem("gold_001", 50) };
+
+        EXPECT_EQ(getInventoryChecksum(inventory),
+            getInventoryChecksum({ makeItem("Gold_001", 20), makeItem("Iron Dagger", 1), makeItem("gold_001", 30) }));
+        EXPECT_NE(getInventoryChecksum(inventory),
+            getInventoryChecksum({ makeItem("iron dagger", 1), makeItem("gold_001", 49) }));
+        EXPECT_NE(getInventoryChecksum(inventory),
+            getInventoryChecksum({ makeItem("iron dagger", 1, 5), makeItem("gold_001", 50) }));
+    }
+
+    TEST(MwmpInventorySyncTest, spellbook_checksum_should_not_depend_on_order_case_or_duplicates)
+    {
+        EXPECT_EQ(getSpellbookChecksum({ "fireball", "frostbite" }),
+            getSpellbookChecksum({ "Frostbite", "fireball", "FIREBALL" }));
+        EXPECT_NE(getSpellbookChecksum({ "fireball", "frostbite" }), getSpellbookChecksum({ "fireball" }));
+    }
+
+    TEST(MwmpInventorySyncTest, applying_delta_should_give_target_inventory)
+    {
+        std::vector<Item> inventory = { makeItem("iron dagger", 1), makeItem("gold_001", 50), makeItem("torch", 2) };
+        const std::vector<Item> target = { makeItem("gold_001", 10), makeItem("torch", 2), makeItem("steel axe", 1) };
+
+        const std::vector<Item> delta = getInventoryDelta(inventory, target);
+
+        ASSERT_EQ(3u, delta.size());
+        EXPECT_EQ("iron dagger", delta[0].refId);
+        EXPECT_EQ(-1, delta[0].count);
+
+        for (const auto& item : delta)
+        {
+            if (item.count > 0)
+                addToInventory(inventory, item, item.count);
+            else
+                EXPECT_TRUE(removeFromInventory(inventory, item, -item.count));
+        }
+
+        EXPECT_EQ(getInventoryChecksum(target), getInventoryChecksum(inventory));
+    }
+
+    TEST(MwmpInventorySyncTest, remove_should_fail_when_stack_is_ambiguous)
+    {
+        std::vector<Item> inventory = { makeItem("iron dagger", 1, 5), makeItem("iron dagger", 1, 10) };
+
+        EXPECT_FALSE(removeFromInventory(inventory, makeItem("iron dagger", 1, 7), 1));
+        EXPECT_TRUE(removeFromInventory(inventory, makeItem("iron dagger", 1, 5), 1));
+        ASSERT_EQ(1u, inventory.size());
+        EXPECT_EQ(10, inventory[0].enchantmentCharge);
+    }
+}
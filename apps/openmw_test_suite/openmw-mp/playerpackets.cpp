@@ -0,0 +1,171 @@
+#include <components/openmw-mp/Packets/Player/PacketPlayerInventory.hpp>
+#include <components/openmw-mp/Packets/Player/PacketPlayerSpellbook.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    Item makeItem(const std::string& refId, int count)
+    {
+        Item item;
+        item.refId = refId;
+        item.count = count;
+        item.charge = -1;
+        item.enchantmentCharge = -1;
+        return item;
+    }
+
+    struct MwmpPlayerPacketsTest : Test
+    {
+        BasePlayer mServer;
+        BasePlayer mClient;
+
+        MwmpPlayerPacketsTest()
+            : mServer(RakNet::UNASSIGNED_RAKNET_GUID)
+            , mClient(RakNet::UNASSIGNED_RAKNET_GUID)
+        {
+        }
+
+        // Write a packet about the server's copy of a player, and read it into the client's
+        unsigned int transfer(PlayerPacket& packet)
+        {
+            RakNet::BitStream stream;
+            packet.setPlayer(&mServer);
+            packet.Packet(&stream, true);
+
+            stream.IgnoreBytes(BasePacket::headerSize());
+            packet.setPlayer(&mClient);
+            packet.SetReadStream(&stream);
+            packet.Read();
+
+            EXPECT_TRUE(packet.isPacketValid());
+            return stream.GetNumberOfBitsUsed();
+        }
+    };
+
+    TEST_F(MwmpPlayerPacketsTest, inventory_set_should_arrive_as_full_set)
+    {
+        PacketPlayerInventory packet(nullptr);
+        mServer.useRefIdTable = true;
+        mServer.inventoryChanges.action = InventoryChanges::SET;
+        mServer.inventoryChanges.items = { makeItem("iron dagger", 1), makeItem("gold_001", 50) };
+
+        transfer(packet);
+
+        EXPECT_EQ(InventoryChanges::SET, mClient.inventoryChanges.action);
+        ASSERT_EQ(2u, mClient.inventoryChanges.items.size());
+        EXPECT_EQ("iron dagger", mClient.inventoryChanges.items[0].refId);
+        EXPECT_EQ(1, mClient.inventoryChanges.items[0].count);
+        EXPECT_EQ("gold_001", mClient.inventoryChanges.items[1].refId);
+        EXPECT_EQ(50, mClient.inventoryChanges.items[1].count);
+    }
+
+    TEST_F(MwmpPlayerPacketsTest, inventory_should_only_send_refids_once_with_refid_table)
+    {
+        PacketPlayerInventory packet(nullptr);
+        mServer.useRefIdTable = true;
+        mServer.inventoryChanges.action = InventoryChanges::SET;
+        mServer.inventoryChanges.items = { makeItem("iron dagger", 1) };
+
+        const unsigned int firstSize = transfer(packet);
+        mServer.inventoryChanges.items[0].count = 2;
+        const unsigned int secondSize = transfer(packet);
+
+        EXPECT_LT(secondSize, firstSize);
+        ASSERT_EQ(1u, mClient.inventoryChanges.items.size());
+        EXPECT_EQ("iron dagger", mClient.inventoryChanges.items[0].refId);
+        EXPECT_EQ(2, mClient.inventoryChanges.items[0].count);
+    }
+
+    TEST_F(MwmpPlayerPacketsTest, inventory_should_send_plain_refids_without_refid_table)
+    {
+        PacketPlayerInventory packet(nullptr);
+        mServer.inventoryChanges.action = InventoryChanges::ADD;
+        mServer.inventoryChanges.items = { makeItem("iron dagger", 1) };
+
+        transfer(packet);
+
+        EXPECT_TRUE(mServer.sentRefIds.isEmpty());
+        EXPECT_TRUE(mClient.receivedRefIds.isEmpty());
+        EXPECT_EQ(InventoryChanges::ADD, mClient.inventoryChanges.action);
+        ASSERT_EQ(1u, mClient.inventoryChanges.items.size());
+        EXPECT_EQ("iron dagger", mClient.inventoryChanges.items[0].refId);
+    }
+
+    TEST_F(MwmpPlayerPacketsTest, spellbook_set_should_arrive_as_full_set)
+    {
+        PacketPlayerSpellbook packet(nullptr);
+        mServer.useRefIdTable = true;
+        mServer.spellbookChanges.action = SpellbookChanges::SET;
+        mServer.spellbookChanges.spells.resize(2);
+        mServer.spellbookChanges.spells[0].mId = "fireball";
+        mServer.spellbookChanges.spells[1].mId = "frostbite";
+
+        transfer(packet);
+        mServer.spellbookChanges.spells.resize(1);
+        transfer(packet);
+
+        EXPECT_EQ(SpellbookChanges::SET, mClient.spellbookChanges.action);
+        ASSERT_EQ(1u, mClient.spellbookChanges.spells.size());
+        EXPECT_EQ("fireball", mClient.spellbookChanges.spells[0].mId);
+    }
+
+    TEST_F(MwmpPlayerPacketsTest, inventory_delta_should_arrive_with_revision_and_base_checksum)
+    {
+        PacketPlayerInventory packet(nullptr);
+        mServer.useRefIdTable = true;
+        mServer.inventoryChanges.action = InventoryChanges::DELTA;
+        mServer.inventoryChanges.revision = 3;
+        mServer.inventoryChanges.baseChecksum = 0xdeadbeef;
+        mServer.inventoryChanges.items = { makeItem("iron dagger", -1), makeItem("gold_001", 50) };
+
+        transfer(packet);
+
+        EXPECT_EQ(InventoryChanges::DELTA, mClient.inventoryChanges.action);
+        EXPECT_EQ(3u, mClient.inventoryChanges.revision);
+        EXPECT_EQ(0xdeadbeefu, mClient.inventoryChanges.baseChecksum);
+        ASSERT_EQ(2u, mClient.inventoryChanges.items.size());
+        EXPECT_EQ("iron dagger", mClient.inventoryChanges.items[0].refId);
+        EXPECT_EQ(-1, mClient.inventoryChanges.items[0].count);
+        EXPECT_EQ(50, mClient.inventoryChanges.items[1].count);
+    }
+
+    TEST_F(MwmpPlayerPacketsTest, inventory_request_set_should_echo_revision)
+    {
+        PacketPlayerInventory packet(nullptr);
+        mServer.inventoryChanges.action = InventoryChanges::REQUEST_SET;
+        mServer.inventoryChanges.revision = 7;
+
+        transfer(packet);
+
+        EXPECT_EQ(InventoryChanges::REQUEST_SET, mClient.inventoryChanges.action);
+        EXPECT_EQ(7u, mClient.inventoryChanges.revision);
+        EXPECT_TRUE(mClient.inventoryChanges.items.empty());
+    }
+
+    TEST_F(MwmpPlayerPacketsTest, spellbook_delta_should_arrive_with_removed_spells)
+    {
+        PacketPlayerSpellbook packet(nullptr);
+        mServer.useRefIdTable = true;
+        mServer.spellbookChanges.action = SpellbookChanges::DELTA;
+        mServer.spellbookChanges.revision = 2;
+        mServer.spellbookChanges.baseChecksum = 42;
+        mServer.spellbookChanges.spells.resize(1);
+        mServer.spellbookChanges.spells[0].mId = "fireball";
+        mServer.spellbookChanges.removedSpells.resize(1);
+        mServer.spellbookChanges.removedSpells[0].mId = "frostbite";
+
+        transfer(packet);
+
+        EXPECT_EQ(SpellbookChanges::DELTA, mClient.spellbookChanges.action);
+        EXPECT_EQ(2u, mClient.spellbookChanges.revision);
+        EXPECT_EQ(42u, mClient.spellbookChanges.baseChecksum);
+        ASSERT_EQ(1u, mClient.spellbookChanges.spells.size());
+        EXPECT_EQ("fireball", mClient.spellbookChanges.spells[0].mId);
+        ASSERT_EQ(1u, mClient.spellbookChanges.removedSpells.size());
+        EXPECT_EQ("frostbite", mClient.spellbookChanges.removedSpells[0].mId);
+    }
+}
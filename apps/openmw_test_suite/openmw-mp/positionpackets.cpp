@@ -0,0 +1,113 @@
+#include <components/openmw-mp/Packets/Actor/PacketActorPosition.hpp>
+#include <components/openmw-mp/Packets/Player/PacketPlayerPosition.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    struct MwmpPlayerPositionPacketTest : Test
+    {
+        BasePlayer mSender;
+        BasePlayer mReceiver;
+
+        MwmpPlayerPositionPacketTest()
+            : mSender(RakNet::UNASSIGNED_RAKNET_GUID)
+            , mReceiver(RakNet::UNASSIGNED_RAKNET_GUID)
+        {
+        }
+
+        // Write the sender's position, and read it into the receiver's
+        void transfer()
+        {
+            PacketPlayerPosition packet(nullptr);
+
+            RakNet::BitStream stream;
+            packet.setPlayer(&mSender);
+            packet.Packet(&stream, true);
+
+            stream.IgnoreBytes(BasePacket::headerSize());
+            packet.setPlayer(&mReceiver);
+            packet.SetReadStream(&stream);
+            packet.Read();
+
+            EXPECT_TRUE(packet.isPacketValid());
+        }
+    };
+
+    struct MwmpActorPositionPacketTest : Test
+    {
+        BaseActorList mSender;
+        BaseActorList mReceiver;
+
+        MwmpActorPositionPacketTest()
+        {
+            mSender.cell.blank();
+        }
+
+        // Write the positions of the sender's actors, and read them into the receiver's
+        void transfer()
+        {
+            PacketActorPosition packet(nullptr);
+
+            RakNet::BitStream stream;
+            packet.setActorList(&mSender);
+            packet.Packet(&stream, true);
+
+            stream.IgnoreBytes(BasePacket::headerSize());
+            packet.setActorList(&mReceiver);
+            packet.SetReadStream(&stream);
+            packet.Read();
+
+            EXPECT_TRUE(packet.isPacketValid());
+        }
+    };
+
+    TEST_F(MwmpPlayerPositionPacketTest, timestamp_should_only_arrive_when_set)
+    {
+        mSender.hasPositionTimestamp = true;
+        mSender.positionTimestamp = 0;
+
+        transfer();
+
+        EXPECT_TRUE(mReceiver.hasPositionTimestamp);
+        EXPECT_EQ(0u, mReceiver.positionTimestamp);
+
+        mSender.hasPositionTimestamp = false;
+        mSender.positionTimestamp = 1234;
+
+        transfer();
+
+        EXPECT_FALSE(mReceiver.hasPositionTimestamp);
+        EXPECT_EQ(0u, mReceiver.positionTimestamp);
+    }
+
+    TEST_F(MwmpActorPositionPacketTest, timestamp_should_only_arrive_when_set)
+    {
+        BaseActor timestamped;
+        timestamped.refNum = 1;
+        timestamped.mpNum = 0;
+        timestamped.hasPositionTimestamp = true;
+        timestamped.positionTimestamp = 0;
+
+        BaseActor untimestamped;
+        untimestamped.refNum = 2;
+        untimestamped.mpNum = 0;
+        untimestamped.hasPositionTimestamp = false;
+        untimestamped.positionTimestamp = 1234;
+
+        mSender.baseActors = { timestamped, untimestamped };
+
+        transfer();
+
+        ASSERT_EQ(2u, mReceiver.baseActors.size());
+        EXPECT_EQ(1u, mReceiver.baseActors[0].refNum);
+        EXPECT_TRUE(mReceiver.baseActors[0].hasPositionTimestamp);
+        EXPECT_EQ(0u, mReceiver.baseActors[0].positionTimestamp);
+        EXPECT_EQ(2u, mReceiver.baseActors[1].refNum);
+        EXPECT_FALSE(mReceiver.baseActors[1].hasPositionTimestamp);
+        EXPECT_EQ(0u, mReceiver.baseActors[1].positionTimestamp);
+    }
+}
@@ -0,0 +1,49 @@
+#include <components/openmw-mp/Base/RefIdTable.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace mwmp;
+
+    TEST(MwmpRefIdTableTest, should_assign_ids_in_order_of_first_use)
+    {
+        RefIdTable table;
+        bool isNew = false;
+
+        EXPECT_TRUE(table.isEmpty());
+        EXPECT_EQ(0u, table.getId("iron dagger", isNew));
+        EXPECT_TRUE(isNew);
+        EXPECT_EQ(1u, table.getId("gold_001", isNew));
+        EXPECT_TRUE(isNew);
+        EXPECT_EQ(0u, table.getId("iron dagger", isNew));
+        EXPECT_FALSE(isNew);
+        EXPECT_EQ(2u, table.getNextId());
+        EXPECT_FALSE(table.isEmpty());
+    }
+
+    TEST(MwmpRefIdTableTest, should_only_resolve_assigned_ids)
+    {
+        RefIdTable table;
+        bool isNew = false;
+        table.getId("gold_001", isNew);
+
+        std::string refId;
+        EXPECT_TRUE(table.getRefId(0, refId));
+        EXPECT_EQ("gold_001", refId);
+        EXPECT_FALSE(table.getRefId(1, refId));
+    }
+
+    TEST(MwmpRefIdTableTest, clear_should_start_over)
+    {
+        RefIdTable table;
+        bool isNew = false;
+        table.getId("gold_001", isNew);
+        table.clear();
+
+        EXPECT_TRUE(table.isEmpty());
+        EXPECT_EQ(0u, table.getId("iron dagger", isNew));
+        EXPECT_TRUE(isNew);
+    }
+}
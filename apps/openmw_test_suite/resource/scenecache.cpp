@@ -0,0 +1,185 @@
+#include <components/resource/scenecache.hpp>
+#include <components/nifosg/matrixtransform.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <osg/Geometry>
+#include <osg/Group>
+#include <osgDB/Options>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+
+    struct ResourceSceneCacheTest : Test
+    {
+        const boost::filesystem::path mDirectory;
+        const boost::filesystem::path mData;
+        VFS::Manager mVFS;
+
+        ResourceSceneCacheTest()
+            : mDirectory(std::string(UnitTest::GetInstance()->current_test_info()->name()) + "_scenecache")
+            , mData(std::string(UnitTest::GetInstance()->current_test_info()->name()) + "_data")
+            , mVFS(false)
+        {
+            boost::filesystem::remove_all(mDirectory);
+            boost::filesystem::remove_all(mData);
+            mVFS.buildIndex();
+        }
+
+        ~ResourceSceneCacheTest()
+        {
+            boost::filesystem::remove_all(mDirectory);
+            boost::filesystem::remove_all(mData);
+        }
+
+        void writeFile(const boost::filesystem::path& path)
+        {
+            boost::filesystem::create_directories(path.parent_path());
+
+            boost::filesystem::ofstream stream;
+            stream.open(path);
+        }
+
+        void buildIndex(VFS::Manager& vfs)
+        {
+            vfs.addArchive(new VFS::FileSystemArchive(mData.string()));
+            vfs.buildIndex();
+        }
+
+        osg::ref_ptr<osg::Node> makeScene()
+        {
+            osg::ref_ptr<NifOsg::MatrixTransform> transform (new NifOsg::MatrixTransform);
+            transform->setName("Transform");
+            transform->mScale = 2.f;
+            transform->mRotationScale.mValues[1][2] = 3.f;
+            transform->setUserValue("recIndex", 7u);
+
+            osg::ref_ptr<osg::Geometry> geometry (new osg::Geometry);
+            geometry->setVertexArray(new osg::Vec3Array(3));
+            transform->addChild(geometry);
+
+            osg::ref_ptr<osg::Group> root (new osg::Group);
+            root->addChild(transform);
+            return root;
+        }
+
+        uint32_t put(Resource::SceneCache& cache, const std::string& name, const std::string& source, osg::Node& node,
+            const std::vector<std::string>& textureNames = {})
+        {
+            uint32_t checksum = 0;
+            std::istringstream stream(source);
+            EXPECT_EQ(nullptr, cache.get(name, stream, checksum));
+            cache.put(name, checksum, textureNames, node);
+            return checksum;
+        }
+
+        osg::ref_ptr<osg::Node> get(Resource::SceneCache& cache, const std::string& name, const std::string& source)
+        {
+            uint32_t checksum = 0;
+            std::istringstream stream(source);
+            return cache.get(name, stream, checksum);
+        }
+    };
+
+    TEST_F(ResourceSceneCacheTest, should_return_scene_converted_from_same_source)
+    {
+        Resource::SceneCache cache(mDirectory.string(), 1024 * 1024, &mVFS, new osgDB::Options);
+        if (!cache.isEnabled())
+            GTEST_SKIP() << "No support for .osgb files in this build";
+
+        osg::ref_ptr<osg::Node> scene = makeScene();
+        put(cache, "meshes/a.nif", "source", *scene);
+
+        osg::ref_ptr<osg::Node> cached = get(cache, "meshes/a.nif", "source");
+        ASSERT_NE(nullptr, cached);
+
+        osg::Group* root = cached->asGroup();
+        ASSERT_NE(nullptr, root);
+        ASSERT_EQ(1u, root->getNumChildren());
+
+        NifOsg::MatrixTransform* transform = dynamic_cast<NifOsg::MatrixTransform*>(root->getChild(0));
+        ASSERT_NE(nullptr, transform);
+        EXPECT_EQ("Transform", transform->getName());
+        EXPECT_EQ(2.f, transform->mScale);
+        EXPECT_EQ(3.f, transform->mRotationScale.mValues[1][2]);
+        unsigned int recIndex = 0;
+        EXPECT_TRUE(transform->getUserValue("recIndex", recIndex));
+        EXPECT_EQ(7u, recIndex);
+        EXPECT_EQ(1u, transform->getNumChildren());
+    }
+
+    TEST_F(ResourceSceneCacheTest, should_not_return_scene_converted_from_other_source)
+    {
+        Resource::SceneCache cache(mDirectory.string(), 1024 * 1024, &mVFS, new osgDB::Options);
+        if (!cache.isEnabled())
+            GTEST_SKIP() << "No support for .osgb files in this build";
+
+        osg::ref_ptr<osg::Node> scene = makeScene();
+        put(cache, "meshes/a.nif", "source", *scene);
+
+        EXPECT_EQ(nullptr, get(cache, "meshes/a.nif", "changed source"));
+        EXPECT_EQ(nullptr, get(cache, "meshes/b.nif", "source"));
+    }
+
+    TEST_F(ResourceSceneCacheTest, should_not_keep_scene_with_callbacks)
+    {
+        Resource::SceneCache cache(mDirectory.string(), 1024 * 1024, &mVFS, new osgDB::Options);
+        if (!cache.isEnabled())
+            GTEST_SKIP() << "No support for .osgb files in this build";
+
+        osg::ref_ptr<osg::Node> scene = makeScene();
+        scene->addUpdateCallback(new osg::Callback);
+        put(cache, "meshes/a.nif", "source", *scene);
+
+        EXPECT_EQ(nullptr, get(cache, "meshes/a.nif", "source"));
+    }
+
+    TEST_F(ResourceSceneCacheTest, should_remove_least_recently_used_files_beyond_size_limit)
+    {
+        {
+            Resource::SceneCache cache(mDirectory.string(), 1024 * 1024, &mVFS, new osgDB::Options);
+            if (!cache.isEnabled())
+                GTEST_SKIP() << "No support for .osgb files in this build";
+
+            osg::ref_ptr<osg::Node> scene = makeScene();
+            put(cache, "meshes/a.nif", "source", *scene);
+        }
+
+        Resource::SceneCache cache(mDirectory.string(), 1, &mVFS, new osgDB::Options);
+        EXPECT_EQ(nullptr, get(cache, "meshes/a.nif", "source"));
+    }
+
+    TEST_F(ResourceSceneCacheTest, should_not_return_scene_with_textures_resolving_to_other_files)
+    {
+        writeFile(mData / "textures" / "tx_a.tga");
+
+        VFS::Manager vfs(false);
+        buildIndex(vfs);
+
+        Resource::SceneCache cache(mDirectory.string(), 1024 * 1024, &vfs, new osgDB::Options);
+        if (!cache.isEnabled())
+            GTEST_SKIP() << "No support for .osgb files in this build";
+
+        osg::ref_ptr<osg::Node> scene = makeScene();
+        put(cache, "meshes/a.nif", "source", *scene, {"tx_a.tga"});
+        EXPECT_NE(nullptr, get(cache, "meshes/a.nif", "source"));
+
+        // A .dds file takes the place of the .tga file the name refers to
+        writeFile(mData / "textures" / "tx_a.dds");
+
+        VFS::Manager changedVfs(false);
+        buildIndex(changedVfs);
+
+        Resource::SceneCache changedCache(mDirectory.string(), 1024 * 1024, &changedVfs, new osgDB::Options);
+        EXPECT_EQ(nullptr, get(changedCache, "meshes/a.nif", "source"));
+    }
+}
@@ -0,0 +1,127 @@
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+
+    struct VFSManagerTest : Test
+    {
+        const boost::filesystem::path mRoot;
+
+        VFSManagerTest()
+            : mRoot(std::string(UnitTest::GetInstance()->current_test_info()->name()) + "_vfs")
+        {
+            boost::filesystem::remove_all(mRoot);
+        }
+
+        ~VFSManagerTest()
+        {
+            boost::filesystem::remove_all(mRoot);
+        }
+
+        void writeFile(const boost::filesystem::path& path, const std::string& content)
+        {
+            boost::filesystem::create_directories(path.parent_path());
+
+            boost::filesystem::ofstream stream;
+            stream.open(path);
+            stream << content;
+        }
+
+        std::string readFile(VFS::Manager& manager, const std::string& name)
+        {
+            Files::IStreamPtr stream = manager.get(name);
+            return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        }
+
+        // Pretend nothing in the directory has changed in a while
+        void backdate(const boost::filesystem::path& path)
+        {
+            const std::time_t past = std::time(nullptr) - 100;
+
+            boost::filesystem::last_write_time(path, past);
+
+            for (boost::filesystem::recursive_directory_iterator it(path), end; it != end; ++it)
+            {
+                if (boost::filesystem::is_directory(*it))
+                    boost::filesystem::last_write_time(it->path(), past);
+            }
+        }
+    };
+
+    TEST_F(VFSManagerTest, later_archives_should_have_priority)
+    {
+        writeFile(mRoot / "first" / "Meshes" / "A.nif", "first a");
+        writeFile(mRoot / "first" / "meshes" / "b.nif", "first b");
+        writeFile(mRoot / "second" / "MESHES" / "a.NIF", "second a");
+
+        VFS::Manager manager(false);
+        manager.addArchive(new VFS::FileSystemArchive((mRoot / "first").string()));
+        manager.addArchive(new VFS::FileSystemArchive((mRoot / "second").string()));
+        manager.buildIndex();
+
+        EXPECT_EQ(2u, manager.getIndex().size());
+        EXPECT_TRUE(manager.exists("meshes\\a.nif"));
+        EXPECT_TRUE(manager.exists("Meshes/B.nif"));
+        EXPECT_FALSE(manager.exists("meshes/c.nif"));
+        EXPECT_EQ("second a", readFile(manager, "meshes/a.nif"));
+        EXPECT_EQ("first b", readFile(manager, "MESHES\\B.NIF"));
+        EXPECT_THROW(manager.getNormalized("meshes/c.nif"), std::runtime_error);
+    }
+
+    TEST_F(VFSManagerTest, index_cache_should_be_used_while_directories_are_unchanged)
+    {
+        const std::string cachePath = (mRoot / "vfs.cache").string();
+        writeFile(mRoot / "data" / "textures" / "a.dds", "a");
+        writeFile(mRoot / "data" / "textures" / "b.dds", "b");
+        backdate(mRoot / "data");
+
+        {
+            VFS::Manager manager(false);
+            manager.setIndexCache(cachePath);
+            manager.addArchive(new VFS::FileSystemArchive((mRoot / "data").string()));
+            manager.buildIndex();
+
+            EXPECT_EQ(2u, manager.getIndex().size());
+        }
+
+        ASSERT_TRUE(boost::filesystem::exists(cachePath));
+
+        // A listing taken from the cache still has the file whose removal the directory doesn't show
+        const std::time_t time = boost::filesystem::last_write_time(mRoot / "data" / "textures");
+        boost::filesystem::remove(mRoot / "data" / "textures" / "b.dds");
+        boost::filesystem::last_write_time(mRoot / "data" / "textures", time);
+
+        {
+            VFS::Manager manager(false);
+            manager.setIndexCache(cachePath);
+            manager.addArchive(new VFS::FileSystemArchive((mRoot / "data").string()));
+            manager.buildIndex();
+
+            EXPECT_TRUE(manager.exists("textures/b.dds"));
+        }
+
+        // Adding a file changes the directory, so it gets listed again
+        writeFile(mRoot / "data" / "textures" / "c.dds", "c");
+
+        {
+            VFS::Manager manager(false);
+            manager.setIndexCache(cachePath);
+            manager.addArchive(new VFS::FileSystemArchive((mRoot / "data").string()));
+            manager.buildIndex();
+
+            EXPECT_EQ(2u, manager.getIndex().size());
+            EXPECT_FALSE(manager.exists("textures/b.dds"));
+            EXPECT_EQ("c", readFile(manager, "textures/c.dds"));
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#include "blobcache.hpp"
+
+namespace Bsa
+{
+    BlobCache::BlobCache(std::size_t capacity)
+        : mCapacity(capacity)
+        , mSize(0)
+    {
+    }
+
+    BlobCache::Blob BlobCache::get(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto found = mIndex.find(key);
+        if (found == mIndex.end())
+            return nullptr;
+
+        mEntries.splice(mEntries.begin(), mEntries, found->second);
+        return found->second->second;
+    }
+
+    void BlobCache::insert(const std::string& key, const Blob& blob)
+    {
+        if (blob == nullptr || blob->size() > mCapacity)
+            return;
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        auto found = mIndex.find(key);
+        if (found != mIndex.end())
+        {
+            mSize -= found->second->second->size();
+            mEntries.erase(found->second);
+            mIndex.erase(found);
+        }
+
+        while (!mEntries.empty() && mSize + blob->size() > mCapacity)
+        {
+            mSize -= mEntries.back().second->size();
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+        }
+
+        mEntries.emplace_front(key, blob);
+        mIndex[key] = mEntries.begin();
+        mSize += blob->size();
+    }
+
+    bool BlobCache::contains(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mIndex.find(key) != mIndex.end();
+    }
+
+    std::size_t BlobCache::getSize() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        return mSize;
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef BSA_BLOB_CACHE_H
+#define BSA_BLOB_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Bsa
+{
+    /// @brief A bounded cache of decompressed files, which drops the least recently used ones first.
+    /// @note May be shared between archives and used from any thread.
+    class BlobCache
+    {
+    public:
+        typedef std::shared_ptr<const std::vector<char>> Blob;
+
+        /// @param capacity The number of bytes the cached files may take up together.
+        explicit BlobCache(std::size_t capacity);
+
+        /// Get the file cached under \a key, or nullptr if it isn't cached.
+        Blob get(const std::string& key);
+
+        /// Cache \a blob under \a key, dropping the least recently used files to make room for it.
+        /// Files bigger than the whole cache aren't kept.
+        void insert(const std::string& key, const Blob& blob);
+
+        bool contains(const std::string& key) const;
+
+        std::size_t getCapacity() const { return mCapacity; }
+
+        std::size_t getSize() const;
+
+    private:
+        typedef std::list<std::pair<std::string, Blob>> Entries;
+
+        const std::size_t mCapacity;
+        std::size_t mSize;
+
+        // Most recently used first
+        Entries mEntries;
+        std::unordered_map<std::string, Entries::iterator> mIndex;
+
+        mutable std::mutex mMutex;
+    };
+}
+
+#endif
@@ -29,8 +29,47 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/memorystream.hpp>
+/*
+    End of tes3mp addition
+*/
+
 using namespace Bsa;
 
+/*
+    Start of tes3mp addition
+
+    Read files straight from an archive mapped into memory
+*/
+namespace
+{
+    typedef std::shared_ptr<const boost::iostreams::mapped_file_source> Mapping;
+
+    /// A stream over part of a mapped archive, which keeps the mapping alive for as long as it is read
+    struct MappedFileStream : Files::IMemStream
+    {
+        MappedFileStream(const Mapping& mapping, size_t offset, size_t size)
+            : Files::MemBuf(mapping->data() + offset, size)
+            , Files::IMemStream(mapping->data() + offset, size)
+            , mMapping(mapping)
+        {
+        }
+
+        Mapping mMapping;
+    };
+}
+/*
+    End of tes3mp addition
+*/
+
 
 /// Error handling
 void BSAFile::fail(const std::string &msg)
@@ -249,7 +288,29 @@ void BSAFile::open(const std::string &file)
 {
     mFilename = file;
     if(boost::filesystem::exists(file))
+    {
         readHeader();
+
+        /*
+            Start of tes3mp addition
+
+            Map the archive into memory once its header has been read
+        */
+        if (mMemoryMapped && boost::filesystem::file_size(file) > 0)
+        {
+            try
+            {
+                mMapping = std::make_shared<const boost::iostreams::mapped_file_source>(file);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to map BSA archive " << file << " into memory: " << e.what();
+            }
+        }
+        /*
+            End of tes3mp addition
+        */
+    }
     else
     {
         { boost::filesystem::fstream(mFilename, std::ios::binary | std::ios::out); }
@@ -275,18 +336,65 @@ Files::IStreamPtr BSAFile::getFile(const char *file)
 
     const FileStruct &fs = mFiles[i];
 
-    return Files::openConstrainedFileStream (mFilename.c_str (), fs.offset, fs.fileSize);
+    /*
+        Start of tes3mp change (minor)
+
+        Read the file from the mapping if the archive is mapped
+    */
+    return openRegion(fs.offset, fs.fileSize);
+    /*
+        End of tes3mp change (minor)
+    */
 }
 
 Files::IStreamPtr BSAFile::getFile(const FileStruct *file)
 {
-    return Files::openConstrainedFileStream (mFilename.c_str (), file->offset, file->fileSize);
+    /*
+        Start of tes3mp change (minor)
+
+        Read the file from the mapping if the archive is mapped
+    */
+    return openRegion(file->offset, file->fileSize);
+    /*
+        End of tes3mp change (minor)
+    */
 }
 
+/*
+    Start of tes3mp addition
+
+    Read files straight from the mapping if the archive is mapped
+*/
+Files::IStreamPtr BSAFile::openRegion(size_t offset, size_t size) const
+{
+    Mapping mapping = mMapping;
+
+    if (mapping == nullptr)
+        return Files::openConstrainedFileStream (mFilename.c_str (), offset, size);
+
+    if (offset > mapping->size() || size > mapping->size() - offset)
+        throw std::runtime_error("BSA Error: File data lies outside of the archive\nArchive: " + mFilename);
+
+    return std::make_shared<MappedFileStream>(mapping, offset, size);
+}
+/*
+    End of tes3mp addition
+*/
+
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
 {
     namespace bfs = boost::filesystem;
 
+    /*
+        Start of tes3mp addition
+
+        Read files from the archive itself from now on, as adding a file moves others around in it
+    */
+    mMapping.reset();
+    /*
+        End of tes3mp addition
+    */
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         bfs::resize_file(mFilename, newStartOfDataBuffer);
@@ -33,6 +33,21 @@
 
 #include <components/files/constrainedfilestream.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Declare the file mapping an archive can be read through
+*/
+namespace boost
+{
+    namespace iostreams
+    {
+        class mapped_file_source;
+    }
+}
+/*
+    End of tes3mp addition
+*/
 
 namespace Bsa
 {
@@ -116,6 +131,23 @@ protected:
     /// @note Thread safe.
     int getIndex(const char *str) const;
 
+    /*
+        Start of tes3mp addition
+
+        Allow the whole archive to be mapped into memory, so files can be read from the mapping
+        instead of opening the archive again for each of them
+    */
+    bool mMemoryMapped = false;
+    std::shared_ptr<const boost::iostreams::mapped_file_source> mMapping;
+
+    /// Open a stream over \a size bytes at \a offset in the archive, straight from the mapping if the
+    /// archive is mapped.
+    /// @note Thread safe.
+    Files::IStreamPtr openRegion(size_t offset, size_t size) const;
+    /*
+        End of tes3mp addition
+    */
+
 public:
     /* -----------------------------------
      * BSA management methods
@@ -134,6 +166,23 @@ public:
     /// Open an archive file.
     void open(const std::string &file);
 
+    /*
+        Start of tes3mp addition
+
+        Allow the whole archive to be mapped into memory
+    */
+    /// Map the archive into memory when it is opened, and return streams over the mapping from getFile(),
+    /// without opening the archive or copying anything for each file. Falls back to reading the archive
+    /// as a file if it can't be mapped. Has to be called before open().
+    void setMemoryMapped(bool memoryMapped)
+    { mMemoryMapped = memoryMapped; }
+
+    bool isMemoryMapped() const
+    { return mMapping != nullptr; }
+    /*
+        End of tes3mp addition
+    */
+
     void close();
 
     /* -----------------------------------
@@ -158,6 +207,20 @@ public:
 
     virtual void addFile(const std::string& filename, std::istream& file);
 
+    /*
+        Start of tes3mp addition
+
+        Allow files to be made ready ahead of being opened
+    */
+    /** Do whatever work opening a file takes in advance, so getFile() can return it quicker later on.
+     * Archives that don't have anything to do in advance ignore this.
+     * @note Thread safe.
+    */
+    virtual void prefetch(const FileStruct* file) {}
+    /*
+        End of tes3mp addition
+    */
+
     /// Get a list of all files
     /// @note Thread safe.
     const FileList &getList() const
@@ -48,8 +48,42 @@
 #include <boost/iostreams/device/array.hpp>
 #include <components/bsa/memorystream.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/files/memorystream.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace Bsa
 {
+/*
+    Start of tes3mp addition
+
+    Read decompressed files straight out of the blobs they were decompressed into, which the
+    streams keep alive for as long as they are read from
+*/
+namespace
+{
+    struct BlobStream : Files::IMemStream
+    {
+        explicit BlobStream(const BlobCache::Blob& blob)
+            : Files::MemBuf(blob->data(), blob->size())
+            , Files::IMemStream(blob->data(), blob->size())
+            , mBlob(blob)
+        {
+        }
+
+        BlobCache::Blob mBlob;
+    };
+}
+/*
+    End of tes3mp addition
+*/
+
 //special marker for invalid records,
 //equal to max uint32_t value
 const uint32_t CompressedBSAFile::sInvalidOffset = std::numeric_limits<uint32_t>::max();
@@ -350,12 +384,69 @@ Files::IStreamPtr CompressedBSAFile::getFile(const char* file)
     return getFile(fileRec);
 }
 
+/*
+    Start of tes3mp change (major)
+
+    Take compressed files from the blob cache if there is one, decompressing and caching them
+    the first time they are requested, and serve uncompressed files from the mapping if the
+    archive is mapped
+*/
 Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
+{
+    BlobCache::Blob blob;
+
+    // Uncompressed files can be streamed straight out of the mapping without copying them
+    if (isMemoryMapped() && !fileRecord.isCompressed(mCompressedByDefault))
+    {
+        size_t offset = fileRecord.offset;
+        size_t size = fileRecord.getSizeWithoutCompressionFlag();
+
+        if (mEmbeddedFileNames)
+        {
+            // Skip over the embedded file name
+            char length = 0;
+            openRegion(offset, size)->read(&length, 1);
+            const size_t nameSize = static_cast<unsigned char>(length) + sizeof(char);
+            if (nameSize > size)
+                fail("Embedded file name lies outside of the file");
+            offset += nameSize;
+            size -= nameSize;
+        }
+
+        return openRegion(offset, size);
+    }
+
+    if (mBlobCache && fileRecord.isCompressed(mCompressedByDefault))
+    {
+        const std::string key = getBlobKey(fileRecord);
+        blob = mBlobCache->get(key);
+
+        if (blob == nullptr)
+        {
+            blob = readBlob(fileRecord);
+            mBlobCache->insert(key, blob);
+        }
+    }
+    else
+        blob = readBlob(fileRecord);
+
+    return std::make_shared<BlobStream>(blob);
+}
+
+BlobCache::Blob CompressedBSAFile::readBlob(const FileRecord& fileRecord)
 {
     size_t size = fileRecord.getSizeWithoutCompressionFlag();
     size_t uncompressedSize = size;
     bool compressed = fileRecord.isCompressed(mCompressedByDefault);
-    Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilename.c_str(), fileRecord.offset, size);
+    /*
+        Start of tes3mp change (minor)
+
+        Read the file from the mapping if the archive is mapped
+    */
+    Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, size);
+    /*
+        End of tes3mp change (minor)
+    */
     std::istream* fileStream = streamPtr.get();
     if (mEmbeddedFileNames)
     {
@@ -370,7 +461,7 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
         fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
         size -= sizeof(uint32_t);
     }
-    std::shared_ptr<Bsa::MemoryInputStream> memoryStreamPtr = std::make_shared<MemoryInputStream>(uncompressedSize);
+    std::shared_ptr<std::vector<char>> blob = std::make_shared<std::vector<char>>(uncompressedSize);
 
     if (compressed)
     {
@@ -380,7 +471,7 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
             inputStreamBuf.push(boost::iostreams::zlib_decompressor());
             inputStreamBuf.push(*fileStream);
 
-            boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
+            boost::iostreams::basic_array_sink<char> sr(blob->data(), uncompressedSize);
             boost::iostreams::copy(inputStreamBuf, sr);
         }
         else // SSE: lz4
@@ -390,7 +481,7 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
             LZ4F_decompressionContext_t context = nullptr;
             LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
             LZ4F_decompressOptions_t options = {};
-            LZ4F_errorCode_t errorCode = LZ4F_decompress(context, memoryStreamPtr->getRawData(), &uncompressedSize, buffer.get(), &size, &options);
+            LZ4F_errorCode_t errorCode = LZ4F_decompress(context, blob->data(), &uncompressedSize, buffer.get(), &size, &options);
             if (LZ4F_isError(errorCode))
                 fail("LZ4 decompression error (file " + mFilename + "): " + LZ4F_getErrorName(errorCode));
             errorCode = LZ4F_freeDecompressionContext(context);
@@ -400,12 +491,35 @@ Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     }
     else
     {
-        fileStream->read(memoryStreamPtr->getRawData(), size);
+        fileStream->read(blob->data(), size);
     }
 
-    return std::shared_ptr<std::istream>(memoryStreamPtr, (std::istream*)memoryStreamPtr.get());
+    return blob;
+}
+
+
+std::string CompressedBSAFile::getBlobKey(const FileRecord& fileRecord) const
+{
+    return mFilename + '|' + std::to_string(fileRecord.offset);
 }
 
+void CompressedBSAFile::prefetch(const FileStruct* file)
+{
+    if (!mBlobCache)
+        return;
+
+    FileRecord fileRecord = getFileRecord(file->name());
+    if (!fileRecord.isValid() || !fileRecord.isCompressed(mCompressedByDefault))
+        return;
+
+    const std::string key = getBlobKey(fileRecord);
+    if (!mBlobCache->contains(key))
+        mBlobCache->insert(key, readBlob(fileRecord));
+}
+/*
+    End of tes3mp change (major)
+*/
+
 BsaVersion CompressedBSAFile::detectVersion(std::string filePath)
 {
     namespace bfs = boost::filesystem;
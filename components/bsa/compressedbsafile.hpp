@@ -28,6 +28,16 @@
 
 #include <components/bsa/bsa_file.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/bsa/blobcache.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace Bsa
 {
     enum BsaVersion
@@ -82,6 +92,19 @@ namespace Bsa
         /// \brief Normalizes given filename or folder and generates format-compatible hash. See https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
         static std::uint64_t generateHash(std::string stem, std::string extension) ;
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+
+        /*
+            Start of tes3mp addition
+
+            Allow decompressed files to be kept in a cache shared between archives and threads
+        */
+        std::shared_ptr<BlobCache> mBlobCache;
+
+        BlobCache::Blob readBlob(const FileRecord& fileRecord);
+        std::string getBlobKey(const FileRecord& fileRecord) const;
+        /*
+            End of tes3mp addition
+        */
     public:
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
@@ -95,6 +118,23 @@ namespace Bsa
         Files::IStreamPtr getFile(const char* filePath) override;
         Files::IStreamPtr getFile(const FileStruct* fileStruct) override;
         void addFile(const std::string& filename, std::istream& file) override;
+
+        /*
+            Start of tes3mp addition
+
+            Allow decompressed files to be kept in a cache shared between archives and threads,
+            and to be decompressed ahead of being opened
+        */
+        /// Keep the files decompressed by getFile() in \a cache, and take them from there when they are
+        /// requested again. Has to be set before any files are read from the archive.
+        void setBlobCache(std::shared_ptr<BlobCache> cache)
+        { mBlobCache = std::move(cache); }
+
+        /// Decompress \a file into the blob cache, if there is one and the file isn't in it already.
+        void prefetch(const FileStruct* file) override;
+        /*
+            End of tes3mp addition
+        */
     };
 }
 
@@ -9,8 +9,6 @@
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 
-#include "../mwmechanics/spelllist.hpp"
-
 namespace
 {
     void readRefs(const ESM::Cell& cell, std::map<ESM::RefNum, std::string>& refs, std::vector<ESM::ESMReader>& readers)
@@ -124,6 +122,118 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
 
     ESM::Dialogue *dialogue = nullptr;
 
+    /*
+        Start of tes3mp change (minor)
+
+        Share the parts of loading a content file that don't depend on how its records are read
+    */
+    prepareLoad(esm);
+
+    // Loop through all records
+    while(esm.hasMoreRecs())
+    {
+        loadRecord(esm, dialogue);
+        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+    }
+    /*
+        End of tes3mp change (minor)
+    */
+}
+
+/*
+    Start of tes3mp addition
+
+    Allow content files to be read in parallel and then added to the store in load order
+*/
+void ESMStore::decode(ESM::ESMReader &esm, DecodedContent &content) const
+{
+    while(esm.hasMoreRecs())
+    {
+        ESM::ESM_Context context = esm.getContext();
+
+        ESM::NAME n = esm.getRecName();
+        esm.getRecHeader();
+
+        std::unique_ptr<StoreBase::DecodedRecord> record;
+        std::map<int, StoreBase *>::const_iterator it = mStores.find(n.intval);
+
+        if (it != mStores.end())
+            record = it->second->decode(esm);
+
+        if (record)
+        {
+            DecodedContent::Entry entry;
+            entry.mStore = it->second;
+            entry.mRecord = std::move(record);
+            entry.mCount = 0;
+            content.mEntries.push_back(std::move(entry));
+        }
+        else
+        {
+            // Leave the record to load(), together with any that directly follow it
+            esm.skipRecord();
+
+            if (!content.mEntries.empty() && !content.mEntries.back().mRecord)
+                content.mEntries.back().mCount++;
+            else
+            {
+                DecodedContent::Entry entry;
+                entry.mStore = nullptr;
+                entry.mContext = context;
+                entry.mCount = 1;
+                content.mEntries.push_back(std::move(entry));
+            }
+        }
+    }
+
+    content.mEndContext = esm.getContext();
+}
+
+void ESMStore::load(ESM::ESMReader &esm, DecodedContent &content, Loading::Listener* listener)
+{
+    listener->setProgressRange(1000);
+
+    ESM::Dialogue *dialogue = nullptr;
+
+    prepareLoad(esm);
+
+    // The contexts were saved by decode() before the parent files were looked up, and cells keep
+    // the contexts they are read with to adjust the refNums of their references later on
+    const std::vector<int> parentFileIndices = esm.getParentFileIndices();
+
+    for (size_t i = 0; i < content.mEntries.size(); ++i)
+    {
+        DecodedContent::Entry &entry = content.mEntries[i];
+
+        if (entry.mRecord)
+        {
+            RecordId id = entry.mStore->insertDecoded(*entry.mRecord);
+            entry.mRecord.reset();
+
+            if (id.mIsDeleted)
+                entry.mStore->eraseStatic(id.mId);
+            else
+                dialogue = nullptr;
+        }
+        else
+        {
+            entry.mContext.parentFileIndices = parentFileIndices;
+            esm.restoreContext(entry.mContext);
+
+            for (int j = 0; j < entry.mCount; ++j)
+                loadRecord(esm, dialogue);
+        }
+
+        listener->setProgress(i * 1000 / content.mEntries.size());
+    }
+
+    // Leave the reader where loading it record by record would have
+    content.mEndContext.parentFileIndices = parentFileIndices;
+    esm.restoreContext(content.mEndContext);
+}
+
+void ESMStore::prepareLoad(ESM::ESMReader &esm)
+{
     // Land texture loading needs to use a separate internal store for each plugin.
     // We set the number of plugins here to avoid continual resizes during loading,
     // and so we can properly verify if valid plugin indices are being passed to the
@@ -157,59 +267,134 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         }
         esm.addParentFileIndex(index);
     }
+}
 
-    // Loop through all records
-    while(esm.hasMoreRecs())
-    {
-        ESM::NAME n = esm.getRecName();
-        esm.getRecHeader();
+void ESMStore::loadRecord(ESM::ESMReader &esm, ESM::Dialogue *&dialogue)
+{
+    ESM::NAME n = esm.getRecName();
+    esm.getRecHeader();
 
-        // Look up the record type.
-        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+    // Look up the record type.
+    std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
 
-        if (it == mStores.end()) {
-            if (n.intval == ESM::REC_INFO) {
-                if (dialogue)
-                {
-                    dialogue->readInfo(esm, esm.getIndex() != 0);
-                }
-                else
-                {
-                    Log(Debug::Error) << "Error: info record without dialog";
-                    esm.skipRecord();
-                }
-            } else if (n.intval == ESM::REC_MGEF) {
-                mMagicEffects.load (esm);
-            } else if (n.intval == ESM::REC_SKIL) {
-                mSkills.load (esm);
+    if (it == mStores.end()) {
+        if (n.intval == ESM::REC_INFO) {
+            if (dialogue)
+            {
+                dialogue->readInfo(esm, esm.getIndex() != 0);
             }
-            else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+            else
             {
-                // ignore project file only records
+                Log(Debug::Error) << "Error: info record without dialog";
                 esm.skipRecord();
             }
-            else {
-                std::stringstream error;
-                error << "Unknown record: " << n.toString();
-                throw std::runtime_error(error.str());
-            }
+        } else if (n.intval == ESM::REC_MGEF) {
+            mMagicEffects.load (esm);
+        } else if (n.intval == ESM::REC_SKIL) {
+            mSkills.load (esm);
+        }
+        else if (n.intval==ESM::REC_FILT || n.intval == ESM::REC_DBGP)
+        {
+            // ignore project file only records
+            esm.skipRecord();
+        }
+        else {
+            std::stringstream error;
+            error << "Unknown record: " << n.toString();
+            throw std::runtime_error(error.str());
+        }
+    } else {
+        RecordId id = it->second->load(esm);
+        if (id.mIsDeleted)
+        {
+            it->second->eraseStatic(id.mId);
+            return;
+        }
+
+        if (n.intval==ESM::REC_DIAL) {
+            dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
         } else {
-            RecordId id = it->second->load(esm);
-            if (id.mIsDeleted)
-            {
-                it->second->eraseStatic(id.mId);
-                continue;
-            }
+            dialogue = nullptr;
+        }
+    }
+}
+/*
+    End of tes3mp addition
+*/
+
+/*
+    Start of tes3mp addition
+
+    Allow the records loaded from the content files to be written to a cache and read back
+    from it in later sessions
+*/
+void ESMStore::writeCache(ESM::ESMWriter &writer) const
+{
+    for (std::map<int, StoreBase *>::const_iterator it = mStores.begin(); it != mStores.end(); ++it)
+        it->second->writeCache(writer);
 
-            if (n.intval==ESM::REC_DIAL) {
+    mMagicEffects.writeCache(writer);
+    mSkills.writeCache(writer);
+
+    // Keep the reference counts as well, as counting them means reading every cell
+    writer.startRecord("RCNT");
+    for (const auto& refCount : mRefCount)
+    {
+        writer.writeHNString("NAME", refCount.first);
+        writer.writeHNT("INTV", refCount.second);
+    }
+    writer.endRecord("RCNT");
+}
+
+void ESMStore::readCache(ESM::ESMReader &reader, std::vector<ESM::ESMReader> &contentReaders)
+{
+    std::vector<std::string> contentFiles;
+
+    for (ESM::ESMReader &esm : contentReaders)
+    {
+        prepareLoad(esm);
+        contentFiles.push_back(esm.getName());
+    }
+
+    ESM::Dialogue *dialogue = nullptr;
+
+    while (reader.hasMoreRecs())
+    {
+        ESM::NAME n = reader.getRecName();
+        reader.getRecHeader();
+
+        std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
+
+        if (it != mStores.end())
+        {
+            RecordId id = it->second->readCache(reader, contentFiles);
+
+            if (n.intval == ESM::REC_DIAL)
                 dialogue = const_cast<ESM::Dialogue*>(mDialogs.find(id.mId));
-            } else {
+            else
                 dialogue = nullptr;
+        }
+        else if (n.intval == ESM::REC_INFO && dialogue)
+            dialogue->readInfo(reader, false);
+        else if (n.intval == ESM::REC_MGEF)
+            mMagicEffects.load(reader);
+        else if (n.intval == ESM::REC_SKIL)
+            mSkills.load(reader);
+        else if (n == "RCNT")
+        {
+            while (reader.hasMoreSubs())
+            {
+                std::string id = reader.getHNString("NAME");
+                reader.getHNT(mRefCount[id], "INTV");
             }
         }
-        listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+        else
+            reader.fail("Unexpected record in cache: " + n.toString());
     }
 }
+/*
+    End of tes3mp addition
+*/
 
 void ESMStore::setUp(bool validateRecords)
 {
@@ -432,24 +617,4 @@ void ESMStore::validateDynamic()
             !mClasses.find (player->mClass))
             throw std::runtime_error ("Invalid player record (race or class unavailable");
     }
-
-    std::pair<std::shared_ptr<MWMechanics::SpellList>, bool> ESMStore::getSpellList(const std::string& originalId) const
-    {
-        const std::string id = Misc::StringUtils::lowerCase(originalId);
-        auto result = mSpellListCache.find(id);
-        std::shared_ptr<MWMechanics::SpellList> ptr;
-        if (result != mSpellListCache.end())
-            ptr = result->second.lock();
-        if (!ptr)
-        {
-            int type = find(id);
-            ptr = std::make_shared<MWMechanics::SpellList>(id, type);
-            if (result != mSpellListCache.end())
-                result->second = ptr;
-            else
-                mSpellListCache.insert({id, ptr});
-            return {ptr, false};
-        }
-        return {ptr, true};
-    }
 } // end namespace
@@ -0,0 +1,186 @@
+#include "esmstorecache.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/files/binarycache.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include "esmstore.hpp"
+
+namespace
+{
+    const char sMagic[] = "OMWESMSTORECACHE";
+
+    // Increase when the layout of cache files, or of anything a store writes into them, changes
+    const uint32_t sFormatVersion = 2;
+
+    typedef boost::iostreams::stream<boost::iostreams::array_source> MemoryStream;
+
+    using Files::readValue;
+    using Files::writeValue;
+
+    uint32_t checksum (const char *data, std::size_t size)
+    {
+        boost::crc_32_type crc;
+        crc.process_bytes (data, size);
+        return crc.checksum();
+    }
+
+    uint32_t fileChecksum (const boost::filesystem::path& path)
+    {
+        boost::crc_32_type crc;
+        boost::filesystem::ifstream stream (path, std::ios_base::binary);
+        char buffer[4096];
+
+        while (stream.read (buffer, sizeof (buffer)) || stream.gcount() > 0)
+            crc.process_bytes (buffer, static_cast<std::size_t> (stream.gcount()));
+
+        return crc.checksum();
+    }
+}
+
+namespace MWWorld
+{
+    ESMStoreCache::ESMStoreCache (const std::string& path, const std::vector<std::string>& contentFiles,
+        ToUTF8::Utf8Encoder* encoder, const std::vector<unsigned int>& knownChecksums)
+    : mPath (path), mPayloadOffset (0), mPayloadSize (0)
+    {
+        std::ostringstream key;
+
+        // The text of the records has been converted from the legacy encoding, so the cache only
+        // fits the encoding it was written with
+        std::string legacyText;
+        for (int c = 0x80; c < 0x100; ++c)
+            legacyText += static_cast<char> (c);
+
+        writeValue (key, encoder ? encoder->getUtf8 (legacyText) : legacyText);
+        writeValue (key, static_cast<uint32_t> (contentFiles.size()));
+
+        for (std::size_t i = 0; i < contentFiles.size(); ++i)
+        {
+            boost::filesystem::path file (contentFiles[i]);
+
+            writeValue (key, file.filename().string());
+            writeValue (key, static_cast<uint64_t> (boost::filesystem::file_size (file)));
+            writeValue (key, static_cast<int64_t> (boost::filesystem::last_write_time (file)));
+            writeValue (key, static_cast<uint32_t> (i < knownChecksums.size() ?
+                knownChecksums[i] : fileChecksum (file)));
+        }
+
+        mKey = key.str();
+    }
+
+    bool ESMStoreCache::open()
+    {
+        if (!boost::filesystem::exists (mPath))
+            return false;
+
+        try
+        {
+            mFile.open (mPath);
+
+            MemoryStream stream (mFile.data(), mFile.size());
+
+            std::string key;
+            uint64_t payloadSize = 0;
+            uint32_t payloadChecksum = 0;
+
+            bool good = Files::readCacheHeader (stream, sMagic, sFormatVersion) &&
+                readValue (stream, key) && key == mKey &&
+                readValue (stream, payloadSize) && readValue (stream, payloadChecksum);
+
+            if (good)
+            {
+                mPayloadOffset = static_cast<std::size_t> (stream.tellg());
+                mPayloadSize = mFile.size() - mPayloadOffset;
+
+                // Make sure nothing has been cut off or changed since the file was written, before
+                // anything of it gets into the store
+                good = payloadSize == mPayloadSize &&
+                    checksum (mFile.data() + mPayloadOffset, mPayloadSize) == payloadChecksum;
+            }
+
+            if (!good)
+            {
+                Log(Debug::Info) << "Ignoring outdated or damaged store cache " << mPath;
+                mFile.close();
+                return false;
+            }
+
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to open store cache " << mPath << ": " << e.what();
+
+            if (mFile.is_open())
+                mFile.close();
+
+            return false;
+        }
+    }
+
+    void ESMStoreCache::read (ESMStore& store, std::vector<ESM::ESMReader>& contentReaders)
+    {
+        if (!mFile.is_open())
+            throw std::runtime_error ("Store cache " + mPath + " has not been opened");
+
+        // Read the records straight out of the mapped file
+        ESM::ESMReader reader;
+        reader.open (Files::IStreamPtr (new MemoryStream (mFile.data() + mPayloadOffset, mPayloadSize)), mPath);
+
+        store.readCache (reader, contentReaders);
+
+        reader.close();
+        mFile.close();
+
+        Log(Debug::Info) << "Loaded the records of " << contentReaders.size() << " content files from " << mPath;
+    }
+
+    bool ESMStoreCache::write (const ESMStore& store)
+    {
+        if (mFile.is_open())
+            mFile.close();
+
+        try
+        {
+            std::stringstream payload (std::ios::in | std::ios::out | std::ios::binary);
+
+            ESM::ESMWriter writer;
+            writer.setFormat (0);
+            writer.setVersion (ESM::VER_13);
+            writer.save (payload);
+            store.writeCache (writer);
+            writer.close();
+
+            const std::string data = payload.str();
+
+            Files::writeFileAtomically (mPath, [&] (std::ostream& stream)
+            {
+                Files::writeCacheHeader (stream, sMagic, sFormatVersion);
+                writeValue (stream, mKey);
+                writeValue (stream, static_cast<uint64_t> (data.size()));
+                writeValue (stream, checksum (data.data(), data.size()));
+                stream.write (data.data(), data.size());
+            });
+
+            Log(Debug::Info) << "Saved store cache " << mPath;
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save store cache " << mPath << ": " << e.what();
+            return false;
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef OPENMW_COMPONENTS_ESMSTORE_ESMSTORECACHE_H
+#define OPENMW_COMPONENTS_ESMSTORE_ESMSTORECACHE_H
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace ESM
+{
+    class ESMReader;
+}
+
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+
+namespace MWWorld
+{
+    class ESMStore;
+
+    /// \brief The records of an ESMStore, as loaded from a list of content files, kept on disk
+    /// between sessions
+    ///
+    /// A cache file belongs to one ordered list of content files, identified by their names,
+    /// sizes, modification times and checksums, and to the encoding their text was read with.
+    /// The cache only holds what loading the content files keeps in memory, so cell references
+    /// and land data are still read from the content files when they are needed.
+    class ESMStoreCache
+    {
+            std::string mPath;
+            std::string mKey;
+            boost::iostreams::mapped_file_source mFile;
+            std::size_t mPayloadOffset;
+            std::size_t mPayloadSize;
+
+        public:
+
+            ESMStoreCache (const std::string& path, const std::vector<std::string>& contentFiles,
+                ToUTF8::Utf8Encoder* encoder, const std::vector<unsigned int>& knownChecksums = {});
+            ///< \a contentFiles are the paths of the content files, in load order. Checksums
+            /// already known for the first of them can be passed in \a knownChecksums.
+
+            bool open();
+            ///< Map the cache file into memory, if it exists and was written for the same content
+            /// files and encoding, and is undamaged.
+
+            void read (ESMStore& store, std::vector<ESM::ESMReader>& contentReaders);
+            ///< Read the store from the cache file opened by open(). \a contentReaders have to be
+            /// opened for the content files, but not loaded.
+
+            bool write (const ESMStore& store);
+            ///< Replace the cache file with the records of \a store, which has to have been loaded
+            /// from the content files and set up.
+            /// \return Success?
+    };
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef OPENMW_COMPONENTS_ESMSTORE_IDINDEX_H
+#define OPENMW_COMPONENTS_ESMSTORE_IDINDEX_H
+
+#include <string>
+
+#include <stdint.h>
+
+#include <components/misc/stringindex.hpp>
+#include <components/misc/stringops.hpp>
+
+namespace MWWorld
+{
+    /// Case-insensitive hash of a record id, the same for an id and its lowercase form
+    inline std::size_t hashId (const std::string& id)
+    {
+        // 64-bit FNV-1a over the lowercase characters
+        uint64_t result = 14695981039346656037ULL;
+
+        for (char c : id)
+        {
+            result ^= static_cast<unsigned char> (Misc::StringUtils::toLower (c));
+            result *= 1099511628211ULL;
+        }
+
+        return static_cast<std::size_t> (result);
+    }
+
+    /// \brief A record id that has been lowercased and hashed once, so looking it up in a store
+    /// again and again doesn't have to
+    class RecordKey
+    {
+            std::string mId;
+            std::size_t mHash;
+
+        public:
+
+            RecordKey() : mHash (hashId (std::string())) {}
+
+            explicit RecordKey (const std::string& id)
+            : mId (Misc::StringUtils::lowerCase (id)), mHash (hashId (mId)) {}
+
+            const std::string& getId() const { return mId; }
+            ///< The lowercase id
+
+            std::size_t getHash() const { return mHash; }
+
+            bool operator== (const RecordKey& key) const
+            {
+                return mHash == key.mHash && mId == key.mId;
+            }
+
+            bool operator!= (const RecordKey& key) const { return !(*this == key); }
+    };
+
+    /// Function object hashing record ids with hashId
+    struct IdHash
+    {
+        std::size_t operator() (const std::string& id) const { return hashId (id); }
+    };
+
+    /// \brief Hash table from lowercase record ids to records kept elsewhere, see Misc::StringIndex
+    ///
+    /// Ids inserted into or erased from the index have to be lowercase, while ids searched for can
+    /// be in any letter case.
+    template<class T>
+    class IdIndex : public Misc::StringIndex<T, IdHash>
+    {
+            typedef Misc::StringIndex<T, IdHash> Base;
+
+        public:
+
+            T *search (const std::string& id) const
+            {
+                return search (id, hashId (id));
+            }
+
+            /// \a hash has to be hashId (id).
+            T *search (const std::string& id, std::size_t hash) const
+            {
+                return Base::search (hash, [&id] (const std::string& key)
+                    { return Misc::StringUtils::ciEqual (key, id); });
+            }
+
+            T *search (const RecordKey& key) const
+            {
+                return Base::search (key.getHash(), [&key] (const std::string& id) { return id == key.getId(); });
+            }
+    };
+}
+
+#endif
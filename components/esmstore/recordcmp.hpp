@@ -1,5 +1,5 @@
-#ifndef OPENMW_MWWORLD_RECORDCMP_H
-#define OPENMW_MWWORLD_RECORDCMP_H
+#ifndef OPENMW_COMPONENTS_ESMSTORE_RECORDCMP_H
+#define OPENMW_COMPONENTS_ESMSTORE_RECORDCMP_H
 
 #include <components/esm/records.hpp>
 
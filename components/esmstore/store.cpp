@@ -8,6 +8,7 @@
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
 
+#include <algorithm>
 #include <iterator>
 #include <stdexcept>
 
@@ -28,6 +29,83 @@ namespace
             return x->mX < y.first;
         }
     };
+
+    /*
+        Start of tes3mp addition
+
+        Keep what the cache holds about records, besides what their save() writes, in one place
+    */
+    // Record flags that have to survive a record being cached
+    template<typename T>
+    uint32_t getRecordFlags(const T &record)
+    {
+        return 0;
+    }
+
+    uint32_t getRecordFlags(const ESM::NPC &record)
+    {
+        return record.mPersistent ? 0x0400 : 0;
+    }
+
+    uint32_t getRecordFlags(const ESM::Creature &record)
+    {
+        return record.mPersistent ? 0x0400 : 0;
+    }
+
+    void writeContext(ESM::ESMWriter &writer, const ESM::ESM_Context &context)
+    {
+        writer.startSubRecord("CTXT");
+        writer.writeT(context.leftRec);
+        writer.writeT(context.leftSub);
+        writer.writeT(static_cast<uint64_t>(context.leftFile));
+        writer.writeT(context.recName);
+        writer.writeT(context.subName);
+        writer.writeT(context.index);
+        writer.writeT(static_cast<uint32_t>(context.subCached));
+        writer.writeT(static_cast<uint64_t>(context.filePos));
+        writer.writeT(static_cast<uint32_t>(context.parentFileIndices.size()));
+        for (int index : context.parentFileIndices)
+            writer.writeT(index);
+        writer.endRecord("CTXT");
+    }
+
+    ESM::ESM_Context readContext(ESM::ESMReader &reader, const std::vector<std::string> &contentFiles)
+    {
+        ESM::ESM_Context context;
+        uint64_t leftFile = 0;
+        uint32_t subCached = 0;
+        uint64_t filePos = 0;
+        uint32_t parentCount = 0;
+
+        reader.getSubHeader();
+        reader.getT(context.leftRec);
+        reader.getT(context.leftSub);
+        reader.getT(leftFile);
+        reader.getT(context.recName);
+        reader.getT(context.subName);
+        reader.getT(context.index);
+        reader.getT(subCached);
+        reader.getT(filePos);
+        reader.getT(parentCount);
+
+        if (context.index < 0 || static_cast<size_t>(context.index) >= contentFiles.size())
+            reader.fail("Cached position is in an unknown content file");
+
+        // The content files may have been opened under other paths when the cache was written
+        context.filename = contentFiles[context.index];
+        context.leftFile = static_cast<size_t>(leftFile);
+        context.subCached = subCached != 0;
+        context.filePos = static_cast<size_t>(filePos);
+
+        context.parentFileIndices.resize(parentCount);
+        for (int &index : context.parentFileIndices)
+            reader.getT(index);
+
+        return context;
+    }
+    /*
+        End of tes3mp addition
+    */
 }
 
 namespace MWWorld
@@ -63,6 +141,26 @@ namespace MWWorld
         if (!ret.second)
             ret.first->second = record;
     }
+
+    /*
+        Start of tes3mp addition
+
+        Allow the records to be written to a cache and read back from it with load()
+    */
+    template<typename T>
+    void IndexedStore<T>::writeCache(ESM::ESMWriter &writer) const
+    {
+        for (typename Static::const_iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+        {
+            writer.startRecord(T::sRecordId);
+            it->second.save(writer);
+            writer.endRecord(T::sRecordId);
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
+
     template<typename T>
     int IndexedStore<T>::getSize() const
     {
@@ -105,6 +203,16 @@ namespace MWWorld
     Store<T>::Store(const Store<T>& orig)
         : mStatic(orig.mStatic)
     {
+        /*
+            Start of tes3mp addition
+
+            Index the copied records rather than the original ones
+        */
+        for (typename Static::iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+            mStaticIndex.insert(it->first, &it->second);
+        /*
+            End of tes3mp addition
+        */
     }
 
     template<typename T>
@@ -114,34 +222,81 @@ namespace MWWorld
         assert(mShared.size() >= mStatic.size());
         mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
         mDynamic.clear();
+        /*
+            Start of tes3mp addition
+
+            Keep the index of dynamic records in line with them
+        */
+        mDynamicIndex.clear();
+        /*
+            End of tes3mp addition
+        */
     }
 
     template<typename T>
     const T *Store<T>::search(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
+        /*
+            Start of tes3mp change (major)
 
-        typename Dynamic::const_iterator dit = mDynamic.find(idLower);
-        if (dit != mDynamic.end())
-            return &dit->second;
+            Look the record up in the hash indices, which compare ids without lowercasing
+            a copy of them first
+        */
+        const std::size_t hash = hashId(id);
 
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-        if (it != mStatic.end())
-            return &(it->second);
+        const T *record = mDynamicIndex.search(id, hash);
+        if (record != nullptr)
+            return record;
 
-        return nullptr;
+        return mStaticIndex.search(id, hash);
+        /*
+            End of tes3mp change (major)
+        */
     }
     template<typename T>
     const T *Store<T>::searchStatic(const std::string &id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-        if (it != mStatic.end())
-            return &(it->second);
+        /*
+            Start of tes3mp change (major)
 
-        return nullptr;
+            Look the record up in the hash index
+        */
+        return mStaticIndex.search(id);
+        /*
+            End of tes3mp change (major)
+        */
     }
 
+    /*
+        Start of tes3mp addition
+
+        Allow callers that look up the same record again and again to lowercase and hash
+        its id only once
+    */
+    template<typename T>
+    const T *Store<T>::search(const RecordKey &key) const
+    {
+        const T *record = mDynamicIndex.search(key);
+        if (record != nullptr)
+            return record;
+
+        return mStaticIndex.search(key);
+    }
+    template<typename T>
+    const T *Store<T>::find(const RecordKey &key) const
+    {
+        const T *ptr = search(key);
+        if (ptr == nullptr)
+        {
+            const std::string msg = T::getRecordType() + " '" + key.getId() + "' not found";
+            throw std::runtime_error(msg);
+        }
+        return ptr;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     template<typename T>
     bool Store<T>::isDynamic(const std::string &id) const
     {
@@ -183,12 +338,84 @@ namespace MWWorld
 
         std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(record.mId, record));
         if (inserted.second)
+        {
             mShared.push_back(&inserted.first->second);
+            /*
+                Start of tes3mp addition
+
+                Index the new record
+            */
+            mStaticIndex.insert(inserted.first->first, &inserted.first->second);
+            /*
+                End of tes3mp addition
+            */
+        }
         else
             inserted.first->second = record;
 
         return RecordId(record.mId, isDeleted);
     }
+
+    /*
+        Start of tes3mp addition
+
+        Allow records to be read on other threads ahead of being added to the store, split into
+        the same two halves as load()
+    */
+    template<typename T>
+    std::unique_ptr<StoreBase::DecodedRecord> Store<T>::decode(ESM::ESMReader &esm) const
+    {
+        std::unique_ptr<Decoded> decoded(new Decoded);
+        decoded->mIsDeleted = false;
+
+        decoded->mRecord.load(esm, decoded->mIsDeleted);
+        Misc::StringUtils::lowerCaseInPlace(decoded->mRecord.mId);
+
+        return std::move(decoded);
+    }
+
+    template<typename T>
+    RecordId Store<T>::insertDecoded(DecodedRecord &record)
+    {
+        Decoded &decoded = static_cast<Decoded&>(record);
+
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert(std::make_pair(decoded.mRecord.mId, decoded.mRecord));
+        if (inserted.second)
+        {
+            mShared.push_back(&inserted.first->second);
+            mStaticIndex.insert(inserted.first->first, &inserted.first->second);
+        }
+        else
+            inserted.first->second = decoded.mRecord;
+
+        return RecordId(decoded.mRecord.mId, decoded.mIsDeleted);
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Write the records loaded from the content files in the order they were loaded in, so
+        reading them back with load() restores that order as well
+    */
+    template<typename T>
+    void Store<T>::writeCache(ESM::ESMWriter& writer) const
+    {
+        for (size_t i = 0; i < mStatic.size(); ++i)
+        {
+            const T &record = *mShared[i];
+
+            writer.startRecord(T::sRecordId, getRecordFlags(record));
+            record.save(writer);
+            writer.endRecord(T::sRecordId);
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
+
     template<typename T>
     void Store<T>::setUp()
     {
@@ -240,11 +467,83 @@ namespace MWWorld
         T *ptr = &result.first->second;
         if (result.second) {
             mShared.push_back(ptr);
+            /*
+                Start of tes3mp addition
+
+                Index the new record
+            */
+            mDynamicIndex.insert(result.first->first, ptr);
+            /*
+                End of tes3mp addition
+            */
         } else {
             *ptr = item;
         }
         return ptr;
     }
+    /*
+        Start of tes3mp addition
+
+        Make it possible to insert many dynamic records at once, in sorted order so each
+        of them can be placed next to the previous one, with the same result as
+        inserting them one by one
+    */
+    template<typename T>
+    void Store<T>::insertBatch(const std::vector<T> &items)
+    {
+        std::vector<std::string> ids;
+        ids.reserve(items.size());
+
+        for (const T &item : items)
+            ids.push_back(Misc::StringUtils::lowerCase(item.mId));
+
+        std::vector<size_t> order(items.size());
+
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+
+        std::stable_sort(order.begin(), order.end(), [&ids](size_t a, size_t b) { return ids[a] < ids[b]; });
+
+        // Records that weren't in the store yet, at the position of the first item that had their id
+        std::vector<T *> newRecords(items.size(), nullptr);
+        typename Dynamic::iterator hint = mDynamic.begin();
+
+        for (size_t first = 0; first < order.size();)
+        {
+            size_t last = first;
+
+            while (last + 1 < order.size() && ids[order[last + 1]] == ids[order[first]])
+                ++last;
+
+            // Of several items with the same id, the last one is the one that remains
+            const T &item = items[order[last]];
+            size_t previousSize = mDynamic.size();
+            typename Dynamic::iterator it = mDynamic.emplace_hint(hint, ids[order[first]], item);
+
+            if (mDynamic.size() != previousSize)
+            {
+                newRecords[order[first]] = &it->second;
+                mDynamicIndex.insert(it->first, &it->second);
+            }
+            else
+                it->second = item;
+
+            hint = std::next(it);
+            first = last + 1;
+        }
+
+        // Keep the order the records were received in
+        mShared.reserve(mShared.size() + items.size());
+
+        for (T *record : newRecords)
+        {
+            if (record != nullptr)
+                mShared.push_back(record);
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
     template<typename T>
     T *Store<T>::insertStatic(const T &item)
     {
@@ -254,6 +553,15 @@ namespace MWWorld
         T *ptr = &result.first->second;
         if (result.second) {
             mShared.push_back(ptr);
+            /*
+                Start of tes3mp addition
+
+                Index the new record
+            */
+            mStaticIndex.insert(result.first->first, ptr);
+            /*
+                End of tes3mp addition
+            */
         } else {
             *ptr = item;
         }
@@ -278,6 +586,15 @@ namespace MWWorld
                 }
                 ++sharedIter;
             }
+            /*
+                Start of tes3mp addition
+
+                Remove the record from the index before it goes away
+            */
+            mStaticIndex.erase(idLower);
+            /*
+                End of tes3mp addition
+            */
             mStatic.erase(it);
         }
 
@@ -292,6 +609,15 @@ namespace MWWorld
         if (it == mDynamic.end()) {
             return false;
         }
+        /*
+            Start of tes3mp addition
+
+            Remove the record from the index before it goes away
+        */
+        mDynamicIndex.erase(key);
+        /*
+            End of tes3mp addition
+        */
         mDynamic.erase(it);
 
         // have to reinit the whole shared part
@@ -420,6 +746,63 @@ namespace MWWorld
         if (mStatic.size() < num)
             mStatic.resize(num);
     }
+
+    /*
+        Start of tes3mp addition
+
+        Write every land texture along with the plugin and index it is stored under, as they
+        can't be told apart by their own contents
+    */
+    void Store<ESM::LandTexture>::writeCache(ESM::ESMWriter &writer) const
+    {
+        for (size_t plugin = 0; plugin < mStatic.size(); ++plugin)
+        {
+            for (size_t index = 0; index < mStatic[plugin].size(); ++index)
+            {
+                const ESM::LandTexture &lt = mStatic[plugin][index];
+
+                // Skip the gaps left by indices that no record has used
+                if (lt.mId.empty() && lt.mTexture.empty())
+                    continue;
+
+                writer.startRecord(ESM::LandTexture::sRecordId);
+                writer.startSubRecord("PLUG");
+                writer.writeT(static_cast<uint32_t>(plugin));
+                writer.writeT(static_cast<uint32_t>(index));
+                writer.endRecord("PLUG");
+                lt.save(writer);
+                writer.endRecord(ESM::LandTexture::sRecordId);
+            }
+        }
+    }
+    RecordId Store<ESM::LandTexture>::readCache(ESM::ESMReader &reader, const std::vector<std::string> &contentFiles)
+    {
+        uint32_t plugin = 0;
+        uint32_t index = 0;
+
+        reader.getSubNameIs("PLUG");
+        reader.getSubHeader();
+        reader.getT(plugin);
+        reader.getT(index);
+
+        ESM::LandTexture lt;
+        bool isDeleted = false;
+
+        lt.load(reader, isDeleted);
+
+        resize(plugin + 1);
+
+        LandTextureList &ltexl = mStatic[plugin];
+        if (index + 1 > ltexl.size())
+            ltexl.resize(index + 1);
+
+        ltexl[index] = lt;
+
+        return RecordId(lt.mId, isDeleted);
+    }
+    /*
+        End of tes3mp addition
+    */
     
     // Land
     //=========================================================================
@@ -498,6 +881,53 @@ namespace MWWorld
         mBuilt = true;
     }
 
+    /*
+        Start of tes3mp addition
+
+        Write what loading a land record keeps of it, including the position its data is read
+        from later on, instead of the data itself
+    */
+    void Store<ESM::Land>::writeCache(ESM::ESMWriter &writer) const
+    {
+        for (const ESM::Land *land : mStatic)
+        {
+            writer.startRecord(ESM::Land::sRecordId);
+            writer.startSubRecord("INTV");
+            writer.writeT(land->mX);
+            writer.writeT(land->mY);
+            writer.endRecord("INTV");
+            writer.writeHNT("DATA", land->mFlags);
+            writer.writeHNT("PLUG", land->mPlugin);
+            writer.writeHNT("DTYP", land->mDataTypes);
+            writer.writeHNT("WNAM", land->mWnam);
+            writeContext(writer, land->mContext);
+            writer.endRecord(ESM::Land::sRecordId);
+        }
+    }
+    RecordId Store<ESM::Land>::readCache(ESM::ESMReader &reader, const std::vector<std::string> &contentFiles)
+    {
+        std::unique_ptr<ESM::Land> land(new ESM::Land());
+
+        reader.getSubNameIs("INTV");
+        reader.getSubHeaderIs(8);
+        reader.getT(land->mX);
+        reader.getT(land->mY);
+        reader.getHNT(land->mFlags, "DATA");
+        reader.getHNT(land->mPlugin, "PLUG");
+        reader.getHNT(land->mDataTypes, "DTYP");
+        reader.getHNT(land->mWnam, "WNAM");
+        reader.getSubNameIs("CTXT");
+        land->mContext = readContext(reader, contentFiles);
+
+        // The cache is written after setUp(), so the records come in sorted already
+        mStatic.push_back(land.release());
+
+        return RecordId();
+    }
+    /*
+        End of tes3mp addition
+    */
+
 
     // Cell
     //=========================================================================
@@ -924,6 +1354,106 @@ namespace MWWorld
         return true;
     }
 
+    /*
+        Start of tes3mp addition
+
+        Write everything loading and merging the cell records has produced, including the
+        positions of the cells' references and the references moved between cells, without
+        the references themselves
+    */
+    void Store<ESM::Cell>::writeCache(ESM::ESMWriter &writer) const
+    {
+        std::vector<const ESM::Cell*> cells;
+        cells.reserve(mInt.size() + mExt.size());
+
+        for (DynamicInt::const_iterator it = mInt.begin(); it != mInt.end(); ++it)
+            cells.push_back(&it->second);
+        for (DynamicExt::const_iterator it = mExt.begin(); it != mExt.end(); ++it)
+            cells.push_back(&it->second);
+
+        for (const ESM::Cell *cell : cells)
+        {
+            writer.startRecord(ESM::Cell::sRecordId);
+            writer.writeHNCString("NAME", cell->mName);
+            writer.writeHNT("DATA", cell->mData, 12);
+            writer.writeHNCString("RGNN", cell->mRegion);
+            writer.writeHNT("AMBI", cell->mAmbi, 16);
+            writer.writeHNT("HAMB", static_cast<uint32_t>(cell->mHasAmbi));
+            writer.writeHNT("WHGT", cell->mWater);
+            writer.writeHNT("WINT", static_cast<uint32_t>(cell->mWaterInt));
+            writer.writeHNT("NAM5", cell->mMapColor);
+            writer.writeHNT("NAM0", cell->mRefNumCounter);
+            writer.writeHNCString("SPAC", cell->mCellId.mWorldspace);
+            writer.writeHNT("CIDX", cell->mCellId.mIndex, 8);
+            writer.writeHNT("PAGE", static_cast<uint32_t>(cell->mCellId.mPaged));
+
+            for (const ESM::ESM_Context &context : cell->mContextList)
+                writeContext(writer, context);
+
+            for (const ESM::MovedCellRef &movedRef : cell->mMovedRefs)
+                writer.writeHNT("MVRF", movedRef);
+
+            for (const std::pair<ESM::CellRef, bool> &leasedRef : cell->mLeasedRefs)
+            {
+                writer.writeHNT("LEAS", static_cast<uint32_t>(leasedRef.second));
+                leasedRef.first.save(writer, true);
+            }
+
+            writer.endRecord(ESM::Cell::sRecordId);
+        }
+    }
+    RecordId Store<ESM::Cell>::readCache(ESM::ESMReader &reader, const std::vector<std::string> &contentFiles)
+    {
+        ESM::Cell cell;
+        uint32_t flag = 0;
+
+        cell.mName = reader.getHNString("NAME");
+        reader.getHNT(cell.mData, "DATA", 12);
+        cell.mRegion = reader.getHNString("RGNN");
+        reader.getHNT(cell.mAmbi, "AMBI", 16);
+        reader.getHNT(flag, "HAMB");
+        cell.mHasAmbi = flag != 0;
+        reader.getHNT(cell.mWater, "WHGT");
+        reader.getHNT(flag, "WINT");
+        cell.mWaterInt = flag != 0;
+        reader.getHNT(cell.mMapColor, "NAM5");
+        reader.getHNT(cell.mRefNumCounter, "NAM0");
+        cell.mCellId.mWorldspace = reader.getHNString("SPAC");
+        reader.getHNT(cell.mCellId.mIndex, "CIDX", 8);
+        reader.getHNT(flag, "PAGE");
+        cell.mCellId.mPaged = flag != 0;
+
+        while (reader.isNextSub("CTXT"))
+            cell.mContextList.push_back(readContext(reader, contentFiles));
+
+        while (reader.isNextSub("MVRF"))
+        {
+            ESM::MovedCellRef movedRef;
+            reader.getHT(movedRef);
+            cell.mMovedRefs.push_back(movedRef);
+        }
+
+        while (reader.isNextSub("LEAS"))
+        {
+            reader.getHT(flag);
+
+            ESM::CellRef ref;
+            bool isDeleted = false;
+            ref.load(reader, isDeleted, true);
+            cell.mLeasedRefs.push_back(std::make_pair(ref, flag != 0));
+        }
+
+        if (cell.mData.mFlags & ESM::Cell::Interior)
+            mInt[Misc::StringUtils::lowerCase(cell.mName)] = cell;
+        else
+            mExt[std::make_pair(cell.mData.mX, cell.mData.mY)] = cell;
+
+        return RecordId(cell.mName);
+    }
+    /*
+        End of tes3mp addition
+    */
+
     
     // Pathgrid
     //=========================================================================
@@ -1023,6 +1553,51 @@ namespace MWWorld
             return find(cell.mName);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Write whether each pathgrid belongs to an interior along with it, so reading it back
+        doesn't depend on the cells being there already
+    */
+    void Store<ESM::Pathgrid>::writeCache(ESM::ESMWriter &writer) const
+    {
+        for (Interior::const_iterator it = mInt.begin(); it != mInt.end(); ++it)
+        {
+            writer.startRecord(ESM::Pathgrid::sRecordId);
+            writer.writeHNT("PGIN", static_cast<uint32_t>(1));
+            it->second.save(writer);
+            writer.endRecord(ESM::Pathgrid::sRecordId);
+        }
+
+        for (Exterior::const_iterator it = mExt.begin(); it != mExt.end(); ++it)
+        {
+            writer.startRecord(ESM::Pathgrid::sRecordId);
+            writer.writeHNT("PGIN", static_cast<uint32_t>(0));
+            it->second.save(writer);
+            writer.endRecord(ESM::Pathgrid::sRecordId);
+        }
+    }
+    RecordId Store<ESM::Pathgrid>::readCache(ESM::ESMReader &reader, const std::vector<std::string> &contentFiles)
+    {
+        uint32_t interior = 0;
+        reader.getHNT(interior, "PGIN");
+
+        ESM::Pathgrid pathgrid;
+        bool isDeleted = false;
+
+        pathgrid.load(reader, isDeleted);
+
+        if (interior)
+            mInt[pathgrid.mCell] = pathgrid;
+        else
+            mExt[std::make_pair(pathgrid.mData.mX, pathgrid.mData.mY)] = pathgrid;
+
+        return RecordId("", isDeleted);
+    }
+    /*
+        End of tes3mp addition
+    */
+
 
     // Skill
     //=========================================================================
@@ -1126,7 +1701,16 @@ namespace MWWorld
         if (found == mStatic.end())
         {
             dialogue.loadData(esm, isDeleted);
-            mStatic.insert(std::make_pair(idLower, dialogue));
+            /*
+                Start of tes3mp change (minor)
+
+                Index the new dialogue
+            */
+            found = mStatic.insert(std::make_pair(idLower, dialogue)).first;
+            mStaticIndex.insert(found->first, &found->second);
+            /*
+                End of tes3mp change (minor)
+            */
         }
         else
         {
@@ -1137,13 +1721,65 @@ namespace MWWorld
         return RecordId(dialogue.mId, isDeleted);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Dialogues get merged with the ones already in the store, so they can't be read ahead
+    */
+    template <>
+    std::unique_ptr<StoreBase::DecodedRecord> Store<ESM::Dialogue>::decode(ESM::ESMReader &esm) const
+    {
+        return nullptr;
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Write every dialogue followed by its infos, the way content files have them, now that
+        setUp() has removed the deleted infos
+    */
+    template <>
+    void Store<ESM::Dialogue>::writeCache(ESM::ESMWriter& writer) const
+    {
+        for (Static::const_iterator it = mStatic.begin(); it != mStatic.end(); ++it)
+        {
+            writer.startRecord(ESM::Dialogue::sRecordId);
+            it->second.save(writer);
+            writer.endRecord(ESM::Dialogue::sRecordId);
+
+            for (const ESM::DialInfo &info : it->second.mInfo)
+            {
+                writer.startRecord(ESM::DialInfo::sRecordId);
+                info.save(writer);
+                writer.endRecord(ESM::DialInfo::sRecordId);
+            }
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
+
     template<>
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
         auto it = mStatic.find(Misc::StringUtils::lowerCase(id));
 
         if (it != mStatic.end())
+        {
+            /*
+                Start of tes3mp addition
+
+                Remove the dialogue from the index before it goes away
+            */
+            mStaticIndex.erase(it->first);
+            /*
+                End of tes3mp addition
+            */
             mStatic.erase(it);
+        }
 
         return true;
     }
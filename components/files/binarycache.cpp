@@ -0,0 +1,69 @@
+#include "binarycache.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/filesystem/operations.hpp>
+
+namespace Files
+{
+
+void writeValue(std::ostream& stream, const std::string& value)
+{
+    writeValue(stream, static_cast<uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+}
+
+bool readValue(std::istream& stream, std::string& value, uint32_t maxSize)
+{
+    uint32_t size = 0;
+
+    if (!readValue(stream, size) || size > maxSize)
+        return false;
+
+    value.resize(size);
+    return static_cast<bool>(stream.read(&value[0], size));
+}
+
+void writeCacheHeader(std::ostream& stream, const std::string& magic, uint32_t formatVersion)
+{
+    writeValue(stream, magic);
+    writeValue(stream, formatVersion);
+}
+
+bool readCacheHeader(std::istream& stream, const std::string& magic, uint32_t formatVersion)
+{
+    std::string fileMagic;
+    uint32_t fileFormatVersion = 0;
+
+    return readValue(stream, fileMagic, static_cast<uint32_t>(magic.size())) && fileMagic == magic &&
+        readValue(stream, fileFormatVersion) && fileFormatVersion == formatVersion;
+}
+
+void writeFileAtomically(const boost::filesystem::path& path, const std::function<void(std::ostream&)>& write)
+{
+    if (path.has_parent_path())
+        boost::filesystem::create_directories(path.parent_path());
+
+    boost::filesystem::path tempPath = path;
+    tempPath += "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+    {
+        std::ofstream stream(tempPath.string(), std::ios::binary | std::ios::trunc);
+
+        write(stream);
+
+        if (!stream)
+            throw std::runtime_error("failed to write " + tempPath.string());
+    }
+
+    boost::filesystem::rename(tempPath, path);
+}
+
+bool isInterruptedWrite(const boost::filesystem::path& path)
+{
+    return path.extension() == ".tmp";
+}
+
+}
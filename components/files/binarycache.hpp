@@ -0,0 +1,62 @@
+#ifndef OPENMW_COMPONENTS_FILES_BINARYCACHE_H
+#define OPENMW_COMPONENTS_FILES_BINARYCACHE_H
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include <stdint.h>
+
+#include <boost/filesystem/path.hpp>
+
+namespace Files
+{
+
+/// Anything bigger than this in a cache file is taken to mean the file is damaged, unless the file
+/// says otherwise
+const uint32_t sMaxCacheValueSize = 16 * 1024 * 1024;
+
+/// Write a value to a cache file as its bytes in memory.
+template<class T>
+void writeValue(std::ostream& stream, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written as they are");
+    stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/// Write a string to a cache file, preceded by its size.
+void writeValue(std::ostream& stream, const std::string& value);
+
+/// Read a value written by writeValue.
+/// \return Whether the whole value could be read
+template<class T>
+bool readValue(std::istream& stream, T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read as they are");
+    return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+/// Read a string written by writeValue.
+/// \return Whether the whole string could be read, and was no bigger than \a maxSize
+bool readValue(std::istream& stream, std::string& value, uint32_t maxSize = sMaxCacheValueSize);
+
+/// Write what identifies the kind and layout of a cache file at its start.
+void writeCacheHeader(std::ostream& stream, const std::string& magic, uint32_t formatVersion);
+
+/// \return Whether a cache file starts with the given kind and layout
+bool readCacheHeader(std::istream& stream, const std::string& magic, uint32_t formatVersion);
+
+/// Write a file by writing a separate file next to it first and then putting that in its place, so an
+/// interrupted write can't leave a damaged file behind, and another thread writing the same file can't
+/// get in the way. Creates the directory of the file if needed.
+/// \note Throws std::runtime_error if writing fails.
+void writeFileAtomically(const boost::filesystem::path& path, const std::function<void(std::ostream&)>& write);
+
+/// \return Whether a file is one left behind by writeFileAtomically because a write was interrupted
+bool isInterruptedWrite(const boost::filesystem::path& path);
+
+}
+
+#endif
@@ -31,6 +31,18 @@ namespace Files
             return seekoff(pos, std::ios_base::beg, which);
         }
 
+        /*
+            Start of tes3mp addition
+
+            Allow readers that know they are reading from memory to read the buffer directly
+        */
+        const char* data() const { return bufferStart; }
+
+        size_t size() const { return static_cast<size_t>(bufferEnd - bufferStart); }
+        /*
+            End of tes3mp addition
+        */
+
     protected:
         char* bufferStart;
         char* bufferEnd;
@@ -9,77 +9,143 @@ namespace Interpreter
 {
     void Interpreter::execute (Type_Code code)
     {
-        unsigned int segSpec = code>>30;
+        /*
+            Start of tes3mp change (major)
+
+            Look up the opcode in the dispatch tables instead of searching the segments
+        */
+        DecodedCode::Instruction instruction;
+        decode (code, instruction);
+        execute (instruction);
+        /*
+            End of tes3mp change (major)
+        */
+    }
+
+    /*
+        Start of tes3mp addition
+
+        Decode and execute instructions through the dispatch tables
+    */
+    template<class T>
+    void Interpreter::DispatchTable<T>::build (const std::map<int, T *>& opcodes)
+    {
+        // Codes further apart than this start a new block instead of leaving a gap in the last one
+        const int maxGap = 64;
+
+        mBlocks.clear();
 
-        switch (segSpec)
+        for (const auto& opcode : opcodes)
         {
-            case 0:
+            if (mBlocks.empty() ||
+                opcode.first - mBlocks.back().mFirstCode - static_cast<int> (mBlocks.back().mOpcodes.size()) > maxGap)
             {
-                int opcode = code>>24;
-                unsigned int arg0 = code & 0xffffff;
+                mBlocks.push_back (Block{opcode.first, {}});
+            }
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment0.find (opcode);
+            Block& block = mBlocks.back();
+            block.mOpcodes.resize (opcode.first - block.mFirstCode + 1, nullptr);
+            block.mOpcodes.back() = opcode.second;
+        }
 
-                if (iter==mSegment0.end())
-                    abortUnknownCode (0, opcode);
+        mOpcodeCount = opcodes.size();
+    }
 
-                iter->second->execute (mRuntime, arg0);
+    void Interpreter::updateDispatchTables()
+    {
+        if (!mTable0.isBuiltFrom (mSegment0))
+            mTable0.build (mSegment0);
 
-                return;
-            }
+        if (!mTable2.isBuiltFrom (mSegment2))
+            mTable2.build (mSegment2);
 
-            case 2:
-            {
-                int opcode = (code>>20) & 0x3ff;
-                unsigned int arg0 = code & 0xfffff;
+        if (!mTable3.isBuiltFrom (mSegment3))
+            mTable3.build (mSegment3);
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment2.find (opcode);
+        if (!mTable5.isBuiltFrom (mSegment5))
+            mTable5.build (mSegment5);
+    }
 
-                if (iter==mSegment2.end())
-                    abortUnknownCode (2, opcode);
+    void Interpreter::decode (Type_Code code, DecodedCode::Instruction& instruction) const
+    {
+        instruction.mOpcode0 = nullptr;
+        instruction.mOpcode1 = nullptr;
+        instruction.mArg0 = 0;
+        instruction.mCode = code;
 
-                iter->second->execute (mRuntime, arg0);
+        switch (code>>30)
+        {
+            case 0:
 
+                instruction.mOpcode1 = mTable0.find (code>>24);
+                instruction.mArg0 = code & 0xffffff;
                 return;
-            }
-        }
 
-        segSpec = code>>26;
+            case 2:
+
+                instruction.mOpcode1 = mTable2.find ((code>>20) & 0x3ff);
+                instruction.mArg0 = code & 0xfffff;
+                return;
+        }
 
-        switch (segSpec)
+        switch (code>>26)
         {
             case 0x30:
-            {
-                int opcode = (code>>8) & 0x3ffff;
-                unsigned int arg0 = code & 0xff;
 
-                std::map<int, Opcode1 *>::iterator iter = mSegment3.find (opcode);
+                instruction.mOpcode1 = mTable3.find ((code>>8) & 0x3ffff);
+                instruction.mArg0 = code & 0xff;
+                return;
 
-                if (iter==mSegment3.end())
-                    abortUnknownCode (3, opcode);
+            case 0x32:
 
-                iter->second->execute (mRuntime, arg0);
+                instruction.mOpcode0 = mTable5.find (code & 0x3ffffff);
+                return;
+        }
+    }
 
+    void Interpreter::execute (const DecodedCode::Instruction& instruction)
+    {
+        if (instruction.mOpcode1)
+            instruction.mOpcode1->execute (mRuntime, instruction.mArg0);
+        else if (instruction.mOpcode0)
+            instruction.mOpcode0->execute (mRuntime);
+        else
+            abortUnknownInstruction (instruction.mCode);
+    }
+
+    void Interpreter::abortUnknownInstruction (Type_Code code)
+    {
+        switch (code>>30)
+        {
+            case 0:
+
+                abortUnknownCode (0, code>>24);
                 return;
-            }
 
-            case 0x32:
-            {
-                int opcode = code & 0x3ffffff;
+            case 2:
 
-                std::map<int, Opcode0 *>::iterator iter = mSegment5.find (opcode);
+                abortUnknownCode (2, (code>>20) & 0x3ff);
+                return;
+        }
 
-                if (iter==mSegment5.end())
-                    abortUnknownCode (5, opcode);
+        switch (code>>26)
+        {
+            case 0x30:
 
-                iter->second->execute (mRuntime);
+                abortUnknownCode (3, (code>>8) & 0x3ffff);
+                return;
 
+            case 0x32:
+
+                abortUnknownCode (5, code & 0x3ffffff);
                 return;
-            }
         }
 
         abortUnknownSegment (code);
     }
+    /*
+        End of tes3mp addition
+    */
 
     void Interpreter::abortUnknownCode (int segment, int opcode)
     {
@@ -174,6 +240,16 @@ namespace Interpreter
 
         try
         {
+            /*
+                Start of tes3mp addition
+
+                Pick up any opcodes installed since the last run
+            */
+            updateDispatchTables();
+            /*
+                End of tes3mp addition
+            */
+
             mRuntime.configure (code, codeSize, context);
 
             int opcodes = static_cast<int> (code[0]);
@@ -195,4 +271,59 @@ namespace Interpreter
 
         end();
     }
+
+    /*
+        Start of tes3mp addition
+
+        Make it possible to decode code once and then run it as often as needed
+    */
+    void Interpreter::decode (const Type_Code *code, int codeSize, DecodedCode& decodedCode)
+    {
+        assert (codeSize>=4);
+
+        updateDispatchTables();
+
+        decodedCode.mCode = code;
+        decodedCode.mCodeSize = codeSize;
+
+        int opcodes = static_cast<int> (code[0]);
+
+        const Type_Code *codeBlock = code + 4;
+
+        decodedCode.mInstructions.resize (opcodes);
+
+        for (int i = 0; i < opcodes; ++i)
+            decode (codeBlock[i], decodedCode.mInstructions[i]);
+    }
+
+    void Interpreter::run (const DecodedCode& decodedCode, Context& context)
+    {
+        assert (decodedCode.mCodeSize>=4);
+
+        begin();
+
+        try
+        {
+            mRuntime.configure (decodedCode.mCode, decodedCode.mCodeSize, context);
+
+            const DecodedCode::Instruction *instructions = decodedCode.mInstructions.data();
+            int opcodes = static_cast<int> (decodedCode.mInstructions.size());
+
+            for (int pc = mRuntime.getPC(); pc>=0 && pc<opcodes; pc = mRuntime.getPC())
+            {
+                mRuntime.setPC (pc+1);
+                execute (instructions[pc]);
+            }
+        }
+        catch (...)
+        {
+            end();
+            throw;
+        }
+
+        end();
+    }
+    /*
+        End of tes3mp addition
+    */
 }
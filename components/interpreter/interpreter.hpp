@@ -3,6 +3,7 @@
 
 #include <map>
 #include <stack>
+#include <vector>
 
 #include "runtime.hpp"
 #include "types.hpp"
@@ -12,8 +13,76 @@ namespace Interpreter
     class Opcode0;
     class Opcode1;
 
+    /*
+        Start of tes3mp addition
+
+        Byte code whose instructions have had their opcodes looked up ahead of time, so it can be
+        run repeatedly without decoding each instruction again every time
+    */
+    struct DecodedCode
+    {
+        struct Instruction
+        {
+            Opcode0 *mOpcode0;
+            Opcode1 *mOpcode1;
+            unsigned int mArg0;
+            Type_Code mCode;
+        };
+
+        const Type_Code *mCode = nullptr;
+        int mCodeSize = 0;
+        std::vector<Instruction> mInstructions;
+    };
+    /*
+        End of tes3mp addition
+    */
+
     class Interpreter
     {
+            /*
+                Start of tes3mp addition
+
+                Opcodes of a segment stored in arrays indexed by their codes, with one array
+                for every cluster of codes that are close together
+            */
+            template<class T>
+            class DispatchTable
+            {
+                    struct Block
+                    {
+                        int mFirstCode;
+                        std::vector<T *> mOpcodes;
+                    };
+
+                    std::vector<Block> mBlocks;
+                    std::size_t mOpcodeCount = 0;
+
+                public:
+
+                    void build (const std::map<int, T *>& opcodes);
+
+                    bool isBuiltFrom (const std::map<int, T *>& opcodes) const
+                    {
+                        return mOpcodeCount == opcodes.size();
+                    }
+
+                    T *find (int code) const
+                    {
+                        for (const Block& block : mBlocks)
+                        {
+                            std::size_t index = static_cast<unsigned int> (code - block.mFirstCode);
+
+                            if (index < block.mOpcodes.size())
+                                return block.mOpcodes[index];
+                        }
+
+                        return nullptr;
+                    }
+            };
+            /*
+                End of tes3mp addition
+            */
+
             std::stack<Runtime> mCallstack;
             bool mRunning;
             Runtime mRuntime;
@@ -22,12 +91,42 @@ namespace Interpreter
             std::map<int, Opcode1 *> mSegment3;
             std::map<int, Opcode0 *> mSegment5;
 
+            /*
+                Start of tes3mp addition
+
+                Keep dense copies of the segments for looking up opcodes while running
+            */
+            DispatchTable<Opcode1> mTable0;
+            DispatchTable<Opcode1> mTable2;
+            DispatchTable<Opcode1> mTable3;
+            DispatchTable<Opcode0> mTable5;
+            /*
+                End of tes3mp addition
+            */
+
             // not implemented
             Interpreter (const Interpreter&);
             Interpreter& operator= (const Interpreter&);
 
             void execute (Type_Code code);
 
+            /*
+                Start of tes3mp addition
+
+                Decode and execute instructions through the dispatch tables, which are rebuilt
+                whenever opcodes have been installed since they were last built
+            */
+            void updateDispatchTables();
+
+            void decode (Type_Code code, DecodedCode::Instruction& instruction) const;
+
+            void execute (const DecodedCode::Instruction& instruction);
+
+            void abortUnknownInstruction (Type_Code code);
+            /*
+                End of tes3mp addition
+            */
+
             void abortUnknownCode (int segment, int opcode);
 
             void abortUnknownSegment (Type_Code code);
@@ -55,6 +154,21 @@ namespace Interpreter
             ///< ownership of \a opcode is transferred to *this.
 
             void run (const Type_Code *code, int codeSize, Context& context);
+
+            /*
+                Start of tes3mp addition
+
+                Make it possible to decode code once and then run it as often as needed
+            */
+            void decode (const Type_Code *code, int codeSize, DecodedCode& decodedCode);
+            ///< \a code must exist for as long as \a decodedCode is run. Opcodes installed after
+            /// decoding are not picked up by \a decodedCode.
+
+            void run (const DecodedCode& decodedCode, Context& context);
+            ///< \a decodedCode must have been decoded by this interpreter.
+            /*
+                End of tes3mp addition
+            */
     };
 }
 
@@ -8,11 +8,6 @@ namespace Interpreter
 {
     Runtime::Runtime() : mContext (nullptr), mCode (nullptr), mCodeSize(0), mPC (0) {}
 
-    int Runtime::getPC() const
-    {
-        return mPC;
-    }
-
     int Runtime::getIntegerLiteral (int index) const
     {
         if (index < 0 || index >= static_cast<int> (mCode[1]))
@@ -71,11 +66,6 @@ namespace Interpreter
         mStack.clear();
     }
 
-    void Runtime::setPC (int PC)
-    {
-        mPC = PC;
-    }
-
     void Runtime::push (const Data& data)
     {
         mStack.push_back (data);
@@ -24,8 +24,19 @@ namespace Interpreter
 
             Runtime ();
 
-            int getPC() const;
+            /*
+                Start of tes3mp change (minor)
+
+                Define the program counter accessors inline, as they are used for every instruction
+            */
+            int getPC() const
+            {
+                return mPC;
+            }
             ///< return program counter.
+            /*
+                End of tes3mp change (minor)
+            */
 
             int getIntegerLiteral (int index) const;
 
@@ -39,8 +50,19 @@ namespace Interpreter
 
             void clear();
 
-            void setPC (int PC);
+            /*
+                Start of tes3mp change (minor)
+
+                Define the program counter accessors inline, as they are used for every instruction
+            */
+            void setPC (int PC)
+            {
+                mPC = PC;
+            }
             ///< set program counter.
+            /*
+                End of tes3mp change (minor)
+            */
 
             void push (const Data& data);
             ///< push data on stack
@@ -0,0 +1,160 @@
+#ifndef MISC_STRINGINDEX_H
+#define MISC_STRINGINDEX_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Misc
+{
+    /// \brief Open-addressing hash table from strings to values kept elsewhere
+    ///
+    /// The index only points to the strings and values, which have to stay where they are for as
+    /// long as they are in the index, as they do in the nodes of a std::map. \a Hash is a function
+    /// object hashing the strings.
+    template<class T, class Hash>
+    class StringIndex
+    {
+            struct Slot
+            {
+                std::size_t mHash;
+                const std::string *mKey;
+                T *mValue;
+            };
+
+            std::vector<Slot> mSlots;
+            std::size_t mSize;
+
+            std::size_t mask() const { return mSlots.size() - 1; }
+
+            void place (const Slot& slot)
+            {
+                std::size_t i = slot.mHash & mask();
+
+                while (mSlots[i].mValue != nullptr)
+                    i = (i + 1) & mask();
+
+                mSlots[i] = slot;
+            }
+
+            void rehash (std::size_t capacity)
+            {
+                std::vector<Slot> slots (capacity, Slot { 0, nullptr, nullptr });
+                mSlots.swap (slots);
+
+                for (const Slot& slot : slots)
+                {
+                    if (slot.mValue != nullptr)
+                        place (slot);
+                }
+            }
+
+        public:
+
+            StringIndex() : mSize (0) {}
+
+            std::size_t size() const { return mSize; }
+
+            void clear()
+            {
+                mSlots.clear();
+                mSize = 0;
+            }
+
+            void reserve (std::size_t size)
+            {
+                // Keep the table at most half full, so probe sequences stay short
+                std::size_t capacity = 16;
+
+                while (capacity < size * 2)
+                    capacity *= 2;
+
+                if (capacity > mSlots.size())
+                    rehash (capacity);
+            }
+
+            /// Search for the value of a string that \a equal accepts and that has \a hash, for
+            /// looking up strings that aren't quite the same as the keys, like in another letter case.
+            template<class Equal>
+            T *search (std::size_t hash, const Equal& equal) const
+            {
+                if (mSize == 0)
+                    return nullptr;
+
+                for (std::size_t i = hash & mask();; i = (i + 1) & mask())
+                {
+                    const Slot& slot = mSlots[i];
+
+                    if (slot.mValue == nullptr)
+                        return nullptr;
+
+                    if (slot.mHash == hash && equal (*slot.mKey))
+                        return slot.mValue;
+                }
+            }
+
+            T *search (const std::string& key) const
+            {
+                return search (Hash() (key), [&key] (const std::string& other) { return other == key; });
+            }
+
+            /// A value already indexed under \a key is replaced.
+            void insert (const std::string& key, T *value)
+            {
+                std::size_t hash = Hash() (key);
+
+                if (!mSlots.empty())
+                {
+                    for (std::size_t i = hash & mask(); mSlots[i].mValue != nullptr; i = (i + 1) & mask())
+                    {
+                        if (mSlots[i].mHash == hash && *mSlots[i].mKey == key)
+                        {
+                            mSlots[i].mKey = &key;
+                            mSlots[i].mValue = value;
+                            return;
+                        }
+                    }
+                }
+
+                reserve (mSize + 1);
+                place (Slot { hash, &key, value });
+                ++mSize;
+            }
+
+            bool erase (const std::string& key)
+            {
+                if (mSize == 0)
+                    return false;
+
+                std::size_t hash = Hash() (key);
+                std::size_t i = hash & mask();
+
+                for (;; i = (i + 1) & mask())
+                {
+                    if (mSlots[i].mValue == nullptr)
+                        return false;
+
+                    if (mSlots[i].mHash == hash && *mSlots[i].mKey == key)
+                        break;
+                }
+
+                // Move back any entry that could only be found by probing past the freed slot
+                for (std::size_t j = (i + 1) & mask(); mSlots[j].mValue != nullptr; j = (j + 1) & mask())
+                {
+                    std::size_t home = mSlots[j].mHash & mask();
+
+                    if (((j - home) & mask()) >= ((j - i) & mask()))
+                    {
+                        mSlots[i] = mSlots[j];
+                        i = j;
+                    }
+                }
+
+                mSlots[i] = Slot { 0, nullptr, nullptr };
+                --mSize;
+                return true;
+            }
+    };
+}
+
+#endif
@@ -155,7 +155,15 @@ std::string NIFFile::printVersion(unsigned int version)
 
 void NIFFile::parse(Files::IStreamPtr stream)
 {
-    NIFStream nif (this, stream);
+    /*
+        Start of tes3mp change (minor)
+
+        Parse the file from a contiguous buffer unless told otherwise
+    */
+    NIFStream nif (this, stream, sParseFromBuffer);
+    /*
+        End of tes3mp change (minor)
+    */
 
     // Check the header string
     std::string head = nif.getVersionString();
@@ -348,4 +356,19 @@ void NIFFile::setLoadUnsupportedFiles(bool load)
     sLoadUnsupportedFiles = load;
 }
 
+/*
+    Start of tes3mp addition
+
+    Allow files to be parsed from a contiguous buffer
+*/
+bool NIFFile::sParseFromBuffer = true;
+
+void NIFFile::setParseFromBuffer(bool parse)
+{
+    sParseFromBuffer = parse;
+}
+/*
+    End of tes3mp addition
+*/
+
 }
@@ -64,6 +64,16 @@ class NIFFile final : public File
 
     static bool sLoadUnsupportedFiles;
 
+    /*
+        Start of tes3mp addition
+
+        Allow files to be parsed from a contiguous buffer
+    */
+    static bool sParseFromBuffer;
+    /*
+        End of tes3mp addition
+    */
+
     /// Parse the file
     void parse(Files::IStreamPtr stream);
 
@@ -153,6 +163,18 @@ public:
     unsigned int getBethVersion() const override { return bethVer; }
 
     static void setLoadUnsupportedFiles(bool load);
+
+    /*
+        Start of tes3mp addition
+
+        Allow files to be parsed from a contiguous buffer
+    */
+    /// Parse files from a contiguous buffer, the memory their stream reads from if it reads from memory,
+    /// instead of through the stream. Enabled by default.
+    static void setParseFromBuffer(bool parse);
+    /*
+        End of tes3mp addition
+    */
 };
 using NIFFilePtr = std::shared_ptr<const Nif::NIFFile>;
 
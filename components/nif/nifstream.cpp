@@ -2,12 +2,75 @@
 //For error reporting
 #include "niffile.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/files/memorystream.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace Nif
 {
+    /*
+        Start of tes3mp addition
+
+        Parse files from a contiguous buffer
+    */
+    NIFStream::NIFStream(NIFFile * file, Files::IStreamPtr inp, bool buffered)
+        : inp(inp), file(file)
+    {
+        if (!buffered)
+            return;
+
+        // Files from memory mapped or decompressed archives are already in memory, so no copy is needed
+        if (const Files::MemBuf *memBuf = dynamic_cast<const Files::MemBuf*>(inp->rdbuf()))
+        {
+            const std::streamoff offset = inp->tellg();
+            if (offset >= 0 && static_cast<std::size_t>(offset) <= memBuf->size())
+            {
+                mPos = memBuf->data() + offset;
+                mEnd = memBuf->data() + memBuf->size();
+                return;
+            }
+        }
+
+        // Other files are read into memory in a few large reads
+        const std::size_t chunkSize = 64 * 1024;
+        std::size_t size = 0;
+
+        while (inp->good())
+        {
+            mBuffer.resize(size + chunkSize);
+            inp->read(mBuffer.data() + size, chunkSize);
+            size += static_cast<std::size_t>(inp->gcount());
+        }
+
+        if (inp->bad())
+            throw std::runtime_error("Failed to read NIF file into memory");
+
+        mBuffer.resize(size);
+        mPos = mBuffer.data();
+        mEnd = mPos + size;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float>(inp, f);
+        /*
+            Start of tes3mp change (minor)
+
+            Read from the buffer the file is parsed from, if there is one
+        */
+        read(f, 4);
+        /*
+            End of tes3mp change (minor)
+        */
         osg::Quat quat;
         quat.w() = f[0];
         quat.x() = f[1];
@@ -5,6 +5,18 @@
 
 #include <cassert>
 #include <stdint.h>
+
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <algorithm>
+#include <cstring>
+/*
+    End of tes3mp addition
+*/
+
 #include <stdexcept>
 #include <vector>
 #include <typeinfo>
@@ -53,74 +65,126 @@ template<typename type> type inline readLittleEndianType(Files::IStreamPtr &pISt
     return val;
 }
 
+/*
+    Start of tes3mp change (major)
+
+    Parse files from a contiguous buffer, taken straight from the memory the stream reads from when
+    there is one, so values and arrays are copied out of it directly instead of through many small
+    stream reads
+*/
 class NIFStream
 {
     /// Input stream
     Files::IStreamPtr inp;
 
+    /// The unread part of the buffer the file is parsed from, or null when it is parsed from the stream
+    const char *mPos = nullptr;
+    const char *mEnd = nullptr;
+
+    /// Holds the file if it had to be read into memory first
+    std::vector<char> mBuffer;
+
+    template <typename T> void read(T* dest, std::size_t numInstances)
+    {
+        static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
+
+        if (mPos == nullptr)
+        {
+            readLittleEndianDynamicBufferOfType<T>(inp, dest, numInstances);
+            return;
+        }
+
+        // Like a stream, a buffer read past its end gives what is left, the rest is zeroed
+        const std::size_t size = numInstances * sizeof(T);
+        const std::size_t available = std::min(size, static_cast<std::size_t>(mEnd - mPos));
+        std::memcpy(dest, mPos, available);
+        if (available < size)
+            std::memset(reinterpret_cast<char*>(dest) + available, 0, size - available);
+        mPos += available;
+
+        if constexpr (Misc::IS_BIG_ENDIAN)
+            for (std::size_t i = 0; i < numInstances; i++)
+                Misc::swapEndiannessInplace(dest[i]);
+    }
+
+    template <typename T> T read()
+    {
+        T val;
+        read(&val, 1);
+        return val;
+    }
+
 public:
 
     NIFFile * const file;
 
-    NIFStream (NIFFile * file, Files::IStreamPtr inp): inp (inp), file (file) {}
+    /// @param buffered Parse from a contiguous buffer? The memory \a inp reads from is used directly if it
+    /// reads from memory, otherwise the rest of \a inp is read into a buffer first.
+    NIFStream (NIFFile * file, Files::IStreamPtr inp, bool buffered = true);
 
-    void skip(size_t size) { inp->ignore(size); }
+    void skip(size_t size)
+    {
+        if (mPos == nullptr)
+            inp->ignore(size);
+        else
+            mPos += std::min(size, static_cast<std::size_t>(mEnd - mPos));
+    }
 
     char getChar()
     {
-        return readLittleEndianType<char>(inp);
+        return read<char>();
     }
 
     short getShort()
     {
-        return readLittleEndianType<short>(inp);
+        return read<short>();
     }
 
     unsigned short getUShort()
     {
-        return readLittleEndianType<unsigned short>(inp);
+        return read<unsigned short>();
     }
 
     int getInt()
     {
-        return readLittleEndianType<int>(inp);
+        return read<int>();
     }
 
     unsigned int getUInt()
     {
-        return readLittleEndianType<unsigned int>(inp);
+        return read<unsigned int>();
     }
 
     float getFloat()
     {
-        return readLittleEndianType<float>(inp);
+        return read<float>();
     }
 
     osg::Vec2f getVector2()
     {
         osg::Vec2f vec;
-        readLittleEndianBufferOfType<2,float>(inp, vec._v);
+        read(vec._v, 2);
         return vec;
     }
 
     osg::Vec3f getVector3()
     {
         osg::Vec3f vec;
-        readLittleEndianBufferOfType<3, float>(inp, vec._v);
+        read(vec._v, 3);
         return vec;
     }
 
     osg::Vec4f getVector4()
     {
         osg::Vec4f vec;
-        readLittleEndianBufferOfType<4, float>(inp, vec._v);
+        read(vec._v, 4);
         return vec;
     }
 
     Matrix3 getMatrix3()
     {
         Matrix3 mat;
-        readLittleEndianBufferOfType<9, float>(inp, (float*)&mat.mValues);
+        read((float*)&mat.mValues, 9);
         return mat;
     }
 
@@ -145,91 +209,108 @@ public:
     ///Read in a string of the given length
     std::string getSizedString(size_t length)
     {
-        std::string str(length, '\0');
-        inp->read(str.data(), length);
-        if (inp->bad())
-            throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
+        if (mPos == nullptr)
+        {
+            std::string str(length, '\0');
+            inp->read(str.data(), length);
+            if (inp->bad())
+                throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
+            return str;
+        }
+
+        const std::size_t available = std::min(length, static_cast<std::size_t>(mEnd - mPos));
+        std::string str(mPos, available);
+        str.resize(length, '\0');
+        mPos += available;
         return str;
     }
     ///Read in a string of the length specified in the file
     std::string getSizedString()
     {
-        size_t size = readLittleEndianType<uint32_t>(inp);
+        size_t size = read<uint32_t>();
         return getSizedString(size);
     }
 
     ///Specific to Bethesda headers, uses a byte for length
     std::string getExportString()
     {
-        size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>(inp));
+        size_t size = static_cast<size_t>(read<uint8_t>());
         return getSizedString(size);
     }
 
     ///This is special since the version string doesn't start with a number, and ends with "\n"
     std::string getVersionString()
     {
-        std::string result;
-        std::getline(*inp, result);
-        if (inp->bad())
-            throw std::runtime_error("Failed to read version string");
+        if (mPos == nullptr)
+        {
+            std::string result;
+            std::getline(*inp, result);
+            if (inp->bad())
+                throw std::runtime_error("Failed to read version string");
+            return result;
+        }
+
+        const char *end = static_cast<const char*>(std::memchr(mPos, '\n', mEnd - mPos));
+        std::string result(mPos, end != nullptr ? end : mEnd);
+        mPos = end != nullptr ? end + 1 : mEnd;
         return result;
     }
 
     void getChars(std::vector<char> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<char>(inp, vec.data(), size);
+        read(vec.data(), size);
     }
 
     void getUChars(std::vector<unsigned char> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned char>(inp, vec.data(), size);
+        read(vec.data(), size);
     }
 
     void getUShorts(std::vector<unsigned short> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned short>(inp, vec.data(), size);
+        read(vec.data(), size);
     }
 
     void getFloats(std::vector<float> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<float>(inp, vec.data(), size);
+        read(vec.data(), size);
     }
 
     void getInts(std::vector<int> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<int>(inp, vec.data(), size);
+        read(vec.data(), size);
     }
 
     void getUInts(std::vector<unsigned int> &vec, size_t size)
     {
         vec.resize(size);
-        readLittleEndianDynamicBufferOfType<unsigned int>(inp, vec.data(), size);
+        read(vec.data(), size);
     }
 
     void getVector2s(std::vector<osg::Vec2f> &vec, size_t size)
     {
         vec.resize(size);
         /* The packed storage of each Vec2f is 2 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp,(float*)vec.data(), size*2);
+        read((float*)vec.data(), size*2);
     }
 
     void getVector3s(std::vector<osg::Vec3f> &vec, size_t size)
     {
         vec.resize(size);
         /* The packed storage of each Vec3f is 3 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size*3);
+        read((float*)vec.data(), size*3);
     }
 
     void getVector4s(std::vector<osg::Vec4f> &vec, size_t size)
     {
         vec.resize(size);
         /* The packed storage of each Vec4f is 4 floats exactly */
-        readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size*4);
+        read((float*)vec.data(), size*4);
     }
 
     void getQuaternions(std::vector<osg::Quat> &quat, size_t size)
@@ -253,7 +334,9 @@ public:
             vec[i] = getSizedString();
     }
 };
-
+/*
+    End of tes3mp change (major)
+*/
 }
 
 #endif
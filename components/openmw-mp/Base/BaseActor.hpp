@@ -13,6 +13,21 @@ namespace mwmp
     {
     public:
 
+        // The facets of an actor that an ID_ACTOR_FRAME carries, in the order they are handled in
+        enum FRAME_FACET
+        {
+            FACET_POSITION = 1,
+            FACET_ANIM_FLAGS = 2,
+            FACET_ANIM_PLAY = 4,
+            FACET_SPEECH = 8,
+            FACET_DEATH = 16,
+            FACET_STATS_DYNAMIC = 32,
+            FACET_EQUIPMENT = 64,
+            FACET_ATTACK = 128,
+            FACET_CAST = 256,
+            FACET_CELL_CHANGE = 512
+        };
+
         BaseActor()
         {
             hasPositionData = false;
@@ -25,6 +40,10 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        // Whether the position comes with the time it was sent at, which positions set by the
+        // server don't, and that time in milliseconds on the sender's steady clock
+        bool hasPositionTimestamp = false;
+        uint32_t positionTimestamp = 0;
 
         ESM::Cell cell;
 
@@ -57,6 +76,9 @@ namespace mwmp
         bool hasPositionData;
         bool hasStatsDynamicData;
 
+        // The FRAME_FACET values for the facets of this actor that are included in an ID_ACTOR_FRAME
+        uint16_t frameFacets = 0;
+
         Item equipmentItems[19];
         SpellsActiveChanges spellsActiveChanges;
     };
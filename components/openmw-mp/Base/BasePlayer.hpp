@@ -10,6 +10,7 @@
 #include <components/esm/loadspel.hpp>
 
 #include <components/openmw-mp/Base/BaseStructs.hpp>
+#include <components/openmw-mp/Base/RefIdTable.hpp>
 
 #include <RakNetTypes.h>
 
@@ -109,9 +110,20 @@ namespace mwmp
         {
             SET = 0,
             ADD,
-            REMOVE
+            REMOVE,
+            DELTA,
+            REQUEST_SET
         };
-        int action; // 0 - Clear and set in entirety, 1 - Add item, 2 - Remove item
+        int action; // 0 - Clear and set in entirety, 1 - Add item, 2 - Remove item,
+                    // 3 - Add items with positive counts and remove items with negative counts,
+                    // 4 - Ask for the inventory to be set in entirety
+
+        // Sent by the server as the number of inventory packets it has sent to this player,
+        // and sent back by the client as the last one of them it had received when it sent its own
+        unsigned int revision = 0;
+
+        // Only used by DELTA, as the checksum of the inventory the delta has to be applied to
+        uint32_t baseChecksum = 0;
     };
 
     struct SpellbookChanges
@@ -121,9 +133,19 @@ namespace mwmp
         {
             SET = 0,
             ADD,
-            REMOVE
+            REMOVE,
+            DELTA,
+            REQUEST_SET
         };
-        int action; // 0 - Clear and set in entirety, 1 - Add spell, 2 - Remove spell
+        int action; // 0 - Clear and set in entirety, 1 - Add spell, 2 - Remove spell,
+                    // 3 - Add spells and remove removedSpells, 4 - Ask for the spellbook to be set in entirety
+
+        // Only used by DELTA
+        std::vector<ESM::Spell> removedSpells;
+
+        // Same as in InventoryChanges, but counting spellbook packets
+        unsigned int revision = 0;
+        uint32_t baseChecksum = 0;
     };
 
     enum RESURRECT_TYPE
@@ -136,7 +158,8 @@ namespace mwmp
     enum MISCELLANEOUS_CHANGE_TYPE
     {
         MARK_LOCATION = 0,
-        SELECTED_SPELL
+        SELECTED_SPELL,
+        FRAME_TIME
     };
 
     class BasePlayer
@@ -206,6 +229,12 @@ namespace mwmp
 
         bool exchangeFullInfo;
 
+        // Whether refIds in inventory and spellbook packets being sent about this player should be
+        // replaced by IDs from sentRefIds, which is only possible for packets sent to the player themselves
+        bool useRefIdTable = false;
+        RefIdTable sentRefIds;
+        RefIdTable receivedRefIds;
+
         InventoryChanges inventoryChanges;
         SpellbookChanges spellbookChanges;
         SpellsActiveChanges spellsActiveChanges;
@@ -222,6 +251,7 @@ namespace mwmp
         int difficulty = 0;
         int enforcedLogLevel;
         float physicsFramerate = 60.0;
+        bool frameTimeReportsRequested = false;
         bool consoleAllowed = false;
         bool bedRestAllowed = true;
         bool wildernessRestAllowed = true;
@@ -236,6 +266,10 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        // Whether the position comes with the time it was sent at, which positions set by the
+        // server don't, and that time in milliseconds on the sender's steady clock
+        bool hasPositionTimestamp = false;
+        uint32_t positionTimestamp = 0;
         ESM::Position previousCellPosition;
         ESM::Position momentum;
         ESM::Cell cell;
@@ -279,6 +313,7 @@ namespace mwmp
         ESM::Cell markCell;
         ESM::Position markPosition;
         std::string selectedSpellId;
+        float averageFrameTime = 0;
 
         mwmp::Item usedItem;
         bool usingItemMagic;
@@ -0,0 +1,199 @@
+#include "InventorySync.hpp"
+
+#include <algorithm>
+
+#include <components/misc/stringops.hpp>
+
+using namespace mwmp;
+
+namespace
+{
+    uint32_t hashBytes(uint32_t hash, const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char*>(data);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    uint32_t hashId(uint32_t hash, const std::string &id)
+    {
+        for (char c : id)
+        {
+            unsigned char lowerChar = static_cast<unsigned char>(Misc::StringUtils::toLower(c));
+            hash = hashBytes(hash, &lowerChar, 1);
+        }
+
+        // Keep the end of one ID apart from the start of the next
+        return hashBytes(hash, "", 1);
+    }
+
+    const uint32_t hashBasis = 2166136261u;
+}
+
+bool InventorySync::isSameStack(const Item &item, const Item &otherItem)
+{
+    return Misc::StringUtils::ciEqual(item.refId, otherItem.refId) && item.charge == otherItem.charge &&
+        item.enchantmentCharge == otherItem.enchantmentCharge && Misc::StringUtils::ciEqual(item.soul, otherItem.soul);
+}
+
+void InventorySync::addToInventory(std::vector<Item> &inventory, const Item &item, int count)
+{
+    if (count <= 0)
+        return;
+
+    for (auto &&stack : inventory)
+    {
+        if (isSameStack(stack, item))
+        {
+            stack.count += count;
+            return;
+        }
+    }
+
+    inventory.push_back(item);
+    inventory.back().count = count;
+}
+
+bool InventorySync::removeFromInventory(std::vector<Item> &inventory, const Item &item, int count)
+{
+    auto it = std::find_if(inventory.begin(), inventory.end(), [&item](const Item &stack) {
+        return isSameStack(stack, item);
+    });
+
+    if (it == inventory.end())
+    {
+        // Stacks that only differ in their enchantment charge are told apart by the client in a way
+        // that can't be reproduced here
+        auto stackMatches = [&item](const Item &stack) {
+            return Misc::StringUtils::ciEqual(stack.refId, item.refId) && stack.charge == item.charge &&
+                Misc::StringUtils::ciEqual(stack.soul, item.soul);
+        };
+
+        if (std::count_if(inventory.begin(), inventory.end(), stackMatches) > 1)
+            return false;
+
+        it = std::find_if(inventory.begin(), inventory.end(), stackMatches);
+    }
+
+    if (it != inventory.end())
+    {
+        int removedCount = std::min(it->count, count);
+        it->count -= removedCount;
+        count -= removedCount;
+
+        if (it->count == 0)
+            inventory.erase(it);
+    }
+
+    if (count == 0)
+        return true;
+
+    auto refIdMatches = [&item](const Item &stack) {
+        return Misc::StringUtils::ciEqual(stack.refId, item.refId);
+    };
+
+    if (std::count_if(inventory.begin(), inventory.end(), refIdMatches) > 1)
+        return false;
+
+    it = std::find_if(inventory.begin(), inventory.end(), refIdMatches);
+
+    if (it != inventory.end())
+    {
+        it->count -= std::min(it->count, count);
+
+        if (it->count == 0)
+            inventory.erase(it);
+    }
+
+    return true;
+}
+
+std::vector<Item> InventorySync::getInventoryDelta(const std::vector<Item> &oldInventory, const std::vector<Item> &newInventory)
+{
+    std::vector<Item> delta;
+
+    for (auto &&stack : newInventory)
+    {
+        int oldCount = 0;
+
+        for (auto &&oldStack : oldInventory)
+        {
+            if (isSameStack(oldStack, stack))
+            {
+                oldCount = oldStack.count;
+                break;
+            }
+        }
+
+        if (stack.count != oldCount)
+        {
+            delta.push_back(stack);
+            delta.back().count = stack.count - oldCount;
+        }
+    }
+
+    for (auto &&oldStack : oldInventory)
+    {
+        bool isKept = std::any_of(newInventory.begin(), newInventory.end(), [&oldStack](const Item &stack) {
+            return isSameStack(stack, oldStack);
+        });
+
+        if (!isKept)
+        {
+            // Removals go first, so the client doesn't mistake a new stack for the one being removed
+            delta.insert(delta.begin(), oldStack);
+            delta.front().count = -oldStack.count;
+        }
+    }
+
+    return delta;
+}
+
+uint32_t InventorySync::getInventoryChecksum(const std::vector<Item> &inventory)
+{
+    std::vector<Item> stacks;
+
+    for (auto &&item : inventory)
+        addToInventory(stacks, item, item.count);
+
+    // Adding up the hashes of the stacks leaves their order out of it
+    uint32_t checksum = 0;
+
+    for (auto &&stack : stacks)
+    {
+        uint32_t hash = hashId(hashBasis, stack.refId);
+        hash = hashBytes(hash, &stack.count, sizeof(stack.count));
+        hash = hashBytes(hash, &stack.charge, sizeof(stack.charge));
+        hash = hashBytes(hash, &stack.enchantmentCharge, sizeof(stack.enchantmentCharge));
+        hash = hashId(hash, stack.soul);
+        checksum += hash;
+    }
+
+    return checksum;
+}
+
+uint32_t InventorySync::getSpellbookChecksum(const std::vector<std::string> &spellIds)
+{
+    std::vector<std::string> uniqueIds;
+
+    for (auto &&spellId : spellIds)
+    {
+        std::string lowerId = Misc::StringUtils::lowerCase(spellId);
+
+        if (std::find(uniqueIds.begin(), uniqueIds.end(), lowerId) == uniqueIds.end())
+            uniqueIds.push_back(lowerId);
+    }
+
+    uint32_t checksum = 0;
+
+    for (auto &&spellId : uniqueIds)
+        checksum += hashId(hashBasis, spellId);
+
+    return checksum;
+}
@@ -0,0 +1,43 @@
+#ifndef OPENMW_INVENTORYSYNC_HPP
+#define OPENMW_INVENTORYSYNC_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <components/openmw-mp/Base/BaseStructs.hpp>
+
+namespace mwmp
+{
+    /*
+        Keeps track of inventories and spellbooks the same way on the server and the client, so
+        the server can send a player the difference between what they have and what a script set
+        instead of all of it, and the player can check that the difference applies to what they
+        have before applying it
+    */
+    namespace InventorySync
+    {
+        // Do two items go into the same stack, regardless of their counts?
+        bool isSameStack(const Item &item, const Item &otherItem);
+
+        void addToInventory(std::vector<Item> &inventory, const Item &item, int count);
+
+        // Mirrors the way the client removes items, which is from the stack closest to the item if there is one
+        // and by refId otherwise, returning false if it can't be known which stacks the client took them from
+        bool removeFromInventory(std::vector<Item> &inventory, const Item &item, int count);
+
+        // Get the additions, as positive counts, and removals, as negative counts, that turn one inventory into
+        // another, with the removals first
+        std::vector<Item> getInventoryDelta(const std::vector<Item> &oldInventory, const std::vector<Item> &newInventory);
+
+        // Get a checksum of the stacks in an inventory that doesn't depend on their order, on the case of their
+        // refIds or on whether equal stacks are kept apart
+        uint32_t getInventoryChecksum(const std::vector<Item> &inventory);
+
+        // Get a checksum of the spell IDs in a spellbook that doesn't depend on their order, their case or on
+        // duplicates
+        uint32_t getSpellbookChecksum(const std::vector<std::string> &spellIds);
+    }
+}
+
+#endif //OPENMW_INVENTORYSYNC_HPP
@@ -0,0 +1,70 @@
+#ifndef OPENMW_REFIDTABLE_HPP
+#define OPENMW_REFIDTABLE_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mwmp
+{
+    /*
+        Maps the refIds exchanged with one connection to numeric IDs handed out in the order the
+        refIds were first sent, so each refId only needs to be sent as a string once per session
+
+        Because packets using the table are reliable and ordered, both ends assign the same IDs
+        as long as each side only adds refIds to its table while writing or reading such a packet
+    */
+    class RefIdTable
+    {
+    public:
+        // Get the ID for a refId, assigning the next one if this is the first time it's used
+        uint32_t getId(const std::string &refId, bool &isNew)
+        {
+            auto it = ids.find(refId);
+
+            if (it != ids.end())
+            {
+                isNew = false;
+                return it->second;
+            }
+
+            uint32_t id = static_cast<uint32_t>(refIds.size());
+            ids[refId] = id;
+            refIds.push_back(refId);
+            isNew = true;
+            return id;
+        }
+
+        bool getRefId(uint32_t id, std::string &refId) const
+        {
+            if (id >= refIds.size())
+                return false;
+
+            refId = refIds[id];
+            return true;
+        }
+
+        // The ID the next new refId will get, which is how a reader can tell a new refId apart
+        uint32_t getNextId() const
+        {
+            return static_cast<uint32_t>(refIds.size());
+        }
+
+        bool isEmpty() const
+        {
+            return refIds.empty();
+        }
+
+        void clear()
+        {
+            ids.clear();
+            refIds.clear();
+        }
+
+    private:
+        std::unordered_map<std::string, uint32_t> ids;
+        std::vector<std::string> refIds;
+    };
+}
+
+#endif //OPENMW_REFIDTABLE_HPP
@@ -13,6 +13,7 @@
 #include "../Packets/Actor/PacketActorSpeech.hpp"
 #include "../Packets/Actor/PacketActorSpellsActive.hpp"
 #include "../Packets/Actor/PacketActorStatsDynamic.hpp"
+#include "../Packets/Actor/PacketActorFrame.hpp"
 
 
 #include "ActorPacketController.hpp"
@@ -42,6 +43,7 @@ mwmp::ActorPacketController::ActorPacketController(RakNet::RakPeerInterface *pee
     AddPacket<PacketActorSpeech>(&packets, peer);
     AddPacket<PacketActorSpellsActive>(&packets, peer);
     AddPacket<PacketActorStatsDynamic>(&packets, peer);
+    AddPacket<PacketActorFrame>(&packets, peer);
 }
 
 
@@ -56,6 +58,12 @@ void mwmp::ActorPacketController::SetStream(RakNet::BitStream *inStream, RakNet:
         packet.second->SetStreams(inStream, outStream);
 }
 
+void mwmp::ActorPacketController::SetScheduler(PacketScheduler *scheduler)
+{
+    for(const auto &packet : packets)
+        packet.second->SetScheduler(scheduler);
+}
+
 bool mwmp::ActorPacketController::ContainsPacket(RakNet::MessageID id)
 {
     for(const auto &packet : packets)
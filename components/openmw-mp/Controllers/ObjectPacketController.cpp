@@ -79,6 +79,12 @@ void mwmp::ObjectPacketController::SetStream(RakNet::BitStream *inStream, RakNet
         packet.second->SetStreams(inStream, outStream);
 }
 
+void mwmp::ObjectPacketController::SetScheduler(PacketScheduler *scheduler)
+{
+    for(const auto &packet : packets)
+        packet.second->SetScheduler(scheduler);
+}
+
 bool mwmp::ObjectPacketController::ContainsPacket(RakNet::MessageID id)
 {
     for(const auto &packet : packets)
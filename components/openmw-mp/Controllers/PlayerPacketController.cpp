@@ -110,6 +110,12 @@ void mwmp::PlayerPacketController::SetStream(RakNet::BitStream *inStream, RakNet
         packet.second->SetStreams(inStream, outStream);
 }
 
+void mwmp::PlayerPacketController::SetScheduler(PacketScheduler *scheduler)
+{
+    for(const auto &packet : packets)
+        packet.second->SetScheduler(scheduler);
+}
+
 bool mwmp::PlayerPacketController::ContainsPacket(RakNet::MessageID id)
 {
     for(const auto &packet : packets)
@@ -27,6 +27,12 @@ void mwmp::SystemPacketController::SetStream(RakNet::BitStream *inStream, RakNet
         packet.second->SetStreams(inStream, outStream);
 }
 
+void mwmp::SystemPacketController::SetScheduler(PacketScheduler *scheduler)
+{
+    for(const auto &packet : packets)
+        packet.second->SetScheduler(scheduler);
+}
+
 bool mwmp::SystemPacketController::ContainsPacket(RakNet::MessageID id)
 {
     for(const auto &packet : packets)
@@ -4,6 +4,7 @@
 
 #include <RakPeerInterface.h>
 #include "../Packets/System/SystemPacket.hpp"
+#include "../Packets/PacketScheduler.hpp"
 #include <unordered_map>
 #include <memory>
 
@@ -15,6 +16,7 @@ namespace mwmp
         SystemPacketController(RakNet::RakPeerInterface *peer);
         SystemPacket *GetPacket(RakNet::MessageID id);
         void SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+        void SetScheduler(PacketScheduler *scheduler);
 
         bool ContainsPacket(RakNet::MessageID id);
 
@@ -47,6 +47,12 @@ void mwmp::WorldstatePacketController::SetStream(RakNet::BitStream *inStream, Ra
         packet.second->SetStreams(inStream, outStream);
 }
 
+void mwmp::WorldstatePacketController::SetScheduler(PacketScheduler *scheduler)
+{
+    for(const auto &packet : packets)
+        packet.second->SetScheduler(scheduler);
+}
+
 bool mwmp::WorldstatePacketController::ContainsPacket(RakNet::MessageID id)
 {
     for(const auto &packet : packets)
@@ -4,6 +4,7 @@
 
 #include <RakPeerInterface.h>
 #include "../Packets/Worldstate/WorldstatePacket.hpp"
+#include "../Packets/PacketScheduler.hpp"
 #include <unordered_map>
 #include <memory>
 
@@ -15,6 +16,7 @@ namespace mwmp
         WorldstatePacketController(RakNet::RakPeerInterface *peer);
         WorldstatePacket *GetPacket(RakNet::MessageID id);
         void SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+        void SetScheduler(PacketScheduler *scheduler);
 
         bool ContainsPacket(RakNet::MessageID id);
 
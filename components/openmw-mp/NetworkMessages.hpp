@@ -112,6 +112,7 @@ enum GameMessages
     ID_PLAYER_ALLY,
     ID_WORLD_DESTINATION_OVERRIDE,
     ID_ACTOR_SPELLS_ACTIVE,
+    ID_ACTOR_FRAME,
     ID_PLACEHOLDER
 };
 
@@ -25,6 +25,11 @@ void ActorPacket::setActorList(BaseActorList *newActorList)
     guid = actorList->guid;
 }
 
+BaseActorList *ActorPacket::getActorList()
+{
+    return actorList;
+}
+
 void ActorPacket::Packet(RakNet::BitStream *newBitstream, bool send)
 {
     if (!PacketHeader(newBitstream, send))
@@ -75,3 +80,9 @@ void ActorPacket::Actor(BaseActor &actor, bool send)
 {
 
 }
+
+void ActorPacket::FacetActor(ActorPacket &facetPacket, BaseActor &actor, bool send)
+{
+    facetPacket.bs = bs;
+    facetPacket.Actor(actor, send);
+}
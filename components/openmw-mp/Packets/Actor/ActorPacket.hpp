@@ -20,11 +20,14 @@ namespace mwmp
         ~ActorPacket();
 
         void setActorList(BaseActorList *newActorList);
+        BaseActorList *getActorList();
 
         virtual void Packet(RakNet::BitStream *newBitstream, bool send);
     protected:
         bool PacketHeader(RakNet::BitStream *newBitstream, bool send);
         virtual void Actor(BaseActor &actor, bool send);
+        // Read or write an actor's fields the way another actor packet does, inside this packet's stream
+        void FacetActor(ActorPacket &facetPacket, BaseActor &actor, bool send);
         BaseActorList *actorList;
         static const int maxActors = 3000;
     };
@@ -0,0 +1,49 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/TimedLog.hpp>
+#include "PacketActorAnimFlags.hpp"
+#include "PacketActorAnimPlay.hpp"
+#include "PacketActorAttack.hpp"
+#include "PacketActorCast.hpp"
+#include "PacketActorCellChange.hpp"
+#include "PacketActorDeath.hpp"
+#include "PacketActorEquipment.hpp"
+#include "PacketActorPosition.hpp"
+#include "PacketActorSpeech.hpp"
+#include "PacketActorStatsDynamic.hpp"
+#include "PacketActorFrame.hpp"
+
+using namespace mwmp;
+
+template <typename T>
+inline void AddFacetPacket(std::vector<std::pair<uint16_t, std::unique_ptr<ActorPacket>>> &facetPackets,
+                           uint16_t facet, RakNet::RakPeerInterface *peer)
+{
+    facetPackets.emplace_back(facet, std::unique_ptr<ActorPacket>(new T(peer)));
+}
+
+PacketActorFrame::PacketActorFrame(RakNet::RakPeerInterface *peer) : ActorPacket(peer)
+{
+    packetID = ID_ACTOR_FRAME;
+
+    AddFacetPacket<PacketActorPosition>(facetPackets, BaseActor::FACET_POSITION, peer);
+    AddFacetPacket<PacketActorAnimFlags>(facetPackets, BaseActor::FACET_ANIM_FLAGS, peer);
+    AddFacetPacket<PacketActorAnimPlay>(facetPackets, BaseActor::FACET_ANIM_PLAY, peer);
+    AddFacetPacket<PacketActorSpeech>(facetPackets, BaseActor::FACET_SPEECH, peer);
+    AddFacetPacket<PacketActorDeath>(facetPackets, BaseActor::FACET_DEATH, peer);
+    AddFacetPacket<PacketActorStatsDynamic>(facetPackets, BaseActor::FACET_STATS_DYNAMIC, peer);
+    AddFacetPacket<PacketActorEquipment>(facetPackets, BaseActor::FACET_EQUIPMENT, peer);
+    AddFacetPacket<PacketActorAttack>(facetPackets, BaseActor::FACET_ATTACK, peer);
+    AddFacetPacket<PacketActorCast>(facetPackets, BaseActor::FACET_CAST, peer);
+    AddFacetPacket<PacketActorCellChange>(facetPackets, BaseActor::FACET_CELL_CHANGE, peer);
+}
+
+void PacketActorFrame::Actor(BaseActor &actor, bool send)
+{
+    RW(actor.frameFacets, send);
+
+    for (auto &&facetPacket : facetPackets)
+    {
+        if (actor.frameFacets & facetPacket.first)
+            FacetActor(*facetPacket.second, actor, send);
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef OPENMW_PACKETACTORFRAME_HPP
+#define OPENMW_PACKETACTORFRAME_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
+
+namespace mwmp
+{
+    /*
+        Carries every facet that changed for the actors of a cell during one update, with each
+        actor's frameFacets telling which of them follow its refNum and mpNum
+
+        Each facet is written the same way as in the packet that carries it on its own
+    */
+    class PacketActorFrame : public ActorPacket
+    {
+    public:
+        PacketActorFrame(RakNet::RakPeerInterface *peer);
+
+        virtual void Actor(BaseActor &actor, bool send);
+
+    private:
+        std::vector<std::pair<uint16_t, std::unique_ptr<ActorPacket>>> facetPackets;
+    };
+}
+
+#endif //OPENMW_PACKETACTORFRAME_HPP
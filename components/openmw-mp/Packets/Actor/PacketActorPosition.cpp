@@ -13,6 +13,10 @@ void PacketActorPosition::Actor(BaseActor &actor, bool send)
 {
     RW(actor.position, send, true);
     RW(actor.direction, send, true);
+    RW(actor.hasPositionTimestamp, send);
+
+    if (actor.hasPositionTimestamp)
+        RW(actor.positionTimestamp, send);
 
     actor.hasPositionData = true;
 }
@@ -2,6 +2,7 @@
 #include <PacketPriority.h>
 #include <RakPeer.h>
 #include "BasePacket.hpp"
+#include "PacketScheduler.hpp"
 
 using namespace mwmp;
 
@@ -12,6 +13,7 @@ BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
     reliability = RELIABLE_ORDERED;
     orderChannel = CHANNEL_SYSTEM;
     this->peer = peer;
+    scheduler = nullptr;
 }
 
 void BasePacket::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -44,6 +46,11 @@ void BasePacket::SetStreams(RakNet::BitStream *inStream, RakNet::BitStream *outS
         bsSend = outStream;
 }
 
+void BasePacket::SetScheduler(PacketScheduler *newScheduler)
+{
+    scheduler = newScheduler;
+}
+
 uint32_t BasePacket::RequestData(RakNet::RakNetGUID targetGuid)
 {
     bsSend->ResetWritePointer();
@@ -56,6 +63,10 @@ uint32_t BasePacket::Send(RakNet::AddressOrGUID destination)
 {
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
+
+    if (scheduler != nullptr)
+        return scheduler->Send(this, bsSend, priority, reliability, orderChannel, destination, false);
+
     return peer->Send(bsSend, priority, reliability, orderChannel, destination, false);
 }
 
@@ -63,6 +74,10 @@ uint32_t BasePacket::Send(bool toOther)
 {
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
+
+    if (scheduler != nullptr)
+        return scheduler->Send(this, bsSend, priority, reliability, orderChannel, guid, toOther);
+
     return peer->Send(bsSend, priority, reliability, orderChannel, guid, toOther);
 }
 
@@ -9,6 +9,8 @@
 
 namespace mwmp
 {
+    class PacketScheduler;
+
     class BasePacket
     {
     public:
@@ -27,6 +29,7 @@ namespace mwmp
         void SetReadStream(RakNet::BitStream *bitStream);
         void SetSendStream(RakNet::BitStream *bitStream);
         void SetStreams(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+        void SetScheduler(PacketScheduler *newScheduler);
         virtual uint32_t RequestData(RakNet::RakNetGUID targetGuid);
 
         static inline uint32_t headerSize()
@@ -126,6 +129,7 @@ namespace mwmp
         int8_t orderChannel;
         RakNet::BitStream *bsRead, *bsSend, *bs;
         RakNet::RakPeerInterface *peer;
+        PacketScheduler *scheduler;
         RakNet::RakNetGUID guid;
         bool packetValid;
     };
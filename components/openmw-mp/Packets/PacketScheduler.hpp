@@ -0,0 +1,28 @@
+#ifndef OPENMW_PACKETSCHEDULER_HPP
+#define OPENMW_PACKETSCHEDULER_HPP
+
+#include <RakNetTypes.h>
+#include <BitStream.h>
+#include <PacketPriority.h>
+
+namespace mwmp
+{
+    class BasePacket;
+
+    /*
+        Packets that have a scheduler set hand their serialized data over to it instead of
+        sending it through the RakPeer themselves, allowing the scheduler to delay, reorder
+        or coalesce them
+    */
+    class PacketScheduler
+    {
+    public:
+        virtual ~PacketScheduler() = default;
+
+        virtual uint32_t Send(BasePacket *packet, RakNet::BitStream *bitStream, PacketPriority priority,
+                              PacketReliability reliability, char orderChannel, RakNet::AddressOrGUID destination,
+                              bool broadcast) = 0;
+    };
+}
+
+#endif //OPENMW_PACKETSCHEDULER_HPP
@@ -20,6 +20,7 @@ void PacketGameSettings::Packet(RakNet::BitStream *newBitstream, bool send)
     RW(player->waitAllowed, send);
     RW(player->enforcedLogLevel, send);
     RW(player->physicsFramerate, send);
+    RW(player->frameTimeReportsRequested, send);
 
     uint32_t gameSettingCount = static_cast<uint32_t>(player->gameSettings.size());
     RW(gameSettingCount, send);
@@ -13,6 +13,17 @@ void PacketPlayerInventory::Packet(RakNet::BitStream *newBitstream, bool send)
     PlayerPacket::Packet(newBitstream, send);
 
     RW(player->inventoryChanges.action, send);
+    RW(player->inventoryChanges.revision, send, true);
+
+    if (player->inventoryChanges.action == InventoryChanges::DELTA)
+        RW(player->inventoryChanges.baseChecksum, send);
+
+    bool useRefIdTable;
+
+    if (send)
+        useRefIdTable = player->useRefIdTable;
+
+    RW(useRefIdTable, send);
 
     uint32_t count;
 
@@ -29,10 +40,10 @@ void PacketPlayerInventory::Packet(RakNet::BitStream *newBitstream, bool send)
 
     for (auto &&item : player->inventoryChanges.items)
     {
-        RW(item.refId, send, true);
+        RWRefId(item.refId, useRefIdTable, send);
         RW(item.count, send);
         RW(item.charge, send);
         RW(item.enchantmentCharge, send);
-        RW(item.soul, send, true);
+        RWRefId(item.soul, useRefIdTable, send);
     }
 }
@@ -25,4 +25,6 @@ void PacketPlayerMiscellaneous::Packet(RakNet::BitStream *newBitstream, bool sen
     }
     else if (player->miscellaneousChangeType == mwmp::MISCELLANEOUS_CHANGE_TYPE::SELECTED_SPELL)
         RW(player->selectedSpellId, send, true);
+    else if (player->miscellaneousChangeType == mwmp::MISCELLANEOUS_CHANGE_TYPE::FRAME_TIME)
+        RW(player->averageFrameTime, send);
 }
@@ -16,4 +16,8 @@ void PacketPlayerPosition::Packet(RakNet::BitStream *newBitstream, bool send)
 
     RW(player->position, send, 1);
     RW(player->direction, send, 1);
+    RW(player->hasPositionTimestamp, send);
+
+    if (player->hasPositionTimestamp)
+        RW(player->positionTimestamp, send);
 }
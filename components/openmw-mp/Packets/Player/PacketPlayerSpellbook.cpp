@@ -13,6 +13,17 @@ void PacketPlayerSpellbook::Packet(RakNet::BitStream *newBitstream, bool send)
     PlayerPacket::Packet(newBitstream, send);
 
     RW(player->spellbookChanges.action, send);
+    RW(player->spellbookChanges.revision, send, true);
+
+    if (player->spellbookChanges.action == SpellbookChanges::DELTA)
+        RW(player->spellbookChanges.baseChecksum, send);
+
+    bool useRefIdTable;
+
+    if (send)
+        useRefIdTable = player->useRefIdTable;
+
+    RW(useRefIdTable, send);
 
     uint32_t count;
 
@@ -29,6 +40,25 @@ void PacketPlayerSpellbook::Packet(RakNet::BitStream *newBitstream, bool send)
 
     for (auto &&spell : player->spellbookChanges.spells)
     {
-        RW(spell.mId, send, true);
+        RWRefId(spell.mId, useRefIdTable, send);
+    }
+
+    if (player->spellbookChanges.action != SpellbookChanges::DELTA)
+        return;
+
+    if (send)
+        count = static_cast<uint32_t>(player->spellbookChanges.removedSpells.size());
+
+    RW(count, send);
+
+    if (!send)
+    {
+        player->spellbookChanges.removedSpells.clear();
+        player->spellbookChanges.removedSpells.resize(count);
+    }
+
+    for (auto &&spell : player->spellbookChanges.removedSpells)
+    {
+        RWRefId(spell.mId, useRefIdTable, send);
     }
 }
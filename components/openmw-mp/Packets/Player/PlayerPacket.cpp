@@ -29,3 +29,33 @@ BasePlayer *PlayerPacket::getPlayer()
 {
     return player;
 }
+
+void PlayerPacket::RWRefId(std::string &refId, bool useRefIdTable, bool send)
+{
+    if (!useRefIdTable)
+    {
+        RW(refId, send, true);
+        return;
+    }
+
+    uint32_t id;
+    bool isNew;
+
+    if (send)
+        id = player->sentRefIds.getId(refId, isNew);
+
+    RW(id, send, true);
+
+    if (send)
+    {
+        if (isNew)
+            RW(refId, send, true);
+    }
+    else if (id == player->receivedRefIds.getNextId())
+    {
+        RW(refId, send, true);
+        player->receivedRefIds.getId(refId, isNew);
+    }
+    else if (!player->receivedRefIds.getRefId(id, refId))
+        packetValid = false;
+}
@@ -22,6 +22,10 @@ namespace mwmp
         BasePlayer *getPlayer();
 
     protected:
+        // Read or write a refId either as a string or as an ID from the player's refId tables,
+        // with the string itself following the ID the first time it is used
+        void RWRefId(std::string &refId, bool useRefIdTable, bool send);
+
         BasePlayer *player;
 
     };
@@ -5,16 +5,75 @@
 #include <cstdio>
 #include <sstream>
 #include <vector>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <boost/lexical_cast.hpp>
 #include "TimedLog.hpp"
 
+/*
+    The asynchronous backend is a bounded multi-producer queue based on per-slot sequence numbers,
+    so threads that log never take a lock. Only the message itself is formatted on the calling
+    thread, directly into a preallocated slot; the timestamp, location and level prefix are
+    formatted later by whoever drains the queue
+*/
+struct TimedLog::AsyncBackend
+{
+    static const size_t messageCapacity = 512;
+
+    struct Entry
+    {
+        std::atomic<size_t> sequence;
+        int level;
+        bool hasPrefix;
+        const char *file;
+        int line;
+        time_t time;
+        char text[messageCapacity];
+        // Holds messages that don't fit into text, and is freed once they have been written out
+        char *longText;
+    };
+
+    AsyncBackend(unsigned int capacity, OverflowPolicy policy);
+    ~AsyncBackend();
+
+    void push(int level, bool hasPrefix, const char *file, int line, const char *message, va_list args);
+    // Must be called with consumerMutex held
+    bool drain();
+    void run();
+
+    std::vector<Entry> entries;
+    size_t mask;
+    OverflowPolicy policy;
+
+    std::atomic<size_t> enqueuePos;
+    size_t dequeuePos;
+
+    std::atomic<unsigned long long> droppedCount;
+    unsigned long long reportedDroppedCount;
+
+    std::mutex consumerMutex;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> running;
+    std::thread flusher;
+};
+
 TimedLog *TimedLog::sTimedLog = nullptr;
 
-TimedLog::TimedLog(int logLevel) : logLevel(logLevel)
+TimedLog::TimedLog(int logLevel) : logLevel(logLevel), asyncBackend(nullptr)
 {
 
 }
 
+TimedLog::~TimedLog()
+{
+    delete asyncBackend;
+}
+
 void TimedLog::Create(int logLevel)
 {
     if (sTimedLog != nullptr)
@@ -45,64 +104,250 @@ void TimedLog::SetLevel(int level)
     sTimedLog->logLevel = level;
 }
 
-const char* getTime()
+void TimedLog::EnableAsync(unsigned int capacity, OverflowPolicy policy)
 {
-    time_t t = time(0);
-    struct tm *tm = localtime(&t);
-    static char result[20];
-    sprintf(result, "%.4d-%.2d-%.2d %.2d:%.2d:%.2d",
-            1900 + tm->tm_year, tm->tm_mon + 1, tm->tm_mday,
-            tm->tm_hour, tm->tm_min, tm->tm_sec);
-    return result;
+    if (sTimedLog == nullptr || sTimedLog->asyncBackend != nullptr)
+        return;
+    sTimedLog->asyncBackend = new AsyncBackend(capacity, policy);
 }
 
-void TimedLog::print(int level, bool hasPrefix, const char *file, int line, const char *message, ...) const
+unsigned long long TimedLog::GetDroppedCount()
 {
-    if (level < logLevel) return;
-    std::stringstream sstr;
+    if (sTimedLog == nullptr || sTimedLog->asyncBackend == nullptr)
+        return 0;
+    return sTimedLog->asyncBackend->droppedCount.load(std::memory_order_relaxed);
+}
+
+// Messages can be printed from several threads when there is no asynchronous backend to order them
+static std::mutex syncWriteMutex;
 
+void getTime(time_t t, char *result, size_t size)
+{
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &t);
+#else
+    localtime_r(&t, &tm);
+#endif
+    snprintf(result, size, "%.4d-%.2d-%.2d %.2d:%.2d:%.2d",
+             1900 + tm.tm_year, tm.tm_mon + 1, tm.tm_mday,
+             tm.tm_hour, tm.tm_min, tm.tm_sec);
+}
+
+void writeEntry(std::ostream &stream, int level, bool hasPrefix, const char *file, int line, time_t time, const char *text)
+{
     if (hasPrefix)
     {
-
-        sstr << "[" << getTime() << "] ";
+        char timeText[32];
+        getTime(time, timeText, sizeof(timeText));
+        stream << "[" << timeText << "] ";
 
         if (file != 0 && line != 0)
         {
-            sstr << "[" << file << ":";
-            sstr << line << "] ";
+            stream << "[" << file << ":";
+            stream << line << "] ";
         }
 
-        sstr << "[";
+        stream << "[";
         switch (level)
         {
-        case LOG_WARN:
-            sstr << "WARN";
+        case TimedLog::LOG_WARN:
+            stream << "WARN";
             break;
-        case LOG_ERROR:
-            sstr << "ERR";
+        case TimedLog::LOG_ERROR:
+            stream << "ERR";
             break;
-        case LOG_FATAL:
-            sstr << "FATAL";
+        case TimedLog::LOG_FATAL:
+            stream << "FATAL";
             break;
         default:
-            sstr << "INFO";
+            stream << "INFO";
+        }
+        stream << "]: ";
+    }
+
+    size_t length = strlen(text);
+    stream.write(text, length);
+    if (length == 0 || text[length - 1] != '\n')
+        stream << '\n';
+}
+
+TimedLog::AsyncBackend::AsyncBackend(unsigned int capacity, OverflowPolicy policy) : policy(policy), enqueuePos(0),
+    dequeuePos(0), droppedCount(0), reportedDroppedCount(0), running(true)
+{
+    size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    entries = std::vector<Entry>(size);
+    mask = size - 1;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        entries[i].sequence.store(i, std::memory_order_relaxed);
+        entries[i].longText = nullptr;
+    }
+
+    flusher = std::thread(&AsyncBackend::run, this);
+}
+
+TimedLog::AsyncBackend::~AsyncBackend()
+{
+    running.store(false);
+    wakeCondition.notify_one();
+    flusher.join();
+
+    std::lock_guard<std::mutex> lock(consumerMutex);
+    drain();
+}
+
+void TimedLog::AsyncBackend::push(int level, bool hasPrefix, const char *file, int line, const char *message, va_list args)
+{
+    Entry *entry;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        entry = &entries[pos & mask];
+        size_t sequence = entry->sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) pos;
+
+        if (difference == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (difference < 0)
+        {
+            // The ring buffer is full
+            if (policy == OVERFLOW_DROP)
+            {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            wakeCondition.notify_one();
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
         }
-        sstr << "]: ";
+        else
+            pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    entry->level = level;
+    entry->hasPrefix = hasPrefix;
+    entry->file = file;
+    entry->line = line;
+    entry->time = time(0);
+
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int length = vsnprintf(entry->text, messageCapacity, message, args);
+
+    if (length >= (int) messageCapacity)
+    {
+        entry->longText = new char[length + 1];
+        vsnprintf(entry->longText, (size_t) length + 1, message, argsCopy);
+    }
+    va_end(argsCopy);
+
+    entry->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool TimedLog::AsyncBackend::drain()
+{
+    bool hasWritten = false;
+
+    while (true)
+    {
+        Entry &entry = entries[dequeuePos & mask];
+
+        if (entry.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+            break;
+
+        if (entry.longText != nullptr)
+        {
+            writeEntry(std::cout, entry.level, entry.hasPrefix, entry.file, entry.line, entry.time, entry.longText);
+            delete[] entry.longText;
+            entry.longText = nullptr;
+        }
+        else
+            writeEntry(std::cout, entry.level, entry.hasPrefix, entry.file, entry.line, entry.time, entry.text);
+
+        entry.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        hasWritten = true;
+    }
+
+    unsigned long long currentDroppedCount = droppedCount.load(std::memory_order_relaxed);
+
+    if (currentDroppedCount != reportedDroppedCount)
+    {
+        std::stringstream sstr;
+        sstr << (currentDroppedCount - reportedDroppedCount) << " log messages were dropped because the log buffer was full";
+        writeEntry(std::cout, LOG_WARN, true, 0, 0, time(0), sstr.str().c_str());
+        reportedDroppedCount = currentDroppedCount;
+        hasWritten = true;
+    }
+
+    if (hasWritten)
+        std::cout << std::flush;
 
+    return hasWritten;
+}
+
+void TimedLog::AsyncBackend::run()
+{
+    while (running.load())
+    {
+        bool hasWritten;
+        {
+            std::lock_guard<std::mutex> lock(consumerMutex);
+            hasWritten = drain();
+        }
+
+        if (!hasWritten)
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(10));
+        }
     }
+}
+
+void TimedLog::print(int level, bool hasPrefix, const char *file, int line, const char *message, ...) const
+{
+    if (level < logLevel) return;
 
-    sstr << message;
-    char back = *sstr.str().rbegin();
-    if (back != '\n')
-        sstr << '\n';
     va_list args;
+
+    if (asyncBackend != nullptr && level < LOG_ERROR)
+    {
+        va_start(args, message);
+        asyncBackend->push(level, hasPrefix, file, line, message, args);
+        va_end(args);
+        return;
+    }
+
     va_start(args, message);
-    std::vector<char> buf((unsigned long) (vsnprintf(nullptr, 0, sstr.str().c_str(), args) + 1));
+    std::vector<char> buf((unsigned long) (vsnprintf(nullptr, 0, message, args) + 1));
     va_end(args);
     va_start(args, message);
-    vsnprintf(buf.data(), buf.size(), sstr.str().c_str(), args);
+    vsnprintf(buf.data(), buf.size(), message, args);
     va_end(args);
-    std::cout << buf.data() << std::flush;
+
+    if (asyncBackend != nullptr)
+    {
+        // Keep the order of messages intact by writing out everything queued before this one
+        std::lock_guard<std::mutex> lock(asyncBackend->consumerMutex);
+        asyncBackend->drain();
+        writeEntry(std::cout, level, hasPrefix, file, line, time(0), buf.data());
+        std::cout << std::flush;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(syncWriteMutex);
+    writeEntry(std::cout, level, hasPrefix, file, line, time(0), buf.data());
+    std::cout << std::flush;
 }
 
 std::string TimedLog::getFilenameTimestamp()
@@ -37,22 +37,44 @@ public:
         LOG_ERROR,
         LOG_FATAL
     };
+
+    enum OverflowPolicy
+    {
+        OVERFLOW_DROP = 0,
+        OVERFLOW_BLOCK
+    };
+
     static void Create(int logLevel);
     static void Delete();
     static const TimedLog &Get();
     static int GetLevel();
     static void SetLevel(int level);
+
+    /**
+     * Switch to asynchronous logging, where messages are placed in a lock-free ring buffer of
+     * the given capacity (rounded up to a power of two) and written out by a background thread.
+     *
+     * Messages of LOG_ERROR and above are still written synchronously, after everything queued
+     * before them, so that they are not lost if the process goes down right afterwards.
+     */
+    static void EnableAsync(unsigned int capacity, OverflowPolicy policy);
+    static unsigned long long GetDroppedCount();
+
     void print(int level, bool hasPrefix, const char *file, int line, const char *message, ...) const;
 
     static std::string getFilenameTimestamp();
 private:
+    struct AsyncBackend;
+
     TimedLog(int logLevel);
+    ~TimedLog();
     /// Not implemented
     TimedLog(const TimedLog &) = delete;
     /// Not implemented
     TimedLog &operator=(TimedLog &) = delete;
     static TimedLog *sTimedLog;
     int logLevel;
+    AsyncBackend *asyncBackend;
 };
 
 
@@ -1,5 +1,6 @@
 #include "Utils.hpp"
 
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
@@ -58,6 +59,12 @@ void Utils::timestamp()
     printf("%s", t);
 }
 
+uint32_t Utils::getSteadyMilliseconds()
+{
+    auto duration = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+}
+
 // Based on http://stackoverflow.com/questions/1637587/c-libcurl-console-progress-bar
 int Utils::progressFunc(double TotalToDownload, double NowDownloaded)
 {
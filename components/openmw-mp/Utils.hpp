@@ -2,6 +2,7 @@
 #define UTILS_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -21,6 +22,9 @@ namespace Utils
 
     void timestamp();
 
+    // Milliseconds on a steady clock, for timestamps that only get compared with each other
+    uint32_t getSteadyMilliseconds();
+
     int progressFunc(double TotalToDownload, double NowDownloaded);
 
     unsigned int getNumberOfDigits(int integer);
@@ -2,7 +2,7 @@
 #define OPENMW_VERSION_HPP
 
 #define TES3MP_VERSION "0.7.1"
-#define TES3MP_PROTO_VERSION 8
+#define TES3MP_PROTO_VERSION 15
 
 #define TES3MP_DEFAULT_PASSW "SuperPassword"
 #define TES3MP_MASTERSERVER_PASSW "12345"
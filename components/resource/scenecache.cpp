@@ -0,0 +1,485 @@
+#include "scenecache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <osg/Drawable>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+#include <osg/Version>
+
+#include <osgDB/InputStream>
+#include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
+#include <osgDB/Registry>
+#include <osgDB/Serializer>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/binarycache.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/misc/resourcehelpers.hpp>
+#include <components/nifosg/matrixtransform.hpp>
+#include <components/nifosg/nifloader.hpp>
+
+namespace
+{
+    const char sMagic[] = "OMWSCENECACHE";
+
+    // Increase when the way graphs are converted from NIF files, or the layout of cache files, changes
+    const uint32_t sFormatVersion = 2;
+
+    using Files::readValue;
+    using Files::writeValue;
+
+    uint32_t checksum(std::istream& stream)
+    {
+        boost::crc_32_type crc;
+        char buffer[64 * 1024];
+
+        while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+            crc.process_bytes(buffer, static_cast<std::size_t>(stream.gcount()));
+
+        return crc.checksum();
+    }
+
+    /// Everything besides the source file a converted graph depends on
+    std::string getSettingsKey()
+    {
+        std::ostringstream key;
+        key << osgGetVersion() << ' ' << NifOsg::Loader::getShowMarkers() << ' ' << NifOsg::Loader::getHiddenNodeMask()
+            << ' ' << NifOsg::Loader::getIntersectionDisabledNodeMask();
+        return key.str();
+    }
+
+    /// Texture names mapped to the files they resolve to. Which file a name resolves to depends on the files in
+    /// the VFS, like whether there is a .dds file to use instead of a .tga one, or one in the top level directory.
+    typedef std::map<std::string, std::string> ResolvedTextures;
+
+    ResolvedTextures resolveTextures(const std::vector<std::string>& names, const VFS::Manager* vfs)
+    {
+        ResolvedTextures textures;
+        for (const std::string& name : names)
+            textures.emplace(name, Misc::ResourceHelpers::correctTexturePath(name, vfs));
+        return textures;
+    }
+
+    void writeResolvedTextures(std::ostream& stream, const ResolvedTextures& textures)
+    {
+        writeValue(stream, static_cast<uint32_t>(textures.size()));
+        for (const auto& texture : textures)
+        {
+            writeValue(stream, texture.first);
+            writeValue(stream, texture.second);
+        }
+    }
+
+    /// Do the texture names kept in \a stream still resolve to the files they did when they were kept?
+    bool readResolvedTextures(std::istream& stream, const VFS::Manager* vfs)
+    {
+        uint32_t count = 0;
+
+        if (!readValue(stream, count) || count > Files::sMaxCacheValueSize)
+            return false;
+
+        std::string name;
+        std::string resolved;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (!readValue(stream, name) || !readValue(stream, resolved)
+                || Misc::ResourceHelpers::correctTexturePath(name, vfs) != resolved)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool isWritableClass(const osg::Object& object)
+    {
+        if (std::strcmp(object.libraryName(), "osg") == 0)
+            return true;
+
+        return std::strcmp(object.libraryName(), "NifOsg") == 0 && std::strcmp(object.className(), "MatrixTransform") == 0;
+    }
+
+    bool canWrite(const osg::UserDataContainer* container)
+    {
+        if (!container)
+            return true;
+
+        if (!isWritableClass(*container) || container->getUserData())
+            return false;
+
+        for (unsigned int i = 0; i < container->getNumUserObjects(); ++i)
+        {
+            if (!isWritableClass(*container->getUserObject(i)))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool canWrite(const osg::StateAttribute& attribute)
+    {
+        if (!isWritableClass(attribute) || attribute.getUpdateCallback() || attribute.getEventCallback()
+            || !canWrite(attribute.getUserDataContainer()))
+            return false;
+
+        // Images are written as the names they are read back with through the image manager
+        if (const osg::Texture* texture = attribute.asTexture())
+        {
+            for (unsigned int i = 0; i < texture->getNumImages(); ++i)
+            {
+                const osg::Image* image = texture->getImage(i);
+                if (image && image->getFileName().empty())
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool canWrite(const osg::StateSet* stateset)
+    {
+        if (!stateset)
+            return true;
+
+        if (stateset->getUpdateCallback() || stateset->getEventCallback() || !canWrite(stateset->getUserDataContainer()))
+            return false;
+
+        for (const auto& attribute : stateset->getAttributeList())
+        {
+            if (!canWrite(*attribute.second.first))
+                return false;
+        }
+
+        for (const auto& unit : stateset->getTextureAttributeList())
+        {
+            for (const auto& attribute : unit)
+            {
+                if (!canWrite(*attribute.second.first))
+                    return false;
+            }
+        }
+
+        for (const auto& uniform : stateset->getUniformList())
+        {
+            if (!isWritableClass(*uniform.second.first) || uniform.second.first->getUpdateCallback()
+                || uniform.second.first->getEventCallback())
+                return false;
+        }
+
+        return true;
+    }
+
+    /// Finds anything in a graph that can't be written and read back in full, like controllers and classes
+    /// of our own
+    class CanWriteVisitor : public osg::NodeVisitor
+    {
+    public:
+        CanWriteVisitor()
+            : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            , mCanWrite(true)
+        {
+        }
+
+        void apply(osg::Node& node) override
+        {
+            if (!isWritableClass(node) || node.getUpdateCallback() || node.getEventCallback() || node.getCullCallback()
+                || node.getComputeBoundingSphereCallback() || !canWrite(node.getUserDataContainer())
+                || !canWrite(node.getStateSet()))
+            {
+                mCanWrite = false;
+                return;
+            }
+
+            traverse(node);
+        }
+
+        void apply(osg::Drawable& drawable) override
+        {
+            if (drawable.getComputeBoundingBoxCallback() || drawable.getDrawCallback())
+            {
+                mCanWrite = false;
+                return;
+            }
+
+            apply(static_cast<osg::Node&>(drawable));
+        }
+
+        bool mCanWrite;
+    };
+
+    bool checkRotationScale(const NifOsg::MatrixTransform& node)
+    {
+        return true;
+    }
+
+    bool readRotationScale(osgDB::InputStream& stream, NifOsg::MatrixTransform& node)
+    {
+        stream >> node.mScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                stream >> node.mRotationScale.mValues[i][j];
+        return true;
+    }
+
+    bool writeRotationScale(osgDB::OutputStream& stream, const NifOsg::MatrixTransform& node)
+    {
+        stream << node.mScale;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                stream << node.mRotationScale.mValues[i][j];
+        stream << std::endl;
+        return true;
+    }
+
+    osg::Object* createMatrixTransform()
+    {
+        return new NifOsg::MatrixTransform;
+    }
+
+    /// Writes and reads back the transformation components NifOsg::MatrixTransform keeps besides its matrix
+    class MatrixTransformWrapper : public osgDB::ObjectWrapper
+    {
+    public:
+        MatrixTransformWrapper()
+            : osgDB::ObjectWrapper(createMatrixTransform, "NifOsg::MatrixTransform",
+                "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
+        {
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>("RotationScale",
+                checkRotationScale, readRotationScale, writeRotationScale), osgDB::BaseSerializer::RW_USER);
+        }
+    };
+}
+
+namespace Resource
+{
+
+    SceneCache::SceneCache(const std::string& directory, std::size_t maxSize, const VFS::Manager* vfs, osgDB::Options* readOptions)
+        : mDirectory(directory)
+        , mMaxSize(maxSize)
+        , mSize(0)
+        , mFull(false)
+        , mVFS(vfs)
+        , mReaderWriter(osgDB::Registry::instance()->getReaderWriterForExtension("osgb"))
+        , mReadOptions(readOptions)
+        , mWriteOptions(new osgDB::Options)
+        , mGeometryWrapper(nullptr)
+        , mMatrixTransformWrapper(nullptr)
+    {
+        static std::once_flag registered;
+        std::call_once(registered, []
+        {
+            osgDB::Registry::instance()->getObjectWrapperManager()->addWrapper(new MatrixTransformWrapper);
+        });
+
+        osgDB::ObjectWrapperManager* wrappers = osgDB::Registry::instance()->getObjectWrapperManager();
+        mGeometryWrapper = wrappers->findWrapper("osg::Geometry");
+        mMatrixTransformWrapper = wrappers->findWrapper("NifOsg::MatrixTransform");
+
+        if (!mReaderWriter || !mGeometryWrapper)
+        {
+            Log(Debug::Warning) << "Scene cache " << mDirectory << " is unavailable: no support for writing and reading .osgb files";
+            mReaderWriter = nullptr;
+            return;
+        }
+
+        // Write images as their names, which the read options read back through the image manager
+        mWriteOptions->setPluginStringData("WriteImageHint", "UseExternal");
+
+        try
+        {
+            boost::filesystem::create_directories(mDirectory);
+            evict();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Scene cache " << mDirectory << " is unavailable: " << e.what();
+            mReaderWriter = nullptr;
+        }
+    }
+
+    bool SceneCache::hasOwnWrappers() const
+    {
+        osgDB::ObjectWrapperManager* wrappers = osgDB::Registry::instance()->getObjectWrapperManager();
+        return wrappers->findWrapper("osg::Geometry") == mGeometryWrapper
+            && wrappers->findWrapper("NifOsg::MatrixTransform") == mMatrixTransformWrapper;
+    }
+
+    std::string SceneCache::getPath(const std::string& normalizedFilename) const
+    {
+        boost::crc_32_type crc;
+        crc.process_bytes(normalizedFilename.data(), normalizedFilename.size());
+
+        std::ostringstream name;
+        name << std::hex << std::setw(8) << std::setfill('0') << crc.checksum() << ".osgb";
+
+        return (boost::filesystem::path(mDirectory) / name.str()).string();
+    }
+
+    void SceneCache::evict()
+    {
+        struct Entry
+        {
+            std::time_t mTime;
+            std::size_t mSize;
+            boost::filesystem::path mPath;
+        };
+
+        std::vector<Entry> entries;
+        std::size_t size = 0;
+
+        for (boost::filesystem::directory_iterator it(mDirectory), end; it != end; ++it)
+        {
+            if (!boost::filesystem::is_regular_file(it->status()))
+                continue;
+
+            const boost::filesystem::path& path = it->path();
+
+            if (Files::isInterruptedWrite(path))
+                boost::filesystem::remove(path);
+            else if (path.extension() == ".osgb")
+            {
+                Entry entry { boost::filesystem::last_write_time(path),
+                    static_cast<std::size_t>(boost::filesystem::file_size(path)), path };
+                size += entry.mSize;
+                entries.push_back(entry);
+            }
+        }
+
+        // Files are touched whenever they are read, so the oldest ones are the least recently used
+        std::sort(entries.begin(), entries.end(), [] (const Entry& left, const Entry& right) { return left.mTime < right.mTime; });
+
+        std::size_t removed = 0;
+        for (const Entry& entry : entries)
+        {
+            if (size <= mMaxSize)
+                break;
+
+            boost::filesystem::remove(entry.mPath);
+            size -= entry.mSize;
+            ++removed;
+        }
+
+        if (removed > 0)
+            Log(Debug::Info) << "Removed " << removed << " least recently used files from scene cache " << mDirectory;
+
+        mSize = size;
+    }
+
+    osg::ref_ptr<osg::Node> SceneCache::get(const std::string& normalizedFilename, std::istream& source, uint32_t& sourceChecksum)
+    {
+        sourceChecksum = checksum(source);
+
+        if (!isEnabled() || !hasOwnWrappers())
+            return nullptr;
+
+        const std::string path = getPath(normalizedFilename);
+
+        try
+        {
+            if (!boost::filesystem::exists(path))
+                return nullptr;
+
+            boost::iostreams::mapped_file_source file(path);
+            Files::IMemStream header(file.data(), file.size());
+
+            std::string name;
+            std::string settings;
+            uint32_t fileChecksum = 0;
+
+            bool good = Files::readCacheHeader(header, sMagic, sFormatVersion) &&
+                readValue(header, name) && name == normalizedFilename &&
+                readValue(header, settings) && settings == getSettingsKey() &&
+                readValue(header, fileChecksum) && fileChecksum == sourceChecksum &&
+                readResolvedTextures(header, mVFS);
+
+            if (!good)
+                return nullptr;
+
+            const std::size_t offset = static_cast<std::size_t>(header.tellg());
+            Files::IMemStream payload(file.data() + offset, file.size() - offset);
+
+            osgDB::ReaderWriter::ReadResult result = mReaderWriter->readNode(payload, mReadOptions);
+            if (!result.success() || !result.getNode())
+            {
+                Log(Debug::Warning) << "Failed to read " << normalizedFilename << " from scene cache: " << result.message();
+                return nullptr;
+            }
+
+            // Mark the file as recently used
+            boost::system::error_code error;
+            boost::filesystem::last_write_time(path, std::time(nullptr), error);
+
+            return result.getNode();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read " << normalizedFilename << " from scene cache: " << e.what();
+            return nullptr;
+        }
+    }
+
+    void SceneCache::put(const std::string& normalizedFilename, uint32_t sourceChecksum,
+        const std::vector<std::string>& textureNames, osg::Node& node)
+    {
+        if (!isEnabled() || mFull || !hasOwnWrappers())
+            return;
+
+        CanWriteVisitor visitor;
+        node.accept(visitor);
+        if (!visitor.mCanWrite)
+            return;
+
+        try
+        {
+            std::stringstream payload(std::ios::in | std::ios::out | std::ios::binary);
+
+            osgDB::ReaderWriter::WriteResult result = mReaderWriter->writeNode(node, payload, mWriteOptions);
+            if (!result.success())
+                throw std::runtime_error(result.message());
+
+            const std::string data = payload.str();
+
+            if (mSize + data.size() > mMaxSize)
+            {
+                if (!mFull.exchange(true))
+                    Log(Debug::Info) << "Scene cache " << mDirectory << " is full, no more scenes are added to it this session";
+                return;
+            }
+
+            mSize += data.size();
+
+            const boost::filesystem::path path = getPath(normalizedFilename);
+
+            Files::writeFileAtomically(path, [&] (std::ostream& stream)
+            {
+                Files::writeCacheHeader(stream, sMagic, sFormatVersion);
+                writeValue(stream, normalizedFilename);
+                writeValue(stream, getSettingsKey());
+                writeValue(stream, sourceChecksum);
+                writeResolvedTextures(stream, resolveTextures(textureNames, mVFS));
+                stream.write(data.data(), data.size());
+            });
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to add " << normalizedFilename << " to scene cache: " << e.what();
+        }
+    }
+
+}
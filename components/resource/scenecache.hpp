@@ -0,0 +1,85 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_SCENECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_SCENECACHE_H
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#include <osg/ref_ptr>
+#include <osg/Node>
+
+namespace VFS
+{
+    class Manager;
+}
+
+namespace osgDB
+{
+    class Options;
+    class ObjectWrapper;
+    class ReaderWriter;
+}
+
+namespace Resource
+{
+
+    /// @brief Scene graphs converted from NIF files, kept on disk between sessions in OSG's native binary format.
+    /// @par Every graph is kept in a file of its own, along with the checksum of the NIF file it was converted from
+    /// and the settings the conversion depends on, so a graph is only reused while neither of them has changed.
+    /// The texture names the NIF file refers to are kept as well, and resolved again whenever the graph is read, so
+    /// a graph isn't reused when the textures it would be converted with now come from other files.
+    /// Only graphs made of classes that can be written and read back in full are kept. Anything with controllers,
+    /// skinning or particles is converted every time.
+    /// @par Once the files take up more than the size limit, nothing more is added for the rest of the session, and
+    /// the least recently used files are removed the next time the cache is opened.
+    /// @note Thread safe.
+    class SceneCache
+    {
+    public:
+        /// @param vfs The VFS texture names are resolved in.
+        /// @param readOptions Options to read the graphs with, which have to take care of reading the images they use.
+        SceneCache(const std::string& directory, std::size_t maxSize, const VFS::Manager* vfs, osgDB::Options* readOptions);
+
+        /// Can graphs be written and read in this build?
+        bool isEnabled() const { return mReaderWriter != nullptr; }
+
+        /// Get the graph kept for \a normalizedFilename, if it was converted from a file with the contents \a source
+        /// gives, with the same settings and the same texture files.
+        /// @param checksum Set to the checksum of \a source, to pass to put() if nothing is kept.
+        osg::ref_ptr<osg::Node> get(const std::string& normalizedFilename, std::istream& source, uint32_t& checksum);
+
+        /// Keep \a node, converted from \a normalizedFilename with the contents \a checksum is for, if all of it
+        /// can be written and read back, and there is room for it.
+        /// @param textureNames The texture names the file refers to, as they are before being resolved.
+        void put(const std::string& normalizedFilename, uint32_t checksum, const std::vector<std::string>& textureNames,
+            osg::Node& node);
+
+    private:
+        std::string mDirectory;
+        std::size_t mMaxSize;
+        std::atomic<std::size_t> mSize;
+        std::atomic<bool> mFull;
+        const VFS::Manager* mVFS;
+
+        osgDB::ReaderWriter* mReaderWriter;
+        osg::ref_ptr<osgDB::Options> mReadOptions;
+        osg::ref_ptr<osgDB::Options> mWriteOptions;
+
+        // The wrappers the graphs are written and read with. Writing scenes for debugging replaces some of
+        // them with ones that leave things out, after which nothing can be reused.
+        const osgDB::ObjectWrapper* mGeometryWrapper;
+        const osgDB::ObjectWrapper* mMatrixTransformWrapper;
+
+        bool hasOwnWrappers() const;
+
+        std::string getPath(const std::string& normalizedFilename) const;
+
+        void evict();
+    };
+
+}
+
+#endif
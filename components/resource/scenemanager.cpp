@@ -1,6 +1,7 @@
 #include "scenemanager.hpp"
 
 #include <cstdlib>
+#include <vector>
 
 #include <osg/Node>
 #include <osg/UserDataContainer>
@@ -35,6 +36,19 @@
 #include "objectcache.hpp"
 #include "multiobjectcache.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/nif/controlled.hpp>
+#include <components/nif/property.hpp>
+
+#include "scenecache.hpp"
+/*
+    End of tes3mp addition
+*/
+
 namespace
 {
 
@@ -107,6 +121,40 @@ namespace
     private:
         unsigned int mMask;
     };
+
+    /*
+        Start of tes3mp addition
+
+        Collect the texture names a NIF file refers to, for the scene cache to check which files they resolve to
+    */
+    std::vector<std::string> getTextureNames(const Nif::File& file)
+    {
+        std::vector<std::string> names;
+
+        for (size_t i = 0; i < file.numRecords(); ++i)
+        {
+            const Nif::Record* record = file.getRecord(i);
+
+            if (record->recType == Nif::RC_NiSourceTexture)
+            {
+                const Nif::NiSourceTexture* texture = static_cast<const Nif::NiSourceTexture*>(record);
+                if (texture->external || texture->data.empty())
+                    names.push_back(texture->filename);
+            }
+            else if (record->recType == Nif::RC_BSShaderTextureSet)
+            {
+                const Nif::BSShaderTextureSet* textureSet = static_cast<const Nif::BSShaderTextureSet*>(record);
+                names.insert(names.end(), textureSet->textures.begin(), textureSet->textures.end());
+            }
+            else if (record->recType == Nif::RC_BSShaderNoLightingProperty)
+                names.push_back(static_cast<const Nif::BSShaderNoLightingProperty*>(record)->filename);
+        }
+
+        return names;
+    }
+    /*
+        End of tes3mp addition
+    */
 }
 
 namespace Resource
@@ -529,7 +577,29 @@ namespace Resource
             {
                 Files::IStreamPtr file = mVFS->get(normalized);
 
-                loaded = load(file, normalized, mImageManager, mNifFileManager);
+                /*
+                    Start of tes3mp change (major)
+
+                    Take graphs converted from NIF files in earlier sessions from the scene cache, and add the
+                    ones that have to be converted to it
+                */
+                if (mSceneCache && getFileExtension(normalized) == "nif")
+                {
+                    uint32_t checksum = 0;
+                    loaded = mSceneCache->get(normalized, *file, checksum);
+
+                    if (!loaded)
+                    {
+                        // NIF files are read through the NIF file manager rather than the stream the checksum was taken from
+                        loaded = load(file, normalized, mImageManager, mNifFileManager);
+                        mSceneCache->put(normalized, checksum, getTextureNames(*mNifFileManager->get(normalized)), *loaded);
+                    }
+                }
+                else
+                    loaded = load(file, normalized, mImageManager, mNifFileManager);
+                /*
+                    End of tes3mp change (major)
+                */
             }
             catch (std::exception& e)
             {
@@ -794,6 +864,26 @@ namespace Resource
         stats->setAttribute(frameNumber, "Node Instance", mInstanceCache->getCacheSize());
     }
 
+    /*
+        Start of tes3mp addition
+
+        Allow converted NIF files to be kept on disk between sessions
+    */
+    void SceneManager::setSceneCache(const std::string& directory, std::size_t maxSize)
+    {
+        // Read the images the graphs use through the image manager, like those of other models
+        osg::ref_ptr<osgDB::Options> options (new osgDB::Options);
+        options->setReadFileCallback(new ImageReadCallback(mImageManager));
+
+        mSceneCache.reset(new SceneCache(directory, maxSize, mVFS, options));
+
+        if (!mSceneCache->isEnabled())
+            mSceneCache.reset();
+    }
+    /*
+        End of tes3mp addition
+    */
+
     Shader::ShaderVisitor *SceneManager::createShaderVisitor(const std::string& shaderPrefix, bool translucentFramebuffer)
     {
         Shader::ShaderVisitor* shaderVisitor = new Shader::ShaderVisitor(*mShaderManager.get(), *mImageManager, shaderPrefix);
@@ -19,6 +19,16 @@ namespace Resource
     class ImageManager;
     class NifFileManager;
     class SharedStateManager;
+
+    /*
+        Start of tes3mp addition
+
+        Allow converted NIF files to be kept on disk between sessions
+    */
+    class SceneCache;
+    /*
+        End of tes3mp addition
+    */
 }
 
 namespace osgUtil
@@ -186,6 +196,18 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        /*
+            Start of tes3mp addition
+
+            Allow converted NIF files to be kept on disk between sessions
+        */
+        /// Keep the scene graphs converted from NIF files in \a directory between sessions, in files that may take
+        /// up \a maxSize bytes together. Should be called before anything is loaded.
+        void setSceneCache(const std::string& directory, std::size_t maxSize);
+        /*
+            End of tes3mp addition
+        */
+
     private:
 
         Shader::ShaderVisitor* createShaderVisitor(const std::string& shaderPrefix = "objects", bool translucentFramebuffer = false);
@@ -220,6 +242,16 @@ namespace Resource
 
         unsigned int mParticleSystemMask;
 
+        /*
+            Start of tes3mp addition
+
+            Allow converted NIF files to be kept on disk between sessions
+        */
+        std::unique_ptr<SceneCache> mSceneCache;
+        /*
+            End of tes3mp addition
+        */
+
         SceneManager(const SceneManager&);
         void operator = (const SceneManager&);
     };
@@ -402,6 +402,32 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Physics Actors",
             "Physics Objects",
             "Physics HeightFields",
+            /*
+                Start of tes3mp addition
+
+                Display the stats reported by the multiplayer networking
+            */
+            "",
+            "Net System In",
+            "Net System Out",
+            "Net Player In",
+            "Net Player Out",
+            "Net Actor In",
+            "Net Actor Out",
+            "Net Object In",
+            "Net Object Out",
+            "Net Worldstate In",
+            "Net Worldstate Out",
+            "Net Bytes In",
+            "Net Bytes Out",
+            "Net Process us",
+            "Net RTT ms",
+            "Net Loss %",
+            "Net Interp Players",
+            "Net Interp Actors",
+            /*
+                End of tes3mp addition
+            */
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
@@ -3,6 +3,16 @@
 
 #include <map>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <iosfwd>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/files/constrainedfilestream.hpp>
 
 namespace VFS
@@ -14,6 +24,18 @@ namespace VFS
         virtual ~File() {}
 
         virtual Files::IStreamPtr open() = 0;
+
+        /*
+            Start of tes3mp addition
+
+            Allow files to be made ready ahead of being opened
+        */
+        /// Do whatever work opening the file takes in advance, so open() returns quicker later on.
+        /// @note May be called from any thread.
+        virtual void prefetch() {}
+        /*
+            End of tes3mp addition
+        */
     };
 
     class Archive
@@ -28,6 +50,24 @@ namespace VFS
         virtual bool contains(const std::string& file, char (*normalize_function) (char)) const = 0;
 
         virtual std::string getDescription() const = 0;
+
+        /*
+            Start of tes3mp addition
+
+            Allow archives that take long to list to keep their listing on disk between sessions
+        */
+        /// Write the names listResources() found, along with what is needed to tell later on whether they are
+        /// still up to date. Archives that are quick to list anyway write nothing.
+        /// @return Was anything written?
+        virtual bool writeIndex(std::ostream& stream) const { return false; }
+
+        /// Take the names for listResources() from what writeIndex() wrote in an earlier session, unless the
+        /// archive has changed since then.
+        /// @return Were the names taken?
+        virtual bool readIndex(std::istream& stream) { return false; }
+        /*
+            End of tes3mp addition
+        */
     };
 
 }
@@ -5,17 +5,46 @@
 namespace VFS
 {
 
-BsaArchive::BsaArchive(const std::string &filename)
+/*
+    Start of tes3mp change (minor)
+
+    Allow the files decompressed from the archive to be kept in a cache shared between archives
+*/
+BsaArchive::BsaArchive(const std::string &filename, std::shared_ptr<Bsa::BlobCache> blobCache)
+/*
+    End of tes3mp change (minor)
+*/
 {
     Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(filename);
 
     if (bsaVersion == Bsa::BSAVER_COMPRESSED) {
         mFile = std::make_unique<Bsa::CompressedBSAFile>(Bsa::CompressedBSAFile());
+
+        /*
+            Start of tes3mp addition
+
+            Keep the files decompressed from the archive in the shared cache, if there is one
+        */
+        if (blobCache)
+            static_cast<Bsa::CompressedBSAFile*>(mFile.get())->setBlobCache(std::move(blobCache));
+        /*
+            End of tes3mp addition
+        */
     }
     else {
         mFile = std::make_unique<Bsa::BSAFile>(Bsa::BSAFile());
     }
 
+    /*
+        Start of tes3mp addition
+
+        Read the files in the archive from a mapping of it
+    */
+    mFile->setMemoryMapped(true);
+    /*
+        End of tes3mp addition
+    */
+
     mFile->open(filename);
 
     const Bsa::BSAFile::FileList &filelist = mFile->getList();
@@ -70,4 +99,17 @@ Files::IStreamPtr BsaArchiveFile::open()
     return mFile->getFile(mInfo);
 }
 
+/*
+    Start of tes3mp addition
+
+    Allow files to be decompressed ahead of being opened
+*/
+void BsaArchiveFile::prefetch()
+{
+    mFile->prefetch(mInfo);
+}
+/*
+    End of tes3mp addition
+*/
+
 }
@@ -5,6 +5,21 @@
 
 #include <components/bsa/bsa_file.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <memory>
+/*
+    End of tes3mp addition
+*/
+
+namespace Bsa
+{
+    class BlobCache;
+}
+
 namespace VFS
 {
     class BsaArchiveFile : public File
@@ -14,6 +29,16 @@ namespace VFS
 
         Files::IStreamPtr open() override;
 
+        /*
+            Start of tes3mp addition
+
+            Allow files to be decompressed ahead of being opened
+        */
+        void prefetch() override;
+        /*
+            End of tes3mp addition
+        */
+
         const Bsa::BSAFile::FileStruct* mInfo;
         Bsa::BSAFile* mFile;
     };
@@ -21,7 +46,15 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::string& filename);
+        /*
+            Start of tes3mp change (minor)
+
+            Allow the files decompressed from the archive to be kept in a cache shared between archives
+        */
+        BsaArchive(const std::string& filename, std::shared_ptr<Bsa::BlobCache> blobCache = nullptr);
+        /*
+            End of tes3mp change (minor)
+        */
         virtual ~BsaArchive();
         void listResources(std::map<std::string, File*>& out, char (*normalize_function) (char)) override;
         bool contains(const std::string& file, char (*normalize_function) (char)) const override;
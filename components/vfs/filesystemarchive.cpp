@@ -4,45 +4,101 @@
 
 #include <components/debug/debuglog.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <istream>
+#include <ostream>
+
+#include <stdint.h>
+
+#include <components/files/binarycache.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace VFS
 {
 
     FileSystemArchive::FileSystemArchive(const std::string &path)
         : mBuiltIndex(false)
         , mPath(path)
+        , mScanTime(0)
+        , mScanned(false)
     {
 
     }
 
-    void FileSystemArchive::listResources(std::map<std::string, File *> &out, char (*normalize_function)(char))
+    /*
+        Start of tes3mp addition
+
+        Walk through the directory apart from building the index, so the names can also be taken
+        from a listing kept on disk
+    */
+    void FileSystemArchive::scan()
     {
-        if (!mBuiltIndex)
-        {
-            typedef boost::filesystem::recursive_directory_iterator directory_iterator;
+        typedef boost::filesystem::recursive_directory_iterator directory_iterator;
+
+        directory_iterator end;
 
-            directory_iterator end;
+        size_t prefix = mPath.size ();
 
-            size_t prefix = mPath.size ();
+        if (mPath.size () > 0 && mPath [prefix - 1] != '\\' && mPath [prefix - 1] != '/')
+            ++prefix;
 
-            if (mPath.size () > 0 && mPath [prefix - 1] != '\\' && mPath [prefix - 1] != '/')
-                ++prefix;
+        mScanTime = std::time(nullptr);
+        mDirectories.emplace_back(std::string(), boost::filesystem::last_write_time (mPath));
+
+        for (directory_iterator i (mPath); i != end; ++i)
+        {
+            std::string proper = i->path ().string ();
 
-            for (directory_iterator i (mPath); i != end; ++i)
+            if(boost::filesystem::is_directory (*i))
             {
-                if(boost::filesystem::is_directory (*i))
-                    continue;
+                mDirectories.emplace_back(proper.substr(prefix), boost::filesystem::last_write_time (i->path ()));
+                continue;
+            }
 
-                std::string proper = i->path ().string ();
+            mFiles.push_back(proper.substr(prefix));
+        }
+
+        mScanned = true;
+    }
+    /*
+        End of tes3mp addition
+    */
+
+    void FileSystemArchive::listResources(std::map<std::string, File *> &out, char (*normalize_function)(char))
+    {
+        if (!mBuiltIndex)
+        {
+            /*
+                Start of tes3mp change (major)
+
+                Build the index from the names found in the directory, or kept on disk from an
+                earlier session
+            */
+            if (!mScanned)
+                scan();
+
+            for (const std::string& name : mFiles)
+            {
+                std::string proper = (boost::filesystem::path (mPath) / name).string ();
 
                 FileSystemArchiveFile file(proper);
 
                 std::string searchable;
 
-                std::transform(proper.begin() + prefix, proper.end(), std::back_inserter(searchable), normalize_function);
+                std::transform(name.begin(), name.end(), std::back_inserter(searchable), normalize_function);
 
                 if (!mIndex.insert (std::make_pair (searchable, file)).second)
                     Log(Debug::Warning) << "Warning: found duplicate file for '" << proper << "', please check your file system for two files with the same name in different cases.";
             }
+            /*
+                End of tes3mp change (major)
+            */
 
             mBuiltIndex = true;
         }
@@ -63,6 +119,88 @@ namespace VFS
         return std::string{"DIR: "} + mPath;
     }
 
+    /*
+        Start of tes3mp addition
+
+        Allow the listing of the directory to be kept on disk between sessions
+    */
+    bool FileSystemArchive::writeIndex(std::ostream& stream) const
+    {
+        if (!mScanned)
+            return false;
+
+        Files::writeValue (stream, static_cast<int64_t> (mScanTime));
+        Files::writeValue (stream, static_cast<uint32_t> (mDirectories.size()));
+
+        for (const auto& directory : mDirectories)
+        {
+            Files::writeValue (stream, directory.first);
+            Files::writeValue (stream, static_cast<int64_t> (directory.second));
+        }
+
+        Files::writeValue (stream, static_cast<uint32_t> (mFiles.size()));
+
+        for (const std::string& name : mFiles)
+            Files::writeValue (stream, name);
+
+        return true;
+    }
+
+    bool FileSystemArchive::readIndex(std::istream& stream)
+    {
+        if (mScanned)
+            return false;
+
+        int64_t scanTime = 0;
+        uint32_t count = 0;
+
+        if (!Files::readValue (stream, scanTime) || !Files::readValue (stream, count) || count > Files::sMaxCacheValueSize)
+            return false;
+
+        std::vector<std::pair<std::string, std::time_t>> directories;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            std::string name;
+            int64_t time = 0;
+
+            if (!Files::readValue (stream, name) || !Files::readValue (stream, time))
+                return false;
+
+            // Any file added to, removed from or renamed in a directory changes its modification time
+            boost::system::error_code error;
+            std::time_t currentTime = boost::filesystem::last_write_time (boost::filesystem::path (mPath) / name, error);
+
+            // Modification times only have a resolution of a second, so a directory changed around the time
+            // it was scanned may have been changed again without it showing
+            if (error || static_cast<int64_t> (currentTime) != time || time >= scanTime - 1)
+                return false;
+
+            directories.emplace_back(name, currentTime);
+        }
+
+        if (!Files::readValue (stream, count) || count > Files::sMaxCacheValueSize)
+            return false;
+
+        std::vector<std::string> files (count);
+
+        for (std::string& name : files)
+        {
+            if (!Files::readValue (stream, name))
+                return false;
+        }
+
+        mDirectories.swap (directories);
+        mFiles.swap (files);
+        mScanTime = static_cast<std::time_t> (scanTime);
+        mScanned = true;
+
+        return true;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     // ----------------------------------------------------------------------------------
 
     FileSystemArchiveFile::FileSystemArchiveFile(const std::string &path)
@@ -3,6 +3,18 @@
 
 #include "archive.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <ctime>
+#include <utility>
+#include <vector>
+/*
+    End of tes3mp addition
+*/
+
 namespace VFS
 {
 
@@ -29,6 +41,19 @@ namespace VFS
 
         std::string getDescription() const override;
 
+        /*
+            Start of tes3mp addition
+
+            Allow the listing of the directory to be kept on disk between sessions, as walking
+            through large data directories takes a while
+        */
+        bool writeIndex(std::ostream& stream) const override;
+
+        bool readIndex(std::istream& stream) override;
+        /*
+            End of tes3mp addition
+        */
+
     private:
         typedef std::map <std::string, FileSystemArchiveFile> index;
         index mIndex;
@@ -36,6 +61,23 @@ namespace VFS
         bool mBuiltIndex;
         std::string mPath;
 
+        /*
+            Start of tes3mp addition
+
+            Keep the names found in the directory apart from the index built from them, along
+            with the modification time of every directory, which changes whenever a file is
+            added to, removed from or renamed in it
+        */
+        void scan();
+
+        std::vector<std::string> mFiles;
+        std::vector<std::pair<std::string, std::time_t>> mDirectories;
+        std::time_t mScanTime;
+        bool mScanned;
+        /*
+            End of tes3mp addition
+        */
+
     };
 
 }
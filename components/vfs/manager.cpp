@@ -2,6 +2,28 @@
 
 #include <stdexcept>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#include <stdint.h>
+
+#include <boost/filesystem.hpp>
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/binarycache.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/misc/stringops.hpp>
 
 #include "archive.hpp"
@@ -25,6 +47,79 @@ namespace
         std::transform(path.begin(), path.end(), path.begin(), normalize_char);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Read and write the listings of archives kept on disk between sessions
+    */
+    const char sMagic[] = "OMWVFSINDEX";
+
+    // Increase when the layout of index cache files changes
+    const uint32_t sFormatVersion = 1;
+
+    // A listing bigger than this in an index cache file means the file is damaged
+    const uint32_t sMaxListingSize = 256 * 1024 * 1024;
+
+    // Map the description of each archive to its listing
+    typedef std::map<std::string, std::string> IndexCache;
+
+    IndexCache readIndexCache(const std::string& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+
+        if (!stream.is_open())
+            return IndexCache();
+
+        uint32_t count = 0;
+
+        bool good = Files::readCacheHeader(stream, sMagic, sFormatVersion) &&
+            Files::readValue(stream, count);
+
+        IndexCache cache;
+
+        for (uint32_t i = 0; good && i < count; ++i)
+        {
+            std::string description;
+            std::string listing;
+
+            good = Files::readValue(stream, description) && Files::readValue(stream, listing, sMaxListingSize);
+            cache[description].swap(listing);
+        }
+
+        if (!good)
+        {
+            Log(Debug::Warning) << "Ignoring outdated or damaged file index cache " << path;
+            return IndexCache();
+        }
+
+        return cache;
+    }
+
+    void writeIndexCache(const std::string& path, const IndexCache& cache)
+    {
+        try
+        {
+            Files::writeFileAtomically(path, [&cache] (std::ostream& stream)
+            {
+                Files::writeCacheHeader(stream, sMagic, sFormatVersion);
+                Files::writeValue(stream, static_cast<uint32_t>(cache.size()));
+
+                for (const auto& entry : cache)
+                {
+                    Files::writeValue(stream, entry.first);
+                    Files::writeValue(stream, entry.second);
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save file index cache " << path << ": " << e.what();
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
+
 }
 
 namespace VFS
@@ -44,6 +139,15 @@ namespace VFS
     void Manager::reset()
     {
         mIndex.clear();
+        /*
+            Start of tes3mp addition
+
+            Keep the lookup table in line with the index
+        */
+        mLookup.clear();
+        /*
+            End of tes3mp addition
+        */
         for (std::vector<Archive*>::iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             delete *it;
         mArchives.clear();
@@ -54,13 +158,132 @@ namespace VFS
         mArchives.push_back(archive);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Allow the listings of archives that take long to list to be kept on disk between sessions
+    */
+    void Manager::setIndexCache(const std::string& path)
+    {
+        mIndexCachePath = path;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     void Manager::buildIndex()
     {
         mIndex.clear();
 
-        for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
-            (*it)->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+        /*
+            Start of tes3mp change (major)
+
+            List the archives on several threads, taking the listings of those that haven't changed
+            since the last session from the index cache, and then merge the listings in the order
+            the archives were added in, so the last one still has priority
+        */
+        const IndexCache cache = mIndexCachePath.empty() ? IndexCache() : readIndexCache(mIndexCachePath);
+
+        std::vector<std::map<std::string, File*>> listings(mArchives.size());
+        std::vector<char> fromCache(mArchives.size(), false);
+        std::vector<std::exception_ptr> errors(mArchives.size());
+        std::atomic<std::size_t> next(0);
+        char (*normalize_function)(char) = mStrict ? &strict_normalize_char : &nonstrict_normalize_char;
+
+        auto listArchives = [&] ()
+        {
+            for (std::size_t i = next++; i < mArchives.size(); i = next++)
+            {
+                try
+                {
+                    IndexCache::const_iterator cached = cache.find(mArchives[i]->getDescription());
+
+                    if (cached != cache.end())
+                    {
+                        std::istringstream stream(cached->second);
+                        fromCache[i] = mArchives[i]->readIndex(stream);
+                    }
+
+                    mArchives[i]->listResources(listings[i], normalize_function);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        const std::size_t threadCount = std::max<std::size_t>(1,
+            std::min<std::size_t>(std::thread::hardware_concurrency(), mArchives.size()));
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 1; i < threadCount; ++i)
+            threads.emplace_back(listArchives);
+
+        listArchives();
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (const std::exception_ptr& error : errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        for (const std::map<std::string, File*>& listing : listings)
+        {
+            for (const auto& entry : listing)
+                mIndex[entry.first] = entry.second;
+        }
+
+        buildLookup();
+
+        if (!mIndexCachePath.empty())
+        {
+            IndexCache newCache;
+            bool changed = false;
+
+            for (std::size_t i = 0; i < mArchives.size(); ++i)
+            {
+                std::ostringstream stream;
+
+                if (mArchives[i]->writeIndex(stream))
+                {
+                    newCache[mArchives[i]->getDescription()] = stream.str();
+                    changed = changed || !fromCache[i];
+                }
+            }
+
+            if (changed || newCache.size() != cache.size())
+                writeIndexCache(mIndexCachePath, newCache);
+        }
+        /*
+            End of tes3mp change (major)
+        */
+    }
+
+    /*
+        Start of tes3mp addition
+
+        Look files up in an open-addressing hash table over the names in mIndex
+    */
+    void Manager::buildLookup()
+    {
+        mLookup.clear();
+        mLookup.reserve(mIndex.size());
+
+        for (const auto& entry : mIndex)
+            mLookup.insert(entry.first, entry.second);
+    }
+
+    File* Manager::lookup(const std::string& normalizedName) const
+    {
+        return mLookup.search(normalizedName);
     }
+    /*
+        End of tes3mp addition
+    */
 
     Files::IStreamPtr Manager::get(const std::string &name) const
     {
@@ -72,10 +295,18 @@ namespace VFS
 
     Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
+        /*
+            Start of tes3mp change (minor)
+
+            Look the file up in the hash table
+        */
+        File* file = lookup(normalizedName);
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return file->open();
+        /*
+            End of tes3mp change (minor)
+        */
     }
 
     bool Manager::exists(const std::string &name) const
@@ -83,8 +314,33 @@ namespace VFS
         std::string normalized = name;
         normalize_path(normalized, mStrict);
 
-        return mIndex.find(normalized) != mIndex.end();
+        /*
+            Start of tes3mp change (minor)
+
+            Look the file up in the hash table
+        */
+        return lookup(normalized) != nullptr;
+        /*
+            End of tes3mp change (minor)
+        */
+    }
+
+    /*
+        Start of tes3mp addition
+
+        Allow files to be made ready ahead of being opened
+    */
+    void Manager::prefetch(const std::string &name) const
+    {
+        std::string normalized = name;
+        normalize_path(normalized, mStrict);
+
+        if (File* file = lookup(normalized))
+            file->prefetch();
     }
+    /*
+        End of tes3mp addition
+    */
 
     const std::map<std::string, File*>& Manager::getIndex() const
     {
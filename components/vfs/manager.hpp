@@ -6,6 +6,19 @@
 #include <vector>
 #include <map>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <functional>
+#include <string>
+
+#include <components/misc/stringindex.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace VFS
 {
 
@@ -33,6 +46,18 @@ namespace VFS
         /// @note Takes ownership of the given pointer.
         void addArchive(Archive* archive);
 
+        /*
+            Start of tes3mp addition
+
+            Allow the listings of archives that take long to list to be kept on disk between sessions
+        */
+        /// Keep the listings of archives that take long to list, like data directories, in the file at
+        /// \a path between sessions. Should be called before buildIndex().
+        void setIndexCache(const std::string& path);
+        /*
+            End of tes3mp addition
+        */
+
         /// Build the file index. Should be called when all archives have been registered.
         void buildIndex();
 
@@ -59,12 +84,42 @@ namespace VFS
         Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
 
         std::string getArchive(const std::string& name) const;
+
+        /*
+            Start of tes3mp addition
+
+            Allow files to be made ready ahead of being opened
+        */
+        /// Do the work opening a file takes in advance, like decompressing it into the cache of
+        /// decompressed files. Files that don't exist are ignored.
+        /// @note May be called from any thread once the index has been built.
+        void prefetch(const std::string& name) const;
+        /*
+            End of tes3mp addition
+        */
     private:
         bool mStrict;
 
         std::vector<Archive*> mArchives;
 
         std::map<std::string, File*> mIndex;
+
+        /*
+            Start of tes3mp addition
+
+            Look files up in an open-addressing hash table over the names in mIndex, which is
+            kept for listing the files in order
+        */
+        Misc::StringIndex<File, std::hash<std::string>> mLookup;
+
+        std::string mIndexCachePath;
+
+        File* lookup(const std::string& normalizedName) const;
+
+        void buildLookup();
+        /*
+            End of tes3mp addition
+        */
     };
 
 }
@@ -3,6 +3,18 @@
 #include <set>
 #include <sstream>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <future>
+#include <memory>
+/*
+    End of tes3mp addition
+*/
+
+#include <components/bsa/blobcache.hpp>
 #include <components/debug/debuglog.hpp>
 
 #include <components/vfs/manager.hpp>
@@ -12,10 +24,30 @@
 namespace VFS
 {
 
-    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles)
+    /*
+        Start of tes3mp change (minor)
+
+        Allow the files decompressed from BSA archives to be kept in a cache shared between them
+    */
+    void registerArchives(VFS::Manager *vfs, const Files::Collections &collections, const std::vector<std::string> &archives, bool useLooseFiles, std::size_t archiveCacheSize)
+    /*
+        End of tes3mp change (minor)
+    */
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
+        /*
+            Start of tes3mp change (major)
+
+            Open the BSA archives, which reads their file lists, in parallel, and then add them
+            in their original order
+        */
+        std::vector<std::future<std::unique_ptr<Archive>>> bsaArchives;
+
+        std::shared_ptr<Bsa::BlobCache> blobCache;
+        if (archiveCacheSize > 0)
+            blobCache = std::make_shared<Bsa::BlobCache>(archiveCacheSize);
+
         for (std::vector<std::string>::const_iterator archive = archives.begin(); archive != archives.end(); ++archive)
         {
             if (collections.doesExist(*archive))
@@ -24,7 +56,8 @@ namespace VFS
                 const std::string archivePath = collections.getPath(*archive).string();
                 Log(Debug::Info) << "Adding BSA archive " << archivePath;
 
-                vfs->addArchive(new BsaArchive(archivePath));
+                bsaArchives.push_back(std::async(std::launch::async,
+                    [archivePath, blobCache] { return std::unique_ptr<Archive>(new BsaArchive(archivePath, blobCache)); }));
             }
             else
             {
@@ -34,6 +67,12 @@ namespace VFS
             }
         }
 
+        for (std::future<std::unique_ptr<Archive>>& archive : bsaArchives)
+            vfs->addArchive(archive.get().release());
+        /*
+            End of tes3mp change (major)
+        */
+
         if (useLooseFiles)
         {
             std::set<boost::filesystem::path> seen;
@@ -7,9 +7,19 @@ namespace VFS
 {
     class Manager;
 
+    /*
+        Start of tes3mp change (minor)
+
+        Allow the files decompressed from BSA archives to be kept in a cache shared between them
+    */
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param archiveCacheSize How many bytes the files decompressed from compressed BSA archives
+    /// may take up in a cache shared between them, or 0 to not keep them at all.
     void registerArchives (VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, std::size_t archiveCacheSize = 0);
+    /*
+        End of tes3mp change (minor)
+    */
 }
 
 #endif